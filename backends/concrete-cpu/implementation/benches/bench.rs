@@ -1,7 +1,21 @@
+use std::alloc::{alloc, dealloc, Layout};
+
+use concrete_cpu::c_api::fft::{
+    concrete_cpu_construct_concrete_fft, concrete_cpu_destroy_concrete_fft, CONCRETE_FFT_ALIGN,
+    CONCRETE_FFT_SIZE,
+};
+use concrete_cpu::c_api::keyswitch::{
+    concrete_cpu_keyswitch_lwe_ciphertext_list_u64, concrete_cpu_keyswitch_lwe_ciphertext_u64,
+};
 use concrete_cpu::c_api::linear_op::{
     concrete_cpu_add_lwe_ciphertext_u64, concrete_cpu_add_plaintext_lwe_ciphertext_u64,
     concrete_cpu_mul_cleartext_lwe_ciphertext_u64, concrete_cpu_negate_lwe_ciphertext_u64,
 };
+use concrete_cpu::c_api::types::Parallelism;
+use concrete_cpu::c_api::wop_pbs::{
+    concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64,
+    concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64_scratch,
+};
 use criterion::{criterion_group, criterion_main, Criterion};
 
 pub fn criterion_benchmark(c: &mut Criterion) {
@@ -63,5 +77,172 @@ pub fn criterion_benchmark(c: &mut Criterion) {
     }
 }
 
-criterion_group!(benches, criterion_benchmark);
+/// Compares the keyswitch specialized for the level count of the key with the generic one, used
+/// above `MAX_SPECIALIZED_KEYSWITCH_LEVEL` levels, and the keyswitch of lists of ciphertexts of
+/// increasing size.
+pub fn keyswitch_benchmark(c: &mut Criterion) {
+    let input_dimension = 2048;
+    let output_dimension = 750;
+
+    for (level, base_log) in [(3, 4), (5, 3), (9, 2)] {
+        let ksk = vec![0_u64; input_dimension * level * (output_dimension + 1)];
+        let ct_in = vec![0_u64; input_dimension + 1];
+        let mut ct_out = vec![0_u64; output_dimension + 1];
+
+        c.bench_function(
+            &format!("keyswitch-lwe-ciphertext-u64-level-{level}"),
+            |b| {
+                b.iter(|| unsafe {
+                    concrete_cpu_keyswitch_lwe_ciphertext_u64(
+                        ct_out.as_mut_ptr(),
+                        ct_in.as_ptr(),
+                        ksk.as_ptr(),
+                        level,
+                        base_log,
+                        input_dimension,
+                        output_dimension,
+                    );
+                });
+            },
+        );
+    }
+
+    // The throughput of the list keyswitch is compared to the one of the keyswitch of the
+    // ciphertexts one at a time above.
+    let (level, base_log) = (3, 4);
+    let ksk = vec![0_u64; input_dimension * level * (output_dimension + 1)];
+    for count in [1, 8, 32, 128] {
+        let ct_in = vec![0_u64; (input_dimension + 1) * count];
+        let mut ct_out = vec![0_u64; (output_dimension + 1) * count];
+
+        c.bench_function(&format!("keyswitch-lwe-ciphertext-list-u64-{count}"), |b| {
+            b.iter(|| unsafe {
+                concrete_cpu_keyswitch_lwe_ciphertext_list_u64(
+                    ct_out.as_mut_ptr(),
+                    ct_in.as_ptr(),
+                    ksk.as_ptr(),
+                    level,
+                    base_log,
+                    input_dimension,
+                    output_dimension,
+                    count,
+                );
+            });
+        });
+    }
+}
+
+/// Measures how the circuit bootstraps and vertical packings of a WoP-PBS scale with the number
+/// of threads.
+pub fn wop_pbs_benchmark(c: &mut Criterion) {
+    let lwe_dimension = 600;
+    let glwe_dimension = 1;
+    let polynomial_size = 1024;
+    let level = 2;
+    let base_log = 10;
+    let ct_in_count = 8;
+    let lut_count = 4;
+
+    let lut_size = 1 << ct_in_count;
+    let big_lwe_dimension = glwe_dimension * polynomial_size;
+    let fpksk_count = glwe_dimension + 1;
+
+    let bsk_len =
+        polynomial_size * (glwe_dimension + 1) * (glwe_dimension + 1) * lwe_dimension * level;
+    let fpksk_len =
+        level * (glwe_dimension + 1) * polynomial_size * (big_lwe_dimension + 1) * fpksk_count;
+
+    let fourier_bsk = vec![0.0_f64; bsk_len];
+    let fpksk = vec![0_u64; fpksk_len];
+    let luts = vec![0_u64; lut_size * lut_count];
+    let ct_in = vec![0_u64; (lwe_dimension + 1) * ct_in_count];
+    let mut ct_out = vec![0_u64; (big_lwe_dimension + 1) * lut_count];
+
+    let fft_layout = Layout::from_size_align(CONCRETE_FFT_SIZE, CONCRETE_FFT_ALIGN).unwrap();
+    let fft = unsafe { alloc(fft_layout) };
+    unsafe { concrete_cpu_construct_concrete_fft(fft.cast(), polynomial_size) };
+
+    let mut stack_size = 0;
+    let mut stack_align = 0;
+    unsafe {
+        concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64_scratch(
+            &mut stack_size,
+            &mut stack_align,
+            lut_count,
+            lwe_dimension,
+            ct_in_count,
+            lut_size,
+            lut_count,
+            glwe_dimension,
+            polynomial_size,
+            polynomial_size,
+            level,
+            fft.cast(),
+        )
+    };
+    let stack_layout = Layout::from_size_align(stack_size, stack_align).unwrap();
+    let stack = unsafe { alloc(stack_layout) };
+
+    // The pointers are passed as addresses so that the closure can be sent to the thread pools.
+    let (fft_addr, stack_addr) = (fft as usize, stack as usize);
+    let mut run = |parallelism| unsafe {
+        concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64(
+            ct_out.as_mut_ptr(),
+            ct_in.as_ptr(),
+            luts.as_ptr(),
+            fourier_bsk.as_ptr(),
+            fpksk.as_ptr(),
+            big_lwe_dimension,
+            lut_count,
+            lwe_dimension,
+            ct_in_count,
+            lut_size,
+            lut_count,
+            level,
+            base_log,
+            glwe_dimension,
+            polynomial_size,
+            lwe_dimension,
+            level,
+            base_log,
+            big_lwe_dimension,
+            glwe_dimension,
+            polynomial_size,
+            fpksk_count,
+            level,
+            base_log,
+            parallelism,
+            fft_addr as *const _,
+            stack_addr as *mut u8,
+            stack_size,
+        );
+    };
+
+    c.bench_function("wop-pbs-cbs-vp-sequential", |b| {
+        b.iter(|| run(Parallelism::No));
+    });
+
+    for thread_count in [1, 2, 4, 8] {
+        let pool = rayon::ThreadPoolBuilder::new()
+            .num_threads(thread_count)
+            .build()
+            .unwrap();
+        c.bench_function(&format!("wop-pbs-cbs-vp-rayon-{thread_count}"), |b| {
+            b.iter(|| pool.install(|| run(Parallelism::Rayon)));
+        });
+    }
+
+    unsafe {
+        dealloc(stack, stack_layout);
+        concrete_cpu_destroy_concrete_fft(fft.cast());
+        dealloc(fft, fft_layout);
+    }
+}
+
+criterion_group!(
+    benches,
+    criterion_benchmark,
+    keyswitch_benchmark,
+    wop_pbs_benchmark
+);
 criterion_main!(benches);
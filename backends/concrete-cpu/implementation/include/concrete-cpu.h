@@ -137,6 +137,7 @@ void concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64(
                                                                                 size_t fpksk_count,
                                                                                 size_t cbs_decomposition_level_count,
                                                                                 size_t cbs_decomposition_base_log,
+                                                                                Parallelism parallelism,
                                                                                 const struct Fft *fft,
                                                                                 uint8_t *stack,
                                                                                 size_t stack_size);
@@ -194,6 +195,27 @@ void concrete_cpu_encrypt_lwe_ciphertext_u64(const uint64_t *lwe_sk,
                                              struct Csprng *csprng,
                                              const struct CsprngVtable *csprng_vtable);
 
+void concrete_cpu_extract_bit_lwe_ciphertext_list_u64(uint64_t *ct_vec_out,
+                                                      const uint64_t *ct_vec_in,
+                                                      const double *fourier_bsk,
+                                                      const uint64_t *ksk,
+                                                      size_t ct_out_dimension,
+                                                      size_t ct_out_count,
+                                                      size_t ct_in_dimension,
+                                                      size_t ct_in_count,
+                                                      const size_t *number_of_bits,
+                                                      const size_t *delta_log,
+                                                      size_t bsk_decomposition_level_count,
+                                                      size_t bsk_decomposition_base_log,
+                                                      size_t bsk_glwe_dimension,
+                                                      size_t bsk_polynomial_size,
+                                                      size_t bsk_input_lwe_dimension,
+                                                      size_t ksk_decomposition_level_count,
+                                                      size_t ksk_decomposition_base_log,
+                                                      size_t ksk_input_dimension,
+                                                      size_t ksk_output_dimension,
+                                                      const struct Fft *fft);
+
 void concrete_cpu_extract_bit_lwe_ciphertext_u64(uint64_t *ct_vec_out,
                                                  const uint64_t *ct_in,
                                                  const double *fourier_bsk,
@@ -261,6 +283,32 @@ void concrete_cpu_init_lwe_keyswitch_key_u64(uint64_t *lwe_ksk,
                                              struct Csprng *csprng,
                                              const struct CsprngVtable *csprng_vtable);
 
+void concrete_cpu_init_lwe_multi_bit_bootstrap_key_u64(uint64_t *lwe_bsk,
+                                                       const uint64_t *input_lwe_sk,
+                                                       const uint64_t *output_glwe_sk,
+                                                       size_t input_lwe_dimension,
+                                                       size_t output_polynomial_size,
+                                                       size_t output_glwe_dimension,
+                                                       size_t decomposition_level_count,
+                                                       size_t decomposition_base_log,
+                                                       size_t grouping_factor,
+                                                       double variance,
+                                                       Parallelism parallelism,
+                                                       struct Csprng *csprng,
+                                                       const struct CsprngVtable *csprng_vtable);
+
+void concrete_cpu_init_lwe_packing_keyswitch_key_u64(uint64_t *lwe_pksk,
+                                                     const uint64_t *input_lwe_sk,
+                                                     const uint64_t *output_glwe_sk,
+                                                     size_t input_lwe_dimension,
+                                                     size_t output_polynomial_size,
+                                                     size_t output_glwe_dimension,
+                                                     size_t decomposition_level_count,
+                                                     size_t decomposition_base_log,
+                                                     double variance,
+                                                     struct Csprng *csprng,
+                                                     const struct CsprngVtable *csprng_vtable);
+
 void concrete_cpu_init_secret_key_u64(uint64_t *sk,
                                       size_t dimension,
                                       struct Csprng *csprng,
@@ -271,6 +319,15 @@ size_t concrete_cpu_keyswitch_key_size_u64(size_t decomposition_level_count,
                                            size_t input_dimension,
                                            size_t output_dimension);
 
+void concrete_cpu_keyswitch_lwe_ciphertext_list_u64(uint64_t *ct_out_list,
+                                                    const uint64_t *ct_in_list,
+                                                    const uint64_t *keyswitch_key,
+                                                    size_t decomposition_level_count,
+                                                    size_t decomposition_base_log,
+                                                    size_t input_dimension,
+                                                    size_t output_dimension,
+                                                    size_t count);
+
 void concrete_cpu_keyswitch_lwe_ciphertext_u64(uint64_t *ct_out,
                                                const uint64_t *ct_in,
                                                const uint64_t *keyswitch_key,
@@ -284,15 +341,80 @@ size_t concrete_cpu_lwe_packing_keyswitch_key_size(size_t glwe_dimension,
                                                    size_t decomposition_level_count,
                                                    size_t input_dimension);
 
+void concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64(uint64_t *ct_out,
+                                                        const uint64_t *ct_in,
+                                                        const uint64_t *accumulator,
+                                                        const double *fourier_bsk,
+                                                        size_t decomposition_level_count,
+                                                        size_t decomposition_base_log,
+                                                        size_t glwe_dimension,
+                                                        size_t polynomial_size,
+                                                        size_t input_lwe_dimension,
+                                                        size_t lut_count_log,
+                                                        size_t ct_out_count,
+                                                        const struct Fft *fft,
+                                                        uint8_t *stack,
+                                                        size_t stack_size);
+
 void concrete_cpu_mul_cleartext_lwe_ciphertext_u64(uint64_t *ct_out,
                                                    const uint64_t *ct_in,
                                                    uint64_t cleartext,
                                                    size_t lwe_dimension);
 
+void concrete_cpu_multi_bit_bootstrap_key_convert_u64_to_fourier(const uint64_t *standard_bsk,
+                                                                 double *fourier_bsk,
+                                                                 size_t decomposition_level_count,
+                                                                 size_t decomposition_base_log,
+                                                                 size_t glwe_dimension,
+                                                                 size_t polynomial_size,
+                                                                 size_t input_lwe_dimension,
+                                                                 size_t grouping_factor,
+                                                                 const struct Fft *fft,
+                                                                 uint8_t *stack,
+                                                                 size_t stack_size);
+
+size_t concrete_cpu_multi_bit_bootstrap_key_size_u64(size_t decomposition_level_count,
+                                                     size_t glwe_dimension,
+                                                     size_t polynomial_size,
+                                                     size_t input_lwe_dimension,
+                                                     size_t grouping_factor);
+
+void concrete_cpu_multi_bit_bootstrap_lwe_ciphertext_u64(uint64_t *ct_out,
+                                                         const uint64_t *ct_in,
+                                                         const uint64_t *accumulator,
+                                                         const double *fourier_bsk,
+                                                         size_t decomposition_level_count,
+                                                         size_t decomposition_base_log,
+                                                         size_t glwe_dimension,
+                                                         size_t polynomial_size,
+                                                         size_t input_lwe_dimension,
+                                                         size_t grouping_factor,
+                                                         Parallelism parallelism,
+                                                         const struct Fft *fft,
+                                                         uint8_t *stack,
+                                                         size_t stack_size);
+
+ScratchStatus concrete_cpu_multi_bit_bootstrap_lwe_ciphertext_u64_scratch(size_t *stack_size,
+                                                                          size_t *stack_align,
+                                                                          size_t decomposition_level_count,
+                                                                          size_t glwe_dimension,
+                                                                          size_t polynomial_size,
+                                                                          const struct Fft *fft);
+
 void concrete_cpu_negate_lwe_ciphertext_u64(uint64_t *ct_out,
                                             const uint64_t *ct_in,
                                             size_t lwe_dimension);
 
+void concrete_cpu_packing_keyswitch_lwe_ciphertext_list_u64(uint64_t *glwe_ct_out,
+                                                            const uint64_t *lwe_ct_list_in,
+                                                            const uint64_t *packing_keyswitch_key,
+                                                            size_t decomposition_level_count,
+                                                            size_t decomposition_base_log,
+                                                            size_t input_dimension,
+                                                            size_t input_count,
+                                                            size_t output_glwe_dimension,
+                                                            size_t output_polynomial_size);
+
 size_t concrete_cpu_secret_key_size_u64(size_t lwe_dimension);
 
 #ifdef __cplusplus
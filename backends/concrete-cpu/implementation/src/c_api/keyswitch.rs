@@ -1,5 +1,7 @@
 use super::types::{Csprng, CsprngVtable};
 use super::utils::nounwind;
+use crate::implementation::types::ciphertext_list::LweCiphertextList;
+use crate::implementation::types::polynomial::Polynomial;
 use crate::implementation::types::*;
 
 #[no_mangle]
@@ -74,6 +76,38 @@ pub unsafe extern "C" fn concrete_cpu_keyswitch_lwe_ciphertext_u64(
     })
 }
 
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_keyswitch_lwe_ciphertext_list_u64(
+    // ciphertexts
+    ct_out_list: *mut u64,
+    ct_in_list: *const u64,
+    // keyswitch key
+    keyswitch_key: *const u64,
+    // keyswitch parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    input_dimension: usize,
+    output_dimension: usize,
+    count: usize,
+) {
+    nounwind(|| {
+        let ct_out_list = LweCiphertextList::from_raw_parts(ct_out_list, output_dimension, count);
+        let ct_in_list = LweCiphertextList::from_raw_parts(ct_in_list, input_dimension, count);
+
+        let keyswitch_key = LweKeyswitchKey::from_raw_parts(
+            keyswitch_key,
+            output_dimension,
+            input_dimension,
+            DecompParams {
+                level: decomposition_level_count,
+                base_log: decomposition_base_log,
+            },
+        );
+
+        keyswitch_key.keyswitch_ciphertext_list(ct_out_list, ct_in_list);
+    })
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_keyswitch_key_size_u64(
     decomposition_level_count: usize,
@@ -87,3 +121,95 @@ pub unsafe extern "C" fn concrete_cpu_keyswitch_key_size_u64(
         input_dimension,
     )
 }
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_init_lwe_packing_keyswitch_key_u64(
+    // packing keyswitch key
+    lwe_pksk: *mut u64,
+    // secret keys
+    input_lwe_sk: *const u64,
+    output_glwe_sk: *const u64,
+    // secret key dimensions
+    input_lwe_dimension: usize,
+    output_polynomial_size: usize,
+    output_glwe_dimension: usize,
+    // packing keyswitch key parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    // noise parameters
+    variance: f64,
+    // csprng
+    csprng: *mut Csprng,
+    csprng_vtable: *const CsprngVtable,
+) {
+    nounwind(|| {
+        let glwe_params = GlweParams {
+            dimension: output_glwe_dimension,
+            polynomial_size: output_polynomial_size,
+        };
+
+        let input_key = LweSecretKey::<&[u64]>::from_raw_parts(input_lwe_sk, input_lwe_dimension);
+        let output_key = GlweSecretKey::<&[u64]>::from_raw_parts(output_glwe_sk, glwe_params);
+        let mut pksk = PackingKeyswitchKey::<&mut [u64]>::from_raw_parts(
+            lwe_pksk,
+            glwe_params,
+            input_lwe_dimension,
+            DecompParams {
+                level: decomposition_level_count,
+                base_log: decomposition_base_log,
+            },
+        );
+
+        // The input key bits are encrypted in constant polynomials
+        let mut one = vec![0_u64; output_polynomial_size];
+        one[0] = 1;
+
+        pksk.fill_with_private_functional_packing_keyswitch_key(
+            &input_key,
+            &output_key,
+            variance,
+            CsprngMut::new(csprng, csprng_vtable),
+            |x| x,
+            Polynomial::new(one.as_slice(), output_polynomial_size),
+        );
+    })
+}
+
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_packing_keyswitch_lwe_ciphertext_list_u64(
+    // ciphertexts
+    glwe_ct_out: *mut u64,
+    lwe_ct_list_in: *const u64,
+    // packing keyswitch key
+    packing_keyswitch_key: *const u64,
+    // packing keyswitch parameters
+    decomposition_level_count: usize,
+    decomposition_base_log: usize,
+    input_dimension: usize,
+    input_count: usize,
+    output_glwe_dimension: usize,
+    output_polynomial_size: usize,
+) {
+    nounwind(|| {
+        let glwe_params = GlweParams {
+            dimension: output_glwe_dimension,
+            polynomial_size: output_polynomial_size,
+        };
+
+        let glwe_ct_out = GlweCiphertext::from_raw_parts(glwe_ct_out, glwe_params);
+        let lwe_ct_list_in =
+            LweCiphertextList::from_raw_parts(lwe_ct_list_in, input_dimension, input_count);
+
+        let packing_keyswitch_key = PackingKeyswitchKey::<&[u64]>::from_raw_parts(
+            packing_keyswitch_key,
+            glwe_params,
+            input_dimension,
+            DecompParams {
+                level: decomposition_level_count,
+                base_log: decomposition_base_log,
+            },
+        );
+
+        packing_keyswitch_key.packing_keyswitch_ciphertext_list(glwe_ct_out, lwe_ct_list_in);
+    })
+}
@@ -3,9 +3,9 @@ use core::slice;
 
 /// # Safety
 ///
-/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must not alias
-/// `[ct_in0, ct_in0 + lwe_dimension + 1[` or `[ct_in1, ct_in1 + lwe_dimension + 1[`, both of which
-/// must be valid ranges for reads.
+/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must either be equal
+/// to or not alias `[ct_in0, ct_in0 + lwe_dimension + 1[` and `[ct_in1, ct_in1 + lwe_dimension + 1[`,
+/// both of which must be valid ranges for reads.
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_add_lwe_ciphertext_u64(
     ct_out: *mut u64,
@@ -21,7 +21,35 @@ pub unsafe extern "C" fn concrete_cpu_add_lwe_ciphertext_u64(
             }
         }
 
+        #[inline]
+        fn implementation_in_place(ct_out: &mut [u64], ct_in: &[u64]) {
+            for (out, &c) in ct_out.iter_mut().zip(ct_in) {
+                *out = out.wrapping_add(c)
+            }
+        }
+
         let lwe_size = lwe_dimension + 1;
+        if ct_out as *const u64 == ct_in0 && ct_out as *const u64 == ct_in1 {
+            let ct_out = slice::from_raw_parts_mut(ct_out, lwe_size);
+            for out in ct_out {
+                *out = out.wrapping_add(*out);
+            }
+            return;
+        }
+        if ct_out as *const u64 == ct_in0 || ct_out as *const u64 == ct_in1 {
+            let ct_in = if ct_out as *const u64 == ct_in0 {
+                ct_in1
+            } else {
+                ct_in0
+            };
+            pulp::Arch::new().dispatch(|| {
+                implementation_in_place(
+                    slice::from_raw_parts_mut(ct_out, lwe_size),
+                    slice::from_raw_parts(ct_in, lwe_size),
+                )
+            });
+            return;
+        }
         pulp::Arch::new().dispatch(|| {
             implementation(
                 slice::from_raw_parts_mut(ct_out, lwe_size),
@@ -34,8 +62,8 @@ pub unsafe extern "C" fn concrete_cpu_add_lwe_ciphertext_u64(
 
 /// # Safety
 ///
-/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must not alias
-/// `[ct_in, ct_in + lwe_dimension + 1[`, which must be a valid range for reads.
+/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must either be equal
+/// to or not alias `[ct_in, ct_in + lwe_dimension + 1[`, which must be a valid range for reads.
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_add_plaintext_lwe_ciphertext_u64(
     ct_out: *mut u64,
@@ -54,6 +82,11 @@ pub unsafe extern "C" fn concrete_cpu_add_plaintext_lwe_ciphertext_u64(
         }
 
         let lwe_size = lwe_dimension + 1;
+        if ct_out as *const u64 == ct_in {
+            let last = &mut *ct_out.add(lwe_dimension);
+            *last = last.wrapping_add(plaintext);
+            return;
+        }
         pulp::Arch::new().dispatch(|| {
             implementation(
                 slice::from_raw_parts_mut(ct_out, lwe_size),
@@ -66,8 +99,8 @@ pub unsafe extern "C" fn concrete_cpu_add_plaintext_lwe_ciphertext_u64(
 
 /// # Safety
 ///
-/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must not alias
-/// `[ct_in, ct_in + lwe_dimension + 1[`, which must be a valid range for reads.
+/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must either be equal
+/// to or not alias `[ct_in, ct_in + lwe_dimension + 1[`, which must be a valid range for reads.
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_mul_cleartext_lwe_ciphertext_u64(
     ct_out: *mut u64,
@@ -83,7 +116,20 @@ pub unsafe extern "C" fn concrete_cpu_mul_cleartext_lwe_ciphertext_u64(
             }
         }
 
+        #[inline]
+        fn implementation_in_place(ct_out: &mut [u64], cleartext: u64) {
+            for out in ct_out {
+                *out = out.wrapping_mul(cleartext)
+            }
+        }
+
         let lwe_size = lwe_dimension + 1;
+        if ct_out as *const u64 == ct_in {
+            pulp::Arch::new().dispatch(|| {
+                implementation_in_place(slice::from_raw_parts_mut(ct_out, lwe_size), cleartext)
+            });
+            return;
+        }
         pulp::Arch::new().dispatch(|| {
             implementation(
                 slice::from_raw_parts_mut(ct_out, lwe_size),
@@ -96,8 +142,8 @@ pub unsafe extern "C" fn concrete_cpu_mul_cleartext_lwe_ciphertext_u64(
 
 /// # Safety
 ///
-/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must not alias
-/// `[ct_in, ct_in + lwe_dimension + 1[`, which must be a valid range for reads.
+/// `[ct_out, ct_out + lwe_dimension + 1[` must be a valid mutable range, and must either be equal
+/// to or not alias `[ct_in, ct_in + lwe_dimension + 1[`, which must be a valid range for reads.
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_negate_lwe_ciphertext_u64(
     ct_out: *mut u64,
@@ -112,7 +158,19 @@ pub unsafe extern "C" fn concrete_cpu_negate_lwe_ciphertext_u64(
             }
         }
 
+        #[inline]
+        fn implementation_in_place(ct_out: &mut [u64]) {
+            for out in ct_out {
+                *out = out.wrapping_neg();
+            }
+        }
+
         let lwe_size = lwe_dimension + 1;
+        if ct_out as *const u64 == ct_in {
+            pulp::Arch::new()
+                .dispatch(|| implementation_in_place(slice::from_raw_parts_mut(ct_out, lwe_size)));
+            return;
+        }
 
         pulp::Arch::new().dispatch(|| {
             implementation(
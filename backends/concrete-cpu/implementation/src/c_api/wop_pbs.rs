@@ -6,8 +6,9 @@ use crate::implementation::types::packing_keyswitch_key_list::PackingKeyswitchKe
 use crate::implementation::types::polynomial_list::PolynomialList;
 use crate::implementation::types::*;
 use crate::implementation::wop::{
-    circuit_bootstrap_boolean_vertical_packing, circuit_bootstrap_boolean_vertical_packing_scratch,
-    extract_bits, extract_bits_scratch,
+    circuit_bootstrap_boolean_vertical_packing, circuit_bootstrap_boolean_vertical_packing_par,
+    circuit_bootstrap_boolean_vertical_packing_scratch, extract_bits, extract_bits_par,
+    extract_bits_scratch,
 };
 use core::slice;
 use dyn_stack::DynStack;
@@ -184,6 +185,92 @@ pub unsafe extern "C" fn concrete_cpu_extract_bit_lwe_ciphertext_u64(
     })
 }
 
+#[no_mangle]
+pub unsafe extern "C" fn concrete_cpu_extract_bit_lwe_ciphertext_list_u64(
+    // ciphertexts
+    ct_vec_out: *mut u64,
+    ct_vec_in: *const u64,
+    // bootstrap key
+    fourier_bsk: *const f64,
+    // keyswitch key
+    ksk: *const u64,
+    // ciphertexts dimensions
+    ct_out_dimension: usize,
+    ct_out_count: usize,
+    ct_in_dimension: usize,
+    ct_in_count: usize,
+    // extract bit parameters of each input ciphertext, whose bits are output after those of the
+    // previous ones
+    number_of_bits: *const usize,
+    delta_log: *const usize,
+    // bootstrap parameters
+    bsk_decomposition_level_count: usize,
+    bsk_decomposition_base_log: usize,
+    bsk_glwe_dimension: usize,
+    bsk_polynomial_size: usize,
+    bsk_input_lwe_dimension: usize,
+    // keyswitch_parameters
+    ksk_decomposition_level_count: usize,
+    ksk_decomposition_base_log: usize,
+    ksk_input_dimension: usize,
+    ksk_output_dimension: usize,
+    // side resources
+    fft: *const Fft,
+) {
+    nounwind(|| {
+        assert_eq!(ct_in_dimension, bsk_glwe_dimension * bsk_polynomial_size);
+        assert_eq!(ct_in_dimension, ksk_input_dimension);
+        assert_eq!(ct_out_dimension, ksk_output_dimension);
+        assert_eq!(ksk_output_dimension, bsk_input_lwe_dimension);
+
+        let numbers_of_bits = slice::from_raw_parts(number_of_bits, ct_in_count);
+        let delta_logs = slice::from_raw_parts(delta_log, ct_in_count);
+        assert_eq!(ct_out_count, numbers_of_bits.iter().sum::<usize>());
+        for (&number_of_bits, &delta_log) in numbers_of_bits.iter().zip(delta_logs) {
+            assert!(64 <= number_of_bits + delta_log);
+        }
+
+        let lwe_list_out =
+            LweCiphertextList::from_raw_parts(ct_vec_out, ct_out_dimension, ct_out_count);
+
+        let lwe_list_in =
+            LweCiphertextList::from_raw_parts(ct_vec_in, ct_in_dimension, ct_in_count);
+
+        let ksk = LweKeyswitchKey::from_raw_parts(
+            ksk,
+            ksk_output_dimension,
+            ksk_input_dimension,
+            DecompParams {
+                level: ksk_decomposition_level_count,
+                base_log: ksk_decomposition_base_log,
+            },
+        );
+
+        let fourier_bsk = BootstrapKey::from_raw_parts(
+            fourier_bsk,
+            GlweParams {
+                dimension: bsk_glwe_dimension,
+                polynomial_size: bsk_polynomial_size,
+            },
+            bsk_input_lwe_dimension,
+            DecompParams {
+                level: bsk_decomposition_level_count,
+                base_log: bsk_decomposition_base_log,
+            },
+        );
+
+        extract_bits_par(
+            lwe_list_out,
+            lwe_list_in,
+            ksk,
+            fourier_bsk,
+            delta_logs,
+            numbers_of_bits,
+            (*fft).as_view(),
+        );
+    })
+}
+
 #[no_mangle]
 pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_vertical_packing_lwe_ciphertext_u64_scratch(
     stack_size: *mut usize,
@@ -266,6 +353,8 @@ pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_vertical_packing
     // circuit bootstrap parameters
     cbs_decomposition_level_count: usize,
     cbs_decomposition_base_log: usize,
+    // parallelism of the circuit bootstraps and of the vertical packings
+    parallelism: Parallelism,
     // side resources
     fft: *const Fft,
     stack: *mut u8,
@@ -337,19 +426,34 @@ pub unsafe extern "C" fn concrete_cpu_circuit_bootstrap_boolean_vertical_packing
             fpksk_count,
         );
 
-        circuit_bootstrap_boolean_vertical_packing(
-            luts,
-            fourier_bsk,
-            lwe_list_out,
-            lwe_list_in,
-            fpksk_list,
-            DecompParams {
-                level: cbs_decomposition_level_count,
-                base_log: cbs_decomposition_base_log,
-            },
-            (*fft).as_view(),
-            DynStack::new(slice::from_raw_parts_mut(stack as _, stack_size)),
-        );
+        let cbs_dp = DecompParams {
+            level: cbs_decomposition_level_count,
+            base_log: cbs_decomposition_base_log,
+        };
+        let stack = DynStack::new(slice::from_raw_parts_mut(stack as _, stack_size));
+
+        match parallelism {
+            Parallelism::No => circuit_bootstrap_boolean_vertical_packing(
+                luts,
+                fourier_bsk,
+                lwe_list_out,
+                lwe_list_in,
+                fpksk_list,
+                cbs_dp,
+                (*fft).as_view(),
+                stack,
+            ),
+            Parallelism::Rayon => circuit_bootstrap_boolean_vertical_packing_par(
+                luts,
+                fourier_bsk,
+                lwe_list_out,
+                lwe_list_in,
+                fpksk_list,
+                cbs_dp,
+                (*fft).as_view(),
+                stack,
+            ),
+        }
     })
 }
 
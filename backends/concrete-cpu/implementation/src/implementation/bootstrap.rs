@@ -7,6 +7,7 @@ use super::fft::FftView;
 use super::polynomial::{
     update_with_wrapping_monic_monomial_mul, update_with_wrapping_unit_monomial_div,
 };
+use super::types::ciphertext_list::LweCiphertextList;
 use super::types::*;
 use super::zip_eq;
 
@@ -37,17 +38,20 @@ impl<'a> BootstrapKey<&'a [f64]> {
         ])
     }
 
+    /// Rotates `lut` by the phase of `lwe`, the phase being rounded to a multiple of
+    /// `2^lut_count_log`.
     pub fn blind_rotate(
         self,
         mut lut: GlweCiphertext<&mut [u64]>,
         lwe: LweCiphertext<&[u64]>,
+        lut_count_log: usize,
         fft: FftView<'_>,
         mut stack: DynStack<'_>,
     ) {
         let (lwe_body, lwe_mask) = lwe.into_data().split_last().unwrap();
 
         let lut_poly_size = lut.glwe_params.polynomial_size;
-        let modulus_switched_body = pbs_modulus_switch(*lwe_body, lut_poly_size, 0, 0);
+        let modulus_switched_body = pbs_modulus_switch(*lwe_body, lut_poly_size, 0, lut_count_log);
 
         for polynomial in lut.as_mut_view().into_polynomial_list().iter_polynomial() {
             update_with_wrapping_unit_monomial_div(polynomial, modulus_switched_body);
@@ -67,7 +71,7 @@ impl<'a> BootstrapKey<&'a [f64]> {
 
                 // We rotate ct_1 by performing ct_1 <- ct_1 * X^{modulus_switched_mask_element}
                 let modulus_switched_mask_element =
-                    pbs_modulus_switch(*lwe_mask_element, lut_poly_size, 0, 0);
+                    pbs_modulus_switch(*lwe_mask_element, lut_poly_size, 0, lut_count_log);
                 for polynomial in ct1.as_mut_view().into_polynomial_list().iter_polynomial() {
                     update_with_wrapping_monic_monomial_mul(
                         polynomial,
@@ -100,11 +104,45 @@ impl<'a> BootstrapKey<&'a [f64]> {
         );
         let mut local_accumulator =
             GlweCiphertext::new(&mut *local_accumulator_data, accumulator.glwe_params);
-        self.blind_rotate(local_accumulator.as_mut_view(), lwe_in, fft, stack);
+        self.blind_rotate(local_accumulator.as_mut_view(), lwe_in, 0, fft, stack);
         local_accumulator
             .as_view()
             .fill_lwe_with_sample_extraction(lwe_out, 0);
     }
+
+    /// Bootstraps `lwe_in` with an accumulator which interleaves `2^lut_count_log`
+    /// lookup tables, i.e. whose coefficient `i` belongs to the table `i % 2^lut_count_log`,
+    /// and extracts the image of `lwe_in` by each of the first `lwe_out.count` tables with a
+    /// single blind rotation.
+    pub fn many_lut_bootstrap(
+        self,
+        mut lwe_out: LweCiphertextList<&mut [u64]>,
+        lwe_in: LweCiphertext<&[u64]>,
+        accumulator: GlweCiphertext<&[u64]>,
+        lut_count_log: usize,
+        fft: FftView<'_>,
+        stack: DynStack<'_>,
+    ) {
+        debug_assert!(lwe_out.count <= 1 << lut_count_log);
+        let (mut local_accumulator_data, stack) = stack.collect_aligned(
+            CACHELINE_ALIGN,
+            accumulator.as_view().into_data().iter().copied(),
+        );
+        let mut local_accumulator =
+            GlweCiphertext::new(&mut *local_accumulator_data, accumulator.glwe_params);
+        self.blind_rotate(
+            local_accumulator.as_mut_view(),
+            lwe_in,
+            lut_count_log,
+            fft,
+            stack,
+        );
+        for (n_th, lwe) in lwe_out.ciphertext_iter_mut().enumerate() {
+            local_accumulator
+                .as_view()
+                .fill_lwe_with_sample_extraction(lwe, n_th);
+        }
+    }
 }
 
 /// This function switches modulus for a single coefficient of a ciphertext,
@@ -137,6 +175,7 @@ mod tests {
 
     use crate::c_api::types::tests::to_generic;
     use crate::implementation::fft::{Fft, FftView};
+    use crate::implementation::types::ciphertext_list::LweCiphertextList;
     use crate::implementation::types::*;
     use concrete_csprng::generators::{RandomGenerator, SoftwareRandomGenerator};
     use concrete_csprng::seeders::Seed;
@@ -261,6 +300,43 @@ mod tests {
 
             self.out_sk.as_view().decrypt_lwe(output.as_view())
         }
+
+        fn many_lut_bootstrap(
+            &mut self,
+            csprng: CsprngMut,
+            pt: u64,
+            encryption_variance: f64,
+            lut: GlweCiphertext<&[u64]>,
+            lut_count_log: usize,
+        ) -> Vec<u64> {
+            let mut input = LweCiphertext::zero(self.in_dim);
+
+            let lut_count = 1 << lut_count_log;
+            let lwe_dimension = self.glwe_params.lwe_dimension();
+            let mut output = vec![0; (lwe_dimension + 1) * lut_count];
+
+            self.in_sk
+                .as_view()
+                .encrypt_lwe(input.as_mut_view(), pt, encryption_variance, csprng);
+
+            self.fourier_bsk.as_view().many_lut_bootstrap(
+                LweCiphertextList::new(output.as_mut_slice(), lwe_dimension, lut_count),
+                input.as_view(),
+                lut,
+                lut_count_log,
+                self.fft.as_view(),
+                DynStack::new(&mut self.stack),
+            );
+
+            output
+                .chunks_exact(lwe_dimension + 1)
+                .map(|lwe| {
+                    self.out_sk
+                        .as_view()
+                        .decrypt_lwe(LweCiphertext::new(lwe, lwe_dimension))
+                })
+                .collect()
+        }
     }
 
     #[test]
@@ -333,4 +409,77 @@ mod tests {
             assert!((diff as f64).abs() / 2.0_f64.powi(64) < 0.01);
         }
     }
+    #[test]
+    fn many_lut_bootstrap_correctness() {
+        let mut csprng = SoftwareRandomGenerator::new(Seed(0));
+
+        let glwe_dim = 1;
+
+        let log2_poly_size = 10;
+        let polynomial_size = 1 << log2_poly_size;
+
+        let glwe_params = GlweParams {
+            dimension: glwe_dim,
+            polynomial_size,
+        };
+
+        let mut keyset = KeySet::new(
+            to_generic(&mut csprng),
+            600,
+            glwe_params,
+            DecompParams {
+                level: 3,
+                base_log: 10,
+            },
+            0.0000000000000000000001,
+        );
+
+        let log2_precision = 3;
+        let precision = 1 << log2_precision;
+
+        let lut_count_log = 2;
+        let lut_count: u64 = 1 << lut_count_log;
+
+        let lut_case_size = polynomial_size as u64 / precision;
+
+        for _ in 0..20 {
+            let lut_index: u64 =
+                u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())) % precision;
+
+            let luts: Vec<Vec<u64>> = (0..lut_count)
+                .map(|_| {
+                    (0..precision)
+                        .map(|_| {
+                            u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap()))
+                        })
+                        .collect()
+                })
+                .collect();
+
+            // The coefficient `i` of the accumulator belongs to the table `i % lut_count`
+            let raw_lut: Vec<u64> = (0..glwe_dim)
+                .flat_map(|_| (0..polynomial_size).map(|_| 0))
+                .chain(
+                    (0..polynomial_size as u64)
+                        .map(|i| luts[(i % lut_count) as usize][(i / lut_case_size) as usize]),
+                )
+                .collect();
+
+            let pt = (lut_index as f64 + 0.5) / (2. * precision as f64) * 2.0_f64.powi(64);
+
+            let images = keyset.many_lut_bootstrap(
+                to_generic(&mut csprng),
+                pt as u64,
+                0.0000000001,
+                GlweCiphertext::new(&raw_lut, glwe_params),
+                lut_count_log,
+            );
+
+            for (lut, image) in luts.iter().zip(images) {
+                let diff = image.wrapping_sub(lut[lut_index as usize]) as i64;
+
+                assert!((diff as f64).abs() / 2.0_f64.powi(64) < 0.01);
+            }
+        }
+    }
 }
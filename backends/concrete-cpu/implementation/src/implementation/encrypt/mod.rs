@@ -189,6 +189,70 @@ impl BootstrapKey<&mut [u64]> {
     }
 }
 
+/// Returns `1` if the bits of `sk_group` are the bits of `pattern`, and `0` otherwise.
+fn multi_bit_pattern_indicator(sk_group: &[u64], pattern: usize) -> u64 {
+    sk_group
+        .iter()
+        .enumerate()
+        .map(|(j, &bit)| {
+            if (pattern >> j) & 1 == 1 {
+                bit
+            } else {
+                1 - bit
+            }
+        })
+        .product()
+}
+
+impl MultiBitBootstrapKey<&mut [u64]> {
+    pub fn fill_with_new_key(
+        self,
+        lwe_sk: LweSecretKey<&[u64]>,
+        glwe_sk: GlweSecretKey<&[u64]>,
+        variance: f64,
+        mut csprng: CsprngMut<'_, '_>,
+    ) {
+        let grouping_factor = self.grouping_factor;
+        let ggsw_per_group = MultiBitBootstrapKey::<&[u64]>::ggsw_per_group(grouping_factor);
+        for (index, mut ggsw) in self.into_ggsw_iter().enumerate() {
+            let group = index / ggsw_per_group;
+            let pattern = index % ggsw_per_group + 1;
+            let sk_group = &lwe_sk.data[group * grouping_factor..(group + 1) * grouping_factor];
+            let encoded = multi_bit_pattern_indicator(sk_group, pattern);
+            glwe_sk.gen_noise_ggsw(ggsw.as_mut_view(), variance, csprng.as_mut());
+            glwe_sk.encrypt_constant_ggsw_noise_full(ggsw, encoded);
+        }
+    }
+}
+
+#[cfg(feature = "parallel")]
+impl MultiBitBootstrapKey<&mut [u64]> {
+    pub fn fill_with_new_key_par(
+        mut self,
+        lwe_sk: LweSecretKey<&[u64]>,
+        glwe_sk: GlweSecretKey<&[u64]>,
+        variance: f64,
+        mut csprng: CsprngMut<'_, '_>,
+    ) {
+        for ggsw in self.as_mut_view().into_ggsw_iter() {
+            glwe_sk.gen_noise_ggsw(ggsw, variance, csprng.as_mut());
+        }
+
+        let grouping_factor = self.grouping_factor;
+        let ggsw_per_group = MultiBitBootstrapKey::<&[u64]>::ggsw_per_group(grouping_factor);
+
+        self.into_ggsw_iter_par()
+            .enumerate()
+            .for_each(|(index, ggsw)| {
+                let group = index / ggsw_per_group;
+                let pattern = index % ggsw_per_group + 1;
+                let sk_group = &lwe_sk.data[group * grouping_factor..(group + 1) * grouping_factor];
+                let encoded = multi_bit_pattern_indicator(sk_group, pattern);
+                glwe_sk.encrypt_constant_ggsw_noise_full(ggsw, encoded);
+            });
+    }
+}
+
 impl LweKeyswitchKey<&mut [u64]> {
     pub fn fill_with_keyswitch_key(
         self,
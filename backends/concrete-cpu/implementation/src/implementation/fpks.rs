@@ -1,4 +1,5 @@
 use super::decomposer::SignedDecomposer;
+use super::types::ciphertext_list::LweCiphertextList;
 use super::types::{GlweCiphertext, GlweParams, LweCiphertext, PackingKeyswitchKey};
 use super::wop::GlweCiphertextList;
 use super::{zip_eq, Container};
@@ -38,6 +39,49 @@ impl PackingKeyswitchKey<&[u64]> {
     }
 }
 
+impl PackingKeyswitchKey<&[u64]> {
+    /// Packs the ciphertexts of `before` in `after` with a key encrypting the input key bits in
+    /// constant polynomials, the message of the `i`-th input ciphertext being the `i`-th
+    /// coefficient of the message of `after`.
+    pub fn packing_keyswitch_ciphertext_list(
+        &self,
+        mut after: GlweCiphertext<&mut [u64]>,
+        before: LweCiphertextList<&[u64]>,
+    ) {
+        let polynomial_size = self.glwe_params.polynomial_size;
+        debug_assert!(before.count <= polynomial_size);
+        after.as_mut_view().into_data().fill(0);
+
+        let mut keyswitched = vec![0_u64; GlweCiphertext::<&[u64]>::data_len(self.glwe_params)];
+        for (index, input_lwe) in before.ciphertext_iter().enumerate() {
+            self.private_functional_keyswitch_ciphertext(
+                GlweCiphertext::new(keyswitched.as_mut_slice(), self.glwe_params),
+                input_lwe,
+            );
+
+            // We add the keyswitched ciphertext multiplied by X^index, the coefficients going
+            // past the polynomial size being negated
+            for (after_polynomial, keyswitched_polynomial) in zip_eq(
+                after
+                    .as_mut_view()
+                    .into_data()
+                    .chunks_exact_mut(polynomial_size),
+                keyswitched.chunks_exact(polynomial_size),
+            ) {
+                let (after_low, after_high) = after_polynomial.split_at_mut(index);
+                let (keyswitched_low, keyswitched_high) =
+                    keyswitched_polynomial.split_at(polynomial_size - index);
+                for (a, k) in zip_eq(after_high.iter_mut(), keyswitched_low) {
+                    *a = a.wrapping_add(*k);
+                }
+                for (a, k) in zip_eq(after_low.iter_mut(), keyswitched_high) {
+                    *a = a.wrapping_sub(*k);
+                }
+            }
+        }
+    }
+}
+
 pub struct LweKeyBitDecomposition<C: Container> {
     pub data: C,
     pub glwe_params: GlweParams,
@@ -1,12 +1,130 @@
 use super::decomposer::SignedDecomposer;
+use super::types::ciphertext_list::LweCiphertextList;
 use super::types::*;
 use super::zip_eq;
 
+/// Largest decomposition level count for which a specialized keyswitch is instantiated.
+pub const MAX_SPECIALIZED_KEYSWITCH_LEVEL: usize = 8;
+
+/// Number of ciphertexts of a list keyswitched together against each block of the key, so that
+/// the block is only streamed from memory once per tile.
+pub const KEYSWITCH_TILE_SIZE: usize = 8;
+
 impl LweKeyswitchKey<&[u64]> {
     pub fn keyswitch_ciphertext(
         self,
         after: LweCiphertext<&mut [u64]>,
         before: LweCiphertext<&[u64]>,
+    ) {
+        self.keyswitch_tile(after.into_data(), before.into_data());
+    }
+
+    pub fn keyswitch_ciphertext_list(
+        self,
+        after: LweCiphertextList<&mut [u64]>,
+        before: LweCiphertextList<&[u64]>,
+    ) {
+        debug_assert_eq!(after.count, before.count);
+        debug_assert_eq!(after.lwe_dimension, self.output_dimension);
+        debug_assert_eq!(before.lwe_dimension, self.input_dimension);
+
+        let after_tile_len = KEYSWITCH_TILE_SIZE * (self.output_dimension + 1);
+        let before_tile_len = KEYSWITCH_TILE_SIZE * (self.input_dimension + 1);
+
+        for (after, before) in zip_eq(
+            after.into_data().chunks_mut(after_tile_len),
+            before.into_data().chunks(before_tile_len),
+        ) {
+            self.keyswitch_tile(after, before);
+        }
+    }
+
+    /// Keyswitches the contiguous ciphertexts of `before` to `after`, with the kernel specialized
+    /// for the level count of the key if there is one.
+    ///
+    /// The level count is dispatched on at run time, once per tile. The base log and the
+    /// dimensions are run-time values in every kernel, and the decomposition is the generic one.
+    fn keyswitch_tile(self, after: &mut [u64], before: &[u64]) {
+        match self.decomp_params.level {
+            1 => self.keyswitch_tile_specialized::<1>(after, before),
+            2 => self.keyswitch_tile_specialized::<2>(after, before),
+            3 => self.keyswitch_tile_specialized::<3>(after, before),
+            4 => self.keyswitch_tile_specialized::<4>(after, before),
+            5 => self.keyswitch_tile_specialized::<5>(after, before),
+            6 => self.keyswitch_tile_specialized::<6>(after, before),
+            7 => self.keyswitch_tile_specialized::<7>(after, before),
+            8 => self.keyswitch_tile_specialized::<8>(after, before),
+            _ => {
+                for (after, before) in zip_eq(
+                    after.chunks_exact_mut(self.output_dimension + 1),
+                    before.chunks_exact(self.input_dimension + 1),
+                ) {
+                    self.keyswitch_ciphertext_generic(
+                        LweCiphertext::new(after, self.output_dimension),
+                        LweCiphertext::new(before, self.input_dimension),
+                    );
+                }
+            }
+        }
+    }
+
+    /// Keyswitch specialized for `LEVEL` decomposition levels.
+    ///
+    /// The decomposition of each mask element is unrolled in an array, and the `LEVEL` rows of
+    /// its block of the key are accumulated in a single vectorizable pass over the output,
+    /// instead of one pass per level. Each block is applied to all the ciphertexts of the tile
+    /// before moving to the next one, so that it stays in cache.
+    fn keyswitch_tile_specialized<const LEVEL: usize>(self, after: &mut [u64], before: &[u64]) {
+        debug_assert_eq!(self.decomp_params.level, LEVEL);
+
+        let row_len = self.output_dimension + 1;
+        let before_len = self.input_dimension + 1;
+
+        for (after, before) in zip_eq(
+            after.chunks_exact_mut(row_len),
+            before.chunks_exact(before_len),
+        ) {
+            after.fill(0);
+            *after.last_mut().unwrap() = *before.last().unwrap();
+        }
+
+        let decomposer = SignedDecomposer::new(self.decomp_params);
+
+        for (i, block) in self.into_lev_ciphertexts().enumerate() {
+            let block = block.into_data();
+            debug_assert_eq!(block.len(), LEVEL * row_len);
+
+            let rows: [&[u64]; LEVEL] =
+                core::array::from_fn(|level| &block[level * row_len..][..row_len]);
+
+            for (after, before) in zip_eq(
+                after.chunks_exact_mut(row_len),
+                before.chunks_exact(before_len),
+            ) {
+                // The decomposition yields the highest level first, which is the last row of
+                // the block.
+                let mut decomposed = [0_u64; LEVEL];
+                for (value, term) in
+                    zip_eq(decomposed.iter_mut().rev(), decomposer.decompose(before[i]))
+                {
+                    *value = term.value();
+                }
+
+                for (j, a) in after.iter_mut().enumerate() {
+                    let mut sum = 0_u64;
+                    for (row, &value) in rows.iter().zip(decomposed.iter()) {
+                        sum = sum.wrapping_add(row[j].wrapping_mul(value));
+                    }
+                    *a = a.wrapping_sub(sum);
+                }
+            }
+        }
+    }
+
+    fn keyswitch_ciphertext_generic(
+        self,
+        after: LweCiphertext<&mut [u64]>,
+        before: LweCiphertext<&[u64]>,
     ) {
         let after = after.into_data();
         let before = before.into_data();
@@ -42,8 +160,11 @@ impl LweKeyswitchKey<&[u64]> {
 
 #[cfg(test)]
 mod tests {
+    use super::{KEYSWITCH_TILE_SIZE, MAX_SPECIALIZED_KEYSWITCH_LEVEL};
     use crate::c_api::types::tests::to_generic;
+    use crate::implementation::types::ciphertext_list::LweCiphertextList;
     use crate::implementation::types::*;
+    use crate::implementation::zip_eq;
     use concrete_csprng::generators::{RandomGenerator, SoftwareRandomGenerator};
     use concrete_csprng::seeders::Seed;
 
@@ -105,6 +226,79 @@ mod tests {
         }
     }
 
+    #[test]
+    fn keyswitch_specialized_matches_generic() {
+        let mut csprng = SoftwareRandomGenerator::new(Seed(0));
+
+        for level in 1..=MAX_SPECIALIZED_KEYSWITCH_LEVEL + 1 {
+            let (in_dim, out_dim) = (64, 32);
+            let decomp_params = DecompParams { level, base_log: 4 };
+
+            let ksk_data = (0..LweKeyswitchKey::<&[u64]>::data_len(out_dim, level, in_dim))
+                .map(|_| u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())))
+                .collect::<Vec<_>>();
+            let ksk = LweKeyswitchKey::new(ksk_data.as_slice(), out_dim, in_dim, decomp_params);
+
+            let input = (0..in_dim + 1)
+                .map(|_| u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())))
+                .collect::<Vec<_>>();
+
+            let mut specialized = LweCiphertext::zero(out_dim);
+            let mut generic = LweCiphertext::zero(out_dim);
+
+            ksk.keyswitch_ciphertext(
+                specialized.as_mut_view(),
+                LweCiphertext::new(input.as_slice(), in_dim),
+            );
+            ksk.keyswitch_ciphertext_generic(
+                generic.as_mut_view(),
+                LweCiphertext::new(input.as_slice(), in_dim),
+            );
+
+            assert_eq!(specialized, generic);
+        }
+    }
+
+    #[test]
+    fn keyswitch_list_matches_generic() {
+        let mut csprng = SoftwareRandomGenerator::new(Seed(0));
+
+        // The count is not a multiple of the tile size, so that the last tile is partial.
+        let count = 2 * KEYSWITCH_TILE_SIZE + 3;
+
+        for level in [3, MAX_SPECIALIZED_KEYSWITCH_LEVEL + 1] {
+            let (in_dim, out_dim) = (64, 32);
+            let decomp_params = DecompParams { level, base_log: 4 };
+
+            let ksk_data = (0..LweKeyswitchKey::<&[u64]>::data_len(out_dim, level, in_dim))
+                .map(|_| u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())))
+                .collect::<Vec<_>>();
+            let ksk = LweKeyswitchKey::new(ksk_data.as_slice(), out_dim, in_dim, decomp_params);
+
+            let input = (0..(in_dim + 1) * count)
+                .map(|_| u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())))
+                .collect::<Vec<_>>();
+
+            let mut list = vec![0_u64; (out_dim + 1) * count];
+            ksk.keyswitch_ciphertext_list(
+                LweCiphertextList::new(list.as_mut_slice(), out_dim, count),
+                LweCiphertextList::new(input.as_slice(), in_dim, count),
+            );
+
+            for (after, before) in zip_eq(
+                list.chunks_exact(out_dim + 1),
+                input.chunks_exact(in_dim + 1),
+            ) {
+                let mut generic = LweCiphertext::zero(out_dim);
+                ksk.keyswitch_ciphertext_generic(
+                    generic.as_mut_view(),
+                    LweCiphertext::new(before, in_dim),
+                );
+                assert_eq!(after, generic.as_view().into_data());
+            }
+        }
+    }
+
     #[test]
     fn keyswitch_correctness() {
         let mut csprng = SoftwareRandomGenerator::new(Seed(0));
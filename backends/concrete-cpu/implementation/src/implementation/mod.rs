@@ -55,6 +55,7 @@ pub mod cmux;
 pub mod encrypt;
 pub mod external_product;
 pub mod keyswitch;
+pub mod multi_bit_bootstrap;
 pub mod wop;
 
 /// Convert a mutable slice reference to an uninitialized mutable slice reference.
@@ -0,0 +1,425 @@
+use aligned_vec::CACHELINE_ALIGN;
+use concrete_fft::c64;
+use dyn_stack::{DynStack, ReborrowMut, SizeOverflow, StackReq};
+use pulp::{as_arrays, as_arrays_mut};
+
+use super::bootstrap::pbs_modulus_switch;
+use super::external_product::{external_product, external_product_scratch};
+use super::fft::FftView;
+use super::polynomial::update_with_wrapping_unit_monomial_div;
+use super::types::*;
+use super::{assume_init_mut, zip_eq};
+
+/// Returns the required memory for [`fill_with_group_ggsw`].
+fn group_ggsw_scratch(polynomial_size: usize, fft: FftView<'_>) -> Result<StackReq, SizeOverflow> {
+    StackReq::try_all_of([
+        StackReq::try_new_aligned::<u64>(polynomial_size, CACHELINE_ALIGN)?,
+        StackReq::try_new_aligned::<f64>(polynomial_size, CACHELINE_ALIGN)?,
+        fft.forward_scratch()?,
+    ])
+}
+
+/// Fills `ggsw_sum` with the fourier GGSW encrypting `X^{e_p} - 1`, where `p` is the pattern of
+/// the secret key bits of the group and `e_p` the sum of the modulus switched mask elements
+/// selected by `p`, so that an external product by it followed by an addition rotates the
+/// accumulator by the mask elements of the group.
+///
+/// Returns false if the GGSW encrypts zero for every pattern, in which case the external product
+/// can be skipped.
+fn fill_with_group_ggsw(
+    ggsw_sum: &mut [f64],
+    group: &[f64],
+    mask_group: &[u64],
+    lut_count_log: usize,
+    fft: FftView<'_>,
+    stack: DynStack<'_>,
+) -> bool {
+    let polynomial_size = fft.polynomial_size();
+    let ggsw_len = ggsw_sum.len();
+
+    let (mut monomial, stack) =
+        stack.make_aligned_with(polynomial_size, CACHELINE_ALIGN, |_| 0_u64);
+    let (mut fourier_monomial, mut stack) =
+        stack.make_aligned_uninit::<f64>(polynomial_size, CACHELINE_ALIGN);
+
+    ggsw_sum.fill(0.0);
+    let mut is_zero = true;
+    for (index, ggsw) in group.chunks_exact(ggsw_len).enumerate() {
+        let pattern = index + 1;
+        let degree = mask_group
+            .iter()
+            .enumerate()
+            .filter(|(j, _)| (pattern >> j) & 1 == 1)
+            .map(|(_, &a)| pbs_modulus_switch(a, polynomial_size, 0, lut_count_log))
+            .sum::<usize>()
+            % (2 * polynomial_size);
+        if degree == 0 {
+            continue;
+        }
+
+        // X^degree - 1 in Z[X] / (X^N + 1)
+        monomial.fill(0);
+        monomial[0] = u64::MAX;
+        if degree < polynomial_size {
+            monomial[degree] = monomial[degree].wrapping_add(1);
+        } else {
+            let degree = degree - polynomial_size;
+            monomial[degree] = monomial[degree].wrapping_sub(1);
+        }
+        fft.forward_as_integer(&mut fourier_monomial, &monomial, stack.rb_mut());
+        let fourier_monomial = unsafe { assume_init_mut(&mut fourier_monomial) };
+        let (fourier_monomial, _) = as_arrays::<2, _>(fourier_monomial);
+
+        for (sum_poly, ggsw_poly) in zip_eq(
+            ggsw_sum.chunks_exact_mut(polynomial_size),
+            ggsw.chunks_exact(polynomial_size),
+        ) {
+            let (sum_poly, _) = as_arrays_mut::<2, _>(sum_poly);
+            let (ggsw_poly, _) = as_arrays::<2, _>(ggsw_poly);
+            for (out, lhs, rhs) in izip!(sum_poly, ggsw_poly, fourier_monomial) {
+                let result = c64::new(lhs[0], lhs[1]) * c64::new(rhs[0], rhs[1]);
+                out[0] += result.re;
+                out[1] += result.im;
+            }
+        }
+        is_zero = false;
+    }
+    !is_zero
+}
+
+impl<'a> MultiBitBootstrapKey<&'a [f64]> {
+    pub fn blind_rotate_scratch(
+        bsk_glwe_params: GlweParams,
+        decomposition_level_count: usize,
+        fft: FftView<'_>,
+    ) -> Result<StackReq, SizeOverflow> {
+        StackReq::try_all_of([
+            StackReq::try_new_aligned::<f64>(
+                GgswCiphertext::<&[f64]>::data_len(bsk_glwe_params, decomposition_level_count),
+                CACHELINE_ALIGN,
+            )?,
+            StackReq::try_any_of([
+                group_ggsw_scratch(bsk_glwe_params.polynomial_size, fft)?,
+                StackReq::try_all_of([
+                    StackReq::try_new_aligned::<u64>(
+                        (bsk_glwe_params.dimension + 1) * bsk_glwe_params.polynomial_size,
+                        CACHELINE_ALIGN,
+                    )?,
+                    external_product_scratch(bsk_glwe_params, fft)?,
+                ])?,
+            ])?,
+        ])
+    }
+
+    pub fn bootstrap_scratch(
+        bsk_glwe_params: GlweParams,
+        decomposition_level_count: usize,
+        fft: FftView<'_>,
+    ) -> Result<StackReq, SizeOverflow> {
+        StackReq::try_all_of([
+            StackReq::try_new_aligned::<u64>(
+                (bsk_glwe_params.dimension + 1) * bsk_glwe_params.polynomial_size,
+                CACHELINE_ALIGN,
+            )?,
+            Self::blind_rotate_scratch(bsk_glwe_params, decomposition_level_count, fft)?,
+        ])
+    }
+
+    fn ggsw_len(&self) -> usize {
+        GgswCiphertext::<&[f64]>::data_len(self.glwe_params, self.decomp_params.level)
+    }
+
+    /// Rotates `lut` by the phase of `lwe`, processing `grouping_factor` elements of the mask
+    /// with a single external product.
+    pub fn blind_rotate(
+        self,
+        mut lut: GlweCiphertext<&mut [u64]>,
+        lwe: LweCiphertext<&[u64]>,
+        lut_count_log: usize,
+        fft: FftView<'_>,
+        stack: DynStack<'_>,
+    ) {
+        let (lwe_body, lwe_mask) = lwe.into_data().split_last().unwrap();
+
+        let lut_poly_size = lut.glwe_params.polynomial_size;
+        let modulus_switched_body = pbs_modulus_switch(*lwe_body, lut_poly_size, 0, lut_count_log);
+
+        for polynomial in lut.as_mut_view().into_polynomial_list().iter_polynomial() {
+            update_with_wrapping_unit_monomial_div(polynomial, modulus_switched_body);
+        }
+
+        let glwe_params = self.glwe_params;
+        let decomp_params = self.decomp_params;
+        let grouping_factor = self.grouping_factor;
+
+        let (mut ggsw_sum, mut stack) =
+            stack.make_aligned_with(self.ggsw_len(), CACHELINE_ALIGN, |_| 0.0_f64);
+
+        for (group, mask_group) in zip_eq(
+            self.into_group_iter(),
+            lwe_mask.chunks_exact(grouping_factor),
+        ) {
+            if !fill_with_group_ggsw(
+                &mut ggsw_sum,
+                group,
+                mask_group,
+                lut_count_log,
+                fft,
+                stack.rb_mut(),
+            ) {
+                continue;
+            }
+            let stack = stack.rb_mut();
+            let (ct1, stack) =
+                stack.collect_aligned(CACHELINE_ALIGN, lut.as_view().into_data().iter().copied());
+            external_product(
+                lut.as_mut_view(),
+                GgswCiphertext::new(&*ggsw_sum, glwe_params, decomp_params),
+                GlweCiphertext::new(&*ct1, glwe_params),
+                fft,
+                stack,
+            );
+        }
+    }
+
+    /// Same as [`Self::blind_rotate`], with the GGSW of the groups computed in parallel, a batch
+    /// of groups at a time, ahead of the sequential external products.
+    #[cfg(feature = "parallel")]
+    pub fn blind_rotate_par(
+        self,
+        mut lut: GlweCiphertext<&mut [u64]>,
+        lwe: LweCiphertext<&[u64]>,
+        lut_count_log: usize,
+        fft: FftView<'_>,
+        mut stack: DynStack<'_>,
+    ) {
+        use core::mem::MaybeUninit;
+        use rayon::prelude::*;
+
+        let (lwe_body, lwe_mask) = lwe.into_data().split_last().unwrap();
+
+        let lut_poly_size = lut.glwe_params.polynomial_size;
+        let modulus_switched_body = pbs_modulus_switch(*lwe_body, lut_poly_size, 0, lut_count_log);
+
+        for polynomial in lut.as_mut_view().into_polynomial_list().iter_polynomial() {
+            update_with_wrapping_unit_monomial_div(polynomial, modulus_switched_body);
+        }
+
+        let glwe_params = self.glwe_params;
+        let decomp_params = self.decomp_params;
+        let grouping_factor = self.grouping_factor;
+        let ggsw_len = self.ggsw_len();
+        // The buffers of the tasks are not aligned, so we leave room to align them.
+        let group_stack_size =
+            group_ggsw_scratch(lut_poly_size, fft).unwrap().size_bytes() + CACHELINE_ALIGN;
+
+        let batch_size = rayon::current_num_threads();
+        let groups: Vec<&[f64]> = self.into_group_iter().collect();
+        let mut ggsw_sums = vec![0.0_f64; batch_size * ggsw_len];
+        let mut is_nonzero = vec![false; batch_size];
+
+        for (groups, mask_groups) in zip_eq(
+            groups.chunks(batch_size),
+            lwe_mask.chunks(batch_size * grouping_factor),
+        ) {
+            ggsw_sums
+                .par_chunks_exact_mut(ggsw_len)
+                .zip(is_nonzero.par_iter_mut())
+                .zip(groups.par_iter())
+                .zip(mask_groups.par_chunks_exact(grouping_factor))
+                .for_each_init(
+                    || vec![MaybeUninit::<u8>::uninit(); group_stack_size],
+                    |buffer, (((ggsw_sum, is_nonzero), group), mask_group)| {
+                        *is_nonzero = fill_with_group_ggsw(
+                            ggsw_sum,
+                            group,
+                            mask_group,
+                            lut_count_log,
+                            fft,
+                            DynStack::new(buffer),
+                        );
+                    },
+                );
+
+            for (ggsw_sum, _) in ggsw_sums
+                .chunks_exact(ggsw_len)
+                .zip(&is_nonzero)
+                .take(groups.len())
+                .filter(|(_, is_nonzero)| **is_nonzero)
+            {
+                let stack = stack.rb_mut();
+                let (ct1, stack) = stack
+                    .collect_aligned(CACHELINE_ALIGN, lut.as_view().into_data().iter().copied());
+                external_product(
+                    lut.as_mut_view(),
+                    GgswCiphertext::new(ggsw_sum, glwe_params, decomp_params),
+                    GlweCiphertext::new(&*ct1, glwe_params),
+                    fft,
+                    stack,
+                );
+            }
+        }
+    }
+
+    pub fn bootstrap(
+        self,
+        lwe_out: LweCiphertext<&mut [u64]>,
+        lwe_in: LweCiphertext<&[u64]>,
+        accumulator: GlweCiphertext<&[u64]>,
+        parallel: bool,
+        fft: FftView<'_>,
+        stack: DynStack<'_>,
+    ) {
+        let (mut local_accumulator_data, stack) = stack.collect_aligned(
+            CACHELINE_ALIGN,
+            accumulator.as_view().into_data().iter().copied(),
+        );
+        let mut local_accumulator =
+            GlweCiphertext::new(&mut *local_accumulator_data, accumulator.glwe_params);
+        if parallel {
+            self.blind_rotate_par(local_accumulator.as_mut_view(), lwe_in, 0, fft, stack);
+        } else {
+            self.blind_rotate(local_accumulator.as_mut_view(), lwe_in, 0, fft, stack);
+        }
+        local_accumulator
+            .as_view()
+            .fill_lwe_with_sample_extraction(lwe_out, 0);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use std::mem::MaybeUninit;
+
+    use crate::c_api::types::tests::to_generic;
+    use crate::implementation::fft::Fft;
+    use crate::implementation::types::*;
+    use concrete_csprng::generators::{RandomGenerator, SoftwareRandomGenerator};
+    use concrete_csprng::seeders::Seed;
+    use dyn_stack::DynStack;
+
+    fn multi_bit_bootstrap_correctness(grouping_factor: usize, parallel: bool) {
+        let mut csprng = SoftwareRandomGenerator::new(Seed(0));
+
+        let in_dim = 120;
+        let glwe_dim = 1;
+        let polynomial_size = 512;
+        let glwe_params = GlweParams {
+            dimension: glwe_dim,
+            polynomial_size,
+        };
+        let decomp_params = DecompParams {
+            level: 3,
+            base_log: 10,
+        };
+
+        let in_sk = LweSecretKey::new_random(to_generic(&mut csprng), in_dim);
+        let out_sk = LweSecretKey::new_random(to_generic(&mut csprng), glwe_params.lwe_dimension());
+
+        let bsk_len = MultiBitBootstrapKey::<&[u64]>::data_len(
+            glwe_params,
+            decomp_params.level,
+            in_dim,
+            grouping_factor,
+        );
+        let mut bsk = vec![0_u64; bsk_len];
+        MultiBitBootstrapKey::new(
+            bsk.as_mut_slice(),
+            glwe_params,
+            in_dim,
+            decomp_params,
+            grouping_factor,
+        )
+        .fill_with_new_key_par(
+            in_sk.as_view(),
+            GlweSecretKey::new(out_sk.data.as_slice(), glwe_params),
+            0.0000000000000000000001,
+            to_generic(&mut csprng),
+        );
+
+        let fft = Fft::new(polynomial_size);
+        let mut stack = vec![MaybeUninit::new(0_u8); 1000000];
+
+        let mut bsk_f = vec![0.; bsk_len];
+        MultiBitBootstrapKey::new(
+            bsk_f.as_mut_slice(),
+            glwe_params,
+            in_dim,
+            decomp_params,
+            grouping_factor,
+        )
+        .fill_with_forward_fourier(
+            MultiBitBootstrapKey::new(
+                bsk.as_slice(),
+                glwe_params,
+                in_dim,
+                decomp_params,
+                grouping_factor,
+            ),
+            fft.as_view(),
+            DynStack::new(&mut stack),
+        );
+        let fourier_bsk = MultiBitBootstrapKey::new(
+            bsk_f.as_slice(),
+            glwe_params,
+            in_dim,
+            decomp_params,
+            grouping_factor,
+        );
+
+        let precision = 8;
+        let lut_case_size = polynomial_size as u64 / precision;
+
+        for _ in 0..20 {
+            let lut_index: u64 =
+                u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())) % precision;
+
+            let lut: Vec<u64> = (0..precision)
+                .map(|_| u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())))
+                .collect();
+
+            let raw_lut: Vec<u64> = (0..glwe_dim)
+                .flat_map(|_| (0..polynomial_size).map(|_| 0))
+                .chain(
+                    lut.iter()
+                        .flat_map(|&lut_value| (0..lut_case_size).map(move |_| lut_value)),
+                )
+                .collect();
+
+            let pt = (lut_index as f64 + 0.5) / (2. * precision as f64) * 2.0_f64.powi(64);
+
+            let mut input = LweCiphertext::zero(in_dim);
+            let mut output = LweCiphertext::zero(glwe_params.lwe_dimension());
+            in_sk.as_view().encrypt_lwe(
+                input.as_mut_view(),
+                pt as u64,
+                0.0000000001,
+                to_generic(&mut csprng),
+            );
+
+            fourier_bsk.bootstrap(
+                output.as_mut_view(),
+                input.as_view(),
+                GlweCiphertext::new(&raw_lut, glwe_params),
+                parallel,
+                fft.as_view(),
+                DynStack::new(&mut stack),
+            );
+
+            let image = out_sk.as_view().decrypt_lwe(output.as_view());
+            let diff = image.wrapping_sub(lut[lut_index as usize]) as i64;
+
+            assert!((diff as f64).abs() / 2.0_f64.powi(64) < 0.01);
+        }
+    }
+
+    #[test]
+    fn multi_bit_bootstrap_correctness_2() {
+        multi_bit_bootstrap_correctness(2, false);
+    }
+
+    #[test]
+    fn multi_bit_bootstrap_correctness_3_par() {
+        multi_bit_bootstrap_correctness(3, true);
+    }
+}
@@ -39,6 +39,9 @@ pub use ggsw_ciphertext::*;
 mod bootstrap_key;
 pub use bootstrap_key::*;
 
+mod multi_bit_bootstrap_key;
+pub use multi_bit_bootstrap_key::*;
+
 mod keyswitch_key;
 pub use keyswitch_key::*;
 
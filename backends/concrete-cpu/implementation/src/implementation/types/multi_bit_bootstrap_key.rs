@@ -0,0 +1,188 @@
+use super::{DecompParams, GgswCiphertext, GlweParams};
+use crate::implementation::fft::FftView;
+use crate::implementation::{zip_eq, Container, ContainerMut, Split};
+use dyn_stack::{DynStack, ReborrowMut};
+#[cfg(feature = "parallel")]
+use rayon::{
+    prelude::{IndexedParallelIterator, ParallelIterator},
+    slice::ParallelSliceMut,
+};
+
+/// Bootstrap key processing the mask of the input ciphertext `grouping_factor` elements at a
+/// time.
+///
+/// For each group of `grouping_factor` bits of the input secret key, the key holds
+/// `2^grouping_factor - 1` GGSW ciphertexts, the GGSW `p` encrypting `1` if the bits of the
+/// group are the bits of `p`, and `0` otherwise. The GGSW of the pattern `0` is not stored as it
+/// is not needed by the blind rotation.
+#[derive(Copy, Clone, Debug, PartialEq, Eq)]
+#[readonly::make]
+pub struct MultiBitBootstrapKey<C: Container> {
+    pub data: C,
+    pub glwe_params: GlweParams,
+    pub input_lwe_dimension: usize,
+    pub decomp_params: DecompParams,
+    pub grouping_factor: usize,
+}
+
+impl<C: Container> MultiBitBootstrapKey<C> {
+    pub fn ggsw_per_group(grouping_factor: usize) -> usize {
+        (1 << grouping_factor) - 1
+    }
+
+    pub fn data_len(
+        glwe_params: GlweParams,
+        decomposition_level_count: usize,
+        input_lwe_dimension: usize,
+        grouping_factor: usize,
+    ) -> usize {
+        debug_assert_eq!(input_lwe_dimension % grouping_factor, 0);
+        glwe_params.polynomial_size
+            * (glwe_params.dimension + 1)
+            * (glwe_params.dimension + 1)
+            * decomposition_level_count
+            * (input_lwe_dimension / grouping_factor)
+            * Self::ggsw_per_group(grouping_factor)
+    }
+
+    pub fn new(
+        data: C,
+        glwe_params: GlweParams,
+        input_lwe_dimension: usize,
+        decomp_params: DecompParams,
+        grouping_factor: usize,
+    ) -> Self {
+        debug_assert_eq!(
+            data.len(),
+            Self::data_len(
+                glwe_params,
+                decomp_params.level,
+                input_lwe_dimension,
+                grouping_factor
+            ),
+        );
+        Self {
+            data,
+            glwe_params,
+            input_lwe_dimension,
+            decomp_params,
+            grouping_factor,
+        }
+    }
+
+    pub unsafe fn from_raw_parts(
+        data: C::Pointer,
+        glwe_params: GlweParams,
+        input_lwe_dimension: usize,
+        decomp_params: DecompParams,
+        grouping_factor: usize,
+    ) -> Self
+    where
+        C: Split,
+    {
+        let data = C::from_raw_parts(
+            data,
+            Self::data_len(
+                glwe_params,
+                decomp_params.level,
+                input_lwe_dimension,
+                grouping_factor,
+            ),
+        );
+
+        Self {
+            data,
+            glwe_params,
+            input_lwe_dimension,
+            decomp_params,
+            grouping_factor,
+        }
+    }
+
+    pub fn as_view(&self) -> MultiBitBootstrapKey<&[C::Item]> {
+        MultiBitBootstrapKey {
+            data: self.data.as_ref(),
+            glwe_params: self.glwe_params,
+            input_lwe_dimension: self.input_lwe_dimension,
+            decomp_params: self.decomp_params,
+            grouping_factor: self.grouping_factor,
+        }
+    }
+
+    pub fn as_mut_view(&mut self) -> MultiBitBootstrapKey<&mut [C::Item]>
+    where
+        C: ContainerMut,
+    {
+        MultiBitBootstrapKey {
+            data: self.data.as_mut(),
+            glwe_params: self.glwe_params,
+            input_lwe_dimension: self.input_lwe_dimension,
+            decomp_params: self.decomp_params,
+            grouping_factor: self.grouping_factor,
+        }
+    }
+
+    pub fn group_count(&self) -> usize {
+        self.input_lwe_dimension / self.grouping_factor
+    }
+
+    /// Returns an iterator over the groups of the key, each group being the contiguous data of
+    /// its `2^grouping_factor - 1` GGSW ciphertexts.
+    pub fn into_group_iter(self) -> C::Chunks
+    where
+        C: Split,
+    {
+        let group_count = self.group_count();
+        self.data.split_into(group_count)
+    }
+
+    pub fn into_ggsw_iter(self) -> impl DoubleEndedIterator<Item = GgswCiphertext<C>>
+    where
+        C: Split,
+    {
+        let ggsw_count = self.group_count() * Self::ggsw_per_group(self.grouping_factor);
+        self.data
+            .split_into(ggsw_count)
+            .map(move |slice| GgswCiphertext::new(slice, self.glwe_params, self.decomp_params))
+    }
+
+    pub fn output_lwe_dimension(&self) -> usize {
+        self.glwe_params.lwe_dimension()
+    }
+}
+
+#[cfg(feature = "parallel")]
+impl<'a> MultiBitBootstrapKey<&'a mut [u64]> {
+    pub fn into_ggsw_iter_par(
+        self,
+    ) -> impl 'a + IndexedParallelIterator<Item = GgswCiphertext<&'a mut [u64]>> {
+        let ggsw_count = self.group_count() * Self::ggsw_per_group(self.grouping_factor);
+        debug_assert_eq!(self.data.len() % ggsw_count, 0);
+        let chunk_size = self.data.len() / ggsw_count;
+
+        self.data
+            .par_chunks_exact_mut(chunk_size)
+            .map(move |slice| GgswCiphertext::new(slice, self.glwe_params, self.decomp_params))
+    }
+}
+
+impl MultiBitBootstrapKey<&mut [f64]> {
+    pub fn fill_with_forward_fourier(
+        &mut self,
+        coef_bsk: MultiBitBootstrapKey<&[u64]>,
+        fft: FftView<'_>,
+        mut stack: DynStack<'_>,
+    ) {
+        debug_assert_eq!(self.decomp_params, coef_bsk.decomp_params);
+        debug_assert_eq!(self.glwe_params, coef_bsk.glwe_params);
+        debug_assert_eq!(self.input_lwe_dimension, coef_bsk.input_lwe_dimension);
+        debug_assert_eq!(self.grouping_factor, coef_bsk.grouping_factor);
+
+        for (a, b) in zip_eq(
+            self.as_mut_view().into_ggsw_iter(),
+            coef_bsk.into_ggsw_iter(),
+        ) {
+            a.fill_with_forward_fourier(b, fft, stack.rb_mut());
+        }
+    }
+}
@@ -193,6 +193,76 @@ pub fn extract_bits(
     }
 }
 
+/// Same as [`extract_bits`] on each ciphertext of `lwe_list_in`, the ciphertexts being processed in
+/// parallel.
+///
+/// The `numbers_of_bits[i]` bits of the i-th input ciphertext starting at the bit `delta_logs[i]`
+/// are output after the bits of the previous input ciphertexts in `lwe_list_out`. Each task
+/// allocates its own scratch memory.
+#[cfg(feature = "parallel")]
+pub fn extract_bits_par(
+    lwe_list_out: LweCiphertextList<&mut [u64]>,
+    lwe_list_in: LweCiphertextList<&[u64]>,
+    ksk: LweKeyswitchKey<&[u64]>,
+    fourier_bsk: BootstrapKey<&[f64]>,
+    delta_logs: &[usize],
+    numbers_of_bits: &[usize],
+    fft: FftView<'_>,
+) {
+    use core::mem::MaybeUninit;
+    use rayon::prelude::*;
+
+    debug_assert_eq!(delta_logs.len(), lwe_list_in.count);
+    debug_assert_eq!(numbers_of_bits.len(), lwe_list_in.count);
+    debug_assert_eq!(lwe_list_out.count, numbers_of_bits.iter().sum::<usize>());
+
+    // The buffers of the tasks are not aligned, so we leave room to align them.
+    let stack_size = extract_bits_scratch(
+        lwe_list_in.lwe_dimension,
+        ksk.output_dimension + 1,
+        fourier_bsk.glwe_params,
+        fft,
+    )
+    .unwrap()
+    .size_bytes()
+        + CACHELINE_ALIGN;
+
+    let lwe_dimension_out = lwe_list_out.lwe_dimension;
+    let mut data_out = lwe_list_out.into_data();
+    let mut lwe_lists_out = Vec::with_capacity(numbers_of_bits.len());
+    for &number_of_bits in numbers_of_bits {
+        let (data, rest) = data_out.split_at_mut(number_of_bits * (lwe_dimension_out + 1));
+        lwe_lists_out.push(LweCiphertextList::new(
+            data,
+            lwe_dimension_out,
+            number_of_bits,
+        ));
+        data_out = rest;
+    }
+
+    let lwes_in: Vec<_> = lwe_list_in.ciphertext_iter().collect();
+    lwes_in
+        .into_par_iter()
+        .zip(lwe_lists_out)
+        .zip(delta_logs)
+        .zip(numbers_of_bits)
+        .for_each_init(
+            || vec![MaybeUninit::<u8>::uninit(); stack_size],
+            |buffer, (((lwe_in, lwe_list_out), &delta_log), &number_of_bits)| {
+                extract_bits(
+                    lwe_list_out,
+                    lwe_in,
+                    ksk,
+                    fourier_bsk,
+                    delta_log,
+                    number_of_bits,
+                    fft,
+                    DynStack::new(buffer),
+                );
+            },
+        );
+}
+
 pub fn circuit_bootstrap_boolean_scratch(
     lwe_in_size: usize,
     bsk_output_lwe_size: usize,
@@ -798,6 +868,116 @@ pub fn circuit_bootstrap_boolean_vertical_packing(
     }
 }
 
+/// Same as [`circuit_bootstrap_boolean_vertical_packing`], with the circuit bootstraps of the
+/// input ciphertexts and the vertical packings of the lookup tables computed in parallel.
+///
+/// Each task works on its own output, so the results are the same as the sequential version.
+/// Only the GGSW ciphertexts of the circuit bootstraps are allocated in `stack`, the tasks
+/// allocating their own scratch memory.
+#[cfg(feature = "parallel")]
+pub fn circuit_bootstrap_boolean_vertical_packing_par(
+    luts: PolynomialList<&[u64]>,
+    fourier_bsk: BootstrapKey<&[f64]>,
+    mut lwe_list_out: LweCiphertextList<&mut [u64]>,
+    lwe_list_in: LweCiphertextList<&[u64]>,
+    fpksk_list: PackingKeyswitchKeyList<&[u64]>,
+    cbs_dp: DecompParams,
+    fft: FftView<'_>,
+    stack: DynStack<'_>,
+) {
+    use core::mem::MaybeUninit;
+    use rayon::prelude::*;
+
+    debug_assert_ne!(lwe_list_in.count, 0);
+    debug_assert_eq!(
+        lwe_list_out.lwe_dimension,
+        fourier_bsk.output_lwe_dimension(),
+    );
+    debug_assert_eq!(lwe_list_out.count, luts.count);
+
+    let glwe_params = fpksk_list.glwe_params;
+    let glwe_dim = glwe_params.dimension;
+    let ggsw_len = glwe_params.polynomial_size * (glwe_dim + 1) * (glwe_dim + 1) * cbs_dp.level;
+    let (mut ggsw_list_data, _) =
+        stack.make_aligned_with(lwe_list_in.count * ggsw_len, CACHELINE_ALIGN, |_| {
+            f64::default()
+        });
+    let mut ggsw_list = FourierGgswCiphertextList::new(
+        &mut *ggsw_list_data,
+        lwe_list_in.count,
+        glwe_params,
+        cbs_dp,
+    );
+
+    // The buffers of the tasks are not aligned, so we leave room to align them.
+    let cbs_stack_size = StackReq::try_all_of([
+        StackReq::try_new_aligned::<u64>(ggsw_len, CACHELINE_ALIGN).unwrap(),
+        StackReq::try_any_of([
+            circuit_bootstrap_boolean_scratch(
+                lwe_list_in.lwe_dimension + 1,
+                fourier_bsk.output_lwe_dimension() + 1,
+                glwe_params,
+                fft,
+            )
+            .unwrap(),
+            fft.forward_scratch().unwrap(),
+        ])
+        .unwrap(),
+    ])
+    .unwrap()
+    .size_bytes()
+        + CACHELINE_ALIGN;
+
+    let lwes_in: Vec<_> = lwe_list_in.ciphertext_iter().collect();
+    let ggsws: Vec<_> = ggsw_list.as_mut_view().into_ggsw_iter().collect();
+    lwes_in.into_par_iter().zip(ggsws).for_each_init(
+        || vec![MaybeUninit::<u8>::uninit(); cbs_stack_size],
+        |buffer, (lwe_in, ggsw)| {
+            let stack = DynStack::new(buffer);
+            let (mut ggsw_res_data, mut stack) =
+                stack.make_aligned_with(ggsw_len, CACHELINE_ALIGN, |_| 0_u64);
+            let mut ggsw_res = GgswCiphertext::new(&mut *ggsw_res_data, glwe_params, cbs_dp);
+
+            circuit_bootstrap_boolean(
+                fourier_bsk,
+                lwe_in,
+                ggsw_res.as_mut_view(),
+                u64::BITS as usize - 1,
+                fpksk_list,
+                fft,
+                stack.rb_mut(),
+            );
+
+            ggsw.fill_with_forward_fourier(ggsw_res.as_view(), fft, stack);
+        },
+    );
+
+    let vp_stack_size = vertical_packing_scratch(
+        glwe_params,
+        (luts.polynomial_size / glwe_params.polynomial_size).max(1),
+        lwe_list_in.count,
+        fft,
+    )
+    .unwrap()
+    .size_bytes()
+        + CACHELINE_ALIGN;
+
+    let luts: Vec<_> = luts.iter_polynomial().collect();
+    let lwes_out: Vec<_> = lwe_list_out.ciphertext_iter_mut().collect();
+    luts.into_par_iter().zip(lwes_out).for_each_init(
+        || vec![MaybeUninit::<u8>::uninit(); vp_stack_size],
+        |buffer, (lut, lwe_out)| {
+            vertical_packing(
+                lut,
+                lwe_out,
+                ggsw_list.as_view(),
+                fft,
+                DynStack::new(buffer),
+            );
+        },
+    );
+}
+
 fn print_ct(ct: u64) {
     print!("{}", (((ct >> 53) + 1) >> 1) % (1 << 10));
 }
@@ -966,3 +1146,132 @@ pub fn blind_rotate(
         cmux(ct_0, ct_1, ggsw, fft, stack);
     }
 }
+
+#[cfg(all(test, feature = "parallel"))]
+mod tests {
+    use std::mem::MaybeUninit;
+
+    use super::*;
+    use crate::implementation::fft::Fft;
+    use concrete_csprng::generators::{RandomGenerator, SoftwareRandomGenerator};
+    use concrete_csprng::seeders::Seed;
+
+    fn random_vec(csprng: &mut SoftwareRandomGenerator, len: usize) -> Vec<u64> {
+        (0..len)
+            .map(|_| u64::from_le_bytes(std::array::from_fn(|_| csprng.next().unwrap())))
+            .collect()
+    }
+
+    #[test]
+    fn circuit_bootstrap_boolean_vertical_packing_par_matches_sequential() {
+        let mut csprng = SoftwareRandomGenerator::new(Seed(0));
+
+        let in_dim = 16;
+        let glwe_params = GlweParams {
+            dimension: 1,
+            polynomial_size: 256,
+        };
+        let bsk_dp = DecompParams {
+            level: 2,
+            base_log: 8,
+        };
+        let fpksk_dp = DecompParams {
+            level: 2,
+            base_log: 8,
+        };
+        let cbs_dp = DecompParams {
+            level: 2,
+            base_log: 8,
+        };
+        let ct_in_count = 3;
+        let lut_count = 3;
+        let lut_size = 1 << ct_in_count;
+
+        let fft = Fft::new(glwe_params.polynomial_size);
+        let fft = fft.as_view();
+
+        let bsk_len = BootstrapKey::<&[u64]>::data_len(glwe_params, bsk_dp.level, in_dim);
+        let bsk = random_vec(&mut csprng, bsk_len);
+        let mut fourier_bsk_data = vec![0.0; bsk_len];
+        let mut stack = vec![MaybeUninit::new(0_u8); 1 << 20];
+        BootstrapKey::new(fourier_bsk_data.as_mut_slice(), glwe_params, in_dim, bsk_dp)
+            .fill_with_forward_fourier(
+                BootstrapKey::new(bsk.as_slice(), glwe_params, in_dim, bsk_dp),
+                fft,
+                DynStack::new(&mut stack),
+            );
+        let fourier_bsk =
+            BootstrapKey::new(fourier_bsk_data.as_slice(), glwe_params, in_dim, bsk_dp);
+
+        let fpksk_count = glwe_params.dimension + 1;
+        let fpksk = random_vec(
+            &mut csprng,
+            PackingKeyswitchKeyList::<&[u64]>::data_len(
+                glwe_params,
+                fpksk_dp.level,
+                glwe_params.lwe_dimension(),
+                fpksk_count,
+            ),
+        );
+        let fpksk_list = PackingKeyswitchKeyList::new(
+            fpksk.as_slice(),
+            glwe_params,
+            glwe_params.lwe_dimension(),
+            fpksk_dp,
+            fpksk_count,
+        );
+
+        let luts = random_vec(&mut csprng, lut_size * lut_count);
+        let lwes_in = random_vec(&mut csprng, (in_dim + 1) * ct_in_count);
+
+        let out_len = (glwe_params.lwe_dimension() + 1) * lut_count;
+        let mut lwes_out_seq = vec![0_u64; out_len];
+        let mut lwes_out_par = vec![0_u64; out_len];
+
+        let scratch = circuit_bootstrap_boolean_vertical_packing_scratch(
+            ct_in_count,
+            lut_count,
+            in_dim + 1,
+            lut_count,
+            glwe_params.lwe_dimension() + 1,
+            glwe_params.polynomial_size,
+            glwe_params.dimension + 1,
+            cbs_dp.level,
+            fft,
+        )
+        .unwrap();
+        let mut stack = vec![MaybeUninit::new(0_u8); scratch.size_bytes() + CACHELINE_ALIGN];
+
+        circuit_bootstrap_boolean_vertical_packing(
+            PolynomialList::new(luts.as_slice(), lut_size, lut_count),
+            fourier_bsk,
+            LweCiphertextList::new(
+                lwes_out_seq.as_mut_slice(),
+                glwe_params.lwe_dimension(),
+                lut_count,
+            ),
+            LweCiphertextList::new(lwes_in.as_slice(), in_dim, ct_in_count),
+            fpksk_list,
+            cbs_dp,
+            fft,
+            DynStack::new(&mut stack),
+        );
+
+        circuit_bootstrap_boolean_vertical_packing_par(
+            PolynomialList::new(luts.as_slice(), lut_size, lut_count),
+            fourier_bsk,
+            LweCiphertextList::new(
+                lwes_out_par.as_mut_slice(),
+                glwe_params.lwe_dimension(),
+                lut_count,
+            ),
+            LweCiphertextList::new(lwes_in.as_slice(), in_dim, ct_in_count),
+            fpksk_list,
+            cbs_dp,
+            fft,
+            DynStack::new(&mut stack),
+        );
+
+        assert_eq!(lwes_out_seq, lwes_out_par);
+    }
+}
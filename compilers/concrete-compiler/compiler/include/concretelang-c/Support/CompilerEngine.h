@@ -392,6 +392,12 @@ compilationFeedbackGetTotalInputsSize(CompilationFeedback feedback);
 MLIR_CAPI_EXPORTED uint64_t
 compilationFeedbackGetTotalOutputsSize(CompilationFeedback feedback);
 
+MLIR_CAPI_EXPORTED uint64_t
+compilationFeedbackGetDeduplicatedKeyswitches(CompilationFeedback feedback);
+
+MLIR_CAPI_EXPORTED uint64_t
+compilationFeedbackGetPeakIntermediateBuffersSize(CompilationFeedback feedback);
+
 MLIR_CAPI_EXPORTED void
 compilationFeedbackDestroy(CompilationFeedback feedback);
 
@@ -12,6 +12,9 @@
 #include "concretelang/Support/LibrarySupport.h"
 #include "mlir-c/IR.h"
 
+#include <functional>
+#include <future>
+
 /// MLIR_CAPI_EXPORTED is used here throughout the API, because of the way the
 /// python extension is built using MLIR cmake functions, which will cause
 /// undefined symbols during runtime if those aren't present.
@@ -59,6 +62,12 @@ jit_server_call(JITSupport_Py support, mlir::concretelang::JITLambda &lambda,
                 concretelang::clientlib::PublicArguments &args,
                 concretelang::clientlib::EvaluationKeys &evaluationKeys);
 
+MLIR_CAPI_EXPORTED std::unique_ptr<concretelang::clientlib::PublicResult>
+jit_server_call(
+    JITSupport_Py support, mlir::concretelang::JITLambda &lambda,
+    concretelang::clientlib::PublicArguments &args,
+    std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys> preparedKeys);
+
 // Library Support bindings ///////////////////////////////////////////////////
 
 struct LibrarySupport_Py {
@@ -94,12 +103,70 @@ library_server_call(LibrarySupport_Py support,
                     concretelang::clientlib::PublicArguments &args,
                     concretelang::clientlib::EvaluationKeys &evaluationKeys);
 
+MLIR_CAPI_EXPORTED std::unique_ptr<concretelang::clientlib::PublicResult>
+library_server_call(
+    LibrarySupport_Py support, concretelang::serverlib::ServerLambda lambda,
+    concretelang::clientlib::PublicArguments &args,
+    std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys> preparedKeys);
+
 MLIR_CAPI_EXPORTED std::string
 library_get_shared_lib_path(LibrarySupport_Py support);
 
 MLIR_CAPI_EXPORTED std::string
 library_get_client_parameters_path(LibrarySupport_Py support);
 
+// Server Support bindings ///////////////////////////////////////////////////
+
+MLIR_CAPI_EXPORTED std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys>
+prepare_evaluation_keys(concretelang::clientlib::EvaluationKeys &evaluationKeys,
+                        std::optional<std::string> sharedKeysPath);
+
+/// Future of the result of a server call run asynchronously.
+class PublicResultFuture {
+public:
+  PublicResultFuture(
+      std::future<std::unique_ptr<concretelang::clientlib::PublicResult>>
+          future)
+      : future(std::move(future)) {}
+  PublicResultFuture(PublicResultFuture &other) = delete;
+  /// The call may use objects owned by the caller until it ends.
+  ~PublicResultFuture() { wait(); }
+
+  /// Waits for the end of the call.
+  void wait() {
+    if (future.valid())
+      future.wait();
+  }
+
+  /// Returns true if the call is done.
+  bool isReady() {
+    return !future.valid() || future.wait_for(std::chrono::seconds(0)) ==
+                                  std::future_status::ready;
+  }
+
+  /// Returns the result of the call, waiting for it if needed, or throws the
+  /// error of the call. The result can only be retrieved once.
+  std::unique_ptr<concretelang::clientlib::PublicResult> get();
+
+private:
+  std::future<std::unique_ptr<concretelang::clientlib::PublicResult>> future;
+};
+
+/// Sets the number of workers running the asynchronous server calls, 2 by
+/// default. Throws if an asynchronous call already started the workers.
+MLIR_CAPI_EXPORTED void set_server_call_workers(unsigned numWorkers);
+
+/// Runs the server call `call` on the worker pool of the server calls and
+/// returns the future of its result.
+MLIR_CAPI_EXPORTED std::shared_ptr<PublicResultFuture> server_call_async(
+    std::function<std::unique_ptr<concretelang::clientlib::PublicResult>()>
+        call);
+
+MLIR_CAPI_EXPORTED std::string performance_counters();
+MLIR_CAPI_EXPORTED void reset_performance_counters();
+MLIR_CAPI_EXPORTED void start_trace();
+MLIR_CAPI_EXPORTED void stop_trace(std::string path);
+
 // Client Support bindings ///////////////////////////////////////////////////
 
 MLIR_CAPI_EXPORTED std::unique_ptr<concretelang::clientlib::KeySet>
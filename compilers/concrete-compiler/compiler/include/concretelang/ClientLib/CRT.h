@@ -39,6 +39,22 @@ uint64_t encode(int64_t plaintext, uint64_t modulus, uint64_t product);
 /// Decode follow the crt encoding
 uint64_t decode(uint64_t val, uint64_t modulus);
 
+/// Encode and expand a lookup table so that it can be used by a wop pbs on
+/// integers decomposed on a crt basis.
+///
+/// \param output The encoded lookup table, made of one lookup table of
+/// `2^sum(bits)` elements per modulus.
+/// \param lut The lookup table to encode.
+/// \param lutSize The number of elements of `lut`.
+/// \param moduli The moduli of the crt decomposition.
+/// \param bits The number of bits of each modulus.
+/// \param product The product of moduli of the crt decomposition.
+/// \param isSigned Whether the integers are signed.
+void encodeLutForWopPBS(uint64_t *output, const uint64_t *lut,
+                        uint64_t lutSize, std::vector<int64_t> moduli,
+                        std::vector<int64_t> bits, uint64_t product,
+                        bool isSigned);
+
 } // namespace crt
 } // namespace clientlib
 } // namespace concretelang
@@ -74,12 +74,16 @@ struct BootstrapKeyParam {
   Variance variance;
   PolynomialSize polynomialSize;
   LweDimension inputLweDimension;
+  /// Number of mask elements processed by each external product, the key of
+  /// a grouping factor `d` holds `2^d - 1` GGSW ciphertexts for each group of
+  /// `d` input key bits.
+  uint64_t groupingFactor = 1;
 
   void hash(size_t &seed);
 
   uint64_t byteSize(uint64_t inputLweSize, uint64_t outputLweSize) {
     return inputLweSize * level * (glweDimension + 1) * (glweDimension + 1) *
-           outputLweSize * 8;
+           outputLweSize * 8 * ((1 << groupingFactor) - 1) / groupingFactor;
   }
 };
 static inline bool operator==(const BootstrapKeyParam &lhs,
@@ -87,7 +91,9 @@ static inline bool operator==(const BootstrapKeyParam &lhs,
   return lhs.inputSecretKeyID == rhs.inputSecretKeyID &&
          lhs.outputSecretKeyID == rhs.outputSecretKeyID &&
          lhs.level == rhs.level && lhs.baseLog == rhs.baseLog &&
-         lhs.glweDimension == rhs.glweDimension && lhs.variance == rhs.variance;
+         lhs.glweDimension == rhs.glweDimension &&
+         lhs.variance == rhs.variance &&
+         lhs.groupingFactor == rhs.groupingFactor;
 }
 
 typedef uint64_t KeyswitchKeyID;
@@ -122,6 +128,10 @@ struct PackingKeyswitchKeyParam {
   PolynomialSize polynomialSize;
   LweDimension inputLweDimension;
   Variance variance;
+  /// True if the key packs ciphertexts in the coefficients of a GLWE, as used
+  /// to compress the outputs, instead of holding the `glweDimension + 1` keys
+  /// of the circuit bootstrap.
+  bool packingOnly = false;
 
   void hash(size_t &seed);
 };
@@ -133,7 +143,8 @@ static inline bool operator==(const PackingKeyswitchKeyParam &lhs,
          lhs.glweDimension == rhs.glweDimension &&
          lhs.polynomialSize == rhs.polynomialSize &&
          lhs.variance == lhs.variance &&
-         lhs.inputLweDimension == rhs.inputLweDimension;
+         lhs.inputLweDimension == rhs.inputLweDimension &&
+         lhs.packingOnly == rhs.packingOnly;
 }
 
 struct Encoding {
@@ -149,11 +160,20 @@ struct EncryptionGate {
   LweSecretKeyID secretKeyID;
   Variance variance;
   Encoding encoding;
+  /// Log2 of the modulus the ciphertexts are switched to when serialized, each
+  /// of their coefficients being packed on `modulusLog` bits. Not set if the
+  /// ciphertexts are serialized modulo 2^64.
+  std::optional<uint64_t> modulusLog;
+  /// Packing keyswitch key used to pack the ciphertexts of an output in GLWE
+  /// ciphertexts, each GLWE holding up to `polynomialSize` of them. Not set if
+  /// the ciphertexts are returned as is.
+  std::optional<PackingKeyswitchKeyID> packingKeyID;
 };
 static inline bool operator==(const EncryptionGate &lhs,
                               const EncryptionGate &rhs) {
   return lhs.secretKeyID == rhs.secretKeyID && lhs.variance == rhs.variance &&
-         lhs.encoding == rhs.encoding;
+         lhs.encoding == rhs.encoding && lhs.modulusLog == rhs.modulusLog &&
+         lhs.packingKeyID == rhs.packingKeyID;
 }
 
 struct CircuitGateShape {
@@ -197,6 +217,9 @@ struct CircuitGate {
     if (isEncrypted()) {
       assert(encryption->secretKeyID < secretKeys.size());
       auto skParam = secretKeys[encryption->secretKeyID];
+      if (encryption->modulusLog.has_value()) {
+        return (*encryption->modulusLog * skParam.lweSize() * numElts + 7) / 8;
+      }
       return 8 * skParam.lweSize() * numElts;
     }
     width = bitWidthAsWord(width) / 8;
@@ -293,6 +316,24 @@ struct ClientParameters {
     shape.push_back(lweSecreteKeyParam.value().lweSize());
     return shape;
   }
+
+  /// packedBufferShape returns the shape of the GLWE ciphertexts packing the
+  /// ciphertexts of the given gate, i.e. the number of GLWE ciphertexts and
+  /// the size of one of them, each GLWE holding up to `polynomialSize`
+  /// ciphertexts of the row-major buffer of the gate.
+  std::vector<int64_t> packedBufferShape(CircuitGate gate) {
+    assert(gate.encryption.has_value() &&
+           gate.encryption->packingKeyID.has_value());
+    assert(*gate.encryption->packingKeyID < packingKeyswitchKeys.size());
+    auto param = packingKeyswitchKeys[*gate.encryption->packingKeyID];
+    auto skParam = lweSecretKeyParam(gate);
+    assert(skParam.has_value());
+
+    int64_t polynomialSize = param.polynomialSize;
+    int64_t nbCiphertexts = bufferSize(gate) / skParam.value().lweSize();
+    return {(nbCiphertexts + polynomialSize - 1) / polynomialSize,
+            (int64_t)(param.glweDimension + 1) * polynomialSize};
+  }
 };
 
 static inline bool operator==(const ClientParameters &lhs,
@@ -7,6 +7,7 @@
 #define CONCRETELANG_CLIENTLIB_KEYSET_H_
 
 #include <memory>
+#include <mutex>
 
 #include "boost/outcome.h"
 
@@ -49,7 +50,8 @@ public:
   outcome::checked<void, StringError>
   allocate_lwe(size_t argPos, uint64_t **ciphertext, uint64_t &size);
 
-  /// encrypt the input to the ciphertext for the argument at argPos.
+  /// encrypt the input to the ciphertext for the argument at argPos. The
+  /// encryptions of concurrent calls are serialized on the CSPRNG.
   outcome::checked<void, StringError>
   encrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t input);
 
@@ -60,6 +62,12 @@ public:
   outcome::checked<void, StringError>
   decrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t &output);
 
+  /// decrypt the GLWE ciphertexts packing the ciphertexts of the output at
+  /// argPos, and decode the `numValues` first values of the output in values.
+  outcome::checked<void, StringError>
+  decrypt_packed_glwe(size_t argPos, const uint64_t *ciphertexts,
+                      size_t numValues, uint64_t *values);
+
   size_t numInputs() { return inputs.size(); }
   size_t numOutputs() { return outputs.size(); }
 
@@ -99,6 +107,8 @@ protected:
 
 private:
   CSPRNG csprng;
+  /// Guards the CSPRNG, shared by the encryptions of concurrent calls.
+  std::mutex csprngMutex;
 
   ///////////////////////////////////////////////
   // Keys mappings
@@ -109,6 +119,11 @@ private:
 
   outcome::checked<LweSecretKey, StringError> findLweSecretKey(LweSecretKeyID);
 
+  /// decode the value of the given encoding from its plaintexts, one per CRT
+  /// block.
+  static void decode(const Encoding &encoding, const uint64_t *plaintexts,
+                     uint64_t &output);
+
   ///////////////////////////////////////////////
   // Convenient positional mapping between positional gate en secret key
   typedef std::vector<std::pair<CircuitGate, std::optional<LweSecretKey>>>
@@ -13,6 +13,23 @@ namespace clientlib {
 
 class KeySet;
 
+/// Content address of a key in the KeySetCache, i.e. a hash of the key
+/// parameters, of the addresses of the keys it depends on and of the seed.
+typedef uint64_t KeyAddress;
+
+/// The content addresses of all the keys of a ClientParameters, in the same
+/// order than the key parameters.
+struct KeyAddresses {
+  std::vector<KeyAddress> secretKeys;
+  std::vector<KeyAddress> bootstrapKeys;
+  std::vector<KeyAddress> keyswitchKeys;
+  std::vector<KeyAddress> packingKeyswitchKeys;
+};
+
+/// KeySetCache is a content-addressed store of keys. Each key is stored
+/// individually under its address, such that circuits which share keys
+/// (i.e. same parameters, same dependencies and same seed) share the cache
+/// entries, and a KeySet is assembled from the stored entries.
 class KeySetCache {
   std::string backingDirectoryPath;
 
@@ -27,11 +44,11 @@ public:
   outcome::checked<std::unique_ptr<KeySet>, StringError>
   generate(ClientParameters &params, uint64_t seed_msb, uint64_t seed_lsb);
 
-private:
-  static outcome::checked<std::unique_ptr<KeySet>, StringError>
-  loadKeys(ClientParameters &params, uint64_t seed_msb, uint64_t seed_lsb,
-           std::string folderPath);
+  /// Returns the content addresses of the keys of the given client parameters.
+  static KeyAddresses keyAddresses(ClientParameters &params, uint64_t seed_msb,
+                                   uint64_t seed_lsb);
 
+private:
   outcome::checked<std::unique_ptr<KeySet>, StringError>
   loadOrGenerateSave(ClientParameters &params, uint64_t seed_msb,
                      uint64_t seed_lsb);
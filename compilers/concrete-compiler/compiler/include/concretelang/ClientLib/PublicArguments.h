@@ -120,6 +120,12 @@ struct PublicResult {
       return (T)decrypted;
     }
 
+    if (gate.encryption->packingKeyID.has_value()) {
+      OUTCOME_TRY(std::vector<uint64_t> decrypted,
+                  this->asClearTextVector<uint64_t>(keySet, pos));
+      return (T)decrypted[0];
+    }
+
     auto &buffer = buffers[pos].getTensor();
 
     auto ciphertext = buffer.getOpaqueElementPointer(0);
@@ -146,6 +152,17 @@ struct PublicResult {
     auto &buffer = buffers[pos].getTensor();
     auto lweSize = clientParameters.lweBufferSize(gate);
 
+    if (gate.encryption->packingKeyID.has_value()) {
+      // The ciphertexts are packed in GLWE ciphertexts
+      std::vector<uint64_t> decrypted(clientParameters.bufferSize(gate) /
+                                      lweSize);
+      auto glwes =
+          reinterpret_cast<uint64_t *>(buffer.getOpaqueElementPointer(0));
+      OUTCOME_TRYV(keySet.decrypt_packed_glwe(pos, glwes, decrypted.size(),
+                                              decrypted.data()));
+      return std::vector<T>(decrypted.begin(), decrypted.end());
+    }
+
     std::vector<T> decryptedValues(buffer.length() / lweSize);
     for (size_t i = 0; i < decryptedValues.size(); i++) {
       auto ciphertext = buffer.getOpaqueElementPointer(i * lweSize);
@@ -180,6 +197,14 @@ TensorData tensorDataFromMemRef(size_t memref_rank, size_t element_width,
                                 bool is_signed, void *allocated, void *aligned,
                                 size_t offset, size_t *sizes, size_t *strides);
 
+/// Packs the ciphertexts of the given encrypted gate, stored in `ciphertexts`
+/// with the shape of `ClientParameters::bufferShape`, in GLWE ciphertexts with
+/// the packing keyswitch key of the gate, and returns them with the shape of
+/// `ClientParameters::packedBufferShape`.
+TensorData packCiphertexts(ClientParameters &clientParameters,
+                           CircuitGate gate, const TensorData &ciphertexts,
+                           const uint64_t *packingKeyswitchKey);
+
 } // namespace clientlib
 } // namespace concretelang
 
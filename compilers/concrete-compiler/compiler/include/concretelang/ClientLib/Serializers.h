@@ -95,6 +95,19 @@ outcome::checked<TensorData, StringError> unserializeTensorData(
 std::ostream &serializeScalarOrTensorData(const ScalarOrTensorData &sotd,
                                           std::ostream &ostream);
 
+/// Serializes the tensor of ciphertexts `ciphertexts` switched to the modulus
+/// 2^modulusLog, each coefficient being packed on `modulusLog` bits.
+std::ostream &serializeSwitchedCiphertexts(const TensorData &ciphertexts,
+                                           uint64_t modulusLog,
+                                           std::ostream &ostream);
+
+/// Unserializes a tensor of ciphertexts serialized by
+/// `serializeSwitchedCiphertexts`, the coefficients being switched back to
+/// the modulus 2^64.
+outcome::checked<TensorData, StringError>
+unserializeSwitchedCiphertexts(const std::vector<int64_t> &expectedSizes,
+                               uint64_t modulusLog, std::istream &istream);
+
 outcome::checked<ScalarOrTensorData, StringError>
 unserializeScalarOrTensorData(const std::vector<int64_t> &expectedSizes,
                               std::istream &istream);
@@ -106,6 +119,9 @@ std::ostream &operator<<(std::ostream &ostream,
                          const LweKeyswitchKey &wrappedKsk);
 LweKeyswitchKey readLweKeyswitchKey(std::istream &istream);
 
+std::ostream &operator<<(std::ostream &ostream, const BootstrapKeyParam param);
+std::istream &operator>>(std::istream &istream, BootstrapKeyParam &param);
+
 std::ostream &operator<<(std::ostream &ostream,
                          const LweBootstrapKey &wrappedBsk);
 LweBootstrapKey readLweBootstrapKey(std::istream &istream);
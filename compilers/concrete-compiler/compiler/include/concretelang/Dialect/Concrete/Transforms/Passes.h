@@ -6,6 +6,9 @@
 #ifndef CONCRETELANG_DIALECT_CONCRETE_TRANSFORMS_PASSES_H_
 #define CONCRETELANG_DIALECT_CONCRETE_TRANSFORMS_PASSES_H_
 
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
 #include "mlir/Pass/Pass.h"
 
 #define GEN_PASS_CLASSES
@@ -14,6 +17,7 @@
 namespace mlir {
 namespace concretelang {
 std::unique_ptr<OperationPass<ModuleOp>> createAddRuntimeContext();
+std::unique_ptr<OperationPass<ModuleOp>> createInlineLeveledOpsPass();
 } // namespace concretelang
 } // namespace mlir
 
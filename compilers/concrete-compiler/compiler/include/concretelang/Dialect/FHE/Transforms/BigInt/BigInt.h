@@ -7,6 +7,7 @@
 #define CONCRETELANG_FHE_BIGINT_PASS_H
 
 #include <concretelang/Dialect/FHE/IR/FHEDialect.h>
+#include <concretelang/Dialect/FHELinalg/IR/FHELinalgDialect.h>
 #include <mlir/Pass/Pass.h>
 
 #define GEN_PASS_CLASSES
@@ -15,8 +16,13 @@
 namespace mlir {
 namespace concretelang {
 
+/// Creates the pass decomposing the big integers into chunks. The carries of
+/// the additions are computed with a parallel prefix network instead of being
+/// rippled from chunk to chunk if `parallelCarries` is set and the network is
+/// shallower.
 std::unique_ptr<mlir::OperationPass<>>
-createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth);
+createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth,
+                             bool parallelCarries = false);
 
 } // namespace concretelang
 } // namespace mlir
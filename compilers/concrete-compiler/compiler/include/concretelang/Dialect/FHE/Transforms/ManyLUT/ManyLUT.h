@@ -0,0 +1,24 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_FHE_MANY_LUT_PASS_H
+#define CONCRETELANG_FHE_MANY_LUT_PASS_H
+
+#include <concretelang/Dialect/FHE/IR/FHEDialect.h>
+#include <mlir/Pass/Pass.h>
+
+#define GEN_PASS_CLASSES
+#include <concretelang/Dialect/FHE/Transforms/ManyLUT/ManyLUT.h.inc>
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<>>
+createFHEManyLUTPass(unsigned int maxPrecision = 8);
+
+} // namespace concretelang
+} // namespace mlir
+
+#endif
@@ -16,6 +16,10 @@
 namespace mlir {
 namespace concretelang {
 std::unique_ptr<mlir::OperationPass<>> createTFHEOptimizationPass();
+/// Creates the keyswitch deduplication pass, which adds the number of removed
+/// keyswitches to `removedKeyswitches` if not null.
+std::unique_ptr<mlir::OperationPass<>>
+createTFHEKeyswitchDeduplicationPass(uint64_t *removedKeyswitches = nullptr);
 std::unique_ptr<mlir::OperationPass<>>
     createTFHECircuitSolutionParametrizationPass(
         concrete_optimizer::dag::CircuitSolution);
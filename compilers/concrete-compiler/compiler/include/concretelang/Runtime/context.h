@@ -7,13 +7,22 @@
 #define CONCRETELANG_RUNTIME_CONTEXT_H
 
 #include <assert.h>
+#include <atomic>
+#include <cstdlib>
+#include <future>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <pthread.h>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "concretelang/ClientLib/EvaluationKeys.h"
 #include "concretelang/Common/Error.h"
+#include "concretelang/Runtime/key_placement.h"
+#include "concretelang/Runtime/shared_key_segment.h"
 
 #include "concrete-cpu.h"
 
@@ -37,10 +46,119 @@ typedef struct FFT {
   size_t polynomial_size;
 } FFT;
 
+/// PreparedEvaluationKeys holds the evaluation keys with the bootstrap keys
+/// converted to the fourier domain. The conversion of the bootstrap keys runs
+/// in background, and accessing a fourier bootstrap key only blocks until this
+/// specific key is converted.
+///
+/// If a `sharedKeysPath` directory is given, the fourier bootstrap keys are
+/// placed in `SharedKeySegment`s of this directory instead of the process
+/// memory, such that the processes of a host using the same keys share a
+/// single read-only copy and convert them only once. Otherwise the keys are
+/// placed in the process memory according to the `KeyPlacement`.
+class PreparedEvaluationKeys {
+public:
+  PreparedEvaluationKeys() = delete;
+  PreparedEvaluationKeys(PreparedEvaluationKeys &other) = delete;
+  PreparedEvaluationKeys(
+      ::concretelang::clientlib::EvaluationKeys evaluationKeys,
+      std::optional<std::string> sharedKeysPath = std::nullopt,
+      KeyPlacement placement = KeyPlacement::fromEnv());
+  /// The conversions use the members, so they must end before their
+  /// destruction, failed or not.
+  ~PreparedEvaluationKeys() {
+    for (auto &conversion : conversions) {
+      conversion.wait();
+    }
+  }
+
+  /// Start the conversion of the bootstrap keys of `evaluationKeys` and
+  /// returns an handle on the prepared keys without waiting for the end of the
+  /// conversion.
+  static std::shared_ptr<PreparedEvaluationKeys>
+  prepare(::concretelang::clientlib::EvaluationKeys evaluationKeys,
+          std::optional<std::string> sharedKeysPath = std::nullopt,
+          KeyPlacement placement = KeyPlacement::fromEnv()) {
+    return std::make_shared<PreparedEvaluationKeys>(evaluationKeys,
+                                                    sharedKeysPath, placement);
+  }
+
+  /// Returns the fourier bootstrap key `keyId`, or its replica on the NUMA
+  /// node of the calling thread, waits for its conversion if still in flight.
+  /// Throws the error of the conversion if it failed.
+  const double *fourierBootstrapKey(size_t keyId) {
+    conversions[keyId].get();
+    auto &replicas = fourierBootstrapKeys[keyId];
+    if (replicas.empty()) {
+      throw std::runtime_error("No fourier bootstrap key after conversion");
+    }
+    if (replicas.size() == 1) {
+      return replicas[0].get();
+    }
+    return replicas[currentNumaNode() % replicas.size()].get();
+  }
+
+  const struct Fft *fft(size_t keyId) { return ffts[keyId].fft; }
+
+  /// Waits for the conversion of all the bootstrap keys, and throws the error
+  /// of the first one which failed.
+  void wait();
+
+  /// Returns true if all the bootstrap keys are converted, and throws the
+  /// error of the first finished conversion which failed.
+  bool isReady();
+
+  const ::concretelang::clientlib::EvaluationKeys &getKeys() const {
+    return evaluationKeys;
+  }
+
+private:
+  ::concretelang::clientlib::EvaluationKeys evaluationKeys;
+  /// The replicas of each fourier bootstrap key, one per NUMA node or a single
+  /// one, either owned by a private buffer or by a shared segment.
+  std::vector<std::vector<std::shared_ptr<const double>>> fourierBootstrapKeys;
+  std::vector<FFT> ffts;
+  std::vector<std::shared_future<void>> conversions;
+};
+
+/// MemoryArena is a memory reused by the successive calls of a compiled
+/// function for their intermediate buffers, when the memory of the function is
+/// planned. The arena grows to the largest size requested, such that the calls
+/// following the first one don't allocate memory for their intermediate
+/// buffers. A single call uses the arena at a time, the calls running
+/// concurrently allocate their own memory.
+class MemoryArena {
+public:
+  MemoryArena() = default;
+  MemoryArena(MemoryArena &other) = delete;
+  ~MemoryArena() { free(buffer.load()); }
+
+  /// Returns the arena grown to at least `size` bytes, or nullptr if the
+  /// arena is used by another call.
+  void *acquire(size_t size);
+
+  /// Releases the arena returned by `acquire`.
+  void release() { used.store(false); }
+
+  /// Returns true if `ptr` is the memory of the arena.
+  bool owns(const void *ptr) const { return ptr == buffer.load(); }
+
+  /// Returns the number of bytes of the arena.
+  size_t size() const { return capacity.load(); }
+
+private:
+  // Only the call holding the arena writes the buffer and its capacity, but
+  // the other calls read them concurrently to release their own memory.
+  std::atomic<void *> buffer{nullptr};
+  std::atomic<size_t> capacity{0};
+  std::atomic<bool> used{false};
+};
+
 typedef struct RuntimeContext {
 
   RuntimeContext() = delete;
   RuntimeContext(::concretelang::clientlib::EvaluationKeys evaluationKeys);
+  RuntimeContext(std::shared_ptr<PreparedEvaluationKeys> preparedKeys);
   ~RuntimeContext() {
 #ifdef CONCRETELANG_CUDA_SUPPORT
     for (int i = 0; i < num_devices; ++i) {
@@ -57,14 +175,32 @@ typedef struct RuntimeContext {
   }
 
   const double *fourier_bootstrap_key_buffer(size_t keyId) {
-    return fourier_bootstrap_keys[keyId]->data();
+    return preparedKeys->fourierBootstrapKey(keyId);
+  }
+
+  /// Returns the number of mask elements processed by each external product
+  /// of the bootstraps with the key `keyId`, 1 for a classic key.
+  uint64_t bootstrap_grouping_factor(size_t keyId) {
+    return evaluationKeys.getBootstrapKey(keyId).parameters().groupingFactor;
   }
 
   const uint64_t *fp_keyswitch_key_buffer(size_t keyId) {
     return evaluationKeys.getPackingKeyswitchKey(keyId).buffer();
   }
 
-  const struct Fft *fft(size_t keyId) { return ffts[keyId].fft; }
+  const struct Fft *fft(size_t keyId) { return preparedKeys->fft(keyId); }
+
+  /// Sets the arena used for the intermediate buffers of the calls using this
+  /// context, which must outlive them.
+  void set_memory_arena(MemoryArena *arena) { memoryArena = arena; }
+
+  /// Returns a memory of `size` bytes for the intermediate buffers of a call,
+  /// the memory arena of the context if any and not used by another call.
+  /// Throws std::bad_alloc if the memory cannot be allocated.
+  void *acquire_arena(size_t size);
+
+  /// Releases the memory returned by `acquire_arena`.
+  void release_arena(void *arena);
 
   const ::concretelang::clientlib::EvaluationKeys getKeys() const {
     return evaluationKeys;
@@ -72,8 +208,8 @@ typedef struct RuntimeContext {
 
 private:
   ::concretelang::clientlib::EvaluationKeys evaluationKeys;
-  std::vector<std::shared_ptr<std::vector<double>>> fourier_bootstrap_keys;
-  std::vector<FFT> ffts;
+  std::shared_ptr<PreparedEvaluationKeys> preparedKeys;
+  MemoryArena *memoryArena = nullptr;
 
 #ifdef CONCRETELANG_CUDA_SUPPORT
 public:
@@ -34,6 +34,7 @@
 #include "concretelang/Runtime/context.h"
 #include "concretelang/Runtime/dfr_debug_interface.h"
 #include "concretelang/Runtime/key_manager.hpp"
+#include "concretelang/Runtime/perf_counters.h"
 #include "concretelang/Runtime/runtime_api.h"
 #include "concretelang/Runtime/workfunction_registry.hpp"
 
@@ -60,6 +61,7 @@ static inline void _dfr_checked_aligned_alloc(void **out, size_t align,
   if (res == EINVAL)
     HPX_THROW_EXCEPTION(hpx::no_success, "DFR: memory allocation failed",
                         "Error: invalid memory alignment.");
+  perf::recordAllocation(size);
 }
 
 struct OpaqueInputData {
@@ -255,6 +257,7 @@ struct GenericComputeServer : component_base<GenericComputeServer> {
 
   // Component actions exposed
   OpaqueOutputData execute_task(const OpaqueInputData &inputs) {
+    perf::Timer timer(perf::Op::DFR_TASK, 0, {});
     auto wfn = _dfr_node_level_work_function_registry->getWorkFunctionPointer(
         inputs.wfn_name);
     std::vector<void *> outputs;
@@ -0,0 +1,50 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_RUNTIME_KEY_PLACEMENT_H
+#define CONCRETELANG_RUNTIME_KEY_PLACEMENT_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mlir {
+namespace concretelang {
+
+/// KeyPlacement describes how the fourier bootstrap keys, which are streamed
+/// by each bootstrap, are placed in memory.
+struct KeyPlacement {
+  /// Back the keys with transparent huge pages to reduce TLB misses.
+  bool hugePages = false;
+  /// Replicate the keys on each NUMA node, a bootstrap reads the replica of
+  /// the node its thread runs on.
+  bool numaReplicas = false;
+
+  /// Returns the placement configured by the `CONCRETE_KEYS_HUGE_PAGES` and
+  /// `CONCRETE_KEYS_NUMA_REPLICAS` environment variables, any value other
+  /// than `0` enables the option.
+  static KeyPlacement fromEnv();
+};
+
+/// Allocates a key buffer of `numWords` doubles, backed by transparent huge
+/// pages if `hugePages` and bound to the NUMA node `numaNode` if not
+/// negative. The placement is best effort, an option which is not supported
+/// by the host is ignored.
+std::shared_ptr<double> allocateKeyBuffer(size_t numWords, bool hugePages,
+                                          int numaNode = -1);
+
+/// Returns the number of NUMA nodes of the host, 1 if unknown.
+size_t numaNodeCount();
+
+/// Returns the NUMA node the calling thread runs on, 0 if unknown.
+size_t currentNumaNode();
+
+/// Returns the cpus of the NUMA node `numaNode`.
+std::vector<int> numaNodeCpus(size_t numaNode);
+
+} // namespace concretelang
+} // namespace mlir
+
+#endif
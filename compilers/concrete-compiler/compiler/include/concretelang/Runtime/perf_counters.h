@@ -0,0 +1,95 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_RUNTIME_PERF_COUNTERS_H
+#define CONCRETELANG_RUNTIME_PERF_COUNTERS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace mlir {
+namespace concretelang {
+namespace perf {
+
+/// The operations of the runtime which are counted and timed.
+enum class Op : uint32_t {
+  KEYSWITCH,
+  BOOTSTRAP,
+  WOP_PBS,
+  DFR_TASK,
+  /// Time between the creation of a dataflow task and the start of its
+  /// execution, i.e. waiting for its inputs then in the scheduler queue.
+  DFR_TASK_WAIT,
+};
+
+/// Number of parameters recorded with an operation, their meaning depends on
+/// the operation (see `paramNames` in the implementation).
+const size_t NUM_PARAMS = 5;
+typedef std::array<uint32_t, NUM_PARAMS> Params;
+
+/// Latencies are recorded in an histogram of powers of two nanoseconds.
+const size_t NUM_BUCKETS = 40;
+
+/// Statistics of an operation on a key with a parameter set.
+struct Stats {
+  std::atomic<uint64_t> count{0};
+  std::atomic<uint64_t> totalNs{0};
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> histogram{};
+};
+
+/// Returns the statistics of `op` with `keyId` and `params`.
+Stats &stats(Op op, uint32_t keyId, const Params &params);
+
+/// Records an operation of duration `durationNs` which started at `startNs`.
+void record(Stats &stats, Op op, uint32_t keyId, uint64_t startNs,
+            uint64_t durationNs);
+
+/// Records an allocation of `bytes` made by the runtime.
+void recordAllocation(uint64_t bytes);
+
+/// Returns a monotonic timestamp in nanoseconds.
+static inline uint64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Timer records the operation which spans the lifetime of the timer.
+class Timer {
+public:
+  Timer(Op op, uint32_t keyId, Params params)
+      : op(op), keyId(keyId), _stats(stats(op, keyId, params)),
+        startNs(now()) {}
+  ~Timer() { record(_stats, op, keyId, startNs, now() - startNs); }
+
+private:
+  Op op;
+  uint32_t keyId;
+  Stats &_stats;
+  uint64_t startNs;
+};
+
+/// Returns the counters as a JSON document.
+std::string countersJSON();
+
+/// Resets all the counters to zero.
+void resetCounters();
+
+/// Starts recording a trace of all the timed operations.
+void startTrace();
+
+/// Stops the recording of the trace and writes it to `path` in the Chrome
+/// trace event format, which is readable by Perfetto. Returns false if the
+/// file cannot be written.
+bool stopTrace(std::string path);
+
+} // namespace perf
+} // namespace concretelang
+} // namespace mlir
+
+#endif
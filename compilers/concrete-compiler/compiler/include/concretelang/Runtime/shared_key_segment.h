@@ -0,0 +1,58 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_RUNTIME_SHARED_KEY_SEGMENT_H
+#define CONCRETELANG_RUNTIME_SHARED_KEY_SEGMENT_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "boost/outcome.h"
+
+#include "concretelang/Common/Error.h"
+
+namespace mlir {
+namespace concretelang {
+
+/// SharedKeySegment is a mapping of a key stored in a file segment shared by
+/// all the processes of a host, e.g. in `/dev/shm` for POSIX shared memory or
+/// in a hugetlbfs mount point. A segment is named after the fingerprint of the
+/// key, the first process which needs the key creates and fills the segment,
+/// the other ones map it read-only. Segments are private to the user who
+/// created them and are only published once filled. Segments outlive the
+/// processes, removing the files of the directory drops them.
+class SharedKeySegment {
+public:
+  SharedKeySegment() = delete;
+  SharedKeySegment(SharedKeySegment &other) = delete;
+  ~SharedKeySegment();
+
+  /// Map the segment of `fingerprint` in `directory`, or create it with
+  /// `numWords` doubles filled by `fill` if it doesn't exist yet.
+  static outcome::checked<std::shared_ptr<SharedKeySegment>,
+                          ::concretelang::error::StringError>
+  openOrCreate(std::string directory, uint64_t fingerprint, size_t numWords,
+               std::function<void(double *)> fill);
+
+  const double *data() const { return words; }
+  size_t size() const { return numWords; }
+
+private:
+  SharedKeySegment(void *mapping, size_t mappingSize, double *words,
+                   size_t numWords)
+      : mapping(mapping), mappingSize(mappingSize), words(words),
+        numWords(numWords) {}
+
+  void *mapping;
+  size_t mappingSize;
+  double *words;
+  size_t numWords;
+};
+
+} // namespace concretelang
+} // namespace mlir
+
+#endif
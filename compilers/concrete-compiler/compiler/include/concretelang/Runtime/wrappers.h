@@ -6,6 +6,7 @@
 #ifndef CONCRETELANG_RUNTIME_WRAPPERS_H
 #define CONCRETELANG_RUNTIME_WRAPPERS_H
 
+#include "concretelang/ClientLib/Types.h"
 #include "concretelang/Runtime/context.h"
 
 extern "C" {
@@ -29,6 +30,15 @@ void memref_encode_expand_lut_for_bootstrap(
     uint64_t input_lut_size, uint64_t input_lut_stride, uint32_t poly_size,
     uint32_t out_MESSAGE_BITS, bool is_signed);
 
+void memref_encode_expand_many_lut_for_bootstrap(
+    uint64_t *output_lut_allocated, uint64_t *output_lut_aligned,
+    uint64_t output_lut_offset, uint64_t output_lut_size,
+    uint64_t output_lut_stride, uint64_t *input_luts_allocated,
+    uint64_t *input_luts_aligned, uint64_t input_luts_offset,
+    uint64_t input_luts_size0, uint64_t input_luts_size1,
+    uint64_t input_luts_stride0, uint64_t input_luts_stride1,
+    uint32_t poly_size, uint32_t out_MESSAGE_BITS, bool is_signed);
+
 void memref_encode_lut_for_crt_woppbs(
     uint64_t *output_lut_allocated, uint64_t *output_lut_aligned,
     uint64_t output_lut_offset, uint64_t output_lut_size0,
@@ -110,6 +120,16 @@ void memref_bootstrap_lwe_u64(
     uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context);
 
+void memref_many_lut_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size, uint64_t ct0_stride,
+    uint64_t *tlu_allocated, uint64_t *tlu_aligned, uint64_t tlu_offset,
+    uint64_t tlu_size, uint64_t tlu_stride, uint32_t input_lwe_dim,
+    uint32_t poly_size, uint32_t level, uint32_t base_log, uint32_t glwe_dim,
+    uint32_t bsk_index, mlir::concretelang::RuntimeContext *context);
+
 void memref_batched_bootstrap_lwe_u64(
     uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
     uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
@@ -173,6 +193,12 @@ void memref_copy_one_rank(uint64_t *src_allocated, uint64_t *src_aligned,
                           uint64_t *dst_aligned, uint64_t dst_offset,
                           uint64_t dst_size, uint64_t dst_stride);
 
+/// \brief Copies a memref of 64 bits integers of any rank and layout to
+/// another, both given as unranked memrefs, by memcpy of the largest blocks
+/// which are contiguous in both memrefs.
+void memref_copy_blocks(int64_t src_rank, void *src_descriptor,
+                        int64_t dst_rank, void *dst_descriptor);
+
 // Single ciphertext CUDA functions ///////////////////////////////////////////
 
 /// \brief Run Keyswitch on GPU.
@@ -223,6 +249,25 @@ void memref_batched_bootstrap_lwe_cuda_u64(
     uint32_t level, uint32_t base_log, uint32_t glwe_dim, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context);
 
+// Memory planning ////////////////////////////////////////////////////////////
+
+/// \brief Acquires the arena of the intermediate buffers of a call
+///
+/// The arena is returned through the descriptor of a 1D memref of bytes, as
+/// the function implements the C interface of a function returning a memref.
+///
+/// \param arena where to write the descriptor of the arena
+/// \param context the runtime context of the call
+/// \param size number of bytes of the arena
+void _mlir_ciface_memref_arena_acquire(
+    concretelang::clientlib::MemRefDescriptor<1> *arena,
+    mlir::concretelang::RuntimeContext *context, uint64_t size);
+
+void memref_arena_release(uint8_t *arena_allocated, uint8_t *arena_aligned,
+                          uint64_t arena_offset, uint64_t arena_size,
+                          uint64_t arena_stride,
+                          mlir::concretelang::RuntimeContext *context);
+
 // Tracing ////////////////////////////////////////////////////////////////////
 void memref_trace_ciphertext(uint64_t *ct0_allocated, uint64_t *ct0_aligned,
                              uint64_t ct0_offset, uint64_t ct0_size,
@@ -234,6 +279,13 @@ void memref_trace_plaintext(uint64_t input, uint64_t input_width,
                             uint32_t msb);
 
 void memref_trace_message(char *message_ptr, uint32_t message_len);
+
+// Multiversioning ////////////////////////////////////////////////////////////
+
+/// \brief Returns true if the host supports the features of the CPU `cpu`,
+/// one of x86-64-v{2,3,4}, selecting the version of the multiversioned
+/// functions of a library to call.
+bool cpu_supports_version(const char *cpu);
 }
 
 #endif
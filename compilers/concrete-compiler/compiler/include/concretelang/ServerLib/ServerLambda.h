@@ -14,6 +14,7 @@
 #include "concretelang/ClientLib/PublicArguments.h"
 #include "concretelang/ClientLib/Types.h"
 #include "concretelang/Common/Error.h"
+#include "concretelang/Runtime/context.h"
 #include "concretelang/ServerLib/DynamicModule.h"
 #include "concretelang/Support/Error.h"
 
@@ -21,6 +22,7 @@ namespace concretelang {
 namespace serverlib {
 
 using concretelang::clientlib::ScalarOrTensorData;
+using mlir::concretelang::PreparedEvaluationKeys;
 
 /// ServerLambda is a utility class that allows to call a function of a
 /// compilation result.
@@ -36,11 +38,47 @@ public:
   static outcome::checked<ServerLambda, concretelang::error::StringError>
   loadFromModule(std::shared_ptr<DynamicModule> module, std::string funcName);
 
+  /// Start the preparation of the evaluation keys for execution, i.e. the
+  /// conversion of the bootstrap keys to the fourier domain, in background.
+  /// The returned handle can be used for any number of calls, a call made
+  /// while the preparation is in flight only waits for the keys it uses.
+  /// If `sharedKeysPath` is set, the prepared keys are shared with the other
+  /// processes of the host through segments of this directory.
+  static std::shared_ptr<PreparedEvaluationKeys>
+  prepareEvaluationKeys(clientlib::EvaluationKeys &evaluationKeys,
+                        std::optional<std::string> sharedKeysPath =
+                            std::nullopt);
+
+  /// Returns the performance counters of the runtime, i.e. the counts and
+  /// latency histograms of the operations per key and parameters set, as a
+  /// JSON document. The counters are shared by all the lambdas of the process.
+  static std::string performanceCounters();
+
+  /// Resets the performance counters of the runtime.
+  static void resetPerformanceCounters();
+
+  /// Starts recording a trace of the operations of the runtime.
+  static void startTrace();
+
+  /// Stops recording the trace and writes it to `path` in the Chrome trace
+  /// event format.
+  static outcome::checked<void, concretelang::error::StringError>
+  stopTrace(std::string path);
+
   /// Call the ServerLambda with public arguments.
   llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
   call(clientlib::PublicArguments &args,
        clientlib::EvaluationKeys &evaluationKeys);
 
+  /// Call the ServerLambda with public arguments and prepared evaluation keys.
+  /// If the memory of the function is planned, the intermediate buffers are
+  /// placed in `arena` when given, such that the calls reusing the same arena
+  /// don't allocate them.
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+  call(clientlib::PublicArguments &args,
+       std::shared_ptr<PreparedEvaluationKeys> preparedKeys,
+       mlir::concretelang::MemoryArena *arena = nullptr);
+
   /// \brief Call the loaded function using opaque pointers to both inputs and
   /// outputs.
   /// \param args Array containing pointers to inputs first, followed by
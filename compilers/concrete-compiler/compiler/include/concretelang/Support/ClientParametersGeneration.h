@@ -19,11 +19,19 @@ namespace concretelang {
 using ::concretelang::clientlib::ChunkInfo;
 using ::concretelang::clientlib::ClientParameters;
 
+/// Creates the client parameters of the function `functionName`. If
+/// `switchOutputsModulus` is set, the encrypted outputs are switched to the
+/// smallest modulus keeping their decryption correct when serialized. If
+/// `packOutputs` is set, the ciphertexts of the encrypted outputs are packed
+/// in GLWE ciphertexts with dedicated packing keyswitch keys.
 llvm::Expected<ClientParameters>
 createClientParametersFromTFHE(mlir::ModuleOp module,
                                llvm::StringRef functionName, int bitsOfSecurity,
                                encodings::CircuitEncodings encodings,
-                               std::optional<CRTDecomposition> maybeCrt);
+                               std::optional<CRTDecomposition> maybeCrt,
+                               uint64_t multiBitGroupingFactor = 1,
+                               bool switchOutputsModulus = false,
+                               bool packOutputs = false);
 
 } // namespace concretelang
 } // namespace mlir
@@ -7,6 +7,7 @@
 #define CONCRETELANG_SUPPORT_COMPILATIONFEEDBACK_H_
 
 #include <cstddef>
+#include <string>
 #include <vector>
 
 #include "concretelang/ClientLib/ClientParameters.h"
@@ -18,6 +19,31 @@ namespace concretelang {
 
 using StringError = ::concretelang::error::StringError;
 
+/// @brief Statistics of the cryptographic operations of the same kind using
+/// the same key at the same location of the program
+struct OperationStatistic {
+  /// @brief the kind of the operations, i.e. "keyswitch", "bootstrap" or
+  /// "wop_pbs"
+  std::string operation;
+
+  /// @brief the location of the operations in the program
+  std::string location;
+
+  /// @brief the index of the key used by the operations, in the keyswitch
+  /// keys for the keyswitches and in the bootstrap keys otherwise
+  uint64_t keyIndex;
+
+  /// @brief the number of operations executed by a call of the program
+  uint64_t count;
+
+  /// @brief the estimated complexity of all the operations
+  double complexity;
+
+  /// @brief the part of the estimated complexity of the cryptographic
+  /// operations of the program spent in these operations
+  double complexityShare;
+};
+
 struct CompilationFeedback {
   double complexity;
 
@@ -42,6 +68,27 @@ struct CompilationFeedback {
   /// @brief the total number of bytes of outputs
   uint64_t totalOutputsSize;
 
+  /// @brief the number of keyswitches removed because another keyswitch
+  /// computes the same result
+  uint64_t deduplicatedKeyswitches = 0;
+
+  /// @brief the number of bytes of the arenas holding the intermediate
+  /// buffers of the functions, 0 if the memory is not planned
+  uint64_t peakIntermediateBuffersSize = 0;
+
+  /// @brief the statistics of the cryptographic operations, by decreasing
+  /// complexity
+  std::vector<OperationStatistic> operationStatistics;
+
+  /// @brief the estimated peak number of bytes of the ciphertexts alive at
+  /// the same time
+  uint64_t peakCiphertextsSize = 0;
+
+  /// @brief the estimated complexity of the longest chain of dependent
+  /// cryptographic operations, i.e. of the program when all the independent
+  /// operations are run in parallel
+  double criticalPathComplexity = 0;
+
   /// @brief crt decomposition of outputs, if crt is not used, empty vectors
   std::vector<std::vector<int64_t>> crtDecompositionsOfOutputs;
 
@@ -54,6 +101,10 @@ struct CompilationFeedback {
   load(std::string path);
 };
 
+llvm::json::Value toJSON(const mlir::concretelang::OperationStatistic &);
+bool fromJSON(const llvm::json::Value,
+              mlir::concretelang::OperationStatistic &, llvm::json::Path);
+
 llvm::json::Value toJSON(const mlir::concretelang::CompilationFeedback &);
 bool fromJSON(const llvm::json::Value,
               mlir::concretelang::CompilationFeedback &, llvm::json::Path);
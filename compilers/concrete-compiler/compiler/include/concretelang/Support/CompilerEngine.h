@@ -12,6 +12,7 @@
 #include <llvm/IR/Module.h>
 #include <llvm/Support/Error.h>
 #include <llvm/Support/SourceMgr.h>
+#include <llvm/Target/TargetMachine.h>
 #include <mlir/IR/BuiltinOps.h>
 #include <mlir/IR/MLIRContext.h>
 #include <mlir/Pass/Pass.h>
@@ -79,6 +80,55 @@ struct CompilationOptions {
   unsigned int chunkSize;
   unsigned int chunkWidth;
 
+  /// Compose the chains of lookup tables and fold the leveled operations
+  /// with clear constants around them into the tables.
+  bool composeLUTs;
+
+  /// Group the lookup tables applied on the same input into many-LUT
+  /// bootstraps, as long as the bootstrap precision stays under
+  /// manyLUTMaxPrecision.
+  bool manyLUT;
+  unsigned int manyLUTMaxPrecision;
+
+  /// Round with lookup tables of at most roundLUTMaxPrecision bits, of the
+  /// precisions of the tables already in the circuit, when it needs fewer
+  /// bootstraps than discarding the bits one by one. 0, the default, always
+  /// discards the bits one by one.
+  unsigned int roundLUTMaxPrecision;
+
+  /// Place the intermediate buffers of the functions in a single arena per
+  /// invocation, reusing the memory of the buffers which are not live at the
+  /// same time.
+  bool planMemory;
+
+  /// Switch the encrypted outputs to the smallest modulus keeping their
+  /// decryption correct when serializing them, reducing the size of the
+  /// results sent to the client.
+  bool outputModulusSwitching;
+
+  /// Pack the ciphertexts of the encrypted outputs in GLWE ciphertexts before
+  /// returning them, up to a polynomial size of them per GLWE, reducing the
+  /// size of the results sent to the client.
+  bool outputPacking;
+
+  /// Lower the leveled operations on ciphertexts to loops fused with each
+  /// other and vectorized with the rest of the circuit, instead of calls to
+  /// the runtime.
+  bool inlineLeveledOps;
+
+  /// CPU, e.g. "skylake-avx512", and comma separated features, e.g.
+  /// "+avx2,-avx512f", targeted by the code of the libraries. The "native"
+  /// CPU is the CPU of the host, with all its features, and the "generic" CPU
+  /// a baseline CPU of the host architecture. The JIT always targets the
+  /// host.
+  std::string targetCPU;
+  std::string targetFeatures;
+
+  /// CPUs, e.g. "x86-64-v3", for which an additional version of the
+  /// functions of the libraries is generated. The version for the most
+  /// capable CPU supported by the host is called at run time.
+  std::vector<std::string> targetCPUVersions;
+
   /// When compiling from a dialect lower than FHE, one needs to provide
   /// encodings info manually to allow the client lib to be generated.
   std::optional<mlir::concretelang::encodings::CircuitEncodings> encodings;
@@ -90,7 +140,11 @@ struct CompilationOptions {
         dataflowParallelize(false), optimizeTFHE(true), emitGPUOps(false),
         clientParametersFuncName(std::nullopt),
         optimizerConfig(optimizer::DEFAULT_CONFIG), chunkIntegers(false),
-        chunkSize(4), chunkWidth(2), encodings(std::nullopt){};
+        chunkSize(4), chunkWidth(2), composeLUTs(false), manyLUT(false),
+        manyLUTMaxPrecision(8), roundLUTMaxPrecision(0), planMemory(false),
+        outputModulusSwitching(false), outputPacking(false),
+        inlineLeveledOps(false), targetCPU("native"), targetFeatures(""),
+        encodings(std::nullopt){};
 
   CompilationOptions(std::string funcname) : CompilationOptions() {
     clientParametersFuncName = funcname;
@@ -128,6 +182,8 @@ public:
     std::optional<mlir::concretelang::ClientParameters> clientParameters;
     std::optional<CompilationFeedback> feedback;
     std::unique_ptr<llvm::Module> llvmModule;
+    /// Target machine of `llvmModule`, set when optimizing the LLVM IR
+    std::unique_ptr<llvm::TargetMachine> targetMachine;
     std::optional<mlir::concretelang::V0FHEContext> fheContext;
 
   protected:
@@ -62,6 +62,13 @@ public:
     return lambda->call(args, evaluationKeys);
   }
 
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+  serverCall(std::shared_ptr<concretelang::JITLambda> lambda,
+             clientlib::PublicArguments &args,
+             std::shared_ptr<PreparedEvaluationKeys> preparedKeys) override {
+    return lambda->call(args, preparedKeys);
+  }
+
 private:
   std::optional<std::string> runtimeLibPath;
   llvm::function_ref<llvm::Error(llvm::Module *)> llvmOptPipeline;
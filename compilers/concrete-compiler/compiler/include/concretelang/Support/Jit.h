@@ -12,6 +12,7 @@
 
 #include <concretelang/ClientLib/KeySet.h>
 #include <concretelang/ClientLib/PublicArguments.h>
+#include <concretelang/Runtime/context.h>
 
 namespace mlir {
 namespace concretelang {
@@ -39,6 +40,12 @@ public:
   call(clientlib::PublicArguments &args,
        clientlib::EvaluationKeys &evaluationKeys);
 
+  /// Call the JIT lambda with the public arguments and prepared evaluation
+  /// keys.
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+  call(clientlib::PublicArguments &args,
+       std::shared_ptr<PreparedEvaluationKeys> preparedKeys);
+
   void setUseDataflow(bool option) { this->useDataflow = option; }
 
   /// invokeRaw execute the jit lambda with a list of Argument, the last one is
@@ -51,6 +58,10 @@ public:
   llvm::Error invokeRaw(llvm::MutableArrayRef<void *> args);
 
 private:
+  template <typename Keys>
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+  callWithKeys(clientlib::PublicArguments &args, Keys &keys);
+
   mlir::LLVM::LLVMFunctionType type;
   std::string name;
   std::unique_ptr<mlir::ExecutionEngine> engine;
@@ -6,12 +6,37 @@
 #ifndef CONCRETELANG_SUPPORT_LLVMEMITFILE
 #define CONCRETELANG_SUPPORT_LLVMEMITFILE
 
+#include <llvm/ADT/ArrayRef.h>
 #include <llvm/ADT/StringRef.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
 
 namespace mlir {
 namespace concretelang {
 
-llvm::Error emitObject(llvm::Module &module, std::string objectPath);
+/// Returns a target machine for the host architecture and the CPU `cpu`, with
+/// the comma separated features `features` (e.g. "+avx2,-avx512f") on top of
+/// the features of the CPU. The "native" CPU is the CPU of the host, with all
+/// its features.
+llvm::Expected<std::unique_ptr<llvm::TargetMachine>>
+createTargetMachine(llvm::StringRef cpu = "native",
+                    llvm::StringRef features = "");
+
+/// Sets the target triple and data layout of `module` to the ones of
+/// `targetMachine`, and its functions to target the CPU and features of
+/// `targetMachine`.
+void setupModuleTarget(llvm::Module &module,
+                       llvm::TargetMachine &targetMachine);
+
+/// Generates a version of the functions of `module` for each CPU of `cpus`
+/// (e.g. "x86-64-v3"). The externally visible functions dispatch their calls
+/// to the version for the most capable CPU supported by the host, or to the
+/// version for the target of the module otherwise.
+llvm::Error multiversionFunctions(llvm::Module &module,
+                                  llvm::ArrayRef<std::string> cpus);
+
+llvm::Error emitObject(llvm::Module &module, llvm::TargetMachine &targetMachine,
+                       std::string objectPath);
 
 llvm::Error callCmd(std::string cmd);
 
@@ -6,8 +6,11 @@
 #ifndef CONCRETELANG_SUPPORT_LAMBDA_ARGUMENT_H
 #define CONCRETELANG_SUPPORT_LAMBDA_ARGUMENT_H
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <vector>
 
 #include <concretelang/Support/Error.h>
 #include <llvm/ADT/ArrayRef.h>
@@ -154,6 +157,17 @@ public:
       llvm::ArrayRef<int64_t> dimensions)
       : dimensions(dimensions.vec()), value(std::move(value)) {}
 
+  /// Construct tensor argument borrowing the linearized values at
+  /// `value` instead of copying them, interpreting them as a
+  /// multi-dimensional tensor with the sizes of the dimensions
+  /// specified in `dimensions`. The values must stay valid as long as
+  /// `owner` is alive, which the argument keeps alive itself.
+  TensorLambdaArgument(typename ScalarArgumentT::value_type *value,
+                       llvm::ArrayRef<int64_t> dimensions,
+                       std::shared_ptr<void> owner)
+      : dimensions(dimensions.vec()), borrowedValue(value),
+        owner(std::move(owner)) {}
+
   /// Construct a one-dimensional tensor argument from the
   /// array `value`.
   TensorLambdaArgument(
@@ -187,27 +201,33 @@ public:
   /// Returns a bare pointer to the linearized values of the tensor
   /// (constant version).
   const typename ScalarArgumentT::value_type *getValue() const {
-    return this->value.data();
+    return this->borrowedValue ? this->borrowedValue : this->value.data();
   }
 
   /// Returns a bare pointer to the linearized values of the tensor (mutable
   /// version).
   typename ScalarArgumentT::value_type *getValue() {
-    return this->value.data();
+    return this->borrowedValue ? this->borrowedValue : this->value.data();
   }
 
+  /// Returns true if the values of the tensor are borrowed from an
+  /// external buffer rather than owned by the argument.
+  bool isBorrowed() const { return this->borrowedValue != nullptr; }
+
   template <typename OtherScalarArgumentT>
   bool
   operator==(const TensorLambdaArgument<OtherScalarArgumentT> &other) const {
     if (getDimensions() != other.getDimensions())
       return false;
 
-    for (auto pair : llvm::zip(value, other.value)) {
-      if (std::get<0>(pair) != std::get<1>(pair))
-        return false;
+    llvm::Expected<size_t> numElements = getNumElements();
+    if (!numElements) {
+      llvm::consumeError(numElements.takeError());
+      return false;
     }
 
-    return true;
+    return std::equal(getValue(), getValue() + *numElements,
+                      other.getValue());
   }
 
   template <typename OtherScalarArgumentT>
@@ -221,6 +241,11 @@ public:
 protected:
   std::vector<typename ScalarArgumentT::value_type> value;
   std::vector<int64_t> dimensions;
+
+  /// Values borrowed from an external buffer, if any, and the object
+  /// keeping that buffer alive
+  typename ScalarArgumentT::value_type *borrowedValue = nullptr;
+  std::shared_ptr<void> owner;
 };
 
 template <typename ScalarArgumentT>
@@ -161,7 +161,7 @@ buildTensorLambdaResult(clientlib::KeySet &keySet,
     return StreamStringError(tensorDim.error().mesg);
 
   return std::make_unique<TensorLambdaArgument<IntLambdaArgument<T>>>(
-      *tensorOrError, tensorDim.value());
+      std::move(*tensorOrError), tensorDim.value());
 }
 
 template <typename T>
@@ -389,6 +389,11 @@ public:
       Lambda lambda, clientlib::PublicArguments &args,
       clientlib::EvaluationKeys &evaluationKeys) = 0;
 
+  /// Call the lambda with the public arguments and prepared evaluation keys.
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>> virtual serverCall(
+      Lambda lambda, clientlib::PublicArguments &args,
+      std::shared_ptr<PreparedEvaluationKeys> preparedKeys) = 0;
+
   /// Build the client KeySet from the client parameters.
   static llvm::Expected<std::unique_ptr<clientlib::KeySet>>
   keySet(clientlib::ClientParameters clientParameters,
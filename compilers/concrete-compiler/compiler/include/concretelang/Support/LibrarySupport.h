@@ -122,6 +122,13 @@ public:
     return lambda.call(args, evaluationKeys);
   }
 
+  /// Call the lambda with the public arguments and prepared evaluation keys.
+  llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+  serverCall(serverlib::ServerLambda lambda, clientlib::PublicArguments &args,
+             std::shared_ptr<PreparedEvaluationKeys> preparedKeys) override {
+    return lambda.call(args, preparedKeys);
+  }
+
   /// Get path to shared library
   std::string getSharedLibPath() {
     return CompilerEngine::Library::getSharedLibraryPath(outputPath);
@@ -7,6 +7,7 @@
 #define CONCRETELANG_SUPPORT_PIPELINE_H_
 
 #include <llvm/IR/Module.h>
+#include <llvm/Target/TargetMachine.h>
 #include <mlir/Dialect/LLVMIR/LLVMTypes.h>
 #include <mlir/Support/LogicalResult.h>
 #include <mlir/Transforms/Passes.h>
@@ -51,7 +52,22 @@ transformFHEBoolean(mlir::MLIRContext &context, mlir::ModuleOp &module,
 mlir::LogicalResult
 transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
                    std::function<bool(mlir::Pass *)> enablePass,
-                   unsigned int chunkSize, unsigned int chunkWidth);
+                   unsigned int chunkSize, unsigned int chunkWidth,
+                   bool parallelCarries);
+
+mlir::LogicalResult
+transformFHERound(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                  std::function<bool(mlir::Pass *)> enablePass,
+                  unsigned int maxPrecision);
+
+mlir::LogicalResult
+composeLookupTables(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                    std::function<bool(mlir::Pass *)> enablePass);
+
+mlir::LogicalResult
+groupLookupTables(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                  std::function<bool(mlir::Pass *)> enablePass,
+                  unsigned int maxPrecision);
 
 mlir::LogicalResult
 lowerFHEToTFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
@@ -84,6 +100,11 @@ mlir::LogicalResult optimizeTFHE(mlir::MLIRContext &context,
                                  mlir::ModuleOp &module,
                                  std::function<bool(mlir::Pass *)> enablePass);
 
+mlir::LogicalResult
+deduplicateKeyswitches(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                       std::function<bool(mlir::Pass *)> enablePass,
+                       uint64_t &removedKeyswitches);
+
 mlir::LogicalResult extractSDFGOps(mlir::MLIRContext &context,
                                    mlir::ModuleOp &module,
                                    std::function<bool(mlir::Pass *)> enablePass,
@@ -91,7 +112,8 @@ mlir::LogicalResult extractSDFGOps(mlir::MLIRContext &context,
 
 mlir::LogicalResult
 lowerConcreteToStd(mlir::MLIRContext &context, mlir::ModuleOp &module,
-                   std::function<bool(mlir::Pass *)> enablePass);
+                   std::function<bool(mlir::Pass *)> enablePass,
+                   bool inlineLeveledOps);
 
 mlir::LogicalResult
 lowerSDFGToStd(mlir::MLIRContext &context, mlir::ModuleOp &module,
@@ -100,10 +122,12 @@ lowerSDFGToStd(mlir::MLIRContext &context, mlir::ModuleOp &module,
 mlir::LogicalResult
 lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
                       std::function<bool(mlir::Pass *)> enablePass,
-                      bool parallelizeLoops, bool gpu);
+                      bool parallelizeLoops, bool gpu, bool planMemory,
+                      uint64_t &arenaSizes);
 
 mlir::LogicalResult optimizeLLVMModule(llvm::LLVMContext &llvmContext,
-                                       llvm::Module &module);
+                                       llvm::Module &module,
+                                       llvm::TargetMachine *targetMachine);
 
 std::unique_ptr<llvm::Module>
 lowerLLVMDialectToLLVMIR(mlir::MLIRContext &context,
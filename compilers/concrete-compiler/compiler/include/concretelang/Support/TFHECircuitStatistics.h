@@ -0,0 +1,28 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#ifndef CONCRETELANG_SUPPORT_TFHECIRCUITSTATISTICS_H_
+#define CONCRETELANG_SUPPORT_TFHECIRCUITSTATISTICS_H_
+
+#include "mlir/IR/BuiltinOps.h"
+
+#include "concretelang/Support/CompilationFeedback.h"
+
+namespace mlir {
+namespace concretelang {
+namespace TFHE {
+
+/// Fills the statistics of the cryptographic operations of the TFHE module
+/// `moduleOp`, whose keys must be normalized, in `feedback`: the number and
+/// the estimated complexity of the keyswitches, bootstraps and wop-pbs per
+/// location, the estimated peak size of the ciphertexts alive at the same
+/// time and the estimated complexity of the critical path.
+void fillCircuitStatistics(mlir::ModuleOp moduleOp,
+                           CompilationFeedback &feedback);
+
+} // namespace TFHE
+} // namespace concretelang
+} // namespace mlir
+#endif
@@ -29,10 +29,11 @@ std::string makePackedFunctionName(llvm::StringRef name);
 uint64_t numArgOfRankedMemrefCallingConvention(uint64_t rank);
 
 template <typename Lambda>
-llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
-invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
-                  std::vector<void *> preparedInputArgs,
-                  clientlib::EvaluationKeys &evaluationKeys) {
+llvm::Expected<std::unique_ptr<clientlib::PublicResult>> invokeRawOnLambda(
+    Lambda *lambda, clientlib::ClientParameters clientParameters,
+    std::vector<void *> preparedInputArgs,
+    std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys> preparedKeys,
+    mlir::concretelang::MemoryArena *arena = nullptr) {
   // invokeRaw needs to have pointers on arguments and a pointers on the result
   // as last argument.
   // Prepare the outputs vector to store the output value of the lambda.
@@ -60,7 +61,8 @@ invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
     rawArgs[i++] = &arg;
   }
 
-  mlir::concretelang::RuntimeContext runtimeContext(evaluationKeys);
+  mlir::concretelang::RuntimeContext runtimeContext(preparedKeys);
+  runtimeContext.set_memory_arena(arena);
   // Pointer on runtime context, the rawArgs take pointer on actual value that
   // is passed to the compiled function.
   auto rtCtxPtr = &runtimeContext;
@@ -105,6 +107,16 @@ invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
         concretelang::clientlib::TensorData td =
             clientlib::tensorDataFromMemRef(rank, elementWidth, sign, allocated,
                                             aligned, offset, sizes, strides);
+        if (output.isEncrypted() &&
+            output.encryption->packingKeyID.has_value()) {
+          // Compress the output by packing its ciphertexts in GLWEs
+          auto packingKeyID = *output.encryption->packingKeyID;
+          buffers.push_back(concretelang::clientlib::ScalarOrTensorData(
+              clientlib::packCiphertexts(
+                  clientParameters, output, td,
+                  runtimeContext.fp_keyswitch_key_buffer(packingKeyID))));
+          continue;
+        }
         buffers.push_back(
             concretelang::clientlib::ScalarOrTensorData(std::move(td)));
       }
@@ -114,6 +126,16 @@ invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
                                               std::move(buffers));
 }
 
+template <typename Lambda>
+llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+invokeRawOnLambda(Lambda *lambda, clientlib::ClientParameters clientParameters,
+                  std::vector<void *> preparedInputArgs,
+                  clientlib::EvaluationKeys &evaluationKeys) {
+  return invokeRawOnLambda(
+      lambda, clientParameters, preparedInputArgs,
+      mlir::concretelang::PreparedEvaluationKeys::prepare(evaluationKeys));
+}
+
 template <typename V, unsigned int N>
 llvm::raw_ostream &operator<<(llvm::raw_ostream &OS,
                               const llvm::SmallVector<V, N> vect) {
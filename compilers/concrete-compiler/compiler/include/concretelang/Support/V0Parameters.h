@@ -78,6 +78,10 @@ constexpr bool DEFAULT_USE_GPU_CONSTRAINTS = false;
 constexpr concrete_optimizer::Encoding DEFAULT_ENCODING =
     concrete_optimizer::Encoding::Auto;
 constexpr bool DEFAULT_CACHE_ON_DISK = true;
+constexpr uint64_t DEFAULT_MULTI_BIT_GROUPING_FACTOR = 1;
+/// The noise of the multi bit bootstraps is only modelled up to this grouping
+/// factor.
+constexpr uint64_t MAX_MULTI_BIT_GROUPING_FACTOR = 4;
 
 /// The strategy of the crypto optimization
 enum Strategy {
@@ -105,6 +109,9 @@ struct Config {
   bool use_gpu_constraints;
   concrete_optimizer::Encoding encoding;
   bool cache_on_disk;
+  /// Number of mask elements processed by each external product of the
+  /// bootstraps, 1 for the classic bootstrap.
+  std::uint64_t multi_bit_grouping_factor;
 };
 
 constexpr Config DEFAULT_CONFIG = {
@@ -117,6 +124,7 @@ constexpr Config DEFAULT_CONFIG = {
     DEFAULT_USE_GPU_CONSTRAINTS,
     DEFAULT_ENCODING,
     DEFAULT_CACHE_ON_DISK,
+    DEFAULT_MULTI_BIT_GROUPING_FACTOR,
 };
 
 using Dag = rust::Box<concrete_optimizer::OperationDag>;
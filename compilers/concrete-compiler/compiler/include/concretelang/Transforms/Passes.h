@@ -6,7 +6,9 @@
 #ifndef CONCRETELANG_TRANSFORMS_PASS_H
 #define CONCRETELANG_TRANSFORMS_PASS_H
 
+#include <mlir/Dialect/Arith/IR/Arith.h>
 #include <mlir/Dialect/Func/IR/FuncOps.h>
+#include <mlir/Dialect/Linalg/IR/Linalg.h>
 #include <mlir/Dialect/MemRef/IR/MemRef.h>
 #include <mlir/Dialect/SCF/IR/SCF.h>
 #include <mlir/Pass/Pass.h>
@@ -21,6 +23,12 @@ std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
 createCollapseParallelLoops();
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createForLoopToParallel();
 std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>> createBatchingPass();
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createDataMovementFusionPass();
+/// Creates the memory planning pass, which adds the sizes of the arenas of the
+/// planned functions to `arenaSizes` if not null.
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createMemoryPlanningPass(uint64_t *arenaSizes = nullptr);
 } // namespace concretelang
 } // namespace mlir
 
@@ -12,6 +12,7 @@
 #include <mlir/Dialect/MemRef/IR/MemRef.h>
 #include <mlir/ExecutionEngine/OptUtils.h>
 
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/pytypes.h>
 #include <pybind11/stl.h>
@@ -20,7 +21,130 @@
 
 using mlir::concretelang::CompilationOptions;
 using mlir::concretelang::JITSupport;
+using mlir::concretelang::IntLambdaArgument;
 using mlir::concretelang::LambdaArgument;
+using mlir::concretelang::TensorLambdaArgument;
+
+/// Returns the result of `f`, computed without holding the GIL such that the
+/// other Python threads run meanwhile. `f` must not use Python objects.
+template <typename F> static auto withoutGIL(F f) {
+  pybind11::gil_scoped_release release;
+  return f();
+}
+
+/// Returns the future of `call` run on the workers of the server calls. The
+/// future waits for the end of the call when Python drops it, so it releases
+/// the GIL meanwhile: the other Python threads keep running, and the call can
+/// take the GIL to release the arrays it borrows.
+template <typename F>
+static std::shared_ptr<PublicResultFuture> callAsync(F call) {
+  auto future = server_call_async(std::move(call));
+  auto raw = future.get();
+  return std::shared_ptr<PublicResultFuture>(
+      raw, [future = std::move(future)](PublicResultFuture *ptr) mutable {
+        if (PyGILState_Check()) {
+          pybind11::gil_scoped_release release;
+          ptr->wait();
+        }
+        future.reset();
+      });
+}
+
+/// Returns a tensor argument borrowing the values of `array`, which must be
+/// C-contiguous and of scalar type `T`, instead of copying them. The argument
+/// keeps `array` alive.
+template <typename T>
+static lambdaArgument borrowArray(pybind11::array array) {
+  std::vector<int64_t> dimensions(array.shape(), array.shape() + array.ndim());
+  // The last reference to the argument may be dropped by a call running
+  // without the GIL, which the release of the array requires.
+  std::shared_ptr<void> owner(new pybind11::array(array), [](void *ptr) {
+    pybind11::gil_scoped_acquire acquire;
+    delete static_cast<pybind11::array *>(ptr);
+  });
+  // The argument only reads the values, so a read-only array is fine.
+  T *data = const_cast<T *>(static_cast<const T *>(array.data()));
+  return lambdaArgument{
+      std::make_shared<TensorLambdaArgument<IntLambdaArgument<T>>>(
+          data, dimensions, std::move(owner))};
+}
+
+/// Base case for `lambdaArgumentFromArrayOf<T, Ts...>(...)`
+template <typename T>
+static bool lambdaArgumentFromArrayOf(pybind11::array array,
+                                      lambdaArgument &result) {
+  if (!array.dtype().equal(pybind11::dtype::of<T>()))
+    return false;
+  result = borrowArray<T>(array);
+  return true;
+}
+
+/// Sets `result` to a tensor argument borrowing the values of `array` if its
+/// scalar type is one of `T, NextT, Ts...`, and returns false otherwise.
+template <typename T, typename NextT, typename... Ts>
+static bool lambdaArgumentFromArrayOf(pybind11::array array,
+                                      lambdaArgument &result) {
+  return lambdaArgumentFromArrayOf<T>(array, result) ||
+         lambdaArgumentFromArrayOf<NextT, Ts...>(array, result);
+}
+
+/// Returns a tensor argument borrowing the values of the NumPy array `array`.
+/// Throws if `array` isn't a C-contiguous array of (u)int{8,16,32,64}.
+static lambdaArgument lambdaArgumentFromArray(pybind11::array array) {
+  if (array.ndim() == 0)
+    throw std::invalid_argument("array must have at least one dimension");
+  if (!(array.flags() & pybind11::array::c_style))
+    throw std::invalid_argument("array must be C-contiguous");
+
+  lambdaArgument result;
+  if (!lambdaArgumentFromArrayOf<uint8_t, uint16_t, uint32_t, uint64_t, int8_t,
+                                 int16_t, int32_t, int64_t>(array, result)) {
+    throw pybind11::type_error("array must be of dtype (u)int{8,16,32,64}");
+  }
+  return result;
+}
+
+/// Base case for `lambdaArgumentGetTensorArray<T, Ts...>(...)`
+template <typename T>
+static bool lambdaArgumentGetTensorArray(lambdaArgument &lambda_arg,
+                                         pybind11::object &result) {
+  auto arg =
+      lambda_arg.ptr->dyn_cast<TensorLambdaArgument<IntLambdaArgument<T>>>();
+  if (arg == nullptr)
+    return false;
+  // The array views the values of the argument, which its base keeps alive.
+  pybind11::capsule base(
+      new std::shared_ptr<LambdaArgument>(lambda_arg.ptr), [](void *ptr) {
+        delete static_cast<std::shared_ptr<LambdaArgument> *>(ptr);
+      });
+  result = pybind11::array_t<T>(arg->getDimensions(), arg->getValue(), base);
+  return true;
+}
+
+/// Sets `result` to a NumPy array viewing the values of the tensor held by
+/// `lambda_arg` if its scalar type is one of `T, NextT, Ts...`, and returns
+/// false otherwise.
+template <typename T, typename NextT, typename... Ts>
+static bool lambdaArgumentGetTensorArray(lambdaArgument &lambda_arg,
+                                         pybind11::object &result) {
+  return lambdaArgumentGetTensorArray<T>(lambda_arg, result) ||
+         lambdaArgumentGetTensorArray<NextT, Ts...>(lambda_arg, result);
+}
+
+/// Returns a NumPy array viewing the values of the tensor held by
+/// `lambda_arg` without copying them.
+static pybind11::object
+lambdaArgumentGetTensorArray(lambdaArgument &lambda_arg) {
+  pybind11::object result;
+  if (!lambdaArgumentGetTensorArray<uint8_t, uint16_t, uint32_t, uint64_t,
+                                    int8_t, int16_t, int32_t, int64_t>(
+          lambda_arg, result)) {
+    throw std::invalid_argument(
+        "LambdaArgument isn't a tensor, should "
+        "be a TensorLambdaArgument<IntLambdaArgument<(u)int{8,16,32,64}_t>>");
+  }
+  return result;
+}
 
 /// Populate the compiler API python module.
 void mlir::concretelang::python::populateCompilerAPISubmodule(
@@ -34,6 +158,12 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
 
   m.def("init_df_parallelization", &initDataflowParallelization);
 
+  m.def("performance_counters", &performance_counters);
+  m.def("reset_performance_counters", &reset_performance_counters);
+  m.def("start_trace", &start_trace);
+  m.def("stop_trace", &stop_trace);
+  m.def("set_server_call_workers", &set_server_call_workers);
+
   pybind11::enum_<optimizer::Strategy>(m, "OptimizerStrategy")
       .value("V0", optimizer::Strategy::V0)
       .value("DAG_MONO", optimizer::Strategy::DAG_MONO)
@@ -61,6 +191,40 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
            })
       .def("set_optimize_concrete", [](CompilationOptions &options,
                                        bool b) { options.optimizeTFHE = b; })
+      .def("set_compose_luts",
+           [](CompilationOptions &options, bool b) { options.composeLUTs = b; })
+      .def("set_many_lut",
+           [](CompilationOptions &options, bool b) { options.manyLUT = b; })
+      .def("set_round_lut_max_precision",
+           [](CompilationOptions &options, unsigned int maxPrecision) {
+             options.roundLUTMaxPrecision = maxPrecision;
+           })
+      .def("set_plan_memory",
+           [](CompilationOptions &options, bool b) { options.planMemory = b; })
+      .def("set_output_modulus_switching",
+           [](CompilationOptions &options, bool b) {
+             options.outputModulusSwitching = b;
+           })
+      .def("set_output_packing",
+           [](CompilationOptions &options, bool b) {
+             options.outputPacking = b;
+           })
+      .def("set_inline_leveled_ops",
+           [](CompilationOptions &options, bool b) {
+             options.inlineLeveledOps = b;
+           })
+      .def("set_target_cpu",
+           [](CompilationOptions &options, std::string cpu) {
+             options.targetCPU = cpu;
+           })
+      .def("set_target_features",
+           [](CompilationOptions &options, std::string features) {
+             options.targetFeatures = features;
+           })
+      .def("set_target_cpu_versions",
+           [](CompilationOptions &options, std::vector<std::string> cpus) {
+             options.targetCPUVersions = cpus;
+           })
       .def("set_p_error",
            [](CompilationOptions &options, double p_error) {
              options.optimizerConfig.p_error = p_error;
@@ -80,8 +244,26 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
       .def("set_security_level",
            [](CompilationOptions &options, int security_level) {
              options.optimizerConfig.security = security_level;
+           })
+      .def("set_multi_bit_grouping_factor",
+           [](CompilationOptions &options, uint64_t groupingFactor) {
+             options.optimizerConfig.multi_bit_grouping_factor = groupingFactor;
            });
 
+  pybind11::class_<mlir::concretelang::OperationStatistic>(
+      m, "OperationStatistic")
+      .def_readonly("operation",
+                    &mlir::concretelang::OperationStatistic::operation)
+      .def_readonly("location",
+                    &mlir::concretelang::OperationStatistic::location)
+      .def_readonly("key_index",
+                    &mlir::concretelang::OperationStatistic::keyIndex)
+      .def_readonly("count", &mlir::concretelang::OperationStatistic::count)
+      .def_readonly("complexity",
+                    &mlir::concretelang::OperationStatistic::complexity)
+      .def_readonly("complexity_share",
+                    &mlir::concretelang::OperationStatistic::complexityShare);
+
   pybind11::class_<mlir::concretelang::CompilationFeedback>(
       m, "CompilationFeedback")
       .def_readonly("complexity",
@@ -102,6 +284,21 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
                     &mlir::concretelang::CompilationFeedback::totalInputsSize)
       .def_readonly("total_output_size",
                     &mlir::concretelang::CompilationFeedback::totalOutputsSize)
+      .def_readonly(
+          "deduplicated_keyswitches",
+          &mlir::concretelang::CompilationFeedback::deduplicatedKeyswitches)
+      .def_readonly("peak_intermediate_buffers_size",
+                    &mlir::concretelang::CompilationFeedback::
+                        peakIntermediateBuffersSize)
+      .def_readonly(
+          "operation_statistics",
+          &mlir::concretelang::CompilationFeedback::operationStatistics)
+      .def_readonly(
+          "peak_ciphertexts_size",
+          &mlir::concretelang::CompilationFeedback::peakCiphertextsSize)
+      .def_readonly(
+          "critical_path_complexity",
+          &mlir::concretelang::CompilationFeedback::criticalPathComplexity)
       .def_readonly(
           "crt_decompositions_of_outputs",
           &mlir::concretelang::CompilationFeedback::crtDecompositionsOfOutputs);
@@ -119,7 +316,8 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
            [](JITSupport_Py &support, std::string mlir_program,
               CompilationOptions options) {
              return jit_compile(support, mlir_program.c_str(), options);
-           })
+           },
+           pybind11::call_guard<pybind11::gil_scoped_release>())
       .def("load_client_parameters",
            [](JITSupport_Py &support,
               mlir::concretelang::JitCompilationResult &result) {
@@ -143,7 +341,42 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
               clientlib::EvaluationKeys &evaluationKeys) {
              return jit_server_call(support, lambda, publicArguments,
                                     evaluationKeys);
-           });
+           },
+           pybind11::call_guard<pybind11::gil_scoped_release>())
+      .def("server_call",
+           [](JITSupport_Py &support, concretelang::JITLambda &lambda,
+              clientlib::PublicArguments &publicArguments,
+              std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys>
+                  preparedKeys) {
+             return jit_server_call(support, lambda, publicArguments,
+                                    preparedKeys);
+           },
+           pybind11::call_guard<pybind11::gil_scoped_release>())
+      // The futures keep the lambda and the arguments alive until the end of
+      // the calls.
+      .def(
+          "server_call_async",
+          [](JITSupport_Py &support, concretelang::JITLambda &lambda,
+             clientlib::PublicArguments &publicArguments,
+             clientlib::EvaluationKeys &evaluationKeys) {
+            return callAsync([=, &lambda, &publicArguments]() mutable {
+              return jit_server_call(support, lambda, publicArguments,
+                                     evaluationKeys);
+            });
+          },
+          pybind11::keep_alive<0, 2>(), pybind11::keep_alive<0, 3>())
+      .def(
+          "server_call_async",
+          [](JITSupport_Py &support, concretelang::JITLambda &lambda,
+             clientlib::PublicArguments &publicArguments,
+             std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys>
+                 preparedKeys) {
+            return callAsync([=, &lambda, &publicArguments]() {
+              return jit_server_call(support, lambda, publicArguments,
+                                     preparedKeys);
+            });
+          },
+          pybind11::keep_alive<0, 2>(), pybind11::keep_alive<0, 3>());
 
   pybind11::class_<mlir::concretelang::LibraryCompilationResult>(
       m, "LibraryCompilationResult")
@@ -169,7 +402,8 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
            [](LibrarySupport_Py &support, std::string mlir_program,
               mlir::concretelang::CompilationOptions options) {
              return library_compile(support, mlir_program.c_str(), options);
-           })
+           },
+           pybind11::call_guard<pybind11::gil_scoped_release>())
       .def("load_client_parameters",
            [](LibrarySupport_Py &support,
               mlir::concretelang::LibraryCompilationResult &result) {
@@ -193,7 +427,41 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
               clientlib::EvaluationKeys &evaluationKeys) {
              return library_server_call(support, lambda, publicArguments,
                                         evaluationKeys);
-           })
+           },
+           pybind11::call_guard<pybind11::gil_scoped_release>())
+      .def("server_call",
+           [](LibrarySupport_Py &support, serverlib::ServerLambda lambda,
+              clientlib::PublicArguments &publicArguments,
+              std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys>
+                  preparedKeys) {
+             return library_server_call(support, lambda, publicArguments,
+                                        preparedKeys);
+           },
+           pybind11::call_guard<pybind11::gil_scoped_release>())
+      // The futures keep the arguments alive until the end of the calls.
+      .def(
+          "server_call_async",
+          [](LibrarySupport_Py &support, serverlib::ServerLambda lambda,
+             clientlib::PublicArguments &publicArguments,
+             clientlib::EvaluationKeys &evaluationKeys) {
+            return callAsync([=, &publicArguments]() mutable {
+              return library_server_call(support, lambda, publicArguments,
+                                         evaluationKeys);
+            });
+          },
+          pybind11::keep_alive<0, 3>())
+      .def(
+          "server_call_async",
+          [](LibrarySupport_Py &support, serverlib::ServerLambda lambda,
+             clientlib::PublicArguments &publicArguments,
+             std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys>
+                 preparedKeys) {
+            return callAsync([=, &publicArguments]() {
+              return library_server_call(support, lambda, publicArguments,
+                                         preparedKeys);
+            });
+          },
+          pybind11::keep_alive<0, 3>())
       .def("get_shared_lib_path",
            [](LibrarySupport_Py &support) {
              return library_get_shared_lib_path(support);
@@ -213,7 +481,9 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
             auto optCache = cache == nullptr
                                 ? std::nullopt
                                 : std::optional<clientlib::KeySetCache>(*cache);
-            return key_set(clientParameters, optCache, seedMsb, seedLsb);
+            return withoutGIL([&]() {
+              return key_set(clientParameters, optCache, seedMsb, seedLsb);
+            });
           },
           pybind11::arg().none(false), pybind11::arg().none(true),
           pybind11::arg("seedMsb") = 0, pybind11::arg("seedLsb") = 0)
@@ -225,24 +495,32 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
                     for (auto i = 0u; i < args.size(); i++) {
                       argsRef.push_back(args[i].ptr.get());
                     }
-                    return encrypt_arguments(clientParameters, keySet, argsRef);
+                    return withoutGIL([&]() {
+                      return encrypt_arguments(clientParameters, keySet,
+                                               argsRef);
+                    });
                   })
-      .def_static("decrypt_result", [](clientlib::KeySet &keySet,
-                                       clientlib::PublicResult &publicResult) {
-        return decrypt_result(keySet, publicResult);
-      });
+      .def_static("decrypt_result",
+                  [](clientlib::KeySet &keySet,
+                     clientlib::PublicResult &publicResult) {
+                    return decrypt_result(keySet, publicResult);
+                  },
+                  pybind11::call_guard<pybind11::gil_scoped_release>());
   pybind11::class_<clientlib::KeySetCache>(m, "KeySetCache")
       .def(pybind11::init<std::string &>());
 
   pybind11::class_<mlir::concretelang::ClientParameters>(m, "ClientParameters")
       .def_static("deserialize",
                   [](const pybind11::bytes &buffer) {
-                    return clientParametersUnserialize(buffer);
+                    std::string json = buffer;
+                    return withoutGIL(
+                        [&]() { return clientParametersUnserialize(json); });
                   })
       .def("serialize",
            [](mlir::concretelang::ClientParameters &clientParameters) {
-             return pybind11::bytes(
-                 clientParametersSerialize(clientParameters));
+             return pybind11::bytes(withoutGIL([&]() {
+               return clientParametersSerialize(clientParameters);
+             }));
            })
       .def("output_signs",
            [](mlir::concretelang::ClientParameters &clientParameters) {
@@ -272,12 +550,15 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
   pybind11::class_<clientlib::KeySet>(m, "KeySet")
       .def_static("deserialize",
                   [](const pybind11::bytes &buffer) {
-                    std::unique_ptr<KeySet> result = keySetUnserialize(buffer);
+                    std::string str = buffer;
+                    std::unique_ptr<KeySet> result =
+                        withoutGIL([&]() { return keySetUnserialize(str); });
                     return result;
                   })
       .def("serialize",
            [](clientlib::KeySet &keySet) {
-             return pybind11::bytes(keySetSerialize(keySet));
+             return pybind11::bytes(
+                 withoutGIL([&]() { return keySetSerialize(keySet); }));
            })
       .def("client_parameters",
            [](clientlib::KeySet &keySet) { return keySet.clientParameters(); })
@@ -290,29 +571,73 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
       .def_static("deserialize",
                   [](mlir::concretelang::ClientParameters &clientParameters,
                      const pybind11::bytes &buffer) {
-                    return publicArgumentsUnserialize(clientParameters, buffer);
+                    std::string str = buffer;
+                    return withoutGIL([&]() {
+                      return publicArgumentsUnserialize(clientParameters, str);
+                    });
                   })
       .def("serialize", [](clientlib::PublicArguments &publicArgument) {
-        return pybind11::bytes(publicArgumentsSerialize(publicArgument));
+        return pybind11::bytes(withoutGIL(
+            [&]() { return publicArgumentsSerialize(publicArgument); }));
       });
   pybind11::class_<clientlib::PublicResult>(m, "PublicResult")
       .def_static("deserialize",
                   [](mlir::concretelang::ClientParameters &clientParameters,
                      const pybind11::bytes &buffer) {
-                    return publicResultUnserialize(clientParameters, buffer);
+                    std::string str = buffer;
+                    return withoutGIL([&]() {
+                      return publicResultUnserialize(clientParameters, str);
+                    });
                   })
       .def("serialize", [](clientlib::PublicResult &publicResult) {
-        return pybind11::bytes(publicResultSerialize(publicResult));
+        return pybind11::bytes(
+            withoutGIL([&]() { return publicResultSerialize(publicResult); }));
       });
 
   pybind11::class_<clientlib::EvaluationKeys>(m, "EvaluationKeys")
       .def_static("deserialize",
                   [](const pybind11::bytes &buffer) {
-                    return evaluationKeysUnserialize(buffer);
+                    std::string str = buffer;
+                    return withoutGIL(
+                        [&]() { return evaluationKeysUnserialize(str); });
                   })
-      .def("serialize", [](clientlib::EvaluationKeys &evaluationKeys) {
-        return pybind11::bytes(evaluationKeysSerialize(evaluationKeys));
-      });
+      .def("serialize",
+           [](clientlib::EvaluationKeys &evaluationKeys) {
+             return pybind11::bytes(withoutGIL(
+                 [&]() { return evaluationKeysSerialize(evaluationKeys); }));
+           })
+      .def(
+          "prepare",
+          [](clientlib::EvaluationKeys &evaluationKeys,
+             std::optional<std::string> sharedKeysPath) {
+            return prepare_evaluation_keys(evaluationKeys, sharedKeysPath);
+          },
+          pybind11::arg("shared_keys_path") = pybind11::none());
+
+  pybind11::class_<mlir::concretelang::PreparedEvaluationKeys,
+                   std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys>>(
+      m, "PreparedEvaluationKeys")
+      .def(
+          "wait",
+          [](mlir::concretelang::PreparedEvaluationKeys &preparedKeys) {
+            preparedKeys.wait();
+          },
+          pybind11::call_guard<pybind11::gil_scoped_release>())
+      .def("is_ready",
+           [](mlir::concretelang::PreparedEvaluationKeys &preparedKeys) {
+             return preparedKeys.isReady();
+           });
+
+  pybind11::class_<PublicResultFuture, std::shared_ptr<PublicResultFuture>>(
+      m, "PublicResultFuture")
+      .def(
+          "wait", [](PublicResultFuture &future) { future.wait(); },
+          pybind11::call_guard<pybind11::gil_scoped_release>())
+      .def("is_ready",
+           [](PublicResultFuture &future) { return future.isReady(); })
+      .def(
+          "get", [](PublicResultFuture &future) { return future.get(); },
+          pybind11::call_guard<pybind11::gil_scoped_release>());
 
   pybind11::class_<lambdaArgument>(m, "LambdaArgument")
       .def_static("from_tensor_u8",
@@ -347,6 +672,7 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
                   [](std::vector<int64_t> tensor, std::vector<int64_t> dims) {
                     return lambdaArgumentFromTensorI64(tensor, dims);
                   })
+      .def_static("from_array", &lambdaArgumentFromArray)
       .def_static("from_scalar", lambdaArgumentFromScalar)
       .def_static("from_signed_scalar", lambdaArgumentFromSignedScalar)
       .def("is_tensor",
@@ -361,6 +687,10 @@ void mlir::concretelang::python::populateCompilerAPISubmodule(
            [](lambdaArgument &lambda_arg) {
              return lambdaArgumentGetSignedTensorData(lambda_arg);
            })
+      .def("get_tensor_array",
+           [](lambdaArgument &lambda_arg) {
+             return lambdaArgumentGetTensorArray(lambda_arg);
+           })
       .def("get_tensor_shape",
            [](lambdaArgument &lambda_arg) {
              return lambdaArgumentGetTensorDimensions(lambda_arg);
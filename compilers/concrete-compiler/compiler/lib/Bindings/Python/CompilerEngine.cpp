@@ -13,6 +13,11 @@
 #include "concretelang/Support/JITSupport.h"
 #include "concretelang/Support/Jit.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #define GET_OR_THROW_LLVM_EXPECTED(VARNAME, EXPECTED)                          \
   auto VARNAME = EXPECTED;                                                     \
   if (auto err = VARNAME.takeError()) {                                        \
@@ -68,6 +73,15 @@ jit_server_call(JITSupport_Py support, mlir::concretelang::JITLambda &lambda,
   return std::move(*publicResult);
 }
 
+MLIR_CAPI_EXPORTED std::unique_ptr<concretelang::clientlib::PublicResult>
+jit_server_call(
+    JITSupport_Py support, mlir::concretelang::JITLambda &lambda,
+    concretelang::clientlib::PublicArguments &args,
+    std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys> preparedKeys) {
+  GET_OR_THROW_LLVM_EXPECTED(publicResult, lambda.call(args, preparedKeys));
+  return std::move(*publicResult);
+}
+
 // Library Support bindings ///////////////////////////////////////////////////
 MLIR_CAPI_EXPORTED LibrarySupport_Py
 library_support(const char *outputPath, const char *runtimeLibraryPath,
@@ -125,6 +139,16 @@ library_server_call(LibrarySupport_Py support,
   return std::move(*publicResult);
 }
 
+MLIR_CAPI_EXPORTED std::unique_ptr<concretelang::clientlib::PublicResult>
+library_server_call(
+    LibrarySupport_Py support, concretelang::serverlib::ServerLambda lambda,
+    concretelang::clientlib::PublicArguments &args,
+    std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys> preparedKeys) {
+  GET_OR_THROW_LLVM_EXPECTED(
+      publicResult, support.support.serverCall(lambda, args, preparedKeys));
+  return std::move(*publicResult);
+}
+
 MLIR_CAPI_EXPORTED std::string
 library_get_shared_lib_path(LibrarySupport_Py support) {
   return support.support.getSharedLibPath();
@@ -135,6 +159,142 @@ library_get_client_parameters_path(LibrarySupport_Py support) {
   return support.support.getClientParametersPath();
 }
 
+// Server Support bindings ///////////////////////////////////////////////////
+
+MLIR_CAPI_EXPORTED std::shared_ptr<mlir::concretelang::PreparedEvaluationKeys>
+prepare_evaluation_keys(concretelang::clientlib::EvaluationKeys &evaluationKeys,
+                        std::optional<std::string> sharedKeysPath) {
+  return concretelang::serverlib::ServerLambda::prepareEvaluationKeys(
+      evaluationKeys, sharedKeysPath);
+}
+
+std::unique_ptr<concretelang::clientlib::PublicResult>
+PublicResultFuture::get() {
+  if (!future.valid()) {
+    throw std::runtime_error("The result of the call was already retrieved");
+  }
+  return future.get();
+}
+
+namespace {
+/// The number of workers of the asynchronous server calls. Each call may
+/// already run on several threads, so the default is small.
+const unsigned DEFAULT_SERVER_CALL_WORKERS = 2;
+
+std::mutex serverCallWorkersMutex;
+unsigned serverCallWorkers = DEFAULT_SERVER_CALL_WORKERS;
+bool serverCallWorkersStarted = false;
+
+/// Returns the number of workers of the pool, which can no longer change.
+unsigned startServerCallWorkers() {
+  std::lock_guard<std::mutex> guard(serverCallWorkersMutex);
+  serverCallWorkersStarted = true;
+  return serverCallWorkers;
+}
+
+/// Pool of the workers running the asynchronous server calls, started by the
+/// first call.
+class ServerCallPool {
+public:
+  ServerCallPool(unsigned numWorkers) {
+    for (unsigned i = 0; i < numWorkers; i++) {
+      workers.emplace_back([this]() { work(); });
+    }
+  }
+
+  ~ServerCallPool() {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      stopping = true;
+    }
+    cv.notify_all();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+  }
+
+  void submit(std::function<void()> task) {
+    {
+      std::lock_guard<std::mutex> guard(mutex);
+      tasks.push_back(std::move(task));
+    }
+    cv.notify_one();
+  }
+
+  static ServerCallPool &get() {
+    static ServerCallPool pool(startServerCallWorkers());
+    return pool;
+  }
+
+private:
+  void work() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+        if (tasks.empty()) {
+          return;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool stopping = false;
+};
+} // namespace
+
+MLIR_CAPI_EXPORTED void set_server_call_workers(unsigned numWorkers) {
+  if (numWorkers == 0) {
+    throw std::invalid_argument(
+        "The number of workers of the server calls must be positive");
+  }
+  std::lock_guard<std::mutex> guard(serverCallWorkersMutex);
+  if (serverCallWorkersStarted) {
+    throw std::runtime_error("The workers of the asynchronous server calls "
+                             "already started");
+  }
+  serverCallWorkers = numWorkers;
+}
+
+MLIR_CAPI_EXPORTED std::shared_ptr<PublicResultFuture> server_call_async(
+    std::function<std::unique_ptr<concretelang::clientlib::PublicResult>()>
+        call) {
+  // The errors of the call are rethrown when retrieving its result.
+  auto task = std::make_shared<std::packaged_task<
+      std::unique_ptr<concretelang::clientlib::PublicResult>()>>(
+      std::move(call));
+  auto future = std::make_shared<PublicResultFuture>(task->get_future());
+  ServerCallPool::get().submit([task]() { (*task)(); });
+  return future;
+}
+
+MLIR_CAPI_EXPORTED std::string performance_counters() {
+  return concretelang::serverlib::ServerLambda::performanceCounters();
+}
+
+MLIR_CAPI_EXPORTED void reset_performance_counters() {
+  concretelang::serverlib::ServerLambda::resetPerformanceCounters();
+}
+
+MLIR_CAPI_EXPORTED void start_trace() {
+  concretelang::serverlib::ServerLambda::startTrace();
+}
+
+MLIR_CAPI_EXPORTED void stop_trace(std::string path) {
+  auto stopped = concretelang::serverlib::ServerLambda::stopTrace(path);
+  if (!stopped) {
+    throw std::runtime_error(stopped.error().mesg);
+  }
+}
+
 // Client Support bindings ///////////////////////////////////////////////////
 
 MLIR_CAPI_EXPORTED std::unique_ptr<concretelang::clientlib::KeySet>
@@ -3,6 +3,7 @@
 
 """Compiler submodule."""
 import atexit
+import json
 
 # pylint: disable=no-name-in-module,import-error
 from mlir._mlir_libs._concretelang._compiler import (
@@ -10,6 +11,13 @@ from mlir._mlir_libs._concretelang._compiler import (
     init_df_parallelization as _init_df_parallelization,
 )
 from mlir._mlir_libs._concretelang._compiler import round_trip as _round_trip
+from mlir._mlir_libs._concretelang._compiler import (
+    performance_counters as _performance_counters,
+    reset_performance_counters as _reset_performance_counters,
+    start_trace as _start_trace,
+    stop_trace as _stop_trace,
+    set_server_call_workers as _set_server_call_workers,
+)
 
 # pylint: enable=no-name-in-module,import-error
 
@@ -19,6 +27,7 @@ from .client_parameters import ClientParameters
 from .compilation_feedback import CompilationFeedback
 from .key_set import KeySet
 from .public_result import PublicResult
+from .public_result_future import PublicResultFuture
 from .public_arguments import PublicArguments
 from .jit_compilation_result import JITCompilationResult
 from .jit_lambda import JITLambda
@@ -29,6 +38,7 @@ from .client_support import ClientSupport
 from .jit_support import JITSupport
 from .library_support import LibrarySupport
 from .evaluation_keys import EvaluationKeys
+from .prepared_evaluation_keys import PreparedEvaluationKeys
 
 
 def init_dfr():
@@ -62,3 +72,63 @@ def round_trip(mlir_str: str) -> str:
     if not isinstance(mlir_str, str):
         raise TypeError(f"mlir_str must be of type str, not {type(mlir_str)}")
     return _round_trip(mlir_str)
+
+
+def performance_counters() -> dict:
+    """Get the performance counters of the runtime.
+
+    The counters hold, for each operation (keyswitch, bootstrap, ...), key and parameters, the
+    count of operations, their total duration and an histogram of their latencies in power of two
+    nanoseconds, as well as the memory allocated by the runtime.
+
+    Returns:
+        dict: performance counters
+    """
+    return json.loads(_performance_counters())
+
+
+def reset_performance_counters():
+    """Reset the performance counters of the runtime."""
+    _reset_performance_counters()
+
+
+def start_trace():
+    """Start recording a trace of the operations of the runtime."""
+    _start_trace()
+
+
+def stop_trace(path: str):
+    """Stop recording the trace and write it to a file.
+
+    The trace is written in the Chrome trace event format, which can be opened with Perfetto.
+
+    Args:
+        path (str): path of the trace file
+
+    Raises:
+        TypeError: if path is not of type str
+    """
+    if not isinstance(path, str):
+        raise TypeError(f"path must be of type str, not {type(path)}")
+    _stop_trace(path)
+
+
+def set_server_call_workers(num_workers: int):
+    """Set the number of workers running the asynchronous server calls, 2 by default.
+
+    Each server call may already run on several threads, so more workers mostly help small calls.
+    The workers start at the first asynchronous call, after which their number can't change.
+
+    Args:
+        num_workers (int): number of workers, which must be positive
+
+    Raises:
+        TypeError: if num_workers is not of type int
+        ValueError: if num_workers is not positive
+        RuntimeError: if an asynchronous call already started the workers
+    """
+    if not isinstance(num_workers, int):
+        raise TypeError(f"num_workers must be of type int, not {type(num_workers)}")
+    if num_workers <= 0:
+        raise ValueError(f"num_workers must be positive, not {num_workers}")
+    _set_server_call_workers(num_workers)
@@ -189,12 +189,9 @@ class ClientSupport(WrapperCpp):
             )
 
         if lambda_arg.is_tensor():
-            return np.array(
-                lambda_arg.get_signed_tensor_data()
-                if is_signed
-                else lambda_arg.get_tensor_data(),
-                dtype=(np.int64 if is_signed else np.uint64),
-            ).reshape(lambda_arg.get_tensor_shape())
+            return lambda_arg.get_tensor_array().astype(
+                np.int64 if is_signed else np.uint64, copy=False
+            )
 
         raise RuntimeError("unknown return type")
 
@@ -243,36 +240,6 @@ class ClientSupport(WrapperCpp):
             if signed:
                 return LambdaArgument.from_signed_scalar(value)
             return LambdaArgument.from_scalar(value)
-        if value.dtype == np.uint8:
-            return LambdaArgument.from_tensor_u8(
-                value.flatten().tolist(), list(value.shape)
-            )
-        if value.dtype == np.uint16:
-            return LambdaArgument.from_tensor_u16(
-                value.flatten().tolist(), list(value.shape)
-            )
-        if value.dtype == np.uint32:
-            return LambdaArgument.from_tensor_u32(
-                value.flatten().tolist(), list(value.shape)
-            )
-        if value.dtype == np.uint64:
-            return LambdaArgument.from_tensor_u64(
-                value.flatten().tolist(), list(value.shape)
-            )
-        if value.dtype == np.int8:
-            return LambdaArgument.from_tensor_i8(
-                value.flatten().tolist(), list(value.shape)
-            )
-        if value.dtype == np.int16:
-            return LambdaArgument.from_tensor_i16(
-                value.flatten().tolist(), list(value.shape)
-            )
-        if value.dtype == np.int32:
-            return LambdaArgument.from_tensor_i32(
-                value.flatten().tolist(), list(value.shape)
-            )
-        if value.dtype == np.int64:
-            return LambdaArgument.from_tensor_i64(
-                value.flatten().tolist(), list(value.shape)
-            )
-        raise TypeError("numpy.array must be of dtype (u)int{8,16,32,64}")
+        # the lambda argument borrows the values of the array, which are only
+        # copied if they aren't contiguous
+        return LambdaArgument.from_array(np.ascontiguousarray(value))
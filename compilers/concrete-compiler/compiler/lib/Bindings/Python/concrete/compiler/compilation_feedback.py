@@ -38,8 +38,25 @@ class CompilationFeedback(WrapperCpp):
         self.total_keyswitch_keys_size = compilation_feedback.total_keyswitch_keys_size
         self.total_inputs_size = compilation_feedback.total_inputs_size
         self.total_output_size = compilation_feedback.total_output_size
+        self.deduplicated_keyswitches = compilation_feedback.deduplicated_keyswitches
+        self.peak_intermediate_buffers_size = (
+            compilation_feedback.peak_intermediate_buffers_size
+        )
         self.crt_decompositions_of_outputs = (
             compilation_feedback.crt_decompositions_of_outputs
         )
+        self.operation_statistics = [
+            {
+                "operation": statistic.operation,
+                "location": statistic.location,
+                "key_index": statistic.key_index,
+                "count": statistic.count,
+                "complexity": statistic.complexity,
+                "complexity_share": statistic.complexity_share,
+            }
+            for statistic in compilation_feedback.operation_statistics
+        ]
+        self.peak_ciphertexts_size = compilation_feedback.peak_ciphertexts_size
+        self.critical_path_complexity = compilation_feedback.critical_path_complexity
 
         super().__init__(compilation_feedback)
@@ -3,6 +3,8 @@
 
 """CompilationOptions."""
 
+from typing import List
+
 # pylint: disable=no-name-in-module,import-error
 from mlir._mlir_libs._concretelang._compiler import (
     CompilationOptions as _CompilationOptions,
@@ -123,6 +125,167 @@ class CompilationOptions(WrapperCpp):
             raise TypeError("can't set the option to a non-boolean value")
         self.cpp().set_optimize_concrete(optimize)
 
+    def set_compose_luts(self, compose_luts: bool):
+        """Set flag to enable/disable composition of lookup tables.
+
+        Chains of lookup tables, and the leveled operations with clear constants around them,
+        are evaluated with a single lookup table.
+
+        Args:
+            compose_luts (bool): whether to turn it on or off
+
+        Raises:
+            TypeError: if the value to set is not boolean
+        """
+        if not isinstance(compose_luts, bool):
+            raise TypeError("can't set the option to a non-boolean value")
+        self.cpp().set_compose_luts(compose_luts)
+
+    def set_many_lut(self, many_lut: bool):
+        """Set flag to enable/disable grouping of lookup tables into many-LUT bootstraps.
+
+        Lookup tables applied on the same input are evaluated with a single bootstrap.
+
+        Args:
+            many_lut (bool): whether to turn it on or off
+
+        Raises:
+            TypeError: if the value to set is not boolean
+        """
+        if not isinstance(many_lut, bool):
+            raise TypeError("can't set the option to a non-boolean value")
+        self.cpp().set_many_lut(many_lut)
+
+    def set_round_lut_max_precision(self, max_precision: int):
+        """Set the maximal precision of the lookup tables used to round.
+
+        Roundings are evaluated with lookup tables of at most `max_precision` bits when it needs
+        fewer bootstraps than discarding the rounded bits one by one. Only the precisions of the
+        lookup tables already in the circuit are used, so that the parameters are not raised.
+
+        Args:
+            max_precision (int): maximal precision of the lookup tables, 0 (the default) to never
+                use them
+
+        Raises:
+            TypeError: if the value to set is not int
+            ValueError: if the value to set is negative
+        """
+        if not isinstance(max_precision, int):
+            raise TypeError("can't set max_precision to a non-int value")
+        if max_precision < 0:
+            raise ValueError("max_precision must be positive or zero")
+        self.cpp().set_round_lut_max_precision(max_precision)
+
+    def set_plan_memory(self, plan_memory: bool):
+        """Set flag to enable/disable planning of the memory of intermediate buffers.
+
+        The intermediate buffers of a circuit are placed in a single arena per call, the buffers
+        which are not live at the same time sharing the same memory.
+
+        Args:
+            plan_memory (bool): whether to turn it on or off
+
+        Raises:
+            TypeError: if the value to set is not boolean
+        """
+        if not isinstance(plan_memory, bool):
+            raise TypeError("can't set the option to a non-boolean value")
+        self.cpp().set_plan_memory(plan_memory)
+
+    def set_output_modulus_switching(self, output_modulus_switching: bool):
+        """Set flag to enable/disable the switch of the modulus of the encrypted outputs.
+
+        The encrypted outputs are switched to the smallest modulus keeping their decryption
+        correct when serialized, reducing the size of the serialized results.
+
+        Args:
+            output_modulus_switching (bool): whether to turn it on or off
+
+        Raises:
+            TypeError: if the value to set is not boolean
+        """
+        if not isinstance(output_modulus_switching, bool):
+            raise TypeError("can't set the option to a non-boolean value")
+        self.cpp().set_output_modulus_switching(output_modulus_switching)
+
+    def set_output_packing(self, output_packing: bool):
+        """Set flag to enable/disable the packing of the encrypted outputs.
+
+        The ciphertexts of the encrypted outputs are packed in GLWE ciphertexts, each holding
+        up to a polynomial size of them, reducing the size of the results sent to the client.
+
+        Args:
+            output_packing (bool): whether to turn it on or off
+
+        Raises:
+            TypeError: if the value to set is not boolean
+        """
+        if not isinstance(output_packing, bool):
+            raise TypeError("can't set the option to a non-boolean value")
+        self.cpp().set_output_packing(output_packing)
+
+    def set_inline_leveled_ops(self, inline_leveled_ops: bool):
+        """Set flag to enable/disable the inlining of the leveled operations.
+
+        The leveled operations on ciphertexts are lowered to loops, fused with each other and
+        vectorized with the rest of the circuit, instead of calls to the runtime.
+
+        Args:
+            inline_leveled_ops (bool): whether to turn it on or off
+
+        Raises:
+            TypeError: if the value to set is not boolean
+        """
+        if not isinstance(inline_leveled_ops, bool):
+            raise TypeError("can't set the option to a non-boolean value")
+        self.cpp().set_inline_leveled_ops(inline_leveled_ops)
+
+    def set_target_cpu(self, cpu: str):
+        """Set the CPU targeted by the code of the libraries.
+
+        "native" targets the CPU of the host with all its features, and "generic" a baseline CPU
+        of the host architecture. The JIT always targets the host.
+
+        Args:
+            cpu (str): name of the CPU, e.g. "native", "generic" or "skylake-avx512"
+
+        Raises:
+            TypeError: if the value to set is not str
+        """
+        if not isinstance(cpu, str):
+            raise TypeError("can't set the target cpu to a non-str value")
+        self.cpp().set_target_cpu(cpu)
+
+    def set_target_features(self, features: str):
+        """Set the features targeted by the code of the libraries on top of the ones of the CPU.
+
+        Args:
+            features (str): comma separated features, e.g. "+avx2,-avx512f"
+
+        Raises:
+            TypeError: if the value to set is not str
+        """
+        if not isinstance(features, str):
+            raise TypeError("can't set the target features to a non-str value")
+        self.cpp().set_target_features(features)
+
+    def set_target_cpu_versions(self, cpus: List[str]):
+        """Set the CPUs for which an additional version of the functions of the libraries is generated.
+
+        The version for the most capable CPU supported by the host is called at run time, or the
+        version for the target CPU if none is supported.
+
+        Args:
+            cpus (List[str]): CPUs among "x86-64-v2", "x86-64-v3" and "x86-64-v4"
+
+        Raises:
+            TypeError: if the value to set is not a list of str
+        """
+        if not isinstance(cpus, list) or not all(isinstance(cpu, str) for cpu in cpus):
+            raise TypeError("can't set the target cpu versions to a non-list of str value")
+        self.cpp().set_target_cpu_versions(cpus)
+
     def set_funcname(self, funcname: str):
         """Set entrypoint function name.
 
@@ -211,3 +374,22 @@ class CompilationOptions(WrapperCpp):
         if not isinstance(security_level, int):
             raise TypeError("can't set security_level to a non-int value")
         self.cpp().set_security_level(security_level)
+
+    def set_multi_bit_grouping_factor(self, grouping_factor: int):
+        """Set the grouping factor of the multi bit bootstrap keys.
+
+        Each external product of the bootstraps processes `grouping_factor` elements of the
+        mask, 1 being the classic bootstrap.
+
+        Args:
+            grouping_factor (int): number of mask elements processed by each external product
+
+        Raises:
+            TypeError: if the value to set is not int
+            ValueError: if the value to set is not in interval [1; 4]
+        """
+        if not isinstance(grouping_factor, int):
+            raise TypeError("can't set grouping_factor to a non-int value")
+        if not 1 <= grouping_factor <= 4:
+            raise ValueError("grouping_factor must be in interval [1; 4]")
+        self.cpp().set_multi_bit_grouping_factor(grouping_factor)
@@ -3,12 +3,15 @@
 
 """EvaluationKeys."""
 
+from typing import Optional
+
 # pylint: disable=no-name-in-module,import-error
 from mlir._mlir_libs._concretelang._compiler import (
     EvaluationKeys as _EvaluationKeys,
 )
 
 # pylint: enable=no-name-in-module,import-error
+from .prepared_evaluation_keys import PreparedEvaluationKeys
 from .wrapper import WrapperCpp
 
 
@@ -40,6 +43,26 @@ class EvaluationKeys(WrapperCpp):
         """
         return self.cpp().serialize()
 
+    def prepare(self, shared_keys_path: Optional[str] = None) -> PreparedEvaluationKeys:
+        """Start the preparation of the EvaluationKeys for execution in background.
+
+        Args:
+            shared_keys_path (Optional[str]): directory (e.g. /dev/shm or a hugetlbfs
+                mount point) where the prepared keys are shared with the other processes
+                of the host, the keys are private to the process if None
+
+        Raises:
+            TypeError: if shared_keys_path is not of type str or None
+
+        Returns:
+            PreparedEvaluationKeys: handle on the keys being prepared
+        """
+        if shared_keys_path is not None and not isinstance(shared_keys_path, str):
+            raise TypeError(
+                f"shared_keys_path must be of type str or None, not {type(shared_keys_path)}"
+            )
+        return PreparedEvaluationKeys.wrap(self.cpp().prepare(shared_keys_path))
+
     @staticmethod
     def deserialize(serialized_evaluation_keys: bytes) -> "EvaluationKeys":
         """Unserialize EvaluationKeys from bytes.
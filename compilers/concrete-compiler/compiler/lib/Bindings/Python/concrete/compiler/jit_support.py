@@ -7,7 +7,7 @@ Just-in-time compilation provide a way to compile and execute an MLIR program wh
 code in memory.
 """
 
-from typing import Optional
+from typing import Optional, Union
 
 # pylint: disable=no-name-in-module,import-error
 from mlir._mlir_libs._concretelang._compiler import (
@@ -23,8 +23,10 @@ from .compilation_feedback import CompilationFeedback
 from .jit_lambda import JITLambda
 from .public_arguments import PublicArguments
 from .public_result import PublicResult
+from .public_result_future import PublicResultFuture
 from .wrapper import WrapperCpp
 from .evaluation_keys import EvaluationKeys
+from .prepared_evaluation_keys import PreparedEvaluationKeys
 
 
 class JITSupport(WrapperCpp):
@@ -166,19 +168,20 @@ class JITSupport(WrapperCpp):
         self,
         jit_lambda: JITLambda,
         public_arguments: PublicArguments,
-        evaluation_keys: EvaluationKeys,
+        evaluation_keys: Union[EvaluationKeys, PreparedEvaluationKeys],
     ) -> PublicResult:
         """Call the JITLambda with public_arguments.
 
         Args:
             jit_lambda (JITLambda): A server lambda to call.
             public_arguments (PublicArguments): The arguments of the call.
-            evaluation_keys (EvaluationKeys): Evalutation keys of the call.
+            evaluation_keys (Union[EvaluationKeys, PreparedEvaluationKeys]): Evalutation keys
+                of the call.
 
         Raises:
             TypeError: if jit_lambda is not of type JITLambda
             TypeError: if public_arguments is not of type PublicArguments
-            TypeError: if evaluation_keys is not of type EvaluationKeys
+            TypeError: if evaluation_keys is not of type EvaluationKeys or PreparedEvaluationKeys
 
         Returns:
             PublicResult: the result of the call of the server lambda.
@@ -191,12 +194,54 @@ class JITSupport(WrapperCpp):
             raise TypeError(
                 f"public_arguments must be of type PublicArguments, not {type(public_arguments)}"
             )
-        if not isinstance(evaluation_keys, EvaluationKeys):
+        if not isinstance(evaluation_keys, (EvaluationKeys, PreparedEvaluationKeys)):
             raise TypeError(
-                f"evaluation_keys must be of type EvaluationKeys, not {type(evaluation_keys)}"
+                f"evaluation_keys must be of type EvaluationKeys or PreparedEvaluationKeys, "
+                f"not {type(evaluation_keys)}"
             )
         return PublicResult.wrap(
             self.cpp().server_call(
                 jit_lambda.cpp(), public_arguments.cpp(), evaluation_keys.cpp()
             )
         )
+
+    def server_call_async(
+        self,
+        jit_lambda: JITLambda,
+        public_arguments: PublicArguments,
+        evaluation_keys: Union[EvaluationKeys, PreparedEvaluationKeys],
+    ) -> PublicResultFuture:
+        """Call the JITLambda with public_arguments asynchronously.
+
+        Args:
+            jit_lambda (JITLambda): A server lambda to call.
+            public_arguments (PublicArguments): The arguments of the call.
+            evaluation_keys (Union[EvaluationKeys, PreparedEvaluationKeys]): Evalutation keys
+                of the call.
+
+        Raises:
+            TypeError: if jit_lambda is not of type JITLambda
+            TypeError: if public_arguments is not of type PublicArguments
+            TypeError: if evaluation_keys is not of type EvaluationKeys or PreparedEvaluationKeys
+
+        Returns:
+            PublicResultFuture: the future of the result of the call of the server lambda.
+        """
+        if not isinstance(jit_lambda, JITLambda):
+            raise TypeError(
+                f"jit_lambda must be of type JITLambda, not {type(jit_lambda)}"
+            )
+        if not isinstance(public_arguments, PublicArguments):
+            raise TypeError(
+                f"public_arguments must be of type PublicArguments, not {type(public_arguments)}"
+            )
+        if not isinstance(evaluation_keys, (EvaluationKeys, PreparedEvaluationKeys)):
+            raise TypeError(
+                f"evaluation_keys must be of type EvaluationKeys or PreparedEvaluationKeys, "
+                f"not {type(evaluation_keys)}"
+            )
+        return PublicResultFuture.wrap(
+            self.cpp().server_call_async(
+                jit_lambda.cpp(), public_arguments.cpp(), evaluation_keys.cpp()
+            )
+        )
@@ -4,6 +4,8 @@
 """LambdaArgument."""
 from typing import List
 
+import numpy as np
+
 # pylint: disable=no-name-in-module,import-error
 from mlir._mlir_libs._concretelang._compiler import (
     LambdaArgument as _LambdaArgument,
@@ -185,6 +187,27 @@ class LambdaArgument(WrapperCpp):
         """
         return LambdaArgument.wrap(_LambdaArgument.from_tensor_i64(data, shape))
 
+    @staticmethod
+    def from_array(array: np.ndarray) -> "LambdaArgument":
+        """Build a LambdaArgument containing the given tensor, without copying its values.
+
+        The LambdaArgument borrows the memory of the array, which it keeps alive, so the array
+        shouldn't be modified as long as the LambdaArgument is in use.
+
+        Args:
+            array (np.ndarray): C-contiguous array of dtype (u)int{8,16,32,64}
+
+        Raises:
+            TypeError: if array is not a numpy.ndarray, or is of an unsupported dtype
+            ValueError: if array is not C-contiguous, or has no dimension
+
+        Returns:
+            LambdaArgument
+        """
+        if not isinstance(array, np.ndarray):
+            raise TypeError(f"array must be of type numpy.ndarray, not {type(array)}")
+        return LambdaArgument.wrap(_LambdaArgument.from_array(array))
+
     def is_signed(self) -> bool:
         """Check if the contained argument is signed.
 
@@ -233,6 +256,14 @@ class LambdaArgument(WrapperCpp):
         """
         return self.cpp().get_tensor_shape()
 
+    def get_tensor_array(self) -> np.ndarray:
+        """Return the contained tensor as a numpy array viewing its values, without copying them.
+
+        Returns:
+            np.ndarray: array of the dtype of the tensor values, keeping the LambdaArgument alive
+        """
+        return self.cpp().get_tensor_array()
+
     def get_tensor_data(self) -> List[int]:
         """Return the contained flattened tensor data.
 
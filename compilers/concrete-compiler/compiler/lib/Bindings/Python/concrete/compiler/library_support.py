@@ -7,7 +7,7 @@ Library support provides a way to compile an MLIR program into a library that ca
 to execute the compiled code.
 """
 import os
-from typing import Optional
+from typing import Optional, Union
 
 # pylint: disable=no-name-in-module,import-error
 from mlir._mlir_libs._concretelang._compiler import (
@@ -20,11 +20,13 @@ from .library_compilation_result import LibraryCompilationResult
 from .public_arguments import PublicArguments
 from .library_lambda import LibraryLambda
 from .public_result import PublicResult
+from .public_result_future import PublicResultFuture
 from .client_parameters import ClientParameters
 from .compilation_feedback import CompilationFeedback
 from .wrapper import WrapperCpp
 from .utils import lookup_runtime_lib
 from .evaluation_keys import EvaluationKeys
+from .prepared_evaluation_keys import PreparedEvaluationKeys
 
 
 # Default output path for compilation artifacts
@@ -241,19 +243,20 @@ class LibrarySupport(WrapperCpp):
         self,
         library_lambda: LibraryLambda,
         public_arguments: PublicArguments,
-        evaluation_keys: EvaluationKeys,
+        evaluation_keys: Union[EvaluationKeys, PreparedEvaluationKeys],
     ) -> PublicResult:
         """Call the library with public_arguments.
 
         Args:
             library_lambda (LibraryLambda): reference to the compiled library
             public_arguments (PublicArguments): arguments to use for execution
-            evaluation_keys (EvaluationKeys): evaluation keys to use for execution
+            evaluation_keys (Union[EvaluationKeys, PreparedEvaluationKeys]): evaluation keys
+                to use for execution
 
         Raises:
             TypeError: if library_lambda is not of type LibraryLambda
             TypeError: if public_arguments is not of type PublicArguments
-            TypeError: if evaluation_keys is not of type EvaluationKeys
+            TypeError: if evaluation_keys is not of type EvaluationKeys or PreparedEvaluationKeys
 
         Returns:
             PublicResult: result of the execution
@@ -266,9 +269,10 @@ class LibrarySupport(WrapperCpp):
             raise TypeError(
                 f"public_arguments must be of type PublicArguments, not {type(public_arguments)}"
             )
-        if not isinstance(evaluation_keys, EvaluationKeys):
+        if not isinstance(evaluation_keys, (EvaluationKeys, PreparedEvaluationKeys)):
             raise TypeError(
-                f"evaluation_keys must be of type EvaluationKeys, not {type(evaluation_keys)}"
+                f"evaluation_keys must be of type EvaluationKeys or PreparedEvaluationKeys, "
+                f"not {type(evaluation_keys)}"
             )
         return PublicResult.wrap(
             self.cpp().server_call(
@@ -278,6 +282,49 @@ class LibrarySupport(WrapperCpp):
             )
         )
 
+    def server_call_async(
+        self,
+        library_lambda: LibraryLambda,
+        public_arguments: PublicArguments,
+        evaluation_keys: Union[EvaluationKeys, PreparedEvaluationKeys],
+    ) -> PublicResultFuture:
+        """Call the library with public_arguments asynchronously.
+
+        Args:
+            library_lambda (LibraryLambda): reference to the compiled library
+            public_arguments (PublicArguments): arguments to use for execution
+            evaluation_keys (Union[EvaluationKeys, PreparedEvaluationKeys]): evaluation keys
+                to use for execution
+
+        Raises:
+            TypeError: if library_lambda is not of type LibraryLambda
+            TypeError: if public_arguments is not of type PublicArguments
+            TypeError: if evaluation_keys is not of type EvaluationKeys or PreparedEvaluationKeys
+
+        Returns:
+            PublicResultFuture: future of the result of the execution
+        """
+        if not isinstance(library_lambda, LibraryLambda):
+            raise TypeError(
+                f"library_lambda must be of type LibraryLambda, not {type(library_lambda)}"
+            )
+        if not isinstance(public_arguments, PublicArguments):
+            raise TypeError(
+                f"public_arguments must be of type PublicArguments, not {type(public_arguments)}"
+            )
+        if not isinstance(evaluation_keys, (EvaluationKeys, PreparedEvaluationKeys)):
+            raise TypeError(
+                f"evaluation_keys must be of type EvaluationKeys or PreparedEvaluationKeys, "
+                f"not {type(evaluation_keys)}"
+            )
+        return PublicResultFuture.wrap(
+            self.cpp().server_call_async(
+                library_lambda.cpp(),
+                public_arguments.cpp(),
+                evaluation_keys.cpp(),
+            )
+        )
+
     def get_shared_lib_path(self) -> str:
         """Get the path where the shared library is expected to be.
 
@@ -0,0 +1,49 @@
+#  Part of the Concrete Compiler Project, under the BSD3 License with Zama Exceptions.
+#  See https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt for license information.
+
+"""PreparedEvaluationKeys."""
+
+# pylint: disable=no-name-in-module,import-error
+from mlir._mlir_libs._concretelang._compiler import (
+    PreparedEvaluationKeys as _PreparedEvaluationKeys,
+)
+
+# pylint: enable=no-name-in-module,import-error
+from .wrapper import WrapperCpp
+
+
+class PreparedEvaluationKeys(WrapperCpp):
+    """
+    EvaluationKeys ready for execution on the server.
+
+    The bootstrap keys are converted to the fourier domain in background, a call made while the
+    conversion is in flight only waits for the keys it uses.
+    """
+
+    def __init__(self, prepared_evaluation_keys: _PreparedEvaluationKeys):
+        """Wrap the native Cpp object.
+
+        Args:
+            prepared_evaluation_keys (_PreparedEvaluationKeys): object to wrap
+
+        Raises:
+            TypeError: if prepared_evaluation_keys is not of type _PreparedEvaluationKeys
+        """
+        if not isinstance(prepared_evaluation_keys, _PreparedEvaluationKeys):
+            raise TypeError(
+                f"prepared_evaluation_keys must be of type _PreparedEvaluationKeys, "
+                f"not {type(prepared_evaluation_keys)}"
+            )
+        super().__init__(prepared_evaluation_keys)
+
+    def wait(self):
+        """Wait for the end of the preparation of all the keys."""
+        self.cpp().wait()
+
+    def is_ready(self) -> bool:
+        """Check if the preparation of all the keys is done.
+
+        Returns:
+            bool: True if all the keys are ready
+        """
+        return self.cpp().is_ready()
@@ -0,0 +1,63 @@
+#  Part of the Concrete Compiler Project, under the BSD3 License with Zama Exceptions.
+#  See https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt for license information.
+
+"""PublicResultFuture."""
+
+# pylint: disable=no-name-in-module,import-error
+from mlir._mlir_libs._concretelang._compiler import (
+    PublicResultFuture as _PublicResultFuture,
+)
+
+# pylint: enable=no-name-in-module,import-error
+from .public_result import PublicResult
+from .wrapper import WrapperCpp
+
+
+class PublicResultFuture(WrapperCpp):
+    """
+    Future of the PublicResult of a server call running asynchronously.
+
+    The call runs on a pool of native workers, without holding the GIL. Dropping the future
+    waits for the end of the call.
+    """
+
+    def __init__(self, public_result_future: _PublicResultFuture):
+        """Wrap the native Cpp object.
+
+        Args:
+            public_result_future (_PublicResultFuture): object to wrap
+
+        Raises:
+            TypeError: if public_result_future is not of type _PublicResultFuture
+        """
+        if not isinstance(public_result_future, _PublicResultFuture):
+            raise TypeError(
+                f"public_result_future must be of type _PublicResultFuture, "
+                f"not {type(public_result_future)}"
+            )
+        super().__init__(public_result_future)
+
+    def wait(self):
+        """Wait for the end of the call."""
+        self.cpp().wait()
+
+    def done(self) -> bool:
+        """Check if the call is done.
+
+        Returns:
+            bool: True if the call is done
+        """
+        return self.cpp().is_ready()
+
+    def result(self) -> PublicResult:
+        """Get the result of the call, waiting for it if needed.
+
+        The result can only be retrieved once.
+
+        Raises:
+            RuntimeError: if the call failed, or if the result was already retrieved
+
+        Returns:
+            PublicResult: result of the call
+        """
+        return PublicResult.wrap(self.cpp().get())
@@ -1082,6 +1082,14 @@ impl CompilationFeedback {
     pub fn total_outputs_size(&self) -> u64 {
         unsafe { ffi::compilationFeedbackGetTotalOutputsSize(self._c) }
     }
+
+    pub fn deduplicated_keyswitches(&self) -> u64 {
+        unsafe { ffi::compilationFeedbackGetDeduplicatedKeyswitches(self._c) }
+    }
+
+    pub fn peak_intermediate_buffers_size(&self) -> u64 {
+        unsafe { ffi::compilationFeedbackGetPeakIntermediateBuffersSize(self._c) }
+    }
 }
 
 /// Parse the MLIR code and returns it.
@@ -779,6 +779,16 @@ uint64_t compilationFeedbackGetTotalOutputsSize(CompilationFeedback feedback) {
   return unwrap(feedback)->totalOutputsSize;
 }
 
+uint64_t
+compilationFeedbackGetDeduplicatedKeyswitches(CompilationFeedback feedback) {
+  return unwrap(feedback)->deduplicatedKeyswitches;
+}
+
+uint64_t compilationFeedbackGetPeakIntermediateBuffersSize(
+    CompilationFeedback feedback) {
+  return unwrap(feedback)->peakIntermediateBuffersSize;
+}
+
 void compilationFeedbackDestroy(CompilationFeedback feedback) {
   C_STRUCT_CLEANER(feedback)
 }
@@ -3,6 +3,7 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <algorithm>
 #include <cstddef>
 #include <stdio.h>
 
@@ -94,6 +95,80 @@ uint64_t decode(uint64_t val, uint64_t modulus) {
   result = result / ((__uint128_t)(1) << 64);
   return (uint64_t)result % modulus;
 }
+
+void encodeLutForWopPBS(uint64_t *output, const uint64_t *lut,
+                        uint64_t lutSize, std::vector<int64_t> moduli,
+                        std::vector<int64_t> bits, uint64_t product,
+                        bool isSigned) {
+  uint64_t logLutCrtSize = 0;
+  for (auto bitsCount : bits) {
+    logLutCrtSize += bitsCount;
+  }
+  uint64_t lutCrtSize = uint64_t(1) << logLutCrtSize;
+
+  // Initialize lut cases not supposed to be reached
+  std::fill(output, output + moduli.size() * lutCrtSize, 0);
+
+  for (uint64_t inIndex = 0; inIndex < lutSize; inIndex++) {
+    // When the woppbs is executed on encrypted signed integers, the index of
+    // the lut elements must be adapted to fit the way signed are encrypted in
+    // CRT (to ensure the lookup falls into the proper case).
+    //
+    // When not signed, the integer values are encoded in increasing order.
+    // That is (example of 9 bits values, using crt decomposition [5,7,16]):
+    //
+    // |0     511|
+    // |---------|
+    // |0     511|
+    //
+    // is encoded as
+    //
+    // |0   511|  INVALID  |
+    // |-------|-----------|
+    // |0   511|512     559|
+    //
+    // Where on top are represented the semantic values, and below, the actual
+    // encoding of values, either on uint64_t or as increasing crt values. As
+    // a consequence, there is nothing particular to do to map the index of
+    // the input lut to an index of the output lut.
+    //
+    // When signed, the integer values are encoded in a way that resembles 2s
+    // complement. That is (example of 9 bits values, using crt decomposition
+    // [5,7,16]):
+    //
+    // |0     255|-256    -1|
+    // |---------|----------|
+    // |0     255|256    511|
+    //
+    // is encoded as
+    //
+    // |0     255|   INVALID   |-256    -1|
+    // |---------|-------------|----------|
+    // |0     255|256       303|304    559|
+    //
+    // As a consequence, to map the index of the input lut to an index of the
+    // output lut we must take care of crossing the invalid range in between
+    // positive values and negative values.
+    uint64_t plaintext = inIndex;
+    if (isSigned && plaintext >= lutSize / 2) {
+      plaintext += product - lutSize;
+    }
+
+    uint64_t outIndex = 0;
+    uint64_t totalBitCount = 0;
+    for (size_t block = 0; block < moduli.size(); block++) {
+      uint64_t modulus = moduli[block];
+      outIndex += (((plaintext % modulus) << bits[block]) / modulus)
+                  << totalBitCount;
+      totalBitCount += bits[block];
+    }
+
+    for (size_t block = 0; block < moduli.size(); block++) {
+      output[block * lutCrtSize + outIndex] =
+          encode(lut[inIndex], moduli[block], product);
+    }
+  }
+}
 } // namespace crt
 } // namespace clientlib
 } // namespace concretelang
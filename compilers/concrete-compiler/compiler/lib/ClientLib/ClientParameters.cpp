@@ -31,7 +31,7 @@ void LweSecretKeyParam::hash(size_t &seed) { hash_(seed, dimension); }
 
 void BootstrapKeyParam::hash(size_t &seed) {
   hash_(seed, inputSecretKeyID, outputSecretKeyID, level, baseLog,
-        glweDimension, double_to_bits(variance));
+        glweDimension, double_to_bits(variance), groupingFactor);
 }
 
 void KeyswitchKeyParam::hash(size_t &seed) {
@@ -43,6 +43,10 @@ void PackingKeyswitchKeyParam::hash(size_t &seed) {
   hash_(seed, inputSecretKeyID, outputSecretKeyID, level, baseLog,
         glweDimension, polynomialSize, inputLweDimension,
         double_to_bits(variance));
+  // Only hashed when set to keep the hash of the existing keys
+  if (packingOnly) {
+    hash_(seed, packingOnly);
+  }
 }
 
 std::size_t ClientParameters::hash() {
@@ -85,6 +89,7 @@ llvm::json::Value toJSON(const BootstrapKeyParam &v) {
       {"variance", v.variance},
       {"polynomialSize", v.polynomialSize},
       {"inputLweDimension", v.inputLweDimension},
+      {"groupingFactor", v.groupingFactor},
   };
   return object;
 }
@@ -98,7 +103,8 @@ bool fromJSON(const llvm::json::Value j, BootstrapKeyParam &v,
          O.map("glweDimension", v.glweDimension) &&
          O.map("variance", v.variance) &&
          O.map("polynomialSize", v.polynomialSize) &&
-         O.map("inputLweDimension", v.inputLweDimension);
+         O.map("inputLweDimension", v.inputLweDimension) &&
+         O.mapOptional("groupingFactor", v.groupingFactor);
 }
 
 llvm::json::Value toJSON(const KeyswitchKeyParam &v) {
@@ -131,6 +137,9 @@ llvm::json::Value toJSON(const PackingKeyswitchKeyParam &v) {
       {"inputLweDimension", v.inputLweDimension},
       {"variance", v.variance},
   };
+  if (v.packingOnly) {
+    object.insert({"packingOnly", v.packingOnly});
+  }
   return object;
 }
 bool fromJSON(const llvm::json::Value j, PackingKeyswitchKeyParam &v,
@@ -143,7 +152,8 @@ bool fromJSON(const llvm::json::Value j, PackingKeyswitchKeyParam &v,
          O.map("glweDimension", v.glweDimension) &&
          O.map("polynomialSize", v.polynomialSize) &&
          O.map("inputLweDimension", v.inputLweDimension) &&
-         O.map("variance", v.variance);
+         O.map("variance", v.variance) &&
+         O.mapOptional("packingOnly", v.packingOnly);
 }
 
 llvm::json::Value toJSON(const CircuitGateShape &v) {
@@ -190,13 +200,21 @@ llvm::json::Value toJSON(const EncryptionGate &v) {
       {"variance", v.variance},
       {"encoding", v.encoding},
   };
+  if (v.modulusLog.has_value()) {
+    object.insert({"modulusLog", *v.modulusLog});
+  }
+  if (v.packingKeyID.has_value()) {
+    object.insert({"packingKeyID", *v.packingKeyID});
+  }
   return object;
 }
 bool fromJSON(const llvm::json::Value j, EncryptionGate &v,
               llvm::json::Path p) {
   llvm::json::ObjectMapper O(j, p);
   return O && O.map("secretKeyID", v.secretKeyID) &&
-         O.map("variance", v.variance) && O.map("encoding", v.encoding);
+         O.map("variance", v.variance) && O.map("encoding", v.encoding) &&
+         O.mapOptional("modulusLog", v.modulusLog) &&
+         O.mapOptional("packingKeyID", v.packingKeyID);
 }
 
 llvm::json::Value toJSON(const CircuitGate &v) {
@@ -114,6 +114,21 @@ LweBootstrapKey::LweBootstrapKey(BootstrapKeyParam &parameters,
     : _parameters(parameters) {
   // TODO
   size_t polynomial_size = outputKey.dimension() / _parameters.glweDimension;
+  if (_parameters.groupingFactor > 1) {
+    assert(inputKey.dimension() % _parameters.groupingFactor == 0);
+    auto size = concrete_cpu_multi_bit_bootstrap_key_size_u64(
+        _parameters.level, _parameters.glweDimension, polynomial_size,
+        inputKey.dimension(), _parameters.groupingFactor);
+    _buffer = std::make_shared<std::vector<uint64_t>>();
+    _buffer->resize(size);
+
+    concrete_cpu_init_lwe_multi_bit_bootstrap_key_u64(
+        _buffer->data(), inputKey.buffer(), outputKey.buffer(),
+        inputKey.dimension(), polynomial_size, _parameters.glweDimension,
+        _parameters.level, _parameters.baseLog, _parameters.groupingFactor,
+        _parameters.variance, Parallelism::Rayon, csprng.ptr, csprng.vtable);
+    return;
+  }
   // Allocate the buffer
   auto size = concrete_cpu_bootstrap_key_size_u64(
       _parameters.level, _parameters.glweDimension, polynomial_size,
@@ -143,6 +158,18 @@ PackingKeyswitchKey::PackingKeyswitchKey(PackingKeyswitchKeyParam &params,
       _parameters.glweDimension, _parameters.polynomialSize, _parameters.level,
       _parameters.inputLweDimension);
   _buffer = std::make_shared<std::vector<uint64_t>>();
+
+  if (_parameters.packingOnly) {
+    // Initialize the single key packing the ciphertexts in the constant
+    // coefficients
+    _buffer->resize(size);
+    concrete_cpu_init_lwe_packing_keyswitch_key_u64(
+        _buffer->data(), inputKey.buffer(), outputKey.buffer(),
+        _parameters.inputLweDimension, _parameters.polynomialSize,
+        _parameters.glweDimension, _parameters.level, _parameters.baseLog,
+        _parameters.variance, csprng.ptr, csprng.vtable);
+    return;
+  }
   _buffer->resize(size * (_parameters.glweDimension + 1));
 
   // Initialize the keyswitch key buffer
@@ -4,6 +4,7 @@
 // for license information.
 
 #include "concretelang/ClientLib/KeySet.h"
+#include "concrete-cpu.h"
 #include "concretelang/ClientLib/CRT.h"
 #include "concretelang/Common/Error.h"
 #include "concretelang/Support/Error.h"
@@ -192,6 +193,7 @@ KeySet::encrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t input) {
   assert(inputSk.second.has_value());
   auto lweSecretKey = *inputSk.second;
   auto lweSecretKeyParam = lweSecretKey.parameters();
+  const std::lock_guard<std::mutex> guard(csprngMutex);
   // CRT encoding - N blocks with crt encoding
   auto crt = encryption->encoding.crt;
   if (!crt.empty()) {
@@ -225,29 +227,80 @@ KeySet::decrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t &output) {
     return StringError("decrypt_lwe: the positional argument is not encrypted");
   }
 
-  auto crt = encryption->encoding.crt;
+  // Decrypt the plaintexts of the blocks
+  auto numBlocks =
+      encryption->encoding.crt.empty() ? 1 : encryption->encoding.crt.size();
+  std::vector<uint64_t> plaintexts(numBlocks);
+  for (auto &plaintext : plaintexts) {
+    lweSecretKey.decrypt(ciphertext, plaintext);
+    ciphertext = ciphertext + lweSecretKeyParam.lweSize();
+  }
+
+  decode(encryption->encoding, plaintexts.data(), output);
+  return outcome::success();
+}
+
+outcome::checked<void, StringError>
+KeySet::decrypt_packed_glwe(size_t argPos, const uint64_t *ciphertexts,
+                            size_t numValues, uint64_t *values) {
+  if (argPos >= outputs.size()) {
+    return StringError("decrypt_packed_glwe: position of argument is too high");
+  }
+  auto encryption = std::get<0>(outputs[argPos]).encryption;
+  if (!encryption.has_value() || !encryption->packingKeyID.has_value()) {
+    return StringError(
+        "decrypt_packed_glwe: the positional argument is not packed");
+  }
+  assert(*encryption->packingKeyID <
+         _clientParameters.packingKeyswitchKeys.size());
+  auto param =
+      _clientParameters.packingKeyswitchKeys[*encryption->packingKeyID];
+  OUTCOME_TRY(auto glweSecretKey, findLweSecretKey(param.outputSecretKeyID));
+
+  // Decrypt the GLWE ciphertexts, the i-th plaintext being the i-th
+  // coefficient of the concatenation of their messages
+  auto numBlocks =
+      encryption->encoding.crt.empty() ? 1 : encryption->encoding.crt.size();
+  size_t numPlaintexts = numValues * numBlocks;
+  size_t polynomialSize = param.polynomialSize;
+  size_t glweSize = (param.glweDimension + 1) * polynomialSize;
+  size_t numGlwes = (numPlaintexts + polynomialSize - 1) / polynomialSize;
+  std::vector<uint64_t> plaintexts(numGlwes * polynomialSize);
+  for (size_t i = 0; i < numGlwes; i++) {
+    concrete_cpu_decrypt_glwe_ciphertext_u64(
+        glweSecretKey.buffer(), plaintexts.data() + i * polynomialSize,
+        ciphertexts + i * glweSize, param.glweDimension, polynomialSize);
+  }
+
+  for (size_t i = 0; i < numValues; i++) {
+    decode(encryption->encoding, plaintexts.data() + i * numBlocks,
+           values[i]);
+  }
+  return outcome::success();
+}
+
+void KeySet::decode(const Encoding &encoding, const uint64_t *plaintexts,
+                    uint64_t &output) {
+  auto crt = encoding.crt;
 
   if (!crt.empty()) {
     // CRT encoded TFHE integers
 
-    // Decrypt and decode remainders
+    // Decode remainders
     std::vector<int64_t> remainders;
     for (auto modulus : crt) {
-      uint64_t decrypted = 0;
-      lweSecretKey.decrypt(ciphertext, decrypted);
-
-      auto plaintext = crt::decode(decrypted, modulus);
+      auto plaintext = crt::decode(*plaintexts, modulus);
       remainders.push_back(plaintext);
-      ciphertext = ciphertext + lweSecretKeyParam.lweSize();
+      plaintexts++;
     }
 
     // Compute the inverse crt
     output = crt::iCrt(crt, remainders);
 
     // Further decode signed integers
-    if (encryption->encoding.isSigned) {
+    if (encoding.isSigned) {
       uint64_t maxPos = 1;
-      for (auto prime : encryption->encoding.crt) {
+      for (auto prime : encoding.crt) {
         maxPos *= prime;
       }
       maxPos /= 2;
@@ -257,18 +310,17 @@ KeySet::decrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t &output) {
     }
   } else {
     // Native encoded TFHE integers - 1 blocks with one padding bits
-    uint64_t plaintext = 0;
-    lweSecretKey.decrypt(ciphertext, plaintext);
+    uint64_t plaintext = *plaintexts;
 
     // Decode unsigned integer
-    uint64_t precision = encryption->encoding.precision;
+    uint64_t precision = encoding.precision;
     output = plaintext >> (64 - precision - 2);
     auto carry = output % 2;
     uint64_t mod = (((uint64_t)1) << (precision + 1));
     output = ((output >> 1) + carry) % mod;
 
     // Further decode signed integers.
-    if (encryption->encoding.isSigned) {
+    if (encoding.isSigned) {
       uint64_t maxPos = (((uint64_t)1) << (precision - 1));
       if (output >= maxPos) { // The output is actually negative.
         // Set the preceding bits to zero
@@ -278,8 +330,6 @@ KeySet::decrypt_lwe(size_t argPos, uint64_t *ciphertext, uint64_t &output) {
       };
     }
   }
-
-  return outcome::success();
 }
 
 const std::vector<LweSecretKey> &KeySet::getSecretKeys() const {
@@ -10,10 +10,19 @@
 #include "concretelang/ClientLib/Serializers.h"
 
 #include "llvm/ADT/ScopeExit.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/SHA256.h"
 
+#include <array>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <future>
+#include <initializer_list>
+#include <map>
 #include <sstream>
 #include <string>
 #include <utime.h>
@@ -71,151 +80,129 @@ outcome::checked<void, StringError> saveKey(llvm::SmallString<0> &path,
   return outcome::success();
 }
 
-outcome::checked<std::unique_ptr<KeySet>, StringError>
-KeySetCache::loadKeys(ClientParameters &params, uint64_t seed_msb,
-                      uint64_t seed_lsb, std::string folderPath) {
-#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
-  getApproval();
-#endif
-
-  // Mark the folder as recently use.
-  // e.g. so the CI can do some cleanup of unused keys.
-  utime(folderPath.c_str(), nullptr);
-
-  std::vector<LweSecretKey> secretKeys;
-  std::vector<LweBootstrapKey> bootstrapKeys;
-  std::vector<LweKeyswitchKey> keyswitchKeys;
-  std::vector<PackingKeyswitchKey> packingKeyswitchKeys;
-
-  // Load secret keys
-  for (auto p : llvm::enumerate(params.secretKeys)) {
-    // TODO - Check parameters?
-    // auto param = secretKeyParam.second;
-    llvm::SmallString<0> path(folderPath);
-    llvm::sys::path::append(path, "secretKey_" + std::to_string(p.index()));
-    OUTCOME_TRY(auto key, loadKey(path, readLweSecretKey));
-    secretKeys.push_back(key);
-  }
-  // Load bootstrap keys
-  for (auto p : llvm::enumerate(params.bootstrapKeys)) {
-    // TODO - Check parameters?
-    // auto param = p.value();
-    llvm::SmallString<0> path(folderPath);
-    llvm::sys::path::append(path, "pbsKey_" + std::to_string(p.index()));
-    OUTCOME_TRY(auto key, loadKey(path, readLweBootstrapKey));
-    bootstrapKeys.push_back(key);
-  }
-  // Load keyswitch keys
-  for (auto p : llvm::enumerate(params.keyswitchKeys)) {
-    // TODO - Check parameters?
-    // auto param = p.value();
-    llvm::SmallString<0> path(folderPath);
-    llvm::sys::path::append(path, "ksKey_" + std::to_string(p.index()));
-    OUTCOME_TRY(auto key, loadKey(path, readLweKeyswitchKey));
-    keyswitchKeys.push_back(key);
-  }
+static uint64_t doubleBits(double v) {
+  uint64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return bits;
+}
 
-  for (auto p : llvm::enumerate(params.packingKeyswitchKeys)) {
-    // TODO - Check parameters?
-    // auto param = p.value();
-    llvm::SmallString<0> path(folderPath);
-    llvm::sys::path::append(path, "pksKey_" + std::to_string(p.index()));
-    OUTCOME_TRY(auto key, loadKey(path, readPackingKeyswitchKey));
-    packingKeyswitchKeys.push_back(key);
+/// Returns the SHA-256 of a canonical encoding of `tag` and `words`, i.e. the
+/// length of the tag, the tag and then each word in little-endian. Unlike
+/// llvm::hash_combine, the result doesn't depend on the platform, the build or
+/// the process, as it identifies keys stored on disk.
+static std::array<uint8_t, 32> sha256(llvm::StringRef tag,
+                                      std::initializer_list<uint64_t> words) {
+  llvm::SmallVector<uint8_t, 128> bytes;
+  auto append = [&](uint64_t word) {
+    for (int i = 0; i < 8; i++) {
+      bytes.push_back((uint8_t)(word >> (8 * i)));
+    }
+  };
+  append(tag.size());
+  bytes.append(tag.bytes_begin(), tag.bytes_end());
+  for (auto word : words) {
+    append(word);
   }
-
-  __uint128_t seed = seed_msb;
-  seed <<= 64;
-  seed += seed_lsb;
-
-  auto csprng = ConcreteCSPRNG(seed);
-
-  OUTCOME_TRY(auto keySet,
-              KeySet::fromKeys(params, secretKeys, bootstrapKeys, keyswitchKeys,
-                               packingKeyswitchKeys, std::move(csprng)));
-
-  return std::move(keySet);
+  return llvm::SHA256::hash(bytes);
 }
 
-outcome::checked<void, StringError> saveKeys(KeySet &key_set,
-                                             llvm::SmallString<0> &folderPath) {
-#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
-  getApproval();
-#endif
-
-  llvm::SmallString<0> folderIncompletePath = folderPath;
-
-  folderIncompletePath.append(".incomplete");
-
-  auto err = llvm::sys::fs::create_directories(folderIncompletePath);
-  if (err) {
-    return StringError("Cannot create directory \"")
-           << std::string(folderIncompletePath) << "\": " << err.message();
+/// Returns the address of the key identified by `tag` and `words`, i.e. the
+/// first 64 bits of the SHA-256 of their canonical encoding.
+static KeyAddress address(llvm::StringRef tag,
+                          std::initializer_list<uint64_t> words) {
+  auto digest = sha256(tag, words);
+  KeyAddress res = 0;
+  for (int i = 7; i >= 0; i--) {
+    res = (res << 8) | digest[i];
   }
-  // Save LWE secret keys
-  for (auto p : llvm::enumerate(key_set.getSecretKeys())) {
+  return res;
+}
 
-    llvm::SmallString<0> path = folderIncompletePath;
-    llvm::sys::path::append(path, "secretKey_" + std::to_string(p.index()));
-    OUTCOME_TRYV(saveKey(path, p.value()));
+KeyAddresses KeySetCache::keyAddresses(ClientParameters &params,
+                                       uint64_t seed_msb, uint64_t seed_lsb) {
+  KeyAddresses addresses;
+  // The identifier of a secret key is part of its address, as two distinct
+  // secret keys of the same dimension must not be merged.
+  for (auto p : llvm::enumerate(params.secretKeys)) {
+    addresses.secretKeys.push_back(address(
+        "secretKey", {seed_msb, seed_lsb, p.index(), p.value().dimension}));
   }
-  // Save bootstrap keys
-  for (auto p : llvm::enumerate(key_set.getBootstrapKeys())) {
-    llvm::SmallString<0> path = folderIncompletePath;
-    llvm::sys::path::append(path, "pbsKey_" + std::to_string(p.index()));
-    OUTCOME_TRYV(saveKey(path, p.value()));
+  // Evaluation keys are addressed by the addresses of their secret keys
+  // instead of the secret key identifiers.
+  for (auto param : params.bootstrapKeys) {
+    assert(param.inputSecretKeyID < addresses.secretKeys.size());
+    assert(param.outputSecretKeyID < addresses.secretKeys.size());
+    addresses.bootstrapKeys.push_back(
+        address("pbsKey", {seed_msb, seed_lsb,
+                           addresses.secretKeys[param.inputSecretKeyID],
+                           addresses.secretKeys[param.outputSecretKeyID],
+                           param.level, param.baseLog, param.glweDimension,
+                           param.polynomialSize, param.inputLweDimension,
+                           doubleBits(param.variance), param.groupingFactor}));
   }
-  // Save keyswitch keys
-  for (auto p : llvm::enumerate(key_set.getKeyswitchKeys())) {
-    llvm::SmallString<0> path = folderIncompletePath;
-    llvm::sys::path::append(path, "ksKey_" + std::to_string(p.index()));
-    OUTCOME_TRYV(saveKey(path, p.value()));
+  for (auto param : params.keyswitchKeys) {
+    assert(param.inputSecretKeyID < addresses.secretKeys.size());
+    assert(param.outputSecretKeyID < addresses.secretKeys.size());
+    addresses.keyswitchKeys.push_back(
+        address("ksKey", {seed_msb, seed_lsb,
+                          addresses.secretKeys[param.inputSecretKeyID],
+                          addresses.secretKeys[param.outputSecretKeyID],
+                          param.level, param.baseLog,
+                          doubleBits(param.variance)}));
   }
-  // Save packing keyswitch keys
-  for (auto p : llvm::enumerate(key_set.getPackingKeyswitchKeys())) {
-    llvm::SmallString<0> path = folderIncompletePath;
-    llvm::sys::path::append(path, "pksKey_" + std::to_string(p.index()));
-    OUTCOME_TRYV(saveKey(path, p.value()));
+  for (auto param : params.packingKeyswitchKeys) {
+    assert(param.inputSecretKeyID < addresses.secretKeys.size());
+    assert(param.outputSecretKeyID < addresses.secretKeys.size());
+    addresses.packingKeyswitchKeys.push_back(
+        address("pksKey", {seed_msb, seed_lsb,
+                           addresses.secretKeys[param.inputSecretKeyID],
+                           addresses.secretKeys[param.outputSecretKeyID],
+                           param.level, param.baseLog, param.glweDimension,
+                           param.polynomialSize, param.inputLweDimension,
+                           doubleBits(param.variance), param.packingOnly}));
   }
+  return addresses;
+}
 
-  err = llvm::sys::fs::rename(folderIncompletePath, folderPath);
-  if (err) {
-    llvm::sys::fs::remove_directories(folderIncompletePath);
+/// Returns the seed of the csprng used to generate the key at the given
+/// address, such that a key only depends on its address and not on the order
+/// of generation. The seed is derived from the seed of the key set by SHA-256,
+/// with the address as context, so that the seeds of the keys are independent
+/// and don't reveal the seed of the key set.
+static __uint128_t keySeed(KeyAddress address, uint64_t seed_msb,
+                           uint64_t seed_lsb) {
+  auto digest = sha256("keySeed", {seed_msb, seed_lsb, address});
+  __uint128_t seed = 0;
+  for (int i = 0; i < 16; i++) {
+    seed = (seed << 8) | digest[i];
   }
-  if (!llvm::sys::fs::exists(folderPath)) {
-    return StringError("Cannot save directory \"")
-           << std::string(folderPath) << "\"";
-  }
-
-  return outcome::success();
+  return seed;
 }
 
-outcome::checked<std::unique_ptr<KeySet>, StringError>
-KeySetCache::loadOrGenerateSave(ClientParameters &params, uint64_t seed_msb,
-                                uint64_t seed_lsb) {
-
-#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
-  getApproval();
-#endif
-
-  llvm::SmallString<0> folderPath =
-      llvm::SmallString<0>(this->backingDirectoryPath);
-
-  llvm::sys::path::append(folderPath, std::to_string(params.hash()));
-
-  llvm::sys::path::append(folderPath, std::to_string(seed_msb) + "_" +
-                                          std::to_string(seed_lsb));
+/// Load the key stored at `path` or generate and store it. A lock on the entry
+/// protects against concurrent generation of the same key by several
+/// processes.
+template <class Key>
+outcome::checked<Key, StringError>
+loadOrGenerateKey(llvm::SmallString<0> path, Key(deser)(std::istream &istream),
+                  std::function<Key()> generate) {
+  if (llvm::sys::fs::exists(path)) {
+    auto key = loadKey(path, deser);
+    if (key.has_value()) {
+      // Mark the entry as recently use.
+      // e.g. so the CI can do some cleanup of unused keys.
+      utime(path.c_str(), nullptr);
+      return key;
+    }
+  }
 
-  // Creating a lock for concurrent generation
-  llvm::SmallString<0> lockPath(folderPath);
-  lockPath.append("lock");
+  // Creating a lock for concurrent generation of this entry
+  llvm::SmallString<0> lockPath(path);
+  lockPath.append(".lock");
   int FD_lock;
-  llvm::sys::fs::create_directories(llvm::sys::path::parent_path(lockPath));
-  // Open or create the lock file
   auto err = llvm::sys::fs::openFile(
       lockPath, FD_lock, llvm::sys::fs::CreationDisposition::CD_OpenAlways,
       llvm::sys::fs::FileAccess::FA_Write, llvm::sys::fs::OpenFlags::OF_None);
-
   if (err) {
     // parent does not exists OR right issue (creation or write)
     return StringError("Cannot access \"")
@@ -231,22 +218,155 @@ KeySetCache::loadOrGenerateSave(ClientParameters &params, uint64_t seed_msb,
   });
   llvm::sys::fs::lockFile(FD_lock);
 
-  if (llvm::sys::fs::exists(folderPath)) {
+  if (llvm::sys::fs::exists(path)) {
     // Once it has been generated by another process (or was alread here)
-    auto keys = loadKeys(params, seed_msb, seed_lsb, std::string(folderPath));
-    if (keys.has_value()) {
-      return keys;
-    } else {
-      std::cerr << std::string(keys.error().mesg) << "\n";
-      std::cerr << "Invalid KeySetCache entry " << std::string(folderPath)
-                << "\n";
-      llvm::sys::fs::remove_directories(folderPath);
-      // Then we can continue as it didn't exist
+    auto key = loadKey(path, deser);
+    if (key.has_value()) {
+      return key;
+    }
+    std::cerr << std::string(key.error().mesg) << "\n";
+    std::cerr << "Invalid KeySetCache entry " << std::string(path) << "\n";
+    llvm::sys::fs::remove(path);
+    // Then we can continue as it didn't exist
+  }
+
+  std::cerr << "KeySetCache: miss, regenerating " << std::string(path) << "\n";
+
+  auto key = generate();
+
+  llvm::SmallString<0> incompletePath(path);
+  incompletePath.append(".incomplete");
+  OUTCOME_TRYV(saveKey(incompletePath, key));
+  err = llvm::sys::fs::rename(incompletePath, path);
+  if (err) {
+    llvm::sys::fs::remove(incompletePath);
+    return StringError("Cannot save key \"")
+           << std::string(path) << "\": " << err.message();
+  }
+  return key;
+}
+
+template <class Key>
+using KeyFuture = std::shared_future<outcome::checked<Key, StringError>>;
+
+/// Schedule the loading or the generation of the keys at the given addresses.
+/// Each distinct address is handled by its own asynchronous task, keys which
+/// share an address share the task.
+template <class Key, class Param>
+std::vector<KeyFuture<Key>> scheduleKeys(
+    llvm::StringRef storePath, llvm::StringRef prefix,
+    std::vector<Param> &params, std::vector<KeyAddress> &addresses,
+    Key(deser)(std::istream &istream),
+    std::function<Key(Param param, __uint128_t seed)> generate,
+    uint64_t seed_msb, uint64_t seed_lsb) {
+  std::map<KeyAddress, KeyFuture<Key>> tasks;
+  std::vector<KeyFuture<Key>> keys;
+  for (size_t i = 0; i < params.size(); i++) {
+    auto address = addresses[i];
+    auto task = tasks.find(address);
+    if (task != tasks.end()) {
+      keys.push_back(task->second);
+      continue;
     }
+    llvm::SmallString<0> path(storePath);
+    llvm::sys::path::append(path, prefix + "_" + llvm::utohexstr(address));
+    auto param = params[i];
+    auto seed = keySeed(address, seed_msb, seed_lsb);
+    KeyFuture<Key> future =
+        std::async(std::launch::async, [path, deser, generate, param, seed]() {
+          return loadOrGenerateKey<Key>(
+              path, deser, [&]() { return generate(param, seed); });
+        }).share();
+    tasks.insert({address, future});
+    keys.push_back(future);
   }
+  return keys;
+}
 
-  std::cerr << "KeySetCache: miss, regenerating " << std::string(folderPath)
-            << "\n";
+/// Wait for all the scheduled keys, and returns them or the first error.
+template <class Key>
+outcome::checked<std::vector<Key>, StringError>
+collectKeys(std::vector<KeyFuture<Key>> &futures) {
+  // Wait for all tasks before reporting errors to not leave running tasks
+  // behind.
+  for (auto &future : futures) {
+    future.wait();
+  }
+  std::vector<Key> keys;
+  for (auto &future : futures) {
+    OUTCOME_TRY(auto key, future.get());
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+outcome::checked<std::unique_ptr<KeySet>, StringError>
+KeySetCache::loadOrGenerateSave(ClientParameters &params, uint64_t seed_msb,
+                                uint64_t seed_lsb) {
+
+#ifdef CONCRETELANG_GENERATE_UNSECURE_SECRET_KEYS
+  getApproval();
+#endif
+
+  llvm::SmallString<0> storePath(this->backingDirectoryPath);
+  llvm::sys::path::append(storePath, "keys");
+  auto err = llvm::sys::fs::create_directories(storePath);
+  if (err) {
+    return StringError("Cannot create directory \"")
+           << std::string(storePath) << "\": " << err.message();
+  }
+
+  auto addresses = keyAddresses(params, seed_msb, seed_lsb);
+
+  // Secret keys first, as evaluation keys depend on them
+  auto secretKeyFutures = scheduleKeys<LweSecretKey, LweSecretKeyParam>(
+      storePath, "secretKey", params.secretKeys, addresses.secretKeys,
+      readLweSecretKey,
+      [](LweSecretKeyParam param, __uint128_t seed) {
+        auto csprng = ConcreteCSPRNG(seed);
+        return LweSecretKey(param, csprng);
+      },
+      seed_msb, seed_lsb);
+  OUTCOME_TRY(auto secretKeys, collectKeys(secretKeyFutures));
+
+  // Then all the evaluation keys concurrently
+  auto bootstrapKeyFutures = scheduleKeys<LweBootstrapKey, BootstrapKeyParam>(
+      storePath, "pbsKey", params.bootstrapKeys, addresses.bootstrapKeys,
+      readLweBootstrapKey,
+      [&secretKeys](BootstrapKeyParam param, __uint128_t seed) {
+        auto csprng = ConcreteCSPRNG(seed);
+        auto inputKey = secretKeys[param.inputSecretKeyID];
+        auto outputKey = secretKeys[param.outputSecretKeyID];
+        return LweBootstrapKey(param, inputKey, outputKey, csprng);
+      },
+      seed_msb, seed_lsb);
+  auto keyswitchKeyFutures = scheduleKeys<LweKeyswitchKey, KeyswitchKeyParam>(
+      storePath, "ksKey", params.keyswitchKeys, addresses.keyswitchKeys,
+      readLweKeyswitchKey,
+      [&secretKeys](KeyswitchKeyParam param, __uint128_t seed) {
+        auto csprng = ConcreteCSPRNG(seed);
+        auto inputKey = secretKeys[param.inputSecretKeyID];
+        auto outputKey = secretKeys[param.outputSecretKeyID];
+        return LweKeyswitchKey(param, inputKey, outputKey, csprng);
+      },
+      seed_msb, seed_lsb);
+  auto packingKeyswitchKeyFutures =
+      scheduleKeys<PackingKeyswitchKey, PackingKeyswitchKeyParam>(
+          storePath, "pksKey", params.packingKeyswitchKeys,
+          addresses.packingKeyswitchKeys, readPackingKeyswitchKey,
+          [&secretKeys](PackingKeyswitchKeyParam param, __uint128_t seed) {
+            auto csprng = ConcreteCSPRNG(seed);
+            auto inputKey = secretKeys[param.inputSecretKeyID];
+            auto outputKey = secretKeys[param.outputSecretKeyID];
+            return PackingKeyswitchKey(param, inputKey, outputKey, csprng);
+          },
+          seed_msb, seed_lsb);
+  auto bootstrapKeys = collectKeys(bootstrapKeyFutures);
+  auto keyswitchKeys = collectKeys(keyswitchKeyFutures);
+  auto packingKeyswitchKeys = collectKeys(packingKeyswitchKeyFutures);
+  OUTCOME_TRYV(bootstrapKeys);
+  OUTCOME_TRYV(keyswitchKeys);
+  OUTCOME_TRYV(packingKeyswitchKeys);
 
   __uint128_t seed = seed_msb;
   seed <<= 64;
@@ -254,11 +374,13 @@ KeySetCache::loadOrGenerateSave(ClientParameters &params, uint64_t seed_msb,
 
   auto csprng = ConcreteCSPRNG(seed);
 
-  OUTCOME_TRY(auto key_set, KeySet::generate(params, std::move(csprng)));
-
-  OUTCOME_TRYV(saveKeys(*key_set, folderPath));
+  OUTCOME_TRY(auto keySet,
+              KeySet::fromKeys(params, secretKeys, bootstrapKeys.value(),
+                               keyswitchKeys.value(),
+                               packingKeyswitchKeys.value(),
+                               std::move(csprng)));
 
-  return std::move(key_set);
+  return std::move(keySet);
 }
 
 outcome::checked<std::unique_ptr<KeySet>, StringError>
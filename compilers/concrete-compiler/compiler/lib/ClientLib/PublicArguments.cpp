@@ -3,9 +3,11 @@
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
 
+#include <algorithm>
 #include <iostream>
 #include <stdlib.h>
 
+#include "concrete-cpu.h"
 #include "concretelang/ClientLib/PublicArguments.h"
 #include "concretelang/ClientLib/Serializers.h"
 
@@ -144,12 +146,29 @@ PublicResult::unserialize(std::istream &istream) {
       return StringError("Clear values are not handled");
     }
 
-    std::vector<int64_t> sizes = gate.shape.dimensions;
-    if (gate.encryption.has_value() && !gate.encryption->encoding.crt.empty()) {
-      sizes.push_back(gate.encryption->encoding.crt.size());
+    std::vector<int64_t> sizes;
+    if (gate.encryption->packingKeyID.has_value()) {
+      sizes = clientParameters.packedBufferShape(gate);
+    } else {
+      sizes = gate.shape.dimensions;
+      if (!gate.encryption->encoding.crt.empty()) {
+        sizes.push_back(gate.encryption->encoding.crt.size());
+      }
+      auto lweSize =
+          clientParameters.lweSecretKeyParam(gate).value().lweSize();
+      sizes.push_back(lweSize);
+    }
+
+    auto modulusLog = gate.encryption->modulusLog;
+    if (modulusLog.has_value()) {
+      auto ciphertexts =
+          unserializeSwitchedCiphertexts(sizes, *modulusLog, istream);
+      if (ciphertexts.has_error())
+        return ciphertexts.error();
+
+      buffers.push_back(ScalarOrTensorData(std::move(ciphertexts.value())));
+      continue;
     }
-    auto lweSize = clientParameters.lweSecretKeyParam(gate).value().lweSize();
-    sizes.push_back(lweSize);
 
     auto sotd = unserializeScalarOrTensorData(sizes, istream);
 
@@ -167,8 +186,15 @@ PublicResult::serialize(std::ostream &ostream) {
     return StringError(
         "PublicResult::serialize: ostream should be in binary mode");
   }
-  for (const ScalarOrTensorData &sotd : buffers) {
-    serializeScalarOrTensorData(sotd, ostream);
+  for (size_t i = 0; i < buffers.size(); i++) {
+    const ScalarOrTensorData &sotd = buffers[i];
+    auto &encryption = clientParameters.outputs[i].encryption;
+    if (encryption.has_value() && encryption->modulusLog.has_value()) {
+      serializeSwitchedCiphertexts(sotd.getTensor(), *encryption->modulusLog,
+                                   ostream);
+    } else {
+      serializeScalarOrTensorData(sotd, ostream);
+    }
     if (ostream.fail()) {
       return StringError("Cannot write data");
     }
@@ -275,5 +301,34 @@ TensorData tensorDataFromMemRef(size_t memref_rank, size_t element_width,
   assert(false);
 }
 
+TensorData packCiphertexts(ClientParameters &clientParameters,
+                           CircuitGate gate, const TensorData &ciphertexts,
+                           const uint64_t *packingKeyswitchKey) {
+  assert(gate.encryption.has_value() &&
+         gate.encryption->packingKeyID.has_value());
+  auto param =
+      clientParameters.packingKeyswitchKeys[*gate.encryption->packingKeyID];
+  auto lweSize = clientParameters.lweSecretKeyParam(gate).value().lweSize();
+  auto shape = clientParameters.packedBufferShape(gate);
+
+  TensorData packed(shape, EncryptedScalarElementType,
+                    EncryptedScalarElementWidth);
+  size_t numCiphertexts = ciphertexts.length() / lweSize;
+  for (int64_t i = 0; i < shape[0]; i++) {
+    // Each GLWE packs the next `polynomialSize` ciphertexts, the last one
+    // possibly less
+    size_t first = i * param.polynomialSize;
+    size_t count =
+        std::min<size_t>(param.polynomialSize, numCiphertexts - first);
+    concrete_cpu_packing_keyswitch_lwe_ciphertext_list_u64(
+        packed.getElementPointer<uint64_t>(i * shape[1]),
+        ciphertexts.getElementPointer<uint64_t>(first * lweSize),
+        packingKeyswitchKey, param.level, param.baseLog,
+        param.inputLweDimension, count, param.glweDimension,
+        param.polynomialSize);
+  }
+  return packed;
+}
+
 } // namespace clientlib
 } // namespace concretelang
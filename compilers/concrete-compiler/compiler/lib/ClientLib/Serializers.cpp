@@ -100,8 +100,18 @@ LweKeyswitchKey readLweKeyswitchKey(std::istream &istream) {
 
 // BootstrapKeyParam ////////////////////////////
 
+// The parameters of the multi-bit bootstrap keys start with this marker and
+// their grouping factor, the parameters of the classic bootstrap keys keep the
+// original layout starting with the level, which can't be the marker. The
+// keysets serialized before the multi-bit keys can then still be read.
+static const uint64_t MULTI_BIT_BOOTSTRAP_KEY_MARKER = 0x4d554c5449424954;
+
 std::ostream &operator<<(std::ostream &ostream, const BootstrapKeyParam param) {
   // TODO keys id
+  if (param.groupingFactor != 1) {
+    writeWord(ostream, MULTI_BIT_BOOTSTRAP_KEY_MARKER);
+    writeWord(ostream, param.groupingFactor);
+  }
   writeWord(ostream, param.level);
   writeWord(ostream, param.baseLog);
   writeWord(ostream, param.glweDimension);
@@ -113,7 +123,12 @@ std::ostream &operator<<(std::ostream &ostream, const BootstrapKeyParam param) {
 
 std::istream &operator>>(std::istream &istream, BootstrapKeyParam &param) {
   // TODO keys id
+  param.groupingFactor = 1;
   readWord(istream, param.level);
+  if (param.level == MULTI_BIT_BOOTSTRAP_KEY_MARKER) {
+    readWord(istream, param.groupingFactor);
+    readWord(istream, param.level);
+  }
   readWord(istream, param.baseLog);
   readWord(istream, param.glweDimension);
   readWord(istream, param.variance);
@@ -565,5 +580,101 @@ unserializeScalarOrTensorData(const std::vector<int64_t> &expectedSizes,
   }
 }
 
+std::ostream &serializeSwitchedCiphertexts(const TensorData &ciphertexts,
+                                           uint64_t modulusLog,
+                                           std::ostream &ostream) {
+  assert(modulusLog > 0 && modulusLog <= 64);
+  writeWord<uint64_t>(ostream, ciphertexts.getRank());
+  for (size_t dim : ciphertexts.getDimensions())
+    writeWord<int64_t>(ostream, dim);
+  writeWord<uint64_t>(ostream, modulusLog);
+
+  // The coefficients are rounded to their `modulusLog` most significant bits
+  // and packed from the least significant bits of the words.
+  uint64_t word = 0;
+  uint64_t filled = 0;
+  for (uint64_t coefficient : ciphertexts.getElements<uint64_t>()) {
+    uint64_t switched = coefficient;
+    if (modulusLog < 64) {
+      switched = (coefficient + ((uint64_t)1 << (63 - modulusLog))) >>
+                 (64 - modulusLog);
+    }
+    word |= switched << filled;
+    filled += modulusLog;
+    if (filled >= 64) {
+      writeWord(ostream, word);
+      filled -= 64;
+      word = filled == 0 ? 0 : switched >> (modulusLog - filled);
+    }
+  }
+  if (filled > 0) {
+    writeWord(ostream, word);
+  }
+  return ostream;
+}
+
+outcome::checked<TensorData, StringError>
+unserializeSwitchedCiphertexts(const std::vector<int64_t> &expectedSizes,
+                               uint64_t modulusLog, std::istream &istream) {
+  if (incorrectMode(istream)) {
+    return StringError("Stream is in incorrect mode");
+  }
+
+  uint64_t numDimensions;
+  readWord(istream, numDimensions);
+  if (numDimensions != expectedSizes.size()) {
+    istream.setstate(std::ios::badbit);
+    return StringError("Number of dimensions did not match the number of "
+                       "expected dimensions");
+  }
+
+  std::vector<size_t> dims;
+  for (uint64_t i = 0; i < numDimensions; i++) {
+    int64_t dimSize;
+    readWord(istream, dimSize);
+    if (dimSize != expectedSizes[i]) {
+      istream.setstate(std::ios::badbit);
+      return StringError("Size of dimension ")
+             << i << " did not match the expected size";
+    }
+    dims.push_back(dimSize);
+  }
+
+  uint64_t serializedModulusLog;
+  readWord(istream, serializedModulusLog);
+  if (serializedModulusLog != modulusLog) {
+    istream.setstate(std::ios::badbit);
+    return StringError("Ciphertexts were switched to the modulus 2^")
+           << serializedModulusLog << " instead of 2^" << modulusLog;
+  }
+
+  TensorData result(dims, ElementType::u64, 64);
+  uint64_t mask =
+      modulusLog == 64 ? UINT64_MAX : ((uint64_t)1 << modulusLog) - 1;
+  uint64_t word = 0;
+  uint64_t available = 0;
+  for (size_t i = 0; i < result.length(); i++) {
+    uint64_t switched = word;
+    if (available < modulusLog) {
+      readWord(istream, word);
+      switched |= word << available;
+      uint64_t consumed = modulusLog - available;
+      word = consumed == 64 ? 0 : word >> consumed;
+      available = 64 - consumed;
+    } else {
+      word >>= modulusLog;
+      available -= modulusLog;
+    }
+    // The decryption modulo 2^64 of the coefficients multiplied by
+    // 2^(64 - modulusLog) is the decryption modulo 2^modulusLog shifted.
+    result.getElementReference<uint64_t>(i) = (switched & mask)
+                                              << (64 - modulusLog);
+  }
+  if (istream.fail()) {
+    return StringError("Cannot read data");
+  }
+  return std::move(result);
+}
+
 } // namespace clientlib
 } // namespace concretelang
@@ -27,6 +27,7 @@ char memref_mul_cleartext_lwe_ciphertext_u64[] =
 char memref_negate_lwe_ciphertext_u64[] = "memref_negate_lwe_ciphertext_u64";
 char memref_keyswitch_lwe_u64[] = "memref_keyswitch_lwe_u64";
 char memref_bootstrap_lwe_u64[] = "memref_bootstrap_lwe_u64";
+char memref_many_lut_bootstrap_lwe_u64[] = "memref_many_lut_bootstrap_lwe_u64";
 char memref_batched_keyswitch_lwe_u64[] = "memref_batched_keyswitch_lwe_u64";
 char memref_batched_bootstrap_lwe_u64[] = "memref_batched_bootstrap_lwe_u64";
 
@@ -47,6 +48,8 @@ char memref_wop_pbs_crt_buffer[] = "memref_wop_pbs_crt_buffer";
 char memref_encode_plaintext_with_crt[] = "memref_encode_plaintext_with_crt";
 char memref_encode_expand_lut_for_bootstrap[] =
     "memref_encode_expand_lut_for_bootstrap";
+char memref_encode_expand_many_lut_for_bootstrap[] =
+    "memref_encode_expand_many_lut_for_bootstrap";
 char memref_encode_lut_for_crt_woppbs[] = "memref_encode_lut_for_crt_woppbs";
 char memref_trace[] = "memref_trace";
 
@@ -118,6 +121,12 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
                                         memref1DType, i32Type, i32Type, i32Type,
                                         i32Type, i32Type, i32Type, contextType},
                                        {});
+  } else if (funcName == memref_many_lut_bootstrap_lwe_u64) {
+    funcType = mlir::FunctionType::get(rewriter.getContext(),
+                                       {memref2DType, memref1DType,
+                                        memref1DType, i32Type, i32Type, i32Type,
+                                        i32Type, i32Type, i32Type, contextType},
+                                       {});
   } else if (funcName == memref_keyswitch_async_lwe_u64) {
     // Todo Answer this question: Isn't it dead ?
     funcType = mlir::FunctionType::get(
@@ -192,6 +201,12 @@ mlir::LogicalResult insertForwardDeclarationOfTheCAPI(
         {memref1DType, memref1DType, rewriter.getI32Type(),
          rewriter.getI32Type(), rewriter.getI1Type()},
         {});
+  } else if (funcName == memref_encode_expand_many_lut_for_bootstrap) {
+    funcType = mlir::FunctionType::get(
+        rewriter.getContext(),
+        {memref1DType, memref2DType, rewriter.getI32Type(),
+         rewriter.getI32Type(), rewriter.getI1Type()},
+        {});
   } else if (funcName == memref_encode_lut_for_crt_woppbs) {
     funcType = mlir::FunctionType::get(
         rewriter.getContext(),
@@ -405,9 +420,10 @@ void encodePlaintextWithCrtAddOperands(
       op.getLoc(), op.getModsProdAttr()));
 }
 
+template <typename EncodeOp>
 void encodeExpandLutForBootstrapAddOperands(
-    Concrete::EncodeExpandLutForBootstrapBufferOp op,
-    mlir::SmallVector<mlir::Value> &operands, mlir::RewriterBase &rewriter) {
+    EncodeOp op, mlir::SmallVector<mlir::Value> &operands,
+    mlir::RewriterBase &rewriter) {
   // poly_size
   operands.push_back(rewriter.create<mlir::arith::ConstantOp>(
       op.getLoc(), op.getPolySizeAttr()));
@@ -510,11 +526,25 @@ struct ConcreteToCAPIPass : public ConcreteToCAPIBase<ConcreteToCAPIPass> {
     patterns.add<
         ConcreteToCAPICallPattern<Concrete::EncodeExpandLutForBootstrapBufferOp,
                                   memref_encode_expand_lut_for_bootstrap>>(
-        &getContext(), encodeExpandLutForBootstrapAddOperands);
+        &getContext(),
+        encodeExpandLutForBootstrapAddOperands<
+            Concrete::EncodeExpandLutForBootstrapBufferOp>);
     patterns
         .add<ConcreteToCAPICallPattern<Concrete::EncodeLutForCrtWopPBSBufferOp,
                                        memref_encode_lut_for_crt_woppbs>>(
             &getContext(), encodeLutForWopPBSAddOperands);
+    patterns.add<ConcreteToCAPICallPattern<
+        Concrete::EncodeExpandManyLutForBootstrapBufferOp,
+        memref_encode_expand_many_lut_for_bootstrap>>(
+        &getContext(),
+        encodeExpandLutForBootstrapAddOperands<
+            Concrete::EncodeExpandManyLutForBootstrapBufferOp>);
+    // There is no many-LUT bootstrap on gpu, the cpu one is used in both cases
+    patterns.add<
+        ConcreteToCAPICallPattern<Concrete::ManyLutBootstrapLweBufferOp,
+                                  memref_many_lut_bootstrap_lwe_u64>>(
+        &getContext(),
+        bootstrapAddOperands<Concrete::ManyLutBootstrapLweBufferOp>);
     if (gpu) {
       patterns.add<ConcreteToCAPICallPattern<Concrete::KeySwitchLweBufferOp,
                                              memref_keyswitch_lwe_cuda_u64>>(
@@ -540,6 +540,46 @@ struct MulEintIntOpPattern : CrtOpPattern<FHE::MulEintIntOp> {
   }
 };
 
+/// Creates the wop-PBS applying `lut` on the crt encoded `input`.
+static mlir::Value createWopPBS(
+    mlir::ConversionPatternRewriter &rewriter, mlir::Location loc,
+    mlir::Type resultType, mlir::Value input, mlir::Value lut, bool isSigned,
+    const mlir::concretelang::CrtLoweringParameters &loweringParameters) {
+  mlir::MLIRContext *context = rewriter.getContext();
+  mlir::Value newLut =
+      rewriter
+          .create<TFHE::EncodeLutForCrtWopPBSOp>(
+              loc,
+              mlir::RankedTensorType::get(
+                  mlir::ArrayRef<int64_t>{
+                      (int64_t)loweringParameters.nMods,
+                      (int64_t)loweringParameters.singleLutSize},
+                  rewriter.getI64Type()),
+              lut,
+              rewriter.getI64ArrayAttr(
+                  mlir::ArrayRef<int64_t>(loweringParameters.mods)),
+              rewriter.getI64ArrayAttr(
+                  mlir::ArrayRef<int64_t>(loweringParameters.bits)),
+              rewriter.getI32IntegerAttr(loweringParameters.modsProd),
+              rewriter.getBoolAttr(isSigned))
+          .getResult();
+
+  // Replace the lut with an encoded / expanded one.
+  auto wopPBS = rewriter.create<TFHE::WopPBSGLWEOp>(
+      loc, resultType, input, newLut,
+      TFHE::GLWEKeyswitchKeyAttr::get(context, TFHE::GLWESecretKey(),
+                                      TFHE::GLWESecretKey(), -1, -1, -1),
+      TFHE::GLWEBootstrapKeyAttr::get(context, TFHE::GLWESecretKey(),
+                                      TFHE::GLWESecretKey(), -1, -1, -1, -1,
+                                      -1),
+      TFHE::GLWEPackingKeyswitchKeyAttr::get(context, TFHE::GLWESecretKey(),
+                                             TFHE::GLWESecretKey(), -1, -1, -1,
+                                             -1, -1, -1),
+      rewriter.getI64ArrayAttr({}), rewriter.getI32IntegerAttr(-1),
+      rewriter.getI32IntegerAttr(-1));
+  return wopPBS.getResult();
+}
+
 /// Rewriter for the `FHE::apply_lookup_table` operation.
 struct ApplyLookupTableEintOpPattern
     : public CrtOpPattern<FHE::ApplyLookupTableEintOp> {
@@ -559,40 +599,48 @@ struct ApplyLookupTableEintOpPattern
     auto originalInputType =
         op.getA().getType().cast<FHE::FheIntegerInterface>();
 
-    mlir::Value newLut =
-        rewriter
-            .create<TFHE::EncodeLutForCrtWopPBSOp>(
-                op.getLoc(),
-                mlir::RankedTensorType::get(
-                    mlir::ArrayRef<int64_t>{
-                        (int64_t)loweringParameters.nMods,
-                        (int64_t)loweringParameters.singleLutSize},
-                    rewriter.getI64Type()),
-                adaptor.getLut(),
-                rewriter.getI64ArrayAttr(
-                    mlir::ArrayRef<int64_t>(loweringParameters.mods)),
-                rewriter.getI64ArrayAttr(
-                    mlir::ArrayRef<int64_t>(loweringParameters.bits)),
-                rewriter.getI32IntegerAttr(loweringParameters.modsProd),
-                rewriter.getBoolAttr(originalInputType.isSigned()))
-            .getResult();
+    auto wopPBS = createWopPBS(
+        rewriter, op.getLoc(), converter->convertType(op.getType()),
+        adaptor.getA(), adaptor.getLut(), originalInputType.isSigned(),
+        loweringParameters);
+
+    rewriter.replaceOp(op, {wopPBS});
+    return ::mlir::success();
+  };
+};
+
+/// Rewriter for the `FHE::apply_many_lookup_tables` operation.
+///
+/// The wop-PBS has no many-LUT variant, each lookup table is applied with its
+/// own wop-PBS.
+struct ApplyManyLookupTablesEintOpPattern
+    : public CrtOpPattern<FHE::ApplyManyLookupTablesEintOp> {
+
+  ApplyManyLookupTablesEintOpPattern(
+      mlir::MLIRContext *context,
+      mlir::concretelang::CrtLoweringParameters params,
+      mlir::PatternBenefit benefit = 1)
+      : CrtOpPattern<FHE::ApplyManyLookupTablesEintOp>(context, params,
+                                                       benefit) {}
+
+  ::mlir::LogicalResult
+  matchAndRewrite(FHE::ApplyManyLookupTablesEintOp op,
+                  FHE::ApplyManyLookupTablesEintOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+    mlir::TypeConverter *converter = this->getTypeConverter();
+
+    auto originalInputType =
+        op.getA().getType().cast<FHE::FheIntegerInterface>();
+
+    llvm::SmallVector<mlir::Value> results;
+    for (auto [lut, result] : llvm::zip(adaptor.getLuts(), op.getResults())) {
+      results.push_back(createWopPBS(
+          rewriter, op.getLoc(), converter->convertType(result.getType()),
+          adaptor.getA(), lut, originalInputType.isSigned(),
+          loweringParameters));
+    }
 
-    // Replace the lut with an encoded / expanded one.
-    auto wopPBS = rewriter.create<TFHE::WopPBSGLWEOp>(
-        op.getLoc(), converter->convertType(op.getType()), adaptor.getA(),
-        newLut,
-        TFHE::GLWEKeyswitchKeyAttr::get(op.getContext(), TFHE::GLWESecretKey(),
-                                        TFHE::GLWESecretKey(), -1, -1, -1),
-        TFHE::GLWEBootstrapKeyAttr::get(op.getContext(), TFHE::GLWESecretKey(),
-                                        TFHE::GLWESecretKey(), -1, -1, -1, -1,
-                                        -1),
-        TFHE::GLWEPackingKeyswitchKeyAttr::get(
-            op.getContext(), TFHE::GLWESecretKey(), TFHE::GLWESecretKey(), -1,
-            -1, -1, -1, -1, -1),
-        rewriter.getI64ArrayAttr({}), rewriter.getI32IntegerAttr(-1),
-        rewriter.getI32IntegerAttr(-1));
-
-    rewriter.replaceOp(op, {wopPBS.getResult()});
+    rewriter.replaceOp(op, results);
     return ::mlir::success();
   };
 };
@@ -1026,8 +1074,10 @@ struct FHEToTFHECrtPass : public FHEToTFHECrtBase<FHEToTFHECrtPass> {
                  //    |_ `FHE::to_signed`
                  lowering::ToSignedOpPattern,
                  //    |_ `FHE::apply_lookup_table`
-                 lowering::ApplyLookupTableEintOpPattern>(&getContext(),
-                                                          loweringParameters);
+                 lowering::ApplyLookupTableEintOpPattern,
+                 //    |_ `FHE::apply_many_lookup_tables`
+                 lowering::ApplyManyLookupTablesEintOpPattern>(
+        &getContext(), loweringParameters);
 
     // Patterns for the relics of the `FHELinalg` dialect operations.
     //    |_ `linalg::generic` turned to nested `scf::for`
@@ -142,6 +142,58 @@ struct ScalarOpPattern : public mlir::OpConversionPattern<T> {
         location, rewriter.getI64Type(), castedInt, constantShiftOp);
     return encodedInt;
   }
+
+  /// Creates the keyswitch of `input` before a bootstrap, a signed `input` is
+  /// first shifted as the bootstrap only supports positive values.
+  TFHE::KeySwitchGLWEOp
+  createBootstrapInput(mlir::Location loc, FHE::FheIntegerInterface inputType,
+                       mlir::Value input,
+                       mlir::DenseI32ArrayAttr operatorIndexes,
+                       mlir::ConversionPatternRewriter &rewriter) const {
+    typing::TypeConverter converter;
+    mlir::Type ksType = this->getTypeConverter()->convertType(input.getType());
+
+    if (operatorIndexes != nullptr) {
+      assert(operatorIndexes != nullptr && operatorIndexes.size() > 0);
+    }
+
+    if (inputType.isSigned()) {
+      // If the input is a signed integer, it comes to the bootstrap with a
+      // signed-leveled encoding (compatible with 2s complement semantics).
+      // Unfortunately pbs is not compatible with this encoding, since the
+      // (virtual) msb must be 0 to avoid a lookup in the phantom negative lut.
+      uint64_t constantRaw = (uint64_t)1 << (inputType.getWidth() - 1);
+      // Note that the constant must be encoded with one more bit to ensure the
+      // signed extension used in the plaintext encoding works as expected.
+      mlir::Value constant = rewriter.create<mlir::arith::ConstantOp>(
+          loc, rewriter.getIntegerAttr(
+                   rewriter.getIntegerType(inputType.getWidth() + 1),
+                   constantRaw));
+      mlir::Value encodedConstant = writePlaintextShiftEncoding(
+          loc, constant, inputType.getWidth(), rewriter);
+      auto inputOp = rewriter.create<TFHE::AddGLWEIntOp>(
+          loc, converter.convertType(input.getType()), input, encodedConstant);
+      if (operatorIndexes != nullptr) {
+        assert(operatorIndexes.size() == 2);
+        auto addIndex = operatorIndexes[0];
+        inputOp->setAttr("TFHE.OId", rewriter.getI32IntegerAttr(addIndex));
+      }
+      input = inputOp;
+    }
+
+    // Insert keyswitch
+    auto ksOp = rewriter.create<TFHE::KeySwitchGLWEOp>(
+        loc, ksType, input,
+        TFHE::GLWEKeyswitchKeyAttr::get(rewriter.getContext(),
+                                        TFHE::GLWESecretKey(),
+                                        TFHE::GLWESecretKey(), -1, -1, -1));
+    if (operatorIndexes != nullptr) {
+      ksOp->setAttr("TFHE.OId",
+                    rewriter.getI32IntegerAttr(
+                        operatorIndexes[operatorIndexes.size() - 1]));
+    }
+    return ksOp;
+  }
 };
 
 /// Rewriter for the `FHE::add_eint_int` operation.
@@ -361,55 +413,109 @@ struct ApplyLookupTableEintOpPattern
                 rewriter.getBoolAttr(inputType.isSigned()))
             .getResult();
 
-    typing::TypeConverter converter;
-    mlir::Value input = adaptor.getA();
-
     auto operatorIndexes =
         op->getAttrOfType<mlir::DenseI32ArrayAttr>("TFHE.OId");
+    auto ksOp = this->createBootstrapInput(op.getLoc(), inputType,
+                                           adaptor.getA(), operatorIndexes,
+                                           rewriter);
+
+    // Insert bootstrap
+    auto bsOp = rewriter.replaceOpWithNewOp<TFHE::BootstrapGLWEOp>(
+        op, getTypeConverter()->convertType(op.getType()), ksOp, newLut,
+        TFHE::GLWEBootstrapKeyAttr::get(op.getContext(), TFHE::GLWESecretKey(),
+                                        TFHE::GLWESecretKey(), -1, -1, -1, -1,
+                                        -1));
     if (operatorIndexes != nullptr) {
-      assert(operatorIndexes != nullptr && operatorIndexes.size() > 0);
+      bsOp->setAttr("TFHE.OId",
+                    rewriter.getI32IntegerAttr(
+                        operatorIndexes[operatorIndexes.size() - 1]));
     }
+    return mlir::success();
+  };
 
-    if (inputType.isSigned()) {
-      // If the input is a signed integer, it comes to the bootstrap with a
-      // signed-leveled encoding (compatible with 2s complement semantics).
-      // Unfortunately pbs is not compatible with this encoding, since the
-      // (virtual) msb must be 0 to avoid a lookup in the phantom negative lut.
-      uint64_t constantRaw = (uint64_t)1 << (inputType.getWidth() - 1);
-      // Note that the constant must be encoded with one more bit to ensure the
-      // signed extension used in the plaintext encoding works as expected.
-      mlir::Value constant = rewriter.create<mlir::arith::ConstantOp>(
-          op.getLoc(),
-          rewriter.getIntegerAttr(
-              rewriter.getIntegerType(inputType.getWidth() + 1), constantRaw));
-      mlir::Value encodedConstant = writePlaintextShiftEncoding(
-          op.getLoc(), constant, inputType.getWidth(), rewriter);
-      auto inputOp = rewriter.create<TFHE::AddGLWEIntOp>(
-          op.getLoc(), converter.convertType(input.getType()), input,
-          encodedConstant);
-      if (operatorIndexes != nullptr) {
-        assert(operatorIndexes.size() == 2);
-        auto addIndex = operatorIndexes[0];
-        inputOp->setAttr("TFHE.OId", rewriter.getI32IntegerAttr(addIndex));
-      }
-      input = inputOp;
+private:
+  mlir::concretelang::ScalarLoweringParameters loweringParameters;
+};
+
+/// Rewriter for the `FHE::apply_many_lookup_tables` operation.
+struct ApplyManyLookupTablesEintOpPattern
+    : public ScalarOpPattern<FHE::ApplyManyLookupTablesEintOp> {
+  ApplyManyLookupTablesEintOpPattern(
+      mlir::TypeConverter &converter, mlir::MLIRContext *context,
+      mlir::concretelang::ScalarLoweringParameters loweringParams,
+      mlir::PatternBenefit benefit = 1)
+      : ScalarOpPattern<FHE::ApplyManyLookupTablesEintOp>(converter, context,
+                                                          benefit),
+        loweringParameters(loweringParams) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(FHE::ApplyManyLookupTablesEintOp op,
+                  FHE::ApplyManyLookupTablesEintOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+
+    auto inputType = op.getA().getType().cast<FHE::FheIntegerInterface>();
+    size_t outputBits = op.getResult(0)
+                            .getType()
+                            .cast<FHE::FheIntegerInterface>()
+                            .getWidth();
+    int64_t lutCount = op.getLuts().size();
+    int64_t lutSize = (int64_t)1 << inputType.getWidth();
+
+    // The luts are interleaved with a stride of the next power of two of
+    // their count, in boxes of an even number of coefficients per input
+    // value, which the polynomial must hold
+    int64_t lutStride = 1;
+    while (lutStride < lutCount) {
+      lutStride <<= 1;
+    }
+    if ((int64_t)loweringParameters.polynomialSize < 2 * lutStride * lutSize) {
+      op->emitError() << "the polynomial size "
+                      << loweringParameters.polynomialSize << " can't hold "
+                      << lutCount << " lookup tables on "
+                      << inputType.getWidth() << " bits";
+      return mlir::failure();
     }
 
-    // Insert keyswitch
-    auto ksOp = rewriter.create<TFHE::KeySwitchGLWEOp>(
-        op.getLoc(), getTypeConverter()->convertType(adaptor.getA().getType()),
-        input,
-        TFHE::GLWEKeyswitchKeyAttr::get(op.getContext(), TFHE::GLWESecretKey(),
-                                        TFHE::GLWESecretKey(), -1, -1, -1));
-    if (operatorIndexes != nullptr) {
-      ksOp->setAttr("TFHE.OId",
-                    rewriter.getI32IntegerAttr(
-                        operatorIndexes[operatorIndexes.size() - 1]));
+    // Stack the lookup tables in a lutCount x lutSize tensor
+    mlir::Value luts = rewriter.create<mlir::tensor::EmptyOp>(
+        op.getLoc(), mlir::ArrayRef<int64_t>{lutCount, lutSize},
+        rewriter.getI64Type());
+    for (auto [i, lut] : llvm::enumerate(op.getLuts())) {
+      luts = rewriter.create<mlir::tensor::InsertSliceOp>(
+          op.getLoc(), lut, luts,
+          mlir::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(i),
+                                             rewriter.getIndexAttr(0)},
+          mlir::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(1),
+                                             rewriter.getIndexAttr(lutSize)},
+          mlir::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(1),
+                                             rewriter.getIndexAttr(1)});
     }
+    mlir::Value newLut =
+        rewriter
+            .create<TFHE::EncodeExpandManyLutForBootstrapOp>(
+                op.getLoc(),
+                mlir::RankedTensorType::get(
+                    mlir::ArrayRef<int64_t>(loweringParameters.polynomialSize),
+                    rewriter.getI64Type()),
+                luts,
+                rewriter.getI32IntegerAttr(loweringParameters.polynomialSize),
+                rewriter.getI32IntegerAttr(outputBits),
+                rewriter.getBoolAttr(inputType.isSigned()))
+            .getResult();
 
-    // Insert bootstrap
-    auto bsOp = rewriter.replaceOpWithNewOp<TFHE::BootstrapGLWEOp>(
-        op, getTypeConverter()->convertType(op.getType()), ksOp, newLut,
+    auto operatorIndexes =
+        op->getAttrOfType<mlir::DenseI32ArrayAttr>("TFHE.OId");
+    auto ksOp = this->createBootstrapInput(op.getLoc(), inputType,
+                                           adaptor.getA(), operatorIndexes,
+                                           rewriter);
+
+    // Insert the many-LUT bootstrap
+    llvm::SmallVector<mlir::Type> resultTypes;
+    for (auto result : op.getResults()) {
+      resultTypes.push_back(getTypeConverter()->convertType(result.getType()));
+    }
+    auto bsOp = rewriter.replaceOpWithNewOp<TFHE::ManyLutBootstrapGLWEOp>(
+        op, resultTypes, ksOp, newLut,
         TFHE::GLWEBootstrapKeyAttr::get(op.getContext(), TFHE::GLWESecretKey(),
                                         TFHE::GLWESecretKey(), -1, -1, -1, -1,
                                         -1));
@@ -779,6 +885,8 @@ struct FHEToTFHEScalarPass : public FHEToTFHEScalarBase<FHEToTFHEScalarPass> {
                  lowering::ToUnsignedOpPattern>(converter, &getContext());
     //    |_ `FHE::apply_lookup_table`
     patterns.add<lowering::ApplyLookupTableEintOpPattern,
+                 //    |_ `FHE::apply_many_lookup_tables`
+                 lowering::ApplyManyLookupTablesEintOpPattern,
                  //    |_ `FHE::round`
                  lowering::RoundEintOpPattern>(converter, &getContext(),
                                                loweringParameters);
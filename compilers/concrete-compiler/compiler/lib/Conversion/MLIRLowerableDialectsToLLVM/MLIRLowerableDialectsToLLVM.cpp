@@ -103,6 +103,65 @@ struct Memref1DCopyOpPattern
   };
 };
 
+/// This rewrite pattern transforms the instances of `memref.copy` on
+/// multidimensional memrefs of 64 bits integers with a non identity layout,
+/// e.g. a copy from a subview or a transposed view, to a call to the runtime
+/// which copies the blocks contiguous in both memrefs with memcpy. The default
+/// lowering calls @memrefCopy which copies such memrefs element by element.
+///
+/// Example:
+///
+/// ```mlir
+/// memref.copy %src, %dst : memref<2x3xi64, strided<[?, ?], offset: ?>> to
+///                          memref<2x3xi64>
+/// ```
+///
+/// becomes:
+///
+/// ```mlir
+/// %_src = memref.cast %src : memref<2x3xi64, strided<[?, ?], offset: ?>> to
+///                            memref<*xi64>
+/// %_dst = memref.cast %dst : memref<2x3xi64> to memref<*xi64>
+/// call @memref_copy_blocks(%_src, %_dst) : (memref<*xi64>, memref<*xi64>)
+///   -> ()
+/// ```
+struct MemrefStridedCopyOpPattern
+    : public mlir::OpRewritePattern<mlir::memref::CopyOp> {
+  MemrefStridedCopyOpPattern(mlir::MLIRContext *context,
+                             mlir::PatternBenefit benefit = 1)
+      : mlir::OpRewritePattern<mlir::memref::CopyOp>(context, benefit) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::memref::CopyOp copyOp,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto srcType = copyOp.getSource().getType().dyn_cast<mlir::MemRefType>();
+    auto dstType = copyOp.getTarget().getType().dyn_cast<mlir::MemRefType>();
+    if (!srcType || !dstType || srcType.getRank() < 2 ||
+        !srcType.getElementType().isInteger(64) ||
+        !dstType.getElementType().isInteger(64) ||
+        (srcType.getLayout().isIdentity() &&
+         dstType.getLayout().isIdentity())) {
+      return mlir::failure();
+    }
+    auto opType = mlir::UnrankedMemRefType::get(rewriter.getI64Type(), 0);
+    if (insertForwardDeclaration(
+            copyOp, rewriter, "memref_copy_blocks",
+            mlir::FunctionType::get(rewriter.getContext(), {opType, opType},
+                                    {}))
+            .failed()) {
+      return mlir::failure();
+    }
+    auto sourceOp = rewriter.create<mlir::memref::CastOp>(
+        copyOp.getLoc(), opType, copyOp.getSource());
+    auto targetOp = rewriter.create<mlir::memref::CastOp>(
+        copyOp.getLoc(), opType, copyOp.getTarget());
+    rewriter.replaceOpWithNewOp<mlir::func::CallOp>(
+        copyOp, "memref_copy_blocks", mlir::TypeRange{},
+        mlir::ValueRange{sourceOp, targetOp});
+    return mlir::success();
+  };
+};
+
 void MLIRLowerableDialectsToLLVMPass::runOnOperation() {
   // Setup the conversion target. We reuse the LLVMConversionTarget that
   // legalize LLVM dialect.
@@ -120,6 +179,7 @@ void MLIRLowerableDialectsToLLVMPass::runOnOperation() {
   // convert the `scf` operations to `std` and `std` operations to `llvm`.
   mlir::RewritePatternSet patterns(&getContext());
   patterns.add<Memref1DCopyOpPattern>(&getContext(), 100);
+  patterns.add<MemrefStridedCopyOpPattern>(&getContext(), 100);
   mlir::concretelang::populateRTToLLVMConversionPatterns(typeConverter,
                                                          patterns);
   mlir::populateFuncToLLVMConversionPatterns(typeConverter, patterns);
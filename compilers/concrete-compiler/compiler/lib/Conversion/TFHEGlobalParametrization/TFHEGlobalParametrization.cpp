@@ -136,33 +136,37 @@ private:
   const mlir::concretelang::V0Parameter cryptoParameters;
 };
 
-struct BootstrapGLWEOpPattern
-    : public mlir::OpRewritePattern<TFHE::BootstrapGLWEOp> {
+/// Parametrizes the bootstraps, `BootstrapOp` is either `TFHE::BootstrapGLWEOp`
+/// or `TFHE::ManyLutBootstrapGLWEOp`.
+template <typename BootstrapOp>
+struct BootstrapGLWEOpPattern : public mlir::OpRewritePattern<BootstrapOp> {
   BootstrapGLWEOpPattern(mlir::MLIRContext *context,
                          TFHEGlobalParametrizationTypeConverter &converter,
                          const mlir::concretelang::V0Parameter cryptoParameters,
                          mlir::PatternBenefit benefit =
                              mlir::concretelang::DEFAULT_PATTERN_BENEFIT)
-      : mlir::OpRewritePattern<TFHE::BootstrapGLWEOp>(context, benefit),
+      : mlir::OpRewritePattern<BootstrapOp>(context, benefit),
         converter(converter), cryptoParameters(cryptoParameters) {}
 
   mlir::LogicalResult
-  matchAndRewrite(TFHE::BootstrapGLWEOp bsOp,
+  matchAndRewrite(BootstrapOp bsOp,
                   mlir::PatternRewriter &rewriter) const override {
-    auto inputTy =
-        bsOp.getCiphertext().getType().cast<TFHE::GLWECipherTextType>();
+    auto inputTy = bsOp.getCiphertext()
+                       .getType()
+                       .template cast<TFHE::GLWECipherTextType>();
     auto newInputTy = converter.glweIntraPBSType(inputTy);
-    auto outputTy = bsOp.getResult().getType().cast<TFHE::GLWECipherTextType>();
-    auto newOutputTy =
-        converter.convertType(outputTy).cast<TFHE::GLWECipherTextType>();
+    llvm::SmallVector<mlir::Type> newOutputTys;
+    for (auto outputTy : bsOp->getResultTypes()) {
+      newOutputTys.push_back(converter.convertType(outputTy));
+    }
     auto newInputKey = converter.getIntraPBSKey();
     auto newOutputKey = converter.getInterPBSKey();
     auto bootstrapKey = TFHE::GLWEBootstrapKeyAttr::get(
         bsOp->getContext(), newInputKey, newOutputKey,
         cryptoParameters.getPolynomialSize(), cryptoParameters.glweDimension,
         cryptoParameters.brLevel, cryptoParameters.brLogBase, -1);
-    auto newOp = rewriter.replaceOpWithNewOp<TFHE::BootstrapGLWEOp>(
-        bsOp, newOutputTy, bsOp.getCiphertext(), bsOp.getLookupTable(),
+    auto newOp = rewriter.replaceOpWithNewOp<BootstrapOp>(
+        bsOp, newOutputTys, bsOp.getCiphertext(), bsOp.getLookupTable(),
         bootstrapKey);
     rewriter.startRootUpdate(newOp);
     newOp.getCiphertext().setType(newInputTy);
@@ -175,6 +179,16 @@ private:
   const mlir::concretelang::V0Parameter cryptoParameters;
 };
 
+/// Returns true if the key of the bootstrap `op` is parametrized.
+template <typename BootstrapOp> bool isParametrizedBootstrap(BootstrapOp op) {
+  return op.getKeyAttr().getInputKey().isParameterized() &&
+         op.getKeyAttr().getOutputKey().isParameterized() &&
+         op.getKeyAttr().getLevels() != -1 &&
+         op.getKeyAttr().getBaseLog() != -1 &&
+         op.getKeyAttr().getGlweDim() != -1 &&
+         op.getKeyAttr().getPolySize() != -1;
+}
+
 struct WopPBSGLWEOpPattern : public mlir::OpRewritePattern<TFHE::WopPBSGLWEOp> {
   WopPBSGLWEOpPattern(mlir::MLIRContext *context,
                       TFHEGlobalParametrizationTypeConverter &converter,
@@ -305,17 +319,13 @@ void TFHEGlobalParametrizationPass::runOnOperation() {
         });
 
     // Parametrize bootstrap
-    patterns.add<BootstrapGLWEOpPattern>(&getContext(), converter,
-                                         cryptoParameters);
+    patterns.add<BootstrapGLWEOpPattern<TFHE::BootstrapGLWEOp>,
+                 BootstrapGLWEOpPattern<TFHE::ManyLutBootstrapGLWEOp>>(
+        &getContext(), converter, cryptoParameters);
     target.addDynamicallyLegalOp<TFHE::BootstrapGLWEOp>(
-        [&](TFHE::BootstrapGLWEOp op) {
-          return op.getKeyAttr().getInputKey().isParameterized() &&
-                 op.getKeyAttr().getOutputKey().isParameterized() &&
-                 op.getKeyAttr().getLevels() != -1 &&
-                 op.getKeyAttr().getBaseLog() != -1 &&
-                 op.getKeyAttr().getGlweDim() != -1 &&
-                 op.getKeyAttr().getPolySize() != -1;
-        });
+        isParametrizedBootstrap<TFHE::BootstrapGLWEOp>);
+    target.addDynamicallyLegalOp<TFHE::ManyLutBootstrapGLWEOp>(
+        isParametrizedBootstrap<TFHE::ManyLutBootstrapGLWEOp>);
 
     // Parametrize wop pbs
     patterns.add<WopPBSGLWEOpPattern>(&getContext(), converter,
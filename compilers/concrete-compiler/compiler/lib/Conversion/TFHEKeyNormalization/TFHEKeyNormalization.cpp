@@ -142,28 +142,33 @@ private:
   conversion::TypeConverter &typeConverter;
 };
 
-struct BootstrapGLWEOpPattern
-    : public mlir::OpRewritePattern<TFHE::BootstrapGLWEOp> {
+/// Normalizes the keys of the bootstraps, `BootstrapOp` is either
+/// `TFHE::BootstrapGLWEOp` or `TFHE::ManyLutBootstrapGLWEOp`.
+template <typename BootstrapOp>
+struct BootstrapGLWEOpPattern : public mlir::OpRewritePattern<BootstrapOp> {
   BootstrapGLWEOpPattern(mlir::MLIRContext *context,
                          conversion::TypeConverter &typeConverter,
                          conversion::KeyConverter &keyConverter,
                          mlir::PatternBenefit benefit =
                              mlir::concretelang::DEFAULT_PATTERN_BENEFIT)
-      : mlir::OpRewritePattern<TFHE::BootstrapGLWEOp>(context, benefit),
+      : mlir::OpRewritePattern<BootstrapOp>(context, benefit),
         keyConverter(keyConverter), typeConverter(typeConverter) {}
 
   mlir::LogicalResult
-  matchAndRewrite(TFHE::BootstrapGLWEOp bsOp,
+  matchAndRewrite(BootstrapOp bsOp,
                   mlir::PatternRewriter &rewriter) const override {
     auto newInputTy = typeConverter.convertType(bsOp.getCiphertext().getType())
-                          .cast<GLWECipherTextType>();
-    auto newOutputTy = typeConverter.convertType(bsOp.getResult().getType());
+                          .template cast<GLWECipherTextType>();
+    llvm::SmallVector<mlir::Type> newOutputTys;
+    for (auto outputTy : bsOp->getResultTypes()) {
+      newOutputTys.push_back(typeConverter.convertType(outputTy));
+    }
     auto newBootstrapKey = keyConverter.convertBootstrapKey(bsOp.getKeyAttr());
-    auto newOp = rewriter.replaceOpWithNewOp<TFHE::BootstrapGLWEOp>(
-        bsOp, newOutputTy, bsOp.getCiphertext(), bsOp.getLookupTable(),
+    auto newOp = rewriter.replaceOpWithNewOp<BootstrapOp>(
+        bsOp, newOutputTys, bsOp.getCiphertext(), bsOp.getLookupTable(),
         newBootstrapKey);
     rewriter.startRootUpdate(newOp);
-    newOp.getCiphertext().setType(newInputTy.cast<GLWECipherTextType>());
+    newOp.getCiphertext().setType(newInputTy);
     rewriter.finalizeRootUpdate(newOp);
     return mlir::success();
   };
@@ -173,6 +178,13 @@ private:
   conversion::TypeConverter &typeConverter;
 };
 
+/// Returns true if the key of the bootstrap `op` is normalized.
+template <typename BootstrapOp> bool isNormalizedBootstrap(BootstrapOp op) {
+  return op.getKeyAttr().getInputKey().isNormalized() &&
+         op.getKeyAttr().getOutputKey().isNormalized() &&
+         op.getKeyAttr().getIndex() != -1;
+}
+
 struct WopPBSGLWEOpPattern : public mlir::OpRewritePattern<TFHE::WopPBSGLWEOp> {
   WopPBSGLWEOpPattern(mlir::MLIRContext *context,
                       conversion::TypeConverter &typeConverter,
@@ -292,14 +304,14 @@ void TFHEKeyNormalizationPass::runOnOperation() {
         });
 
     // Parametrize bootstrap
-    patterns.add<patterns::BootstrapGLWEOpPattern>(&getContext(), typeConverter,
-                                                   keyConverter);
+    patterns.add<
+        patterns::BootstrapGLWEOpPattern<TFHE::BootstrapGLWEOp>,
+        patterns::BootstrapGLWEOpPattern<TFHE::ManyLutBootstrapGLWEOp>>(
+        &getContext(), typeConverter, keyConverter);
     target.addDynamicallyLegalOp<TFHE::BootstrapGLWEOp>(
-        [&](TFHE::BootstrapGLWEOp op) {
-          return op.getKeyAttr().getInputKey().isNormalized() &&
-                 op.getKeyAttr().getOutputKey().isNormalized() &&
-                 op.getKeyAttr().getIndex() != -1;
-        });
+        patterns::isNormalizedBootstrap<TFHE::BootstrapGLWEOp>);
+    target.addDynamicallyLegalOp<TFHE::ManyLutBootstrapGLWEOp>(
+        patterns::isNormalizedBootstrap<TFHE::ManyLutBootstrapGLWEOp>);
 
     // Parametrize wop pbs
     patterns.add<patterns::WopPBSGLWEOpPattern>(&getContext(), typeConverter,
@@ -141,6 +141,61 @@ struct BootstrapGLWEOpPattern
   }
 };
 
+struct ManyLutBootstrapGLWEOpPattern
+    : public mlir::OpConversionPattern<TFHE::ManyLutBootstrapGLWEOp> {
+
+  ManyLutBootstrapGLWEOpPattern(mlir::MLIRContext *context,
+                                mlir::TypeConverter &typeConverter)
+      : mlir::OpConversionPattern<TFHE::ManyLutBootstrapGLWEOp>(
+            typeConverter, context,
+            mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  ::mlir::LogicalResult
+  matchAndRewrite(TFHE::ManyLutBootstrapGLWEOp bsOp,
+                  TFHE::ManyLutBootstrapGLWEOp::Adaptor adaptor,
+                  mlir::ConversionPatternRewriter &rewriter) const override {
+    TFHE::GLWECipherTextType inputType =
+        bsOp.getCiphertext().getType().cast<TFHE::GLWECipherTextType>();
+
+    auto polySize = adaptor.getKey().getPolySize();
+    auto glweDimension = adaptor.getKey().getGlweDim();
+    auto levels = adaptor.getKey().getLevels();
+    auto baseLog = adaptor.getKey().getBaseLog();
+    auto inputLweDimension =
+        inputType.getKey().getNormalized().value().dimension;
+    auto bskIndex = bsOp.getKeyAttr().getIndex();
+
+    // All the results are bootstrapped in a single tensor, one row per
+    // lookup table
+    auto resultType = this->getTypeConverter()
+                          ->convertType(bsOp.getResult(0).getType())
+                          .cast<mlir::RankedTensorType>();
+    int64_t lutCount = bsOp.getNumResults();
+    int64_t lweSize = resultType.getDimSize(0);
+    auto manyLutOp = rewriter.create<Concrete::ManyLutBootstrapLweTensorOp>(
+        bsOp.getLoc(),
+        mlir::RankedTensorType::get({lutCount, lweSize},
+                                    resultType.getElementType()),
+        adaptor.getCiphertext(), adaptor.getLookupTable(), inputLweDimension,
+        polySize, levels, baseLog, glweDimension, bskIndex);
+
+    llvm::SmallVector<mlir::Value> results;
+    for (int64_t i = 0; i < lutCount; i++) {
+      results.push_back(rewriter.create<mlir::tensor::ExtractSliceOp>(
+          bsOp.getLoc(), resultType, manyLutOp,
+          mlir::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(i),
+                                             rewriter.getIndexAttr(0)},
+          mlir::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(1),
+                                             rewriter.getIndexAttr(lweSize)},
+          mlir::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(1),
+                                             rewriter.getIndexAttr(1)}));
+    }
+    rewriter.replaceOp(bsOp, results);
+
+    return mlir::success();
+  }
+};
+
 struct WopPBSGLWEOpPattern
     : public mlir::OpConversionPattern<TFHE::WopPBSGLWEOp> {
 
@@ -790,6 +845,10 @@ void TFHEToConcretePass::runOnOperation() {
           mlir::concretelang::TFHE::EncodeExpandLutForBootstrapOp,
           mlir::concretelang::Concrete::EncodeExpandLutForBootstrapTensorOp,
           true>,
+      mlir::concretelang::GenericOneToOneOpConversionPattern<
+          mlir::concretelang::TFHE::EncodeExpandManyLutForBootstrapOp,
+          mlir::concretelang::Concrete::EncodeExpandManyLutForBootstrapTensorOp,
+          true>,
       mlir::concretelang::GenericOneToOneOpConversionPattern<
           mlir::concretelang::TFHE::EncodeLutForCrtWopPBSOp,
           mlir::concretelang::Concrete::EncodeLutForCrtWopPBSTensorOp, true>,
@@ -802,6 +861,7 @@ void TFHEToConcretePass::runOnOperation() {
                   ZeroOpPattern<mlir::concretelang::TFHE::ZeroTensorGLWEOp>>(
       &getContext());
   patterns.insert<SubIntGLWEOpPattern, BootstrapGLWEOpPattern,
+                  ManyLutBootstrapGLWEOpPattern,
                   BatchedBootstrapGLWEOpPattern, KeySwitchGLWEOpPattern,
                   BatchedKeySwitchGLWEOpPattern, WopPBSGLWEOpPattern>(
       &getContext(), converter);
@@ -123,6 +123,10 @@ void mlir::concretelang::Concrete::
     // bootstrap_lwe_tensor => bootstrap_lwe_buffer
     Concrete::BootstrapLweTensorOp::attachInterface<TensorToMemrefOp<
         Concrete::BootstrapLweTensorOp, Concrete::BootstrapLweBufferOp>>(*ctx);
+    // many_lut_bootstrap_lwe_tensor => many_lut_bootstrap_lwe_buffer
+    Concrete::ManyLutBootstrapLweTensorOp::attachInterface<
+        TensorToMemrefOp<Concrete::ManyLutBootstrapLweTensorOp,
+                         Concrete::ManyLutBootstrapLweBufferOp>>(*ctx);
     // batched_keyswitch_lwe_tensor => batched_keyswitch_lwe_buffer
     Concrete::BatchedKeySwitchLweTensorOp::attachInterface<
         TensorToMemrefOp<Concrete::BatchedKeySwitchLweTensorOp,
@@ -143,6 +147,12 @@ void mlir::concretelang::Concrete::
     Concrete::EncodeExpandLutForBootstrapTensorOp::attachInterface<
         TensorToMemrefOp<Concrete::EncodeExpandLutForBootstrapTensorOp,
                          Concrete::EncodeExpandLutForBootstrapBufferOp>>(*ctx);
+    // encode_expand_many_lut_for_bootstrap_tensor =>
+    // encode_expand_many_lut_for_bootstrap_buffer
+    Concrete::EncodeExpandManyLutForBootstrapTensorOp::attachInterface<
+        TensorToMemrefOp<Concrete::EncodeExpandManyLutForBootstrapTensorOp,
+                         Concrete::EncodeExpandManyLutForBootstrapBufferOp>>(
+        *ctx);
     // encode_lut_for_crt_woppbs_tensor =>
     // encode_lut_for_crt_woppbs_buffer
     Concrete::EncodeLutForCrtWopPBSTensorOp::attachInterface<
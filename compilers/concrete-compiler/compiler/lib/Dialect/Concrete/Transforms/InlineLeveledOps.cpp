@@ -0,0 +1,178 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Dialect/Tensor/IR/Tensor.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include "concretelang/Dialect/Concrete/IR/ConcreteDialect.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Dialect/Concrete/Transforms/Passes.h"
+
+namespace Concrete = mlir::concretelang::Concrete;
+
+namespace {
+
+/// Ciphertexts read by the leveled operations, in the order of the arguments
+/// of the body of the `linalg.generic` computing them.
+mlir::SmallVector<mlir::Value> ciphertexts(Concrete::AddLweTensorOp op) {
+  return {op.getLhs(), op.getRhs()};
+}
+
+mlir::SmallVector<mlir::Value>
+ciphertexts(Concrete::AddPlaintextLweTensorOp op) {
+  return {op.getLhs()};
+}
+
+mlir::SmallVector<mlir::Value>
+ciphertexts(Concrete::MulCleartextLweTensorOp op) {
+  return {op.getLhs()};
+}
+
+mlir::SmallVector<mlir::Value> ciphertexts(Concrete::NegateLweTensorOp op) {
+  return {op.getCiphertext()};
+}
+
+/// Builds the computation of one element of the result of the leveled
+/// operations from the elements `args` of their ciphertexts, with the same
+/// wrapping arithmetic modulo 2^64 as the runtime.
+mlir::Value buildElement(mlir::OpBuilder &builder, mlir::Location loc,
+                         Concrete::AddLweTensorOp op, mlir::ValueRange args,
+                         int64_t size) {
+  return builder.create<mlir::arith::AddIOp>(loc, args[0], args[1]);
+}
+
+/// The plaintext is only added to the body of the ciphertext, i.e. its last
+/// element, the mask being copied as is.
+mlir::Value buildElement(mlir::OpBuilder &builder, mlir::Location loc,
+                         Concrete::AddPlaintextLweTensorOp op,
+                         mlir::ValueRange args, int64_t size) {
+  mlir::Value index = builder.create<mlir::linalg::IndexOp>(loc, 0);
+  mlir::Value bodyIndex =
+      builder.create<mlir::arith::ConstantIndexOp>(loc, size - 1);
+  mlir::Value isBody = builder.create<mlir::arith::CmpIOp>(
+      loc, mlir::arith::CmpIPredicate::eq, index, bodyIndex);
+  mlir::Value zero = builder.create<mlir::arith::ConstantIntOp>(loc, 0, 64);
+  mlir::Value plaintext =
+      builder.create<mlir::arith::SelectOp>(loc, isBody, op.getRhs(), zero);
+  return builder.create<mlir::arith::AddIOp>(loc, args[0], plaintext);
+}
+
+mlir::Value buildElement(mlir::OpBuilder &builder, mlir::Location loc,
+                         Concrete::MulCleartextLweTensorOp op,
+                         mlir::ValueRange args, int64_t size) {
+  return builder.create<mlir::arith::MulIOp>(loc, args[0], op.getRhs());
+}
+
+mlir::Value buildElement(mlir::OpBuilder &builder, mlir::Location loc,
+                         Concrete::NegateLweTensorOp op, mlir::ValueRange args,
+                         int64_t size) {
+  mlir::Value zero = builder.create<mlir::arith::ConstantIntOp>(loc, 0, 64);
+  return builder.create<mlir::arith::SubIOp>(loc, zero, args[0]);
+}
+
+/// Rewrites a leveled operation on a lwe ciphertext to a `linalg.generic`
+/// computing its elements, instead of a call to the runtime.
+///
+/// Example:
+///
+/// ```mlir
+/// %r = "Concrete.add_lwe_tensor"(%a, %b)
+///        : (tensor<1025xi64>, tensor<1025xi64>) -> tensor<1025xi64>
+/// ```
+///
+/// becomes:
+///
+/// ```mlir
+/// %e = tensor.empty() : tensor<1025xi64>
+/// %r = linalg.generic {indexing_maps = [(d0) -> (d0), (d0) -> (d0),
+///                                       (d0) -> (d0)],
+///                      iterator_types = ["parallel"]}
+///        ins(%a, %b : tensor<1025xi64>, tensor<1025xi64>)
+///        outs(%e : tensor<1025xi64>) {
+///   ^bb0(%x: i64, %y: i64, %z: i64):
+///     %s = arith.addi %x, %y : i64
+///     linalg.yield %s : i64
+/// } -> tensor<1025xi64>
+/// ```
+template <typename LeveledOp>
+struct LeveledOpToLinalgPattern : public mlir::OpRewritePattern<LeveledOp> {
+  LeveledOpToLinalgPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<LeveledOp>(context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(LeveledOp op,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto type = op.getResult()
+                    .getType()
+                    .template cast<mlir::RankedTensorType>();
+    // Ciphertexts of dynamic size keep the runtime implementation
+    if (!type.hasStaticShape()) {
+      return mlir::failure();
+    }
+    int64_t size = type.getDimSize(0);
+
+    mlir::SmallVector<mlir::Value> inputs = ciphertexts(op);
+    mlir::Value init = rewriter.create<mlir::tensor::EmptyOp>(
+        op.getLoc(), type.getShape(), type.getElementType());
+    mlir::SmallVector<mlir::AffineMap> maps(
+        inputs.size() + 1, rewriter.getMultiDimIdentityMap(1));
+    mlir::SmallVector<mlir::utils::IteratorType> iteratorTypes{
+        mlir::utils::IteratorType::parallel};
+
+    auto genericOp = rewriter.create<mlir::linalg::GenericOp>(
+        op.getLoc(), mlir::TypeRange{type}, inputs, mlir::ValueRange{init},
+        maps, iteratorTypes,
+        [&](mlir::OpBuilder &builder, mlir::Location loc,
+            mlir::ValueRange args) {
+          mlir::Value element = buildElement(builder, loc, op, args, size);
+          builder.create<mlir::linalg::YieldOp>(loc, element);
+        });
+    rewriter.replaceOp(op, genericOp.getResults());
+    return mlir::success();
+  }
+};
+
+struct InlineLeveledOpsPass
+    : public InlineLeveledOpsBase<InlineLeveledOpsPass> {
+  void runOnOperation() override {
+    mlir::MLIRContext *context = &getContext();
+    mlir::RewritePatternSet patterns(context);
+    patterns.add<LeveledOpToLinalgPattern<Concrete::AddLweTensorOp>,
+                 LeveledOpToLinalgPattern<Concrete::AddPlaintextLweTensorOp>,
+                 LeveledOpToLinalgPattern<Concrete::MulCleartextLweTensorOp>,
+                 LeveledOpToLinalgPattern<Concrete::NegateLweTensorOp>>(
+        context);
+
+    // A producer is only fused in its single consumer, as it would otherwise
+    // be computed once per consumer.
+    mlir::linalg::populateElementwiseOpsFusionPatterns(
+        patterns, [](mlir::OpOperand *fusedOperand) {
+          mlir::Operation *producer = fusedOperand->get().getDefiningOp();
+          return producer != nullptr && producer->hasOneUse();
+        });
+
+    if (mlir::applyPatternsAndFoldGreedily(getOperation(), std::move(patterns))
+            .failed()) {
+      signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createInlineLeveledOpsPass() {
+  return std::make_unique<InlineLeveledOpsPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
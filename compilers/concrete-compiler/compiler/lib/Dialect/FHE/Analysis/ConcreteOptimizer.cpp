@@ -141,6 +141,12 @@ struct FunctionToDag {
              mlir::isa<mlir::concretelang::Tracing::TraceCiphertextOp>(op));
       return;
     }
+    if (auto manyLut =
+            llvm::dyn_cast<FHE::ApplyManyLookupTablesEintOp>(op)) {
+      // special case as all the results come from the same bootstrap
+      addManyLut(dag, manyLut, encrypted_inputs);
+      return;
+    }
     assert(op.getNumResults() == 1);
     auto val = op.getResult(0);
     auto precision = fhe::utils::getEintPrecision(val);
@@ -210,13 +216,44 @@ struct FunctionToDag {
     index[val] = lutIndex;
   }
 
+  void addManyLut(optimizer::Dag &dag, FHE::ApplyManyLookupTablesEintOp &op,
+                  Inputs &encrypted_inputs) {
+    assert(encrypted_inputs.size() == 1);
+    auto inputType = op.getA().getType().cast<FHE::FheIntegerInterface>();
+    auto precision = fhe::utils::getEintPrecision(op.getResult(0));
+    auto encrypted_input = encrypted_inputs[0];
+    std::vector<std::uint64_t> unknowFunction;
+    std::vector<int32_t> operatorIndexes;
+    if (inputType.isSigned()) {
+      encrypted_input = dag->add_dot(slice(encrypted_inputs),
+                                     concrete_optimizer::weights::vector(
+                                         slice(std::vector<std::int64_t>{1})));
+      operatorIndexes.push_back(encrypted_input.index);
+    }
+    // The lookup tables are interleaved in the accumulator, so the bootstrap
+    // runs on `ceil(log2(n))` more bits than the input precision
+    auto lutPrecision =
+        inputType.getWidth() + llvm::Log2_64_Ceil(op.getLuts().size());
+    encrypted_input = dag->add_unsafe_cast(encrypted_input, lutPrecision);
+    auto lutIndex =
+        dag->add_lut(encrypted_input, slice(unknowFunction), precision);
+    operatorIndexes.push_back(lutIndex.index);
+    mlir::Builder builder(op.getContext());
+    if (setOptimizerID)
+      op->setAttr("TFHE.OId", builder.getDenseI32ArrayAttr(operatorIndexes));
+    for (auto result : op.getResults()) {
+      index[result] = lutIndex;
+    }
+  }
+
   concrete_optimizer::dag::OperatorIndex addRound(optimizer::Dag &dag,
                                                   mlir::Value &val,
                                                   Inputs &encrypted_inputs,
                                                   int rounded_precision) {
     assert(encrypted_inputs.size() == 1);
-    // No need to distinguish different lut kind until we do approximate
-    // paradigm on outputs
+    // The roundings which are cheaper with lookup tables are rewritten before
+    // the dag is built, the remaining ones discard their bits one by one as
+    // the round operator is expanded by the optimizer
     auto encrypted_input = encrypted_inputs[0];
     index[val] = dag->add_round_op(encrypted_input, rounded_precision);
     return index[val];
@@ -1316,8 +1316,6 @@ public:
 
   void visitOperation(Operation *op, ArrayRef<const MANPLattice *> operands,
                       ArrayRef<MANPLattice *> results) override {
-    MANPLattice *latticeRes = results[0];
-
     bool isDummy = false;
     llvm::APInt norm2SqEquiv;
 
@@ -1363,7 +1361,9 @@ public:
       norm2SqEquiv = getSqMANP(maxEintOp, operands);
     } else if (llvm::isa<mlir::concretelang::FHE::ZeroEintOp>(op) ||
                llvm::isa<mlir::concretelang::FHE::ZeroTensorOp>(op) ||
-               llvm::isa<mlir::concretelang::FHE::ApplyLookupTableEintOp>(op)) {
+               llvm::isa<mlir::concretelang::FHE::ApplyLookupTableEintOp>(op) ||
+               llvm::isa<mlir::concretelang::FHE::ApplyManyLookupTablesEintOp>(
+                   op)) {
       norm2SqEquiv = llvm::APInt{1, 1, false};
     } else if (llvm::isa<mlir::concretelang::FHE::ToBoolOp>(op) ||
                llvm::isa<mlir::concretelang::FHE::FromBoolOp>(op)) {
@@ -1559,7 +1559,10 @@ public:
     }
 
     if (!isDummy) {
-      latticeRes->join(MANPLatticeValue{norm2SqEquiv});
+      // All the results of a multi-result operation share the same norm
+      for (MANPLattice *result : results) {
+        result->join(MANPLatticeValue{norm2SqEquiv});
+      }
 
       op->setAttr("SMANP",
                   mlir::IntegerAttr::get(
@@ -1582,7 +1585,9 @@ public:
             << APIntToStringValUnsigned(norm2SqEquiv) << "\n";
       }
     } else {
-      latticeRes->join(MANPLatticeValue{});
+      for (MANPLattice *result : results) {
+        result->join(MANPLatticeValue{});
+      }
     }
   }
 
@@ -1648,6 +1653,21 @@ protected:
       }
     }
 
+    // A many-LUT bootstrap needs `ceil(log2(n))` more bits of precision than
+    // its input to fit the `n` interleaved lookup tables
+    if (auto manyLutOp = llvm::dyn_cast<
+            mlir::concretelang::FHE::ApplyManyLookupTablesEintOp>(op)) {
+      uint64_t inputManp = 1;
+      if (auto inputOp = manyLutOp.getA().getDefiningOp()) {
+        if (auto attr = inputOp->getAttrOfType<mlir::IntegerAttr>("MANP")) {
+          inputManp = attr.getValue().getZExtValue();
+        }
+      }
+      unsigned int width = fhe::utils::getEintPrecision(manyLutOp.getA());
+      this->updateMax(inputManp,
+                      width + llvm::Log2_64_Ceil(manyLutOp.getLuts().size()));
+    }
+
     // Process all results using MANP attribute from MANP pas
     for (mlir::OpResult res : op->getResults()) {
       mlir::concretelang::FHE::FheIntegerInterface eTy =
@@ -280,6 +280,46 @@ mlir::LogicalResult GenGateOp::verify() {
   return mlir::success();
 }
 
+mlir::LogicalResult ApplyManyLookupTablesEintOp::verify() {
+  auto ct = this->getA().getType().cast<FheIntegerInterface>();
+  auto luts = this->getLuts();
+
+  if (luts.size() < 2) {
+    this->emitOpError() << "should have at least two lookup tables";
+    return mlir::failure();
+  }
+  if (luts.size() != this->getResults().size()) {
+    this->emitOpError() << "should have as many results as lookup tables";
+    return mlir::failure();
+  }
+
+  // Check the shape of lut arguments
+  auto width = ct.getWidth();
+  auto expectedSize = 1 << width;
+
+  mlir::SmallVector<int64_t, 1> expectedShape{expectedSize};
+  for (auto lut : luts) {
+    auto lutType = lut.getType().cast<TensorType>();
+    if (!lutType.hasStaticShape(expectedShape)) {
+      emitErrorBadLutSize(*this, "luts", "ct", expectedSize, width);
+      return mlir::failure();
+    }
+    if (!lutType.getElementType().isInteger(64)) {
+      this->emitOpError() << "should have the i64 constant";
+      return mlir::failure();
+    }
+  }
+
+  auto resultType = this->getResults().front().getType();
+  for (auto result : this->getResults()) {
+    if (result.getType() != resultType) {
+      this->emitOpError() << "should have results of the same type";
+      return mlir::failure();
+    }
+  }
+  return mlir::success();
+}
+
 mlir::LogicalResult RoundEintOp::verify() {
   auto input = this->getInput().getType().cast<FheIntegerInterface>();
   auto output = this->getResult().getType().cast<FheIntegerInterface>();
@@ -16,8 +16,11 @@
 #include <concretelang/Dialect/FHE/IR/FHEOps.h>
 #include <concretelang/Dialect/FHE/IR/FHETypes.h>
 #include <concretelang/Dialect/FHE/Transforms/BigInt/BigInt.h>
+#include <concretelang/Dialect/FHELinalg/IR/FHELinalgOps.h>
 #include <concretelang/Support/Constants.h>
 
+#include <functional>
+
 namespace mlir {
 namespace concretelang {
 
@@ -43,6 +46,47 @@ mlir::Value getTruthTableCarryExtract(mlir::PatternRewriter &rewriter,
   return truthTable.getResult();
 }
 
+/// States of a chunk, or of a range of chunks, in the carry-lookahead
+/// addition: the range either kills an incoming carry, propagates it, or
+/// generates a carry whatever the incoming one.
+enum CarryState : uint64_t { KILL = 0, PROPAGATE = 1, GENERATE = 2 };
+
+/// Constructs a constant tensor of `tableSize` values computed by `f`, used as
+/// a lookup table on chunks.
+mlir::Value getTable(mlir::PatternRewriter &rewriter, mlir::Location loc,
+                     unsigned int tableSize,
+                     std::function<uint64_t(uint64_t)> f) {
+  std::vector<llvm::APInt> values;
+  values.reserve(tableSize);
+  for (uint64_t i = 0; i < tableSize; i++)
+    values.push_back(llvm::APInt(64, f(i), false));
+  auto tableAttr = mlir::DenseElementsAttr::get(
+      mlir::RankedTensorType::get({tableSize}, rewriter.getIntegerType(64)),
+      values);
+  return rewriter.create<mlir::arith::ConstantOp>(loc, tableAttr).getResult();
+}
+
+/// Constructs a constant tensor holding the single value `value`, broadcasted
+/// by the FHELinalg operations with a clear operand.
+mlir::Value getBroadcastedConstant(mlir::PatternRewriter &rewriter,
+                                   mlir::Location loc, uint64_t value,
+                                   unsigned int width) {
+  auto type = mlir::RankedTensorType::get({1}, rewriter.getIntegerType(width));
+  auto attr = mlir::DenseElementsAttr::get(type, llvm::APInt(width, value));
+  return rewriter.create<mlir::arith::ConstantOp>(loc, attr).getResult();
+}
+
+/// Returns the depth, in lookup tables, of the carry-lookahead addition of
+/// `numberOfChunks` chunks: the lookup of the states, the
+/// `ceil(log2(numberOfChunks))` levels of the network and the extraction of
+/// the carries.
+int64_t getPrefixCarryDepth(int64_t numberOfChunks) {
+  int64_t depth = 2;
+  for (int64_t distance = 1; distance < numberOfChunks; distance *= 2)
+    depth++;
+  return depth;
+}
+
 namespace {
 
 namespace typing {
@@ -81,14 +125,23 @@ public:
 
 } // namespace typing
 
+/// Lowers the addition of chunked integers, either with a ripple carry, where
+/// the carry of each chunk is extracted with a lookup table before adding it
+/// to the next chunk, or with a carry-lookahead (Kogge-Stone) network, whose
+/// depth is logarithmic in the number of chunks but which needs about
+/// `log2(numberOfChunks)` times more lookup tables. The latter is chosen when
+/// the lookup tables of a level of the network can run in parallel and it is
+/// shallower than the ripple carry.
 class AddEintPattern
     : public mlir::OpConversionPattern<mlir::concretelang::FHE::AddEintOp> {
 public:
   AddEintPattern(mlir::TypeConverter &converter, mlir::MLIRContext *context,
-                 unsigned int chunkSize, unsigned int chunkWidth)
+                 unsigned int chunkSize, unsigned int chunkWidth,
+                 bool parallelCarries)
       : mlir::OpConversionPattern<mlir::concretelang::FHE::AddEintOp>(
             converter, context, ::mlir::concretelang::DEFAULT_PATTERN_BENEFIT),
-        chunkSize(chunkSize), chunkWidth(chunkWidth) {}
+        chunkSize(chunkSize), chunkWidth(chunkWidth),
+        parallelCarries(parallelCarries) {}
 
   mlir::LogicalResult
   matchAndRewrite(FHE::AddEintOp op, FHE::AddEintOp::Adaptor adaptor,
@@ -105,6 +158,16 @@ public:
     assert(eintChunkWidth == chunkSize && "wrong tensor elements width");
     auto numberOfChunks = shape[0];
 
+    // The combination of the states of two ranges of chunks is looked up
+    // from `3 * high + low`, which needs 4 bits. The ripple carry has one
+    // lookup table per chunk on its critical path, so the network is
+    // shallower from 6 chunks on.
+    if (parallelCarries && chunkSize >= 4 &&
+        getPrefixCarryDepth(numberOfChunks) < numberOfChunks) {
+      rewriter.replaceOp(op, lowerWithPrefixCarries(op, adaptor, rewriter));
+      return mlir::success();
+    }
+
     mlir::Value carry =
         rewriter
             .create<FHE::ZeroEintOp>(op.getLoc(),
@@ -165,15 +228,117 @@ public:
   }
 
 private:
+  /// Lowers the addition with a Kogge-Stone network on the carry states of
+  /// the chunks, each level of the network being a single FHELinalg lookup
+  /// table on all the chunks:
+  ///
+  /// 1. the chunks are added and the state of each chunk is looked up from
+  ///    its sum: generate if it overflows, propagate if it is the largest
+  ///    value of a chunk, kill otherwise;
+  /// 2. at each level `d`, the state of chunk `i >= d` is combined with the
+  ///    state of chunk `i - d`, so that after `ceil(log2(numberOfChunks))`
+  ///    levels, the state of chunk `i` is the state of the chunks `0..i`;
+  /// 3. the carry out of each chunk is generated iff its final state is
+  ///    generate, and is moved from the chunk to the next one.
+  mlir::Value
+  lowerWithPrefixCarries(FHE::AddEintOp op, FHE::AddEintOp::Adaptor adaptor,
+                         mlir::ConversionPatternRewriter &rewriter) const {
+    auto loc = op.getLoc();
+    auto tensorType = adaptor.getA().getType().cast<mlir::RankedTensorType>();
+    auto numberOfChunks = tensorType.getDimSize(0);
+    auto tableSize = 1u << chunkSize;
+    uint64_t chunkMax = (1u << chunkWidth) - 1;
+
+    auto sliceType = [&](int64_t size) {
+      return mlir::RankedTensorType::get({size}, tensorType.getElementType());
+    };
+    auto extractSlice = [&](mlir::Value tensor, int64_t offset,
+                            int64_t size) -> mlir::Value {
+      return rewriter.create<mlir::tensor::ExtractSliceOp>(
+          loc, sliceType(size), tensor,
+          llvm::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(offset)},
+          llvm::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(size)},
+          llvm::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(1)});
+    };
+    auto insertSlice = [&](mlir::Value slice, mlir::Value tensor,
+                           int64_t offset, int64_t size) -> mlir::Value {
+      return rewriter.create<mlir::tensor::InsertSliceOp>(
+          loc, slice, tensor,
+          llvm::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(offset)},
+          llvm::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(size)},
+          llvm::ArrayRef<mlir::OpFoldResult>{rewriter.getIndexAttr(1)});
+    };
+
+    // 1. sums and states of the chunks
+    mlir::Value sums = rewriter.create<FHELinalg::AddEintOp>(
+        loc, tensorType, adaptor.getA(), adaptor.getB());
+    mlir::Value stateTable =
+        getTable(rewriter, loc, tableSize, [&](uint64_t sum) {
+          return sum > chunkMax    ? GENERATE
+                 : sum == chunkMax ? PROPAGATE
+                                   : KILL;
+        });
+    mlir::Value states = rewriter.create<FHELinalg::ApplyLookupTableEintOp>(
+        loc, tensorType, sums, stateTable);
+
+    // 2. prefix network
+    mlir::Value combineTable =
+        getTable(rewriter, loc, tableSize, [](uint64_t index) -> uint64_t {
+          uint64_t high = index / 3, low = index % 3;
+          if (high > GENERATE)
+            return KILL;
+          return high == PROPAGATE ? low : high;
+        });
+    mlir::Value three = getBroadcastedConstant(rewriter, loc, 3, chunkSize + 1);
+    for (int64_t distance = 1; distance < numberOfChunks; distance *= 2) {
+      auto size = numberOfChunks - distance;
+      mlir::Value high = extractSlice(states, distance, size);
+      mlir::Value low = extractSlice(states, 0, size);
+      mlir::Value scaledHigh = rewriter.create<FHELinalg::MulEintIntOp>(
+          loc, sliceType(size), high, three);
+      mlir::Value index = rewriter.create<FHELinalg::AddEintOp>(
+          loc, sliceType(size), scaledHigh, low);
+      mlir::Value combined =
+          rewriter.create<FHELinalg::ApplyLookupTableEintOp>(
+              loc, sliceType(size), index, combineTable);
+      states = insertSlice(combined, states, distance, size);
+    }
+
+    // 3. carries
+    mlir::Value carryTable =
+        getTable(rewriter, loc, tableSize, [](uint64_t state) -> uint64_t {
+          return state == GENERATE;
+        });
+    mlir::Value carriesOut =
+        rewriter.create<FHELinalg::ApplyLookupTableEintOp>(
+            loc, tensorType, states, carryTable);
+    mlir::Value carriesIn = insertSlice(
+        extractSlice(carriesOut, 0, numberOfChunks - 1),
+        rewriter.create<FHE::ZeroTensorOp>(loc, tensorType).getResult(), 1,
+        numberOfChunks - 1);
+    mlir::Value sumsWithCarries = rewriter.create<FHELinalg::AddEintOp>(
+        loc, tensorType, sums, carriesIn);
+    mlir::Value shiftedCarries = rewriter.create<FHELinalg::MulEintIntOp>(
+        loc, tensorType, carriesOut,
+        getBroadcastedConstant(rewriter, loc, 1 << chunkWidth,
+                               chunkSize + 1));
+    return rewriter.create<FHELinalg::SubEintOp>(loc, tensorType,
+                                                 sumsWithCarries,
+                                                 shiftedCarries);
+  }
+
   unsigned int chunkSize, chunkWidth;
+  bool parallelCarries;
 };
 
 /// Perfoms the transformation of big integer operations
 class FHEBigIntTransformPass
     : public FHEBigIntTransformBase<FHEBigIntTransformPass> {
 public:
-  FHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth)
-      : chunkSize(chunkSize), chunkWidth(chunkWidth){};
+  FHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth,
+                         bool parallelCarries)
+      : chunkSize(chunkSize), chunkWidth(chunkWidth),
+        parallelCarries(parallelCarries){};
 
   void runOnOperation() override {
     mlir::Operation *op = getOperation();
@@ -187,7 +352,10 @@ public:
                       FHE::ZeroEintOp, FHE::ZeroTensorOp, FHE::AddEintOp,
                       FHE::MulEintIntOp, FHE::SubEintOp,
                       FHE::ApplyLookupTableEintOp, mlir::tensor::ExtractOp,
-                      mlir::tensor::InsertOp>();
+                      mlir::tensor::InsertOp, mlir::tensor::ExtractSliceOp,
+                      mlir::tensor::InsertSliceOp, FHELinalg::AddEintOp,
+                      FHELinalg::MulEintIntOp, FHELinalg::SubEintOp,
+                      FHELinalg::ApplyLookupTableEintOp>();
     concretelang::addDynamicallyLegalTypeOp<FHE::AddEintOp>(target, converter);
     // Func ops are only legal with converted types
     target.addDynamicallyLegalOp<mlir::func::FuncOp>(
@@ -203,7 +371,7 @@ public:
                                                                   converter);
 
     patterns.add<AddEintPattern>(converter, &getContext(), chunkSize,
-                                 chunkWidth);
+                                 chunkWidth, parallelCarries);
 
     if (mlir::applyPartialConversion(op, target, std::move(patterns))
             .failed()) {
@@ -213,15 +381,18 @@ public:
 
 private:
   unsigned int chunkSize, chunkWidth;
+  bool parallelCarries;
 };
 
 } // end anonymous namespace
 
 std::unique_ptr<mlir::OperationPass<>>
-createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth) {
+createFHEBigIntTransformPass(unsigned int chunkSize, unsigned int chunkWidth,
+                             bool parallelCarries) {
   assert(chunkSize >= chunkWidth + 1 &&
          "chunkSize must be greater than chunkWidth");
-  return std::make_unique<FHEBigIntTransformPass>(chunkSize, chunkWidth);
+  return std::make_unique<FHEBigIntTransformPass>(chunkSize, chunkWidth,
+                                                  parallelCarries);
 }
 
 } // namespace concretelang
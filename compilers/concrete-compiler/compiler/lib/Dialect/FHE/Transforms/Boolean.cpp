@@ -4,14 +4,20 @@
 // for license information.
 
 #include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/IR/Matchers.h>
 #include <mlir/IR/PatternMatch.h>
+#include <mlir/Pass/PassManager.h>
 #include <mlir/Transforms/GreedyPatternRewriteDriver.h>
+#include <mlir/Transforms/Passes.h>
 
 #include <concretelang/Dialect/FHE/IR/FHEOps.h>
 #include <concretelang/Dialect/FHE/IR/FHETypes.h>
 #include <concretelang/Dialect/FHE/Transforms/Boolean/Boolean.h>
 #include <concretelang/Support/Constants.h>
 
+#include <functional>
+#include <optional>
+
 namespace mlir {
 namespace concretelang {
 
@@ -144,6 +150,242 @@ public:
   }
 };
 
+/// Returns the truth table of the gate `op` if it's a constant of 4 boolean
+/// values.
+std::optional<llvm::SmallVector<uint64_t, 4>>
+constantTruthTable(mlir::concretelang::FHE::GenGateOp op) {
+  mlir::DenseIntElementsAttr attr;
+  if (!mlir::matchPattern(op.getTruthTable(), mlir::m_Constant(&attr)) ||
+      attr.getNumElements() != 4) {
+    return std::nullopt;
+  }
+  llvm::SmallVector<uint64_t, 4> values;
+  for (auto value : attr.getValues<llvm::APInt>()) {
+    if (value.getZExtValue() > 1) {
+      return std::nullopt;
+    }
+    values.push_back(value.getZExtValue());
+  }
+  return values;
+}
+
+mlir::Value createTruthTable(mlir::PatternRewriter &rewriter,
+                             mlir::Location loc,
+                             llvm::ArrayRef<uint64_t> values) {
+  llvm::SmallVector<llvm::APInt, 4> apValues;
+  for (auto value : values) {
+    apValues.push_back(llvm::APInt(64, value, false));
+  }
+  auto attr = mlir::DenseElementsAttr::get(
+      mlir::RankedTensorType::get({(int64_t)values.size()},
+                                  rewriter.getIntegerType(64)),
+      apValues);
+  return rewriter.create<mlir::arith::ConstantOp>(loc, attr).getResult();
+}
+
+/// A boolean input of a gate seen as a function of at most two boolean
+/// values: the input itself, its negation, or a gate producing it.
+struct GateInput {
+  llvm::SmallVector<mlir::Value, 2> inputs;
+  std::function<uint64_t(uint64_t, uint64_t)> eval;
+};
+
+/// Fuses the gates and negations producing the inputs of a gate into the
+/// latter, as long as the fused gate still has at most two distinct inputs,
+/// which is the most the 2 bits index of a lookup table on booleans can hold.
+/// The fused gates are only fused if they have no other user, so that the
+/// number of lookup tables never increases. Fusing a gate removes its lookup
+/// table, while fusing a negation, which is leveled, removes a leveled
+/// operation.
+///
+/// Example:
+///
+/// ```mlir
+/// %na = "FHE.not"(%a) : (!FHE.ebool) -> !FHE.ebool
+/// %0 = "FHE.gen_gate"(%na, %b, %and) : (...) -> !FHE.ebool
+/// %1 = "FHE.gen_gate"(%0, %a, %xor) : (...) -> !FHE.ebool
+/// ```
+///
+/// becomes a single gate, i.e. a single lookup table:
+///
+/// ```mlir
+/// %1 = "FHE.gen_gate"(%a, %b, %fused) : (...) -> !FHE.ebool
+/// ```
+class GateFusionPattern
+    : public mlir::OpRewritePattern<mlir::concretelang::FHE::GenGateOp> {
+public:
+  GateFusionPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<mlir::concretelang::FHE::GenGateOp>(
+            context, ::mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::concretelang::FHE::GenGateOp op,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto truthTable = constantTruthTable(op);
+    if (!truthTable.has_value()) {
+      return mlir::failure();
+    }
+
+    auto plain = [](mlir::Value value) {
+      return GateInput{{value}, [](uint64_t x, uint64_t) { return x; }};
+    };
+    GateInput left = plain(op.getLeft());
+    GateInput right = plain(op.getRight());
+    std::optional<GateInput> fusedLeft = fuse(op, op.getLeft());
+    std::optional<GateInput> fusedRight = fuse(op, op.getRight());
+
+    // Fuses both inputs if possible, otherwise the one which fits
+    std::optional<llvm::SmallVector<mlir::Value, 2>> leaves;
+    for (auto [l, r] : {std::make_pair(fusedLeft, fusedRight),
+                        std::make_pair(fusedLeft, std::optional(right)),
+                        std::make_pair(std::optional(left), fusedRight)}) {
+      if (!l.has_value() || !r.has_value()) {
+        continue;
+      }
+      leaves = distinctInputs(*l, *r);
+      if (leaves.has_value()) {
+        left = *l;
+        right = *r;
+        break;
+      }
+    }
+    if (!leaves.has_value()) {
+      return mlir::failure();
+    }
+
+    // Evaluates the fused gate on all the values of its inputs, the values
+    // of each operand being given in the order of its own inputs
+    auto operandValue = [&](GateInput &input, uint64_t x, uint64_t y) {
+      auto valueOf = [&](mlir::Value value) {
+        return value == (*leaves)[0] ? x : y;
+      };
+      auto first = valueOf(input.inputs[0]);
+      auto second =
+          input.inputs.size() > 1 ? valueOf(input.inputs[1]) : first;
+      return input.eval(first, second);
+    };
+    llvm::SmallVector<uint64_t, 4> fusedTable;
+    for (uint64_t x = 0; x < 2; x++) {
+      for (uint64_t y = 0; y < 2; y++) {
+        auto l = operandValue(left, x, y);
+        auto r = operandValue(right, x, y);
+        fusedTable.push_back((*truthTable)[2 * l + r]);
+      }
+    }
+
+    if (leaves->size() == 1) {
+      // Only the entries where both inputs are equal are used
+      uint64_t whenFalse = fusedTable[0], whenTrue = fusedTable[3];
+      if (whenFalse == 0 && whenTrue == 1) {
+        rewriter.replaceOp(op, (*leaves)[0]);
+        return mlir::success();
+      }
+      if (whenFalse == 1 && whenTrue == 0) {
+        rewriter.replaceOpWithNewOp<mlir::concretelang::FHE::BoolNotOp>(
+            op, op.getResult().getType(), (*leaves)[0]);
+        return mlir::success();
+      }
+      leaves->push_back((*leaves)[0]);
+    }
+
+    auto fusedTableValue = createTruthTable(rewriter, op.getLoc(), fusedTable);
+    rewriter.replaceOpWithNewOp<mlir::concretelang::FHE::GenGateOp>(
+        op, op.getResult().getType(), (*leaves)[0], (*leaves)[1],
+        fusedTableValue);
+    return mlir::success();
+  }
+
+private:
+  /// Returns `value` seen as a function of the inputs of the negation or of
+  /// the gate producing it, if the latter is only used by `user`.
+  static std::optional<GateInput> fuse(mlir::Operation *user,
+                                       mlir::Value value) {
+    mlir::Operation *producer = value.getDefiningOp();
+    if (producer == nullptr ||
+        llvm::any_of(producer->getUsers(), [&](mlir::Operation *other) {
+          return other != user;
+        })) {
+      return std::nullopt;
+    }
+    if (auto notOp =
+            llvm::dyn_cast<mlir::concretelang::FHE::BoolNotOp>(producer)) {
+      return GateInput{{notOp.getValue()},
+                       [](uint64_t x, uint64_t) { return 1 - x; }};
+    }
+    if (auto gateOp =
+            llvm::dyn_cast<mlir::concretelang::FHE::GenGateOp>(producer)) {
+      auto truthTable = constantTruthTable(gateOp);
+      if (!truthTable.has_value()) {
+        return std::nullopt;
+      }
+      auto table = *truthTable;
+      return GateInput{{gateOp.getLeft(), gateOp.getRight()},
+                       [table](uint64_t x, uint64_t y) {
+                         return table[2 * x + y];
+                       }};
+    }
+    return std::nullopt;
+  }
+
+  /// Returns the distinct inputs of the gate with the operands `left` and
+  /// `right`, if there are at most two.
+  static std::optional<llvm::SmallVector<mlir::Value, 2>>
+  distinctInputs(const GateInput &left, const GateInput &right) {
+    llvm::SmallVector<mlir::Value, 2> inputs;
+    for (const GateInput *operand : {&left, &right}) {
+      for (mlir::Value input : operand->inputs) {
+        if (llvm::is_contained(inputs, input)) {
+          continue;
+        }
+        if (inputs.size() == 2) {
+          return std::nullopt;
+        }
+        inputs.push_back(input);
+      }
+    }
+    return inputs;
+  }
+};
+
+/// Folds the negation of a gate used only by the negation into the truth
+/// table of the gate, and a double negation into its input. The negations
+/// being leveled, this removes leveled operations, not lookup tables.
+class NotFoldingPattern
+    : public mlir::OpRewritePattern<mlir::concretelang::FHE::BoolNotOp> {
+public:
+  NotFoldingPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<mlir::concretelang::FHE::BoolNotOp>(
+            context, ::mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::concretelang::FHE::BoolNotOp op,
+                  mlir::PatternRewriter &rewriter) const override {
+    mlir::Operation *producer = op.getValue().getDefiningOp();
+    if (auto notOp = llvm::dyn_cast_or_null<mlir::concretelang::FHE::BoolNotOp>(
+            producer)) {
+      rewriter.replaceOp(op, notOp.getValue());
+      return mlir::success();
+    }
+    auto gateOp =
+        llvm::dyn_cast_or_null<mlir::concretelang::FHE::GenGateOp>(producer);
+    if (!gateOp || !gateOp->hasOneUse()) {
+      return mlir::failure();
+    }
+    auto truthTable = constantTruthTable(gateOp);
+    if (!truthTable.has_value()) {
+      return mlir::failure();
+    }
+    llvm::SmallVector<uint64_t, 4> negatedTable;
+    for (auto value : *truthTable) {
+      negatedTable.push_back(1 - value);
+    }
+    rewriter.replaceOpWithNewOp<mlir::concretelang::FHE::GenGateOp>(
+        op, op.getResult().getType(), gateOp.getLeft(), gateOp.getRight(),
+        createTruthTable(rewriter, op.getLoc(), negatedTable));
+    return mlir::success();
+  }
+};
+
 /// Perfoms the transformation of boolean operations
 class FHEBooleanTransformPass
     : public FHEBooleanTransformBase<FHEBooleanTransformPass> {
@@ -151,20 +393,51 @@ public:
   void runOnOperation() override {
     mlir::Operation *op = getOperation();
 
+    // The gates are first all generalized, then fused with the gates and
+    // negations producing their inputs, before being lowered to lookup tables
+    mlir::RewritePatternSet fusionPatterns(&getContext());
+    fusionPatterns.add<MuxOpPattern>(&getContext());
+    fusionPatterns
+        .add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolAndOp>>(
+            &getContext(), llvm::SmallVector<uint64_t, 4>({0, 0, 0, 1}));
+    fusionPatterns
+        .add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolNandOp>>(
+            &getContext(), llvm::SmallVector<uint64_t, 4>({1, 1, 1, 0}));
+    fusionPatterns
+        .add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolOrOp>>(
+            &getContext(), llvm::SmallVector<uint64_t, 4>({0, 1, 1, 1}));
+    fusionPatterns
+        .add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolXorOp>>(
+            &getContext(), llvm::SmallVector<uint64_t, 4>({0, 1, 1, 0}));
+    fusionPatterns.add<GateFusionPattern, NotFoldingPattern>(&getContext());
+
+    if (mlir::applyPatternsAndFoldGreedily(op, std::move(fusionPatterns))
+            .failed()) {
+      this->signalPassFailure();
+      return;
+    }
+
+    bool hasGates = false;
+    op->walk([&](mlir::concretelang::FHE::GenGateOp) { hasGates = true; });
+    if (!hasGates) {
+      return;
+    }
+
     mlir::RewritePatternSet patterns(&getContext());
     patterns.add<GenGatePattern>(&getContext());
-    patterns.add<MuxOpPattern>(&getContext());
-    patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolAndOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({0, 0, 0, 1}));
-    patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolNandOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({1, 1, 1, 0}));
-    patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolOrOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({0, 1, 1, 1}));
-    patterns.add<GeneralizeGatePattern<mlir::concretelang::FHE::BoolXorOp>>(
-        &getContext(), llvm::SmallVector<uint64_t, 4>({0, 1, 1, 0}));
 
     if (mlir::applyPatternsAndFoldGreedily(op, std::move(patterns)).failed()) {
       this->signalPassFailure();
+      return;
+    }
+
+    // The gates on the same inputs share the computation of their index, so
+    // that their lookup tables can share their keyswitch, or be grouped in a
+    // single many-LUT bootstrap
+    mlir::OpPassManager pm(op->getName());
+    pm.addPass(mlir::createCSEPass());
+    if (this->runPipeline(pm, op).failed()) {
+      this->signalPassFailure();
     }
   }
 };
@@ -0,0 +1,265 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <functional>
+#include <optional>
+#include <tuple>
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/Matchers.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include "concretelang/Dialect/FHE/IR/FHEOps.h"
+#include "concretelang/Dialect/FHE/Transforms/LUTComposition/LUTComposition.h"
+
+namespace arith = mlir::arith;
+
+namespace FHE = mlir::concretelang::FHE;
+
+namespace {
+
+/// A leveled operation with clear constants, as a function on the bit
+/// representation of the encrypted integers. As all the leveled operations
+/// are computed modulo `2^width`, it's the same for signed and unsigned
+/// integers.
+typedef std::function<uint64_t(uint64_t)> LeveledFunction;
+
+/// The encrypted operand of a leveled operation and its function.
+typedef std::pair<mlir::Value, LeveledFunction> Leveled;
+
+/// Returns the value of `value` if it's a constant integer.
+static std::optional<uint64_t> constantInt(mlir::Value value) {
+  llvm::APInt constant;
+  if (!mlir::matchPattern(value, mlir::m_ConstantInt(&constant))) {
+    return std::nullopt;
+  }
+  return constant.sextOrTrunc(64).getZExtValue();
+}
+
+/// Returns the encrypted operand of `op` and the function it computes if
+/// `op` is a leveled operation which can be evaluated in a lookup table.
+static std::optional<Leveled> matchLeveled(mlir::Operation *op) {
+  if (op == nullptr) {
+    return std::nullopt;
+  }
+  if (auto add = llvm::dyn_cast<FHE::AddEintIntOp>(op)) {
+    if (auto c = constantInt(add.getB())) {
+      return Leveled{add.getA(), [=](uint64_t x) { return x + *c; }};
+    }
+  } else if (auto sub = llvm::dyn_cast<FHE::SubEintIntOp>(op)) {
+    if (auto c = constantInt(sub.getB())) {
+      return Leveled{sub.getA(), [=](uint64_t x) { return x - *c; }};
+    }
+  } else if (auto sub = llvm::dyn_cast<FHE::SubIntEintOp>(op)) {
+    if (auto c = constantInt(sub.getA())) {
+      return Leveled{sub.getB(), [=](uint64_t x) { return *c - x; }};
+    }
+  } else if (auto mul = llvm::dyn_cast<FHE::MulEintIntOp>(op)) {
+    if (auto c = constantInt(mul.getB())) {
+      return Leveled{mul.getA(), [=](uint64_t x) { return x * *c; }};
+    }
+  } else if (auto neg = llvm::dyn_cast<FHE::NegEintOp>(op)) {
+    return Leveled{neg.getA(), [](uint64_t x) { return -x; }};
+  } else if (auto cast = llvm::dyn_cast<FHE::ToSignedOp>(op)) {
+    return Leveled{cast.getInput(), [](uint64_t x) { return x; }};
+  } else if (auto cast = llvm::dyn_cast<FHE::ToUnsignedOp>(op)) {
+    return Leveled{cast.getInput(), [](uint64_t x) { return x; }};
+  }
+  return std::nullopt;
+}
+
+/// Returns the values of the lookup table `lut` if it's a constant.
+static std::optional<std::vector<uint64_t>> constantLut(mlir::Value lut) {
+  mlir::DenseIntElementsAttr attr;
+  if (!mlir::matchPattern(lut, mlir::m_Constant(&attr))) {
+    return std::nullopt;
+  }
+  std::vector<uint64_t> values;
+  for (auto value : attr.getValues<llvm::APInt>()) {
+    values.push_back(value.sextOrTrunc(64).getZExtValue());
+  }
+  return values;
+}
+
+/// Returns the index in a lookup table on `type` of the integer `value`.
+static uint64_t lutIndex(uint64_t value, mlir::Type type) {
+  auto width = type.cast<FHE::FheIntegerInterface>().getWidth();
+  return value & ((1ull << width) - 1);
+}
+
+/// Returns `value` as an integer of `type`, i.e. reduced modulo `2^width`
+/// and sign extended for signed integers.
+static int64_t lutValue(uint64_t value, mlir::Type type) {
+  auto integerType = type.cast<FHE::FheIntegerInterface>();
+  auto width = integerType.getWidth();
+  uint64_t index = lutIndex(value, type);
+  if (integerType.isSigned() && (index >> (width - 1)) != 0) {
+    return (int64_t)index - (int64_t)(1ull << width);
+  }
+  return index;
+}
+
+static FHE::ApplyLookupTableEintOp
+createLut(mlir::PatternRewriter &rewriter, mlir::Location loc,
+          mlir::Type resultType, mlir::Value input,
+          llvm::ArrayRef<int64_t> values) {
+  auto lut = rewriter.create<arith::ConstantOp>(
+      loc, rewriter.getI64TensorAttr(values));
+  return rewriter.create<FHE::ApplyLookupTableEintOp>(loc, resultType, input,
+                                                      lut);
+}
+
+/// Rewrites `lut(f(x), T)` to `lut(x, T o f)` for a leveled `f`.
+struct LeveledThenLutPattern
+    : public mlir::OpRewritePattern<FHE::ApplyLookupTableEintOp> {
+  LeveledThenLutPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<FHE::ApplyLookupTableEintOp>(context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(FHE::ApplyLookupTableEintOp lutOp,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto leveled = matchLeveled(lutOp.getA().getDefiningOp());
+    auto table = constantLut(lutOp.getLut());
+    if (!leveled || !table) {
+      return mlir::failure();
+    }
+    auto [input, function] = *leveled;
+    std::vector<int64_t> values;
+    for (uint64_t i = 0; i < table->size(); i++) {
+      values.push_back((*table)[lutIndex(function(i), input.getType())]);
+    }
+    auto newLut = createLut(rewriter, lutOp.getLoc(), lutOp.getType(), input,
+                            values);
+    rewriter.replaceOp(lutOp, {newLut});
+    return mlir::success();
+  }
+};
+
+/// Rewrites `f(lut(x, T))` to `lut(x, f o T)` for a leveled `f`, when the
+/// result of the lookup table has no other use.
+struct LutThenLeveledPattern : public mlir::RewritePattern {
+  LutThenLeveledPattern(mlir::MLIRContext *context)
+      : mlir::RewritePattern(mlir::Pattern::MatchAnyOpTypeTag(), 1, context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::Operation *op,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto leveled = matchLeveled(op);
+    if (!leveled) {
+      return mlir::failure();
+    }
+    auto [input, function] = *leveled;
+    auto lutOp = input.getDefiningOp<FHE::ApplyLookupTableEintOp>();
+    if (lutOp == nullptr || !lutOp->hasOneUse()) {
+      return mlir::failure();
+    }
+    auto table = constantLut(lutOp.getLut());
+    if (!table) {
+      return mlir::failure();
+    }
+    auto resultType = op->getResult(0).getType();
+    std::vector<int64_t> values;
+    for (auto value : *table) {
+      values.push_back(lutValue(function(value), resultType));
+    }
+    auto newLut = createLut(rewriter, op->getLoc(), resultType, lutOp.getA(),
+                            values);
+    rewriter.replaceOp(op, {newLut});
+    return mlir::success();
+  }
+};
+
+/// Rewrites `lut(lut(x, T1), T2)` to `lut(x, T2 o T1)`, when the result of
+/// the first lookup table has no other use.
+struct LutThenLutPattern
+    : public mlir::OpRewritePattern<FHE::ApplyLookupTableEintOp> {
+  LutThenLutPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<FHE::ApplyLookupTableEintOp>(context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(FHE::ApplyLookupTableEintOp lutOp,
+                  mlir::PatternRewriter &rewriter) const override {
+    auto firstOp = lutOp.getA().getDefiningOp<FHE::ApplyLookupTableEintOp>();
+    if (firstOp == nullptr || !firstOp->hasOneUse()) {
+      return mlir::failure();
+    }
+    auto firstTable = constantLut(firstOp.getLut());
+    auto table = constantLut(lutOp.getLut());
+    if (!firstTable || !table) {
+      return mlir::failure();
+    }
+    std::vector<int64_t> values;
+    for (auto value : *firstTable) {
+      values.push_back((*table)[lutIndex(value, firstOp.getType())]);
+    }
+    auto newLut = createLut(rewriter, lutOp.getLoc(), lutOp.getType(),
+                            firstOp.getA(), values);
+    rewriter.replaceOp(lutOp, {newLut});
+    return mlir::success();
+  }
+};
+
+struct FHELUTComposition : public FHELUTCompositionBase<FHELUTComposition> {
+  void runOnOperation() final {
+    mlir::Operation *op = this->getOperation();
+    auto patterns = mlir::RewritePatternSet(&this->getContext());
+    patterns.insert<LeveledThenLutPattern, LutThenLeveledPattern,
+                    LutThenLutPattern>(&this->getContext());
+    if (mlir::applyPatternsAndFoldGreedily(op, std::move(patterns)).failed()) {
+      this->signalPassFailure();
+      return;
+    }
+    removeDuplicates();
+  }
+
+private:
+  /// Replaces the lookup tables which have the same input, table and result
+  /// type than a dominating one by the result of the latter.
+  void removeDuplicates() {
+    mlir::DominanceInfo dominance(this->getOperation());
+    llvm::SmallVector<FHE::ApplyLookupTableEintOp> lutOps;
+    this->getOperation()->walk(
+        [&](FHE::ApplyLookupTableEintOp lutOp) { lutOps.push_back(lutOp); });
+
+    // The table is identified by its value, or by its attribute when it's a
+    // constant to find the same tables defined by different operations.
+    typedef std::tuple<mlir::Value, mlir::Value, mlir::Attribute, mlir::Type>
+        Key;
+    llvm::DenseMap<Key, llvm::SmallVector<FHE::ApplyLookupTableEintOp>>
+        candidates;
+    for (auto lutOp : lutOps) {
+      mlir::Attribute table;
+      mlir::Value lut = lutOp.getLut();
+      if (mlir::matchPattern(lut, mlir::m_Constant(&table))) {
+        lut = nullptr;
+      }
+      auto &sameLutOps =
+          candidates[{lutOp.getA(), lut, table, lutOp.getType()}];
+      auto dominating = llvm::find_if(sameLutOps, [&](auto other) {
+        return dominance.properlyDominates(other, lutOp);
+      });
+      if (dominating != sameLutOps.end()) {
+        lutOp.getResult().replaceAllUsesWith(dominating->getResult());
+        lutOp.erase();
+      } else {
+        sameLutOps.push_back(lutOp);
+      }
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<>> createFHELUTCompositionPass() {
+  return std::make_unique<FHELUTComposition>();
+}
+
+} // namespace concretelang
+} // namespace mlir
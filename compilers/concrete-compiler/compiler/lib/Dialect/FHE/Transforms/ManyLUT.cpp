@@ -0,0 +1,111 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/Matchers.h"
+#include "llvm/ADT/MapVector.h"
+
+#include "concretelang/Dialect/FHE/IR/FHEOps.h"
+#include "concretelang/Dialect/FHE/Transforms/ManyLUT/ManyLUT.h"
+
+namespace FHE = mlir::concretelang::FHE;
+
+namespace {
+
+struct FHEManyLUT : public FHEManyLUTBase<FHEManyLUT> {
+  FHEManyLUT(unsigned int maxPrecision) { this->maxPrecision = maxPrecision; }
+
+  void runOnOperation() final {
+    mlir::DominanceInfo dominance(this->getOperation());
+    this->getOperation()->walk(
+        [&](mlir::Block *block) { groupBlock(block, dominance); });
+  }
+
+private:
+  /// Groups the lookup tables of `block` applied on the same input with the
+  /// same result type.
+  void groupBlock(mlir::Block *block, mlir::DominanceInfo &dominance) {
+    llvm::MapVector<std::pair<mlir::Value, mlir::Type>,
+                    llvm::SmallVector<FHE::ApplyLookupTableEintOp>>
+        groups;
+    for (auto &op : block->getOperations()) {
+      if (auto lutOp = llvm::dyn_cast<FHE::ApplyLookupTableEintOp>(op)) {
+        groups[{lutOp.getA(), lutOp.getType()}].push_back(lutOp);
+      }
+    }
+    for (auto &group : groups) {
+      auto width = group.first.first.getType()
+                       .cast<FHE::FheIntegerInterface>()
+                       .getWidth();
+      if (width >= maxPrecision) {
+        continue;
+      }
+      size_t maxLuts = 1ull << std::min(maxPrecision - width, 16u);
+      auto remaining = group.second;
+      while (remaining.size() >= 2) {
+        llvm::SmallVector<FHE::ApplyLookupTableEintOp> chunk, rest;
+        chunk.push_back(remaining.front());
+        for (auto lutOp : llvm::drop_begin(remaining)) {
+          if (chunk.size() < maxLuts &&
+              isAvailable(lutOp.getLut(), chunk.front(), dominance)) {
+            chunk.push_back(lutOp);
+          } else {
+            rest.push_back(lutOp);
+          }
+        }
+        if (chunk.size() >= 2) {
+          replaceByManyLut(chunk, dominance);
+        }
+        remaining = rest;
+      }
+    }
+  }
+
+  /// Returns true if `lut` can be used by an operation placed before `op`,
+  /// i.e. if it dominates `op` or is a constant which can be cloned.
+  static bool isAvailable(mlir::Value lut, mlir::Operation *op,
+                          mlir::DominanceInfo &dominance) {
+    return dominance.properlyDominates(lut, op) ||
+           mlir::matchPattern(lut, mlir::m_Constant());
+  }
+
+  /// Replaces the lookup tables of `chunk` by a single many-LUT operation
+  /// placed at the first one.
+  static void replaceByManyLut(
+      llvm::SmallVectorImpl<FHE::ApplyLookupTableEintOp> &chunk,
+      mlir::DominanceInfo &dominance) {
+    auto first = chunk.front();
+    mlir::OpBuilder builder(first);
+    llvm::SmallVector<mlir::Value> luts;
+    llvm::SmallVector<mlir::Type> resultTypes;
+    for (auto lutOp : chunk) {
+      mlir::Value lut = lutOp.getLut();
+      if (!dominance.properlyDominates(lut, first)) {
+        lut = builder.clone(*lut.getDefiningOp())->getResult(0);
+      }
+      luts.push_back(lut);
+      resultTypes.push_back(lutOp.getType());
+    }
+    auto manyLut = builder.create<FHE::ApplyManyLookupTablesEintOp>(
+        first.getLoc(), resultTypes, first.getA(), luts);
+    for (auto [lutOp, result] : llvm::zip(chunk, manyLut.getResults())) {
+      lutOp.getResult().replaceAllUsesWith(result);
+      lutOp.erase();
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<>>
+createFHEManyLUTPass(unsigned int maxPrecision) {
+  return std::make_unique<FHEManyLUT>(maxPrecision);
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -0,0 +1,228 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+#include <algorithm>
+#include <set>
+
+#include "concretelang/Dialect/FHE/IR/FHEOps.h"
+#include "concretelang/Dialect/FHE/IR/FHETypes.h"
+#include "concretelang/Dialect/FHE/Transforms/Round/Round.h"
+#include "concretelang/Dialect/FHELinalg/IR/FHELinalgOps.h"
+
+namespace arith = mlir::arith;
+
+namespace FHE = mlir::concretelang::FHE;
+namespace FHELinalg = mlir::concretelang::FHELinalg;
+
+namespace {
+
+/// Returns the encrypted integer type of the scalar or tensor type `type`.
+static FHE::FheIntegerInterface encryptedElementType(mlir::Type type) {
+  if (auto tensorType = type.dyn_cast<mlir::RankedTensorType>()) {
+    type = tensorType.getElementType();
+  }
+  return type.cast<FHE::FheIntegerInterface>();
+}
+
+/// Returns `type` with encrypted integers of `width` bits.
+static mlir::Type withWidth(mlir::Type type, unsigned width) {
+  auto elementType = encryptedElementType(type);
+  mlir::Type newElementType =
+      elementType.isSigned()
+          ? (mlir::Type)FHE::EncryptedSignedIntegerType::get(
+                type.getContext(), width)
+          : (mlir::Type)FHE::EncryptedIntegerType::get(type.getContext(),
+                                                        width);
+  if (auto tensorType = type.dyn_cast<mlir::RankedTensorType>()) {
+    return mlir::RankedTensorType::get(tensorType.getShape(),
+                                       newElementType);
+  }
+  return newElementType;
+}
+
+/// Returns the lookup table rounding an integer of `width` bits to
+/// `width - discardedBits` bits, with the same semantic as the bootstraps
+/// discarding the bits one by one: the result of the rounding of the
+/// largest values can overflow in the padding bit.
+static llvm::SmallVector<int64_t> roundingTable(unsigned width,
+                                                unsigned discardedBits,
+                                                bool isSigned) {
+  int64_t size = (int64_t)1 << width;
+  int64_t carry = (int64_t)1 << (discardedBits - 1);
+  llvm::SmallVector<int64_t> table;
+  for (int64_t index = 0; index < size; index++) {
+    // The signed integers are indexed by their two's complement
+    int64_t value = (isSigned && index >= size / 2) ? index - size : index;
+    table.push_back((value + carry) >> discardedBits);
+  }
+  return table;
+}
+
+/// Rewrites a rounding discarding more than one bit to use fewer bootstraps,
+/// with a lookup table of a precision the circuit already has.
+///
+/// The bootstraps discarding the bits one by one belong to the partition of
+/// the input of the rounding, so a table of a precision already used by
+/// another table of the circuit doesn't raise the parameters of its
+/// partition, and costs less than the bootstraps it replaces. A table of a
+/// new precision could cost more, so the rounding is then kept.
+///
+/// Example:
+///
+/// ```mlir
+/// %1 = "FHE.round"(%0) : (!FHE.eint<6>) -> !FHE.eint<2>
+/// ```
+///
+/// becomes, with a table on 6 bits in the circuit:
+///
+/// ```mlir
+/// %1 = "FHE.apply_lookup_table"(%0, %round)
+///        : (!FHE.eint<6>, tensor<64xi64>) -> !FHE.eint<2>
+/// ```
+///
+/// and, with a table on 4 bits in the circuit but none on 6 bits:
+///
+/// ```mlir
+/// %c = arith.constant 2 : i7
+/// %1 = "FHE.sub_eint_int"(%0, %c) : (!FHE.eint<6>, i7) -> !FHE.eint<6>
+/// %2 = "FHE.round"(%1) : (!FHE.eint<6>) -> !FHE.eint<4>
+/// %3 = "FHE.apply_lookup_table"(%2, %round)
+///        : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<2>
+/// ```
+template <typename RoundOp, typename SubEintIntOp,
+          typename ApplyLookupTableOp>
+struct RoundPattern : public mlir::OpRewritePattern<RoundOp> {
+  RoundPattern(mlir::MLIRContext *context, unsigned int maxPrecision,
+               const std::set<unsigned> &lutWidths)
+      : mlir::OpRewritePattern<RoundOp>(context), maxPrecision(maxPrecision),
+        lutWidths(lutWidths) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(RoundOp op, mlir::PatternRewriter &rewriter) const override {
+    mlir::Value input = op.getInput();
+    auto inputType = encryptedElementType(input.getType());
+    unsigned inputWidth = inputType.getWidth();
+    unsigned outputWidth =
+        encryptedElementType(op.getResult().getType()).getWidth();
+
+    // A single lookup table on the input replaces one bootstrap per discarded
+    // bit. Otherwise, the lowest bits are discarded one by one until the
+    // integer fits in the widest table narrower than the input.
+    unsigned lutWidth = inputWidth;
+    if (inputWidth > maxPrecision || !lutWidths.count(inputWidth)) {
+      auto bound =
+          lutWidths.lower_bound(std::min(inputWidth, maxPrecision + 1));
+      if (bound == lutWidths.begin()) {
+        return mlir::failure();
+      }
+      lutWidth = *std::prev(bound);
+    }
+    // The table must replace at least two bootstraps
+    if (lutWidth < outputWidth + 2) {
+      return mlir::failure();
+    }
+
+    if (lutWidth < inputWidth) {
+      // Rounding `x - 2^(t-1)` by `t` bits discards the `t` lowest bits of
+      // `x` without propagating their carry, which is done by the table
+      unsigned truncatedBits = inputWidth - lutWidth;
+      mlir::Value carry = createConstant(
+          rewriter, op.getLoc(), input.getType(), inputWidth + 1,
+          (int64_t)1 << (truncatedBits - 1));
+      mlir::Value truncationInput = rewriter.create<SubEintIntOp>(
+          op.getLoc(), input.getType(), input, carry);
+      input = rewriter.create<RoundOp>(
+          op.getLoc(), withWidth(input.getType(), lutWidth), truncationInput);
+    }
+
+    auto table = roundingTable(lutWidth, lutWidth - outputWidth,
+                               inputType.isSigned());
+    mlir::Value lut = rewriter.create<arith::ConstantOp>(
+        op.getLoc(), mlir::DenseIntElementsAttr::get(
+                         mlir::RankedTensorType::get(
+                             {(int64_t)table.size()}, rewriter.getI64Type()),
+                         llvm::ArrayRef<int64_t>(table)));
+    rewriter.replaceOpWithNewOp<ApplyLookupTableOp>(
+        op, op.getResult().getType(), input, lut);
+    return mlir::success();
+  }
+
+private:
+  /// Creates the clear constant `value` of `width` bits to combine with an
+  /// encrypted value of `type`, as a tensor of the same shape for tensors.
+  static mlir::Value createConstant(mlir::PatternRewriter &rewriter,
+                                    mlir::Location loc, mlir::Type type,
+                                    unsigned width, int64_t value) {
+    auto intType = rewriter.getIntegerType(width);
+    if (auto tensorType = type.dyn_cast<mlir::RankedTensorType>()) {
+      auto constantType =
+          mlir::RankedTensorType::get(tensorType.getShape(), intType);
+      return rewriter.create<arith::ConstantOp>(
+          loc, mlir::DenseElementsAttr::get(
+                   constantType, rewriter.getIntegerAttr(intType, value)));
+    }
+    return rewriter.create<arith::ConstantOp>(
+        loc, rewriter.getIntegerAttr(intType, value));
+  }
+
+  unsigned int maxPrecision;
+  const std::set<unsigned> &lutWidths;
+};
+
+/// Returns the precisions of the inputs of the lookup tables of `op`.
+static std::set<unsigned> lookupTableWidths(mlir::Operation *op) {
+  std::set<unsigned> widths;
+  op->walk([&](mlir::Operation *lut) {
+    if (llvm::isa<FHE::ApplyLookupTableEintOp,
+                  FHELinalg::ApplyLookupTableEintOp,
+                  FHELinalg::ApplyMultiLookupTableEintOp,
+                  FHELinalg::ApplyMappedLookupTableEintOp>(lut)) {
+      widths.insert(
+          encryptedElementType(lut->getOperand(0).getType()).getWidth());
+    }
+  });
+  return widths;
+}
+
+struct FHERoundTransform : public FHERoundTransformBase<FHERoundTransform> {
+  FHERoundTransform(unsigned int maxPrecision) {
+    this->maxPrecision = maxPrecision;
+  }
+
+  void runOnOperation() final {
+    // Only the tables of the original circuit are considered, the ones
+    // created by the patterns have the precision of one of them
+    auto lutWidths = lookupTableWidths(getOperation());
+    mlir::RewritePatternSet patterns(&getContext());
+    patterns.add<RoundPattern<FHE::RoundEintOp, FHE::SubEintIntOp,
+                              FHE::ApplyLookupTableEintOp>,
+                 RoundPattern<FHELinalg::RoundOp, FHELinalg::SubEintIntOp,
+                              FHELinalg::ApplyLookupTableEintOp>>(
+        &getContext(), maxPrecision, lutWidths);
+    // The roundings created by the patterns have a result of the precision of
+    // the widest table narrower than their input, so they are left to the
+    // lowering discarding the bits one by one
+    if (mlir::applyPatternsAndFoldGreedily(getOperation(), std::move(patterns))
+            .failed()) {
+      signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<>>
+createFHERoundTransformPass(unsigned int maxPrecision) {
+  return std::make_unique<FHERoundTransform>(maxPrecision);
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -44,7 +44,8 @@ namespace {
 // TODO: adjust these two functions based on cost model
 static bool isCandidateForTask(Operation *op) {
   return isa<
-      FHE::ApplyLookupTableEintOp, FHELinalg::MatMulEintIntOp,
+      FHE::ApplyLookupTableEintOp, FHE::ApplyManyLookupTablesEintOp,
+      FHELinalg::MatMulEintIntOp,
       FHELinalg::AddEintIntOp, FHELinalg::AddEintOp, FHELinalg::SubIntEintOp,
       FHELinalg::SubEintIntOp, FHELinalg::SubEintOp, FHELinalg::NegEintOp,
       FHELinalg::MulEintIntOp, FHELinalg::ApplyLookupTableEintOp,
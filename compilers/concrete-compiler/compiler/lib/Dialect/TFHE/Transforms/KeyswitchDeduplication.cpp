@@ -0,0 +1,152 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <tuple>
+
+#include <mlir/IR/Dominance.h>
+#include <mlir/Interfaces/SideEffectInterfaces.h>
+#include <llvm/ADT/DenseMap.h>
+
+#include <concretelang/Dialect/TFHE/IR/TFHEOps.h>
+#include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
+
+namespace mlir {
+namespace concretelang {
+
+namespace {
+
+/// Maximal depth of the operations compared to find equivalent inputs.
+const unsigned int MAX_EQUIVALENCE_DEPTH = 4;
+
+/// Returns true if `a` and `b` have the same attributes, ignoring the
+/// optimizer operator indexes.
+bool haveSameAttributes(mlir::Operation *a, mlir::Operation *b) {
+  auto attrs = [](mlir::Operation *op) {
+    llvm::SmallVector<mlir::NamedAttribute> attrs;
+    for (auto attr : op->getAttrs()) {
+      if (attr.getName() != "TFHE.OId") {
+        attrs.push_back(attr);
+      }
+    }
+    return attrs;
+  };
+  return attrs(a) == attrs(b);
+}
+
+/// Returns true if `a` and `b` are the same value or are computed by the same
+/// pure operations on the same values.
+bool isEquivalent(mlir::Value a, mlir::Value b,
+                  unsigned int depth = MAX_EQUIVALENCE_DEPTH) {
+  if (a == b) {
+    return true;
+  }
+  auto opA = a.getDefiningOp();
+  auto opB = b.getDefiningOp();
+  if (depth == 0 || opA == nullptr || opB == nullptr ||
+      a.getType() != b.getType() || opA->getName() != opB->getName() ||
+      opA->getNumResults() != 1 || opA->getNumRegions() != 0 ||
+      opA->getNumOperands() != opB->getNumOperands() || !mlir::isPure(opA) ||
+      !haveSameAttributes(opA, opB)) {
+    return false;
+  }
+  for (auto [operandA, operandB] :
+       llvm::zip(opA->getOperands(), opB->getOperands())) {
+    if (!isEquivalent(operandA, operandB, depth - 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// Returns the value that the input of a keyswitch is computed from, which
+/// identifies the candidates for equivalence.
+mlir::Value getRoot(mlir::Value input) {
+  if (auto addOp = input.getDefiningOp<TFHE::AddGLWEIntOp>()) {
+    return addOp.getA();
+  }
+  return input;
+}
+
+/// Erases the operation computing `value`, and then its operands, if it has
+/// no more uses. Keyswitches are kept as they are handled by the pass.
+void eraseIfDead(mlir::Value value) {
+  auto op = value.getDefiningOp();
+  if (op == nullptr || !mlir::isOpTriviallyDead(op) ||
+      llvm::isa<TFHE::KeySwitchGLWEOp, TFHE::BatchedKeySwitchGLWEOp>(op)) {
+    return;
+  }
+  llvm::SmallVector<mlir::Value> operands(op->getOperands());
+  op->erase();
+  for (auto operand : operands) {
+    eraseIfDead(operand);
+  }
+}
+
+/// Returns the number of keyswitches computed by `op`.
+uint64_t keyswitchCount(TFHE::KeySwitchGLWEOp) { return 1; }
+
+uint64_t keyswitchCount(TFHE::BatchedKeySwitchGLWEOp op) {
+  return op.getType().cast<mlir::RankedTensorType>().getNumElements();
+}
+
+class TFHEKeyswitchDeduplicationPass
+    : public TFHEKeyswitchDeduplicationBase<TFHEKeyswitchDeduplicationPass> {
+public:
+  TFHEKeyswitchDeduplicationPass(uint64_t *removedKeyswitches)
+      : removedKeyswitches(removedKeyswitches) {}
+
+  void runOnOperation() override {
+    mlir::DominanceInfo dominance(getOperation());
+    uint64_t removed = deduplicate<TFHE::KeySwitchGLWEOp>(dominance) +
+                       deduplicate<TFHE::BatchedKeySwitchGLWEOp>(dominance);
+    if (removedKeyswitches != nullptr) {
+      *removedKeyswitches += removed;
+    }
+  }
+
+private:
+  /// Replaces the keyswitches equivalent to a dominating one and returns the
+  /// number of removed keyswitches.
+  template <typename KeyswitchOp>
+  uint64_t deduplicate(mlir::DominanceInfo &dominance) {
+    llvm::SmallVector<KeyswitchOp> ksOps;
+    getOperation()->walk([&](KeyswitchOp ksOp) { ksOps.push_back(ksOp); });
+
+    typedef std::tuple<mlir::Value, mlir::Attribute, mlir::Type> Key;
+    llvm::DenseMap<Key, llvm::SmallVector<KeyswitchOp>> candidates;
+    uint64_t removed = 0;
+    for (auto ksOp : ksOps) {
+      mlir::Value input = ksOp->getOperand(0);
+      auto &sameRootOps =
+          candidates[{getRoot(input), ksOp.getKeyAttr(), ksOp.getType()}];
+      auto dominating = llvm::find_if(sameRootOps, [&](KeyswitchOp other) {
+        return dominance.properlyDominates(other.getOperation(),
+                                           ksOp.getOperation()) &&
+               isEquivalent(other->getOperand(0), input);
+      });
+      if (dominating != sameRootOps.end()) {
+        removed += keyswitchCount(ksOp);
+        ksOp.getResult().replaceAllUsesWith(dominating->getResult());
+        ksOp.erase();
+        eraseIfDead(input);
+      } else {
+        sameRootOps.push_back(ksOp);
+      }
+    }
+    return removed;
+  }
+
+  uint64_t *removedKeyswitches;
+};
+
+} // end anonymous namespace
+
+std::unique_ptr<mlir::OperationPass<>>
+createTFHEKeyswitchDeduplicationPass(uint64_t *removedKeyswitches) {
+  return std::make_unique<TFHEKeyswitchDeduplicationPass>(removedKeyswitches);
+}
+
+} // namespace concretelang
+} // namespace mlir
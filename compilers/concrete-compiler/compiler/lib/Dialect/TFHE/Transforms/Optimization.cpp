@@ -4,9 +4,11 @@
 // for license information.
 
 #include <mlir/Dialect/Arith/IR/Arith.h>
+#include <mlir/IR/Matchers.h>
 #include <mlir/IR/PatternMatch.h>
 #include <mlir/Transforms/GreedyPatternRewriteDriver.h>
 
+#include <concretelang/ClientLib/CRT.h>
 #include <concretelang/Dialect/TFHE/IR/TFHEOps.h>
 #include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
 #include <concretelang/Support/Constants.h>
@@ -63,6 +65,83 @@ public:
   }
 };
 
+/// Returns the integers of an array attribute.
+std::vector<int64_t> toIntVector(mlir::ArrayAttr array) {
+  std::vector<int64_t> values;
+  for (auto attr : array) {
+    values.push_back(attr.cast<mlir::IntegerAttr>().getInt());
+  }
+  return values;
+}
+
+/// Rewrite the encoding of a constant lookup table for a crt wop pbs as a
+/// constant holding the encoded lookup table, so that it is emitted as a
+/// read-only global instead of being encoded at each call.
+class EncodeLutForCrtWopPBSOpPattern
+    : public mlir::OpRewritePattern<TFHE::EncodeLutForCrtWopPBSOp> {
+public:
+  EncodeLutForCrtWopPBSOpPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<TFHE::EncodeLutForCrtWopPBSOp>(
+            context, ::mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(TFHE::EncodeLutForCrtWopPBSOp op,
+                  mlir::PatternRewriter &rewriter) const override {
+    mlir::DenseIntElementsAttr lutAttr;
+    if (!mlir::matchPattern(op.getInputLookupTable(),
+                            mlir::m_Constant(&lutAttr))) {
+      return mlir::failure();
+    }
+
+    std::vector<uint64_t> lut;
+    for (auto value : lutAttr.getValues<llvm::APInt>()) {
+      lut.push_back(value.getZExtValue());
+    }
+    auto resultType = op.getResult().getType().cast<mlir::RankedTensorType>();
+    std::vector<uint64_t> encodedLut(resultType.getNumElements());
+    ::concretelang::clientlib::crt::encodeLutForWopPBS(
+        encodedLut.data(), lut.data(), lut.size(),
+        toIntVector(op.getCrtDecomposition()), toIntVector(op.getCrtBits()),
+        op.getModulusProduct(), op.getIsSigned());
+
+    rewriter.replaceOpWithNewOp<mlir::arith::ConstantOp>(
+        op, mlir::DenseIntElementsAttr::get(
+                resultType, llvm::ArrayRef<uint64_t>(encodedLut)));
+    return mlir::success();
+  }
+};
+
+/// Rewrite the crt encoding of a constant plaintext as a constant holding the
+/// encoded plaintext.
+class EncodePlaintextWithCrtOpPattern
+    : public mlir::OpRewritePattern<TFHE::EncodePlaintextWithCrtOp> {
+public:
+  EncodePlaintextWithCrtOpPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<TFHE::EncodePlaintextWithCrtOp>(
+            context, ::mlir::concretelang::DEFAULT_PATTERN_BENEFIT) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(TFHE::EncodePlaintextWithCrtOp op,
+                  mlir::PatternRewriter &rewriter) const override {
+    llvm::APInt plaintext;
+    if (!mlir::matchPattern(op.getInput(), mlir::m_ConstantInt(&plaintext))) {
+      return mlir::failure();
+    }
+
+    std::vector<uint64_t> encoded;
+    for (auto modulus : toIntVector(op.getMods())) {
+      encoded.push_back(::concretelang::clientlib::crt::encode(
+          plaintext.getSExtValue(), modulus, op.getModsProd()));
+    }
+
+    rewriter.replaceOpWithNewOp<mlir::arith::ConstantOp>(
+        op, mlir::DenseIntElementsAttr::get(
+                op.getResult().getType().cast<mlir::RankedTensorType>(),
+                llvm::ArrayRef<uint64_t>(encoded)));
+    return mlir::success();
+  }
+};
+
 /// Optimization pass that should choose more efficient ways of performing
 /// crypto operations.
 class TFHEOptimizationPass : public TFHEOptimizationBase<TFHEOptimizationPass> {
@@ -71,7 +150,9 @@ public:
     mlir::Operation *op = getOperation();
 
     mlir::RewritePatternSet patterns(op->getContext());
-    patterns.add<MulCleartextLweCiphertextOpPattern>(op->getContext());
+    patterns.add<MulCleartextLweCiphertextOpPattern,
+                 EncodeLutForCrtWopPBSOpPattern,
+                 EncodePlaintextWithCrtOpPattern>(op->getContext());
 
     if (mlir::applyPatternsAndFoldGreedily(op, std::move(patterns)).failed()) {
       this->signalPassFailure();
@@ -105,7 +105,7 @@ public:
       });
       // Fixup input of the boostrap operator
       DEBUG("### Fixup input tlu of bootstrap")
-      func.walk([&](TFHE::BootstrapGLWEOp op) {
+      auto fixupBootstrap = [&](auto op) {
         DEBUG("process op: " << op)
         auto attrBootstrapKey =
             op->getAttrOfType<TFHE::GLWEBootstrapKeyAttr>("key");
@@ -121,6 +121,11 @@ public:
                 lutDefiningOp);
             encodeOp != nullptr) {
           encodeOp.setPolySize(polySize);
+        } else if (auto encodeOp =
+                       mlir::dyn_cast<TFHE::EncodeExpandManyLutForBootstrapOp>(
+                           lutDefiningOp);
+                   encodeOp != nullptr) {
+          encodeOp.setPolySize(polySize);
         } else if (auto constantOp =
                        mlir::dyn_cast<arith::ConstantOp>(lutDefiningOp)) {
           // Rounded PBS case
@@ -147,12 +152,15 @@ public:
             attrBootstrapKey.getPolySize(), attrBootstrapKey.getGlweDim(),
             attrBootstrapKey.getLevels(), attrBootstrapKey.getBaseLog(), -1);
         op.setKeyAttr(newAttrBootstrapKey);
-      });
+      };
+      func.walk([&](TFHE::BootstrapGLWEOp op) { fixupBootstrap(op); });
+      func.walk([&](TFHE::ManyLutBootstrapGLWEOp op) { fixupBootstrap(op); });
       // Fixup incompatible operators with extra conversion keys
       DEBUG("### Fixup with extra conversion keys")
       func.walk([&](mlir::Operation *op) {
         // Skip bootstrap/keyswitch
         if (mlir::isa<TFHE::BootstrapGLWEOp>(op) ||
+            mlir::isa<TFHE::ManyLutBootstrapGLWEOp>(op) ||
             mlir::isa<TFHE::KeySwitchGLWEOp>(op)) {
           return;
         }
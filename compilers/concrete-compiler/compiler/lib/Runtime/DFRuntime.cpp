@@ -21,6 +21,7 @@
 
 #include "concretelang/Runtime/DFRuntime.hpp"
 #include "concretelang/Runtime/distributed_generic_task_server.hpp"
+#include "concretelang/Runtime/perf_counters.h"
 #include "concretelang/Runtime/runtime_api.h"
 #include "concretelang/Runtime/time_util.h"
 
@@ -90,6 +91,15 @@ static inline size_t _dfr_find_next_execution_locality() {
   return next_loc % mlir::concretelang::dfr::num_nodes;
 }
 
+// Record the time between the creation of a task and the start of its
+// execution.
+static inline void _dfr_record_task_wait(uint64_t created) {
+  using namespace mlir::concretelang;
+  static perf::Stats &stats = perf::stats(perf::Op::DFR_TASK_WAIT, 0, {});
+  perf::record(stats, perf::Op::DFR_TASK_WAIT, 0, created,
+               perf::now() - created);
+}
+
 /// Runtime generic async_task.  Each first NUM_PARAMS pairs of
 /// arguments in the variadic list corresponds to a void* pointer on a
 /// hpx::future<void*> and the size of data within the future.  After
@@ -138,16 +148,18 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   // individual synchronization for each return independently.
   mlir::concretelang::dfr::GenericComputeClient *gcc_target =
       &mlir::concretelang::dfr::gcc[_dfr_find_next_execution_locality()];
+  uint64_t created = mlir::concretelang::perf::now();
   switch (num_params) {
   case 0:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target,
+         gcc_target, created,
          ctx]() -> hpx::future<mlir::concretelang::dfr::OpaqueOutputData> {
           std::vector<void *> params = {};
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         }));
     break;
@@ -155,12 +167,13 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 1:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0)
+         gcc_target, ctx, created](hpx::shared_future<void *> param0)
             -> hpx::future<mlir::concretelang::dfr::OpaqueOutputData> {
           std::vector<void *> params = {param0.get()};
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future));
@@ -169,13 +182,14 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 2:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1)
             -> hpx::future<mlir::concretelang::dfr::OpaqueOutputData> {
           std::vector<void *> params = {param0.get(), param1.get()};
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -185,7 +199,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 3:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2)
             -> hpx::future<mlir::concretelang::dfr::OpaqueOutputData> {
@@ -194,6 +208,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -204,7 +219,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 4:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3)
@@ -214,6 +229,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -225,7 +241,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 5:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -237,6 +253,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -249,7 +266,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 6:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -262,6 +279,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -275,7 +293,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 7:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -289,6 +307,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -303,7 +322,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 8:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -318,6 +337,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -333,7 +353,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 9:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -350,6 +370,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -366,7 +387,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 10:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -384,6 +405,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -401,7 +423,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 11:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -420,6 +442,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -438,7 +461,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 12:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -458,6 +481,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -477,7 +501,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 13:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -499,6 +523,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -519,7 +544,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 14:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -542,6 +567,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -563,7 +589,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 15:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -587,6 +613,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -609,7 +636,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 16:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -634,6 +661,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -657,7 +685,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 17:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -684,6 +712,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -708,7 +737,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 18:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -736,6 +765,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -761,7 +791,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 19:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -790,6 +820,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -816,7 +847,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
   case 20:
     oodf = std::move(hpx::dataflow(
         [wfnname, param_sizes, param_types, output_sizes, output_types,
-         gcc_target, ctx](hpx::shared_future<void *> param0,
+         gcc_target, ctx, created](hpx::shared_future<void *> param0,
                           hpx::shared_future<void *> param1,
                           hpx::shared_future<void *> param2,
                           hpx::shared_future<void *> param3,
@@ -846,6 +877,7 @@ void _dfr_create_async_task(wfnptr wfn, void *ctx, size_t num_params,
           mlir::concretelang::dfr::OpaqueInputData oid(
               wfnname, params, param_sizes, param_types, output_sizes,
               output_types, ctx);
+          _dfr_record_task_wait(created);
           return gcc_target->execute_task(oid);
         },
         *((dfr_refcounted_future_p)refcounted_futures[0])->future,
@@ -5,8 +5,15 @@
 
 #include "concretelang/Runtime/context.h"
 #include "concretelang/Common/Error.h"
+#include "llvm/Support/xxhash.h"
+#include <algorithm>
 #include <assert.h>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <new>
 #include <stdio.h>
+#include <thread>
 
 namespace clientlib = ::concretelang::clientlib;
 namespace mlir {
@@ -29,57 +36,212 @@ FFT::~FFT() {
   }
 }
 
-RuntimeContext::RuntimeContext(clientlib::EvaluationKeys evaluationKeys)
-    : evaluationKeys(evaluationKeys) {
-  {
-
-    // Initialize for each bootstrap key the fourier one
-    for (auto bsk : evaluationKeys.getBootstrapKeys()) {
-      auto param = bsk.parameters();
-
-      size_t decomposition_level_count = param.level;
-      size_t decomposition_base_log = param.baseLog;
-      size_t glwe_dimension = param.glweDimension;
-      size_t polynomial_size = param.polynomialSize;
-      size_t input_lwe_dimension = param.inputLweDimension;
+/// Convert the bootstrap key `bsk` to the fourier domain. The key is a list of
+/// independent ggsw ciphertexts, `inputLweDimension` of them for a classic key
+/// and `2^d - 1` for each group of `d` input key bits for a multi bit key,
+/// which are converted concurrently by `numChunks` chunks.
+static void convertBootstrapKeyToFourier(clientlib::LweBootstrapKey bsk,
+                                         double *fourier_data,
+                                         const struct Fft *fft,
+                                         size_t numChunks) {
+  auto param = bsk.parameters();
+  size_t decomposition_level_count = param.level;
+  size_t decomposition_base_log = param.baseLog;
+  size_t glwe_dimension = param.glweDimension;
+  size_t polynomial_size = param.polynomialSize;
+  size_t ggsw_count = param.inputLweDimension / param.groupingFactor *
+                      ((1 << param.groupingFactor) - 1);
+  if (ggsw_count == 0) {
+    return;
+  }
+  size_t ggsw_size = bsk.size() / ggsw_count;
 
-      // Create the FFT
-      FFT fft(polynomial_size);
+  numChunks = std::max<size_t>(1, std::min(numChunks, ggsw_count));
+  size_t chunk_size = (ggsw_count + numChunks - 1) / numChunks;
 
+  std::vector<std::future<void>> chunks;
+  for (size_t first = 0; first < ggsw_count; first += chunk_size) {
+    size_t count = std::min(chunk_size, ggsw_count - first);
+    chunks.push_back(std::async(std::launch::async, [=]() {
       // Allocate scratch for key conversion
       size_t scratch_size;
       size_t scratch_align;
       concrete_cpu_bootstrap_key_convert_u64_to_fourier_scratch(
-          &scratch_size, &scratch_align, fft.fft);
+          &scratch_size, &scratch_align, fft);
       auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
 
-      // Allocate the fourier_bootstrap_key
-      auto fourier_data = std::make_shared<std::vector<double>>();
-      fourier_data->resize(bsk.size());
-      auto bsk_data = bsk.buffer();
-
-      // Convert bootstrap_key to the fourier domain
+      // Convert the ggsw ciphertexts of the chunk to the fourier domain, as
+      // a classic key with one ggsw per input key bit
       concrete_cpu_bootstrap_key_convert_u64_to_fourier(
-          bsk_data, fourier_data->data(), decomposition_level_count,
-          decomposition_base_log, glwe_dimension, polynomial_size,
-          input_lwe_dimension, fft.fft, scratch, scratch_size);
+          bsk.buffer() + first * ggsw_size, fourier_data + first * ggsw_size,
+          decomposition_level_count, decomposition_base_log, glwe_dimension,
+          polynomial_size, count, fft, scratch, scratch_size);
 
-      // Store the fourier_bootstrap_key in the context
-      fourier_bootstrap_keys.push_back(fourier_data);
-      ffts.push_back(std::move(fft));
       free(scratch);
+    }));
+  }
+  for (auto &chunk : chunks) {
+    chunk.wait();
+  }
+}
+
+/// Returns the fingerprint of the bootstrap key `bsk`, i.e. a hash of its
+/// content and of the parameters which define its fourier conversion. The
+/// fingerprint names the segments shared by the processes, so it must not
+/// depend on the process, unlike llvm::hash_combine.
+static uint64_t fingerprint(const clientlib::LweBootstrapKey &bsk) {
+  auto param = bsk.parameters();
+  llvm::StringRef content((const char *)bsk.buffer(),
+                          bsk.size() * sizeof(uint64_t));
+  uint64_t fields[] = {llvm::xxHash64(content), param.level,
+                       param.baseLog,           param.glweDimension,
+                       param.polynomialSize,    param.inputLweDimension,
+                       param.groupingFactor};
+  return llvm::xxHash64(llvm::StringRef((const char *)fields, sizeof(fields)));
+}
+
+PreparedEvaluationKeys::PreparedEvaluationKeys(
+    clientlib::EvaluationKeys evaluationKeys,
+    std::optional<std::string> sharedKeysPath, KeyPlacement placement)
+    : evaluationKeys(evaluationKeys) {
+  auto bootstrapKeys = evaluationKeys.getBootstrapKeys();
+  if (bootstrapKeys.empty()) {
+    return;
+  }
+
+  // Create the FFT of each bootstrap key before starting any conversion, the
+  // fourier bootstrap keys are set by their conversion.
+  for (auto bsk : bootstrapKeys) {
+    ffts.push_back(FFT(bsk.parameters().polynomialSize));
+  }
+  fourierBootstrapKeys.resize(bootstrapKeys.size());
+
+  size_t numReplicas = placement.numaReplicas ? numaNodeCount() : 1;
+
+  // Share the available threads between the keys
+  size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+  size_t numChunks = std::max<size_t>(1, numThreads / bootstrapKeys.size());
+
+  // Convert each bootstrap key in background
+  for (size_t keyId = 0; keyId < bootstrapKeys.size(); keyId++) {
+    auto bsk = bootstrapKeys[keyId];
+    auto fft = ffts[keyId].fft;
+    auto &replicas = fourierBootstrapKeys[keyId];
+    auto convert = [=](double *fourier_data) {
+      convertBootstrapKeyToFourier(bsk, fourier_data, fft, numChunks);
+    };
+    conversions.push_back(
+        std::async(std::launch::async, [=, &replicas]() {
+          if (sharedKeysPath.has_value()) {
+            auto segment = SharedKeySegment::openOrCreate(
+                sharedKeysPath.value(), fingerprint(bsk), bsk.size(), convert);
+            if (segment.has_value()) {
+              auto s = segment.value();
+              replicas.push_back(std::shared_ptr<const double>(s, s->data()));
+              return;
+            }
+            std::cerr << "Fallback to a private fourier bootstrap key: "
+                      << segment.error().mesg << "\n";
+          }
+          // Convert the key on the first node, then copy it on the others
+          int firstNode = numReplicas > 1 ? 0 : -1;
+          auto fourier_data =
+              allocateKeyBuffer(bsk.size(), placement.hugePages, firstNode);
+          convert(fourier_data.get());
+          replicas.push_back(fourier_data);
+          for (size_t node = 1; node < numReplicas; node++) {
+            auto replica =
+                allocateKeyBuffer(bsk.size(), placement.hugePages, node);
+            memcpy(replica.get(), fourier_data.get(),
+                   bsk.size() * sizeof(double));
+            replicas.push_back(replica);
+          }
+        }).share());
+  }
+}
+
+void PreparedEvaluationKeys::wait() {
+  for (auto &conversion : conversions) {
+    conversion.get();
+  }
+}
+
+bool PreparedEvaluationKeys::isReady() {
+  bool ready = true;
+  for (auto &conversion : conversions) {
+    if (conversion.wait_for(std::chrono::seconds(0)) !=
+        std::future_status::ready) {
+      ready = false;
+    } else {
+      conversion.get();
     }
+  }
+  return ready;
+}
 
-#ifdef CONCRETELANG_CUDA_SUPPORT
-    assert(cudaGetDeviceCount(&num_devices) == cudaSuccess);
-    bsk_gpu.resize(num_devices, nullptr);
-    ksk_gpu.resize(num_devices, nullptr);
-    for (int i = 0; i < num_devices; ++i) {
-      bsk_gpu_mutex.push_back(std::make_unique<std::mutex>());
-      ksk_gpu_mutex.push_back(std::make_unique<std::mutex>());
+/// Alignment in bytes of the memory of the intermediate buffers.
+const size_t ARENA_ALIGNMENT = 64;
+
+static void *allocateArena(size_t size) {
+  // The size given to aligned_alloc must be a multiple of the alignment
+  size = (size + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT;
+  return aligned_alloc(ARENA_ALIGNMENT, size);
+}
+
+void *MemoryArena::acquire(size_t size) {
+  if (used.exchange(true)) {
+    return nullptr;
+  }
+  if (size > capacity.load()) {
+    free(buffer.exchange(nullptr));
+    capacity.store(0);
+    auto grown = allocateArena(size);
+    if (grown == nullptr) {
+      used.store(false);
+      return nullptr;
     }
-#endif
+    buffer.store(grown);
+    capacity.store(size);
+  }
+  return buffer.load();
+}
+
+void *RuntimeContext::acquire_arena(size_t size) {
+  if (memoryArena != nullptr) {
+    if (auto arena = memoryArena->acquire(size)) {
+      return arena;
+    }
+  }
+  auto arena = allocateArena(size);
+  if (arena == nullptr) {
+    throw std::bad_alloc();
+  }
+  return arena;
+}
+
+void RuntimeContext::release_arena(void *arena) {
+  if (memoryArena != nullptr && memoryArena->owns(arena)) {
+    memoryArena->release();
+  } else {
+    free(arena);
+  }
+}
+
+RuntimeContext::RuntimeContext(clientlib::EvaluationKeys evaluationKeys)
+    : RuntimeContext(PreparedEvaluationKeys::prepare(evaluationKeys)) {}
+
+RuntimeContext::RuntimeContext(
+    std::shared_ptr<PreparedEvaluationKeys> preparedKeys)
+    : evaluationKeys(preparedKeys->getKeys()), preparedKeys(preparedKeys) {
+#ifdef CONCRETELANG_CUDA_SUPPORT
+  assert(cudaGetDeviceCount(&num_devices) == cudaSuccess);
+  bsk_gpu.resize(num_devices, nullptr);
+  ksk_gpu.resize(num_devices, nullptr);
+  for (int i = 0; i < num_devices; ++i) {
+    bsk_gpu_mutex.push_back(std::make_unique<std::mutex>());
+    ksk_gpu_mutex.push_back(std::make_unique<std::mutex>());
   }
+#endif
 }
 
 } // namespace concretelang
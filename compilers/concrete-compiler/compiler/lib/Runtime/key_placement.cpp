@@ -0,0 +1,133 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "concretelang/Runtime/key_placement.h"
+
+namespace mlir {
+namespace concretelang {
+
+/// Mappings are rounded up to the size of a huge page.
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/// The `MPOL_BIND` memory policy of the Linux `mbind` syscall.
+static const int MPOL_BIND_POLICY = 2;
+
+static bool envFlag(const char *name) {
+  char *env = getenv(name);
+  return env != nullptr && strcmp(env, "0") != 0;
+}
+
+KeyPlacement KeyPlacement::fromEnv() {
+  KeyPlacement placement;
+  placement.hugePages = envFlag("CONCRETE_KEYS_HUGE_PAGES");
+  placement.numaReplicas = envFlag("CONCRETE_KEYS_NUMA_REPLICAS");
+  return placement;
+}
+
+/// Parses a list in the sysfs format, e.g. `0-3,8,10-11`.
+static std::vector<int> parseList(std::string list) {
+  std::vector<int> values;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || range == "\n") {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last =
+        dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int value = first; value <= last; value++) {
+      values.push_back(value);
+    }
+  }
+  return values;
+}
+
+static std::vector<int> readList(std::string path) {
+  std::ifstream file(path);
+  std::string list;
+  if (!std::getline(file, list)) {
+    return {};
+  }
+  return parseList(list);
+}
+
+size_t numaNodeCount() {
+  static size_t count = []() -> size_t {
+    auto nodes = readList("/sys/devices/system/node/online");
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  }();
+  return count;
+}
+
+size_t currentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu, node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+std::vector<int> numaNodeCpus(size_t numaNode) {
+  auto cpus = readList("/sys/devices/system/node/node" +
+                       std::to_string(numaNode) + "/cpulist");
+  if (cpus.empty() && numaNode == 0) {
+    // No NUMA information, all the cpus are on the single node
+    for (long cpu = 0; cpu < sysconf(_SC_NPROCESSORS_ONLN); cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::shared_ptr<double> allocateKeyBuffer(size_t numWords, bool hugePages,
+                                          int numaNode) {
+  if (!hugePages && numaNode < 0) {
+    return std::shared_ptr<double>(new double[numWords],
+                                   std::default_delete<double[]>());
+  }
+  size_t size = numWords * sizeof(double);
+  size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+  void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    return std::shared_ptr<double>(new double[numWords],
+                                   std::default_delete<double[]>());
+  }
+#ifdef MADV_HUGEPAGE
+  if (hugePages) {
+    madvise(mapping, size, MADV_HUGEPAGE);
+  }
+#endif
+#if defined(__linux__) && defined(SYS_mbind)
+  // The pages are not touched yet, so they are all allocated on the node.
+  if (numaNode >= 0) {
+    const size_t bitsPerMask = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> nodeMask(numaNode / bitsPerMask + 1, 0);
+    nodeMask[numaNode / bitsPerMask] = 1ul << (numaNode % bitsPerMask);
+    syscall(SYS_mbind, mapping, size, MPOL_BIND_POLICY, nodeMask.data(),
+            nodeMask.size() * bitsPerMask + 1, 0);
+  }
+#endif
+  return std::shared_ptr<double>((double *)mapping,
+                                 [size](double *p) { munmap(p, size); });
+}
+
+} // namespace concretelang
+} // namespace mlir
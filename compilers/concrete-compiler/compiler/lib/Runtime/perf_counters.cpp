@@ -0,0 +1,232 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include "concretelang/Runtime/perf_counters.h"
+
+namespace mlir {
+namespace concretelang {
+namespace perf {
+
+namespace {
+struct Key {
+  Op op;
+  uint32_t keyId;
+  Params params;
+
+  bool operator==(const Key &other) const {
+    return op == other.op && keyId == other.keyId && params == other.params;
+  }
+};
+
+struct KeyHash {
+  size_t operator()(const Key &key) const {
+    size_t hash = (size_t)key.op * 31 + key.keyId;
+    for (auto param : key.params) {
+      hash = hash * 0x9e3779b97f4a7c15 + param;
+    }
+    return hash;
+  }
+};
+
+struct Entry {
+  Key key;
+  Stats stats;
+};
+
+struct TraceEvent {
+  Op op;
+  uint32_t keyId;
+  uint64_t startNs;
+  uint64_t durationNs;
+};
+
+/// The events recorded by a thread, kept after the thread exits.
+struct ThreadTrace {
+  std::mutex mutex;
+  uint64_t tid;
+  std::vector<TraceEvent> events;
+};
+
+std::mutex entriesMutex;
+std::unordered_map<Key, std::unique_ptr<Entry>, KeyHash> entries;
+/// Per thread cache of `entries` to avoid the lock on the hot path.
+thread_local std::unordered_map<Key, Stats *, KeyHash> threadEntries;
+
+std::atomic<uint64_t> allocatedBytes{0};
+std::atomic<uint64_t> allocationCount{0};
+
+std::atomic<bool> tracing{false};
+std::mutex tracesMutex;
+std::vector<std::shared_ptr<ThreadTrace>> traces;
+thread_local std::shared_ptr<ThreadTrace> threadTrace;
+} // namespace
+
+static const char *opName(Op op) {
+  switch (op) {
+  case Op::KEYSWITCH:
+    return "keyswitch";
+  case Op::BOOTSTRAP:
+    return "bootstrap";
+  case Op::WOP_PBS:
+    return "wop_pbs";
+  case Op::DFR_TASK:
+    return "dfr_task";
+  case Op::DFR_TASK_WAIT:
+    return "dfr_task_wait";
+  }
+  return "unknown";
+}
+
+/// Returns the names of the parameters of `op`, empty for the unused ones.
+static std::array<const char *, NUM_PARAMS> paramNames(Op op) {
+  switch (op) {
+  case Op::KEYSWITCH:
+    return {"level", "base_log", "input_dimension", "output_dimension", ""};
+  case Op::BOOTSTRAP:
+    return {"input_lwe_dimension", "polynomial_size", "level", "base_log",
+            "glwe_dimension"};
+  case Op::WOP_PBS:
+    return {"polynomial_size", "bsk_level", "bsk_base_log", "cbs_level",
+            "cbs_base_log"};
+  default:
+    return {"", "", "", "", ""};
+  }
+}
+
+Stats &stats(Op op, uint32_t keyId, const Params &params) {
+  Key key{op, keyId, params};
+  auto cached = threadEntries.find(key);
+  if (cached != threadEntries.end()) {
+    return *cached->second;
+  }
+  std::lock_guard<std::mutex> guard(entriesMutex);
+  auto &entry = entries[key];
+  if (entry == nullptr) {
+    entry = std::make_unique<Entry>();
+    entry->key = key;
+  }
+  threadEntries[key] = &entry->stats;
+  return entry->stats;
+}
+
+void record(Stats &stats, Op op, uint32_t keyId, uint64_t startNs,
+            uint64_t durationNs) {
+  stats.count.fetch_add(1, std::memory_order_relaxed);
+  stats.totalNs.fetch_add(durationNs, std::memory_order_relaxed);
+  size_t bucket = 63 - __builtin_clzll(durationNs | 1);
+  stats.histogram[std::min(bucket, NUM_BUCKETS - 1)].fetch_add(
+      1, std::memory_order_relaxed);
+
+  if (!tracing.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (threadTrace == nullptr) {
+    threadTrace = std::make_shared<ThreadTrace>();
+    std::lock_guard<std::mutex> guard(tracesMutex);
+    threadTrace->tid = traces.size();
+    traces.push_back(threadTrace);
+  }
+  std::lock_guard<std::mutex> guard(threadTrace->mutex);
+  threadTrace->events.push_back({op, keyId, startNs, durationNs});
+}
+
+void recordAllocation(uint64_t bytes) {
+  allocatedBytes.fetch_add(bytes, std::memory_order_relaxed);
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::string countersJSON() {
+  std::stringstream json;
+  json << "{\"allocated_bytes\": " << allocatedBytes.load()
+       << ", \"allocation_count\": " << allocationCount.load()
+       << ", \"operations\": [";
+  std::lock_guard<std::mutex> guard(entriesMutex);
+  bool first = true;
+  for (auto &it : entries) {
+    auto &entry = *it.second;
+    json << (first ? "" : ", ") << "{\"op\": \"" << opName(entry.key.op)
+         << "\", \"key_id\": " << entry.key.keyId << ", \"params\": {";
+    auto names = paramNames(entry.key.op);
+    bool firstParam = true;
+    for (size_t i = 0; i < NUM_PARAMS; i++) {
+      if (names[i][0] == '\0') {
+        continue;
+      }
+      json << (firstParam ? "" : ", ") << "\"" << names[i]
+           << "\": " << entry.key.params[i];
+      firstParam = false;
+    }
+    json << "}, \"count\": " << entry.stats.count.load()
+         << ", \"total_ns\": " << entry.stats.totalNs.load()
+         << ", \"histogram_log2_ns\": [";
+    for (size_t i = 0; i < NUM_BUCKETS; i++) {
+      json << (i == 0 ? "" : ", ") << entry.stats.histogram[i].load();
+    }
+    json << "]}";
+    first = false;
+  }
+  json << "]}";
+  return json.str();
+}
+
+void resetCounters() {
+  std::lock_guard<std::mutex> guard(entriesMutex);
+  for (auto &it : entries) {
+    auto &stats = it.second->stats;
+    stats.count = 0;
+    stats.totalNs = 0;
+    for (auto &bucket : stats.histogram) {
+      bucket = 0;
+    }
+  }
+  allocatedBytes = 0;
+  allocationCount = 0;
+}
+
+void startTrace() {
+  std::lock_guard<std::mutex> guard(tracesMutex);
+  for (auto &trace : traces) {
+    std::lock_guard<std::mutex> traceGuard(trace->mutex);
+    trace->events.clear();
+  }
+  tracing = true;
+}
+
+bool stopTrace(std::string path) {
+  tracing = false;
+  std::ofstream file(path);
+  file << std::fixed << std::setprecision(3) << "{\"traceEvents\": [";
+  bool first = true;
+  auto pid = getpid();
+  std::lock_guard<std::mutex> guard(tracesMutex);
+  for (auto &trace : traces) {
+    std::lock_guard<std::mutex> traceGuard(trace->mutex);
+    for (auto &event : trace->events) {
+      file << (first ? "" : ",\n") << "{\"name\": \"" << opName(event.op)
+           << "\", \"cat\": \"concrete\", \"ph\": \"X\", \"ts\": "
+           << event.startNs / 1000. << ", \"dur\": " << event.durationNs / 1000.
+           << ", \"pid\": " << pid << ", \"tid\": " << trace->tid
+           << ", \"args\": {\"key_id\": " << event.keyId << "}}";
+      first = false;
+    }
+    trace->events.clear();
+  }
+  file << "]}\n";
+  return !file.fail();
+}
+
+} // namespace perf
+} // namespace concretelang
+} // namespace mlir
@@ -0,0 +1,157 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "concretelang/Runtime/shared_key_segment.h"
+
+namespace mlir {
+namespace concretelang {
+
+using StringError = ::concretelang::error::StringError;
+
+namespace {
+/// The header stored at the beginning of a segment, the key words follow it
+/// at `SEGMENT_HEADER_SIZE`.
+struct SegmentHeader {
+  uint64_t magic;
+  uint64_t fingerprint;
+  uint64_t numWords;
+};
+
+const uint64_t SEGMENT_MAGIC = 0x434f4e4352455445; // "CONCRETE"
+const size_t SEGMENT_HEADER_SIZE = 64;
+/// Segments are sized in multiple of 2MiB to be mappable on huge pages.
+const size_t SEGMENT_ALIGN = 2 * 1024 * 1024;
+/// Number of attempts to open or create a segment, when it's created or
+/// removed by another process in the meantime.
+const int SEGMENT_MAX_ATTEMPTS = 3;
+} // namespace
+
+static_assert(sizeof(SegmentHeader) <= SEGMENT_HEADER_SIZE,
+              "segment header doesn't fit in its reserved space");
+
+static std::string segmentPath(std::string directory, uint64_t fingerprint) {
+  std::stringstream path;
+  path << directory << "/concrete_fbsk_" << std::hex << fingerprint;
+  return path.str();
+}
+
+SharedKeySegment::~SharedKeySegment() { munmap(mapping, mappingSize); }
+
+outcome::checked<std::shared_ptr<SharedKeySegment>, StringError>
+SharedKeySegment::openOrCreate(std::string directory, uint64_t fingerprint,
+                               size_t numWords,
+                               std::function<void(double *)> fill) {
+  size_t mappingSize = SEGMENT_HEADER_SIZE + numWords * sizeof(double);
+  mappingSize = (mappingSize + SEGMENT_ALIGN - 1) / SEGMENT_ALIGN *
+                SEGMENT_ALIGN;
+  auto path = segmentPath(directory, fingerprint);
+
+  // Maps the published segment `fd` read-only. The directory may be writable
+  // by other users, so only the segments which belong to the current user and
+  // are private to them are trusted.
+  auto mapPublished = [&](int fd)
+      -> outcome::checked<std::shared_ptr<SharedKeySegment>, StringError> {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) ||
+        st.st_uid != geteuid() || (st.st_mode & (S_IRWXG | S_IRWXO)) != 0) {
+      close(fd);
+      return StringError("Untrusted shared key segment ")
+             << path << ", it must be a file private to the current user";
+    }
+    if ((size_t)st.st_size != mappingSize) {
+      close(fd);
+      return StringError("Invalid shared key segment ") << path;
+    }
+    void *mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    auto err = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+      return StringError("Cannot map shared key segment ")
+             << path << ": " << strerror(err);
+    }
+    auto header = (SegmentHeader *)mapping;
+    if (header->magic != SEGMENT_MAGIC || header->fingerprint != fingerprint ||
+        header->numWords != numWords) {
+      munmap(mapping, mappingSize);
+      return StringError("Invalid shared key segment ") << path;
+    }
+    auto words = (double *)((char *)mapping + SEGMENT_HEADER_SIZE);
+    return std::shared_ptr<SharedKeySegment>(
+        new SharedKeySegment(mapping, mappingSize, words, numWords));
+  };
+
+  for (int attempt = 0; attempt < SEGMENT_MAX_ATTEMPTS; attempt++) {
+    int fd = open(path.c_str(), O_RDONLY | O_NOFOLLOW);
+    if (fd >= 0) {
+      return mapPublished(fd);
+    }
+    if (errno != ENOENT) {
+      return StringError("Cannot open shared key segment ")
+             << path << ": " << strerror(errno);
+    }
+
+    // The segment is filled in a temporary file, created private to the
+    // current user, and then published under its name at once. So a segment
+    // found under its name is always complete, even if its creator died,
+    // while an interrupted creation only leaves a temporary file behind.
+    std::string tmpPath = path + ".XXXXXX";
+    fd = mkstemp(&tmpPath[0]);
+    if (fd < 0) {
+      return StringError("Cannot create shared key segment ")
+             << tmpPath << ": " << strerror(errno);
+    }
+    if (ftruncate(fd, mappingSize) != 0) {
+      auto err = errno;
+      close(fd);
+      unlink(tmpPath.c_str());
+      return StringError("Cannot allocate shared key segment ")
+             << tmpPath << ": " << strerror(err);
+    }
+    void *mapping =
+        mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto err = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+      unlink(tmpPath.c_str());
+      return StringError("Cannot map shared key segment ")
+             << tmpPath << ": " << strerror(err);
+    }
+    auto header = new (mapping) SegmentHeader();
+    header->magic = SEGMENT_MAGIC;
+    header->fingerprint = fingerprint;
+    header->numWords = numWords;
+    auto words = (double *)((char *)mapping + SEGMENT_HEADER_SIZE);
+    fill(words);
+    mprotect(mapping, mappingSize, PROT_READ);
+
+    // Unlike rename, link doesn't replace a segment published in the meantime
+    // by another process, which is then mapped instead to share its memory.
+    int linked = link(tmpPath.c_str(), path.c_str());
+    err = errno;
+    unlink(tmpPath.c_str());
+    if (linked == 0) {
+      return std::shared_ptr<SharedKeySegment>(
+          new SharedKeySegment(mapping, mappingSize, words, numWords));
+    }
+    munmap(mapping, mappingSize);
+    if (err != EEXIST) {
+      return StringError("Cannot publish shared key segment ")
+             << path << ": " << strerror(err);
+    }
+  }
+  return StringError("Cannot open or create shared key segment ") << path;
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -6,6 +6,7 @@
 #include "concretelang/Runtime/wrappers.h"
 #include "concrete-cpu.h"
 #include "concretelang/Common/Error.h"
+#include <algorithm>
 #include <assert.h>
 #include <bitset>
 #include <cmath>
@@ -17,6 +18,7 @@
 #include <vector>
 
 #include "concretelang/ClientLib/CRT.h"
+#include "concretelang/Runtime/perf_counters.h"
 #include "concretelang/Runtime/wrappers.h"
 
 #ifdef CONCRETELANG_CUDA_SUPPORT
@@ -235,6 +237,17 @@ void memref_batched_bootstrap_lwe_cuda_u64(
 
 #endif
 
+/// Aborts with the error message `message` of the runtime function `function`
+/// if `condition` doesn't hold. Unlike an assert, the check is kept in the
+/// release builds, for the conditions depending on the circuit.
+static void runtimeCheck(bool condition, const char *function,
+                         const char *message) {
+  if (!condition) {
+    std::cerr << "Runtime: " << function << ": " << message << "\n";
+    abort();
+  }
+}
+
 void memref_encode_plaintext_with_crt(
     uint64_t *output_allocated, uint64_t *output_aligned,
     uint64_t output_offset, uint64_t output_size, uint64_t output_stride,
@@ -320,6 +333,67 @@ void memref_encode_expand_lut_for_bootstrap(
   return;
 }
 
+void memref_encode_expand_many_lut_for_bootstrap(
+    uint64_t *output_lut_allocated, uint64_t *output_lut_aligned,
+    uint64_t output_lut_offset, uint64_t output_lut_size,
+    uint64_t output_lut_stride, uint64_t *input_luts_allocated,
+    uint64_t *input_luts_aligned, uint64_t input_luts_offset,
+    uint64_t input_luts_size0, uint64_t input_luts_size1,
+    uint64_t input_luts_stride0, uint64_t input_luts_stride1,
+    uint32_t poly_size, uint32_t out_MESSAGE_BITS, bool is_signed) {
+
+  runtimeCheck(output_lut_stride == 1,
+               "memref_encode_expand_many_lut_for_bootstrap",
+               "stride not equal to 1");
+
+  size_t lut_count = input_luts_size0;
+  size_t lut_size = input_luts_size1;
+  // The many-lut bootstrap rotates the accumulator by multiples of
+  // `lut_stride`, the value of the lut `j` is then read at `j`.
+  size_t lut_stride = 1;
+  while (lut_stride < lut_count) {
+    lut_stride <<= 1;
+  }
+  size_t mega_case_size = output_lut_size / lut_size;
+
+  runtimeCheck(mega_case_size != 0 && mega_case_size % (2 * lut_stride) == 0,
+               "memref_encode_expand_many_lut_for_bootstrap",
+               "polynomial too small for the number of luts");
+
+  // See memref_encode_expand_lut_for_bootstrap
+  std::function<size_t(size_t)> indexMap;
+  if (is_signed) {
+    size_t halfInputSize = lut_size / 2;
+    indexMap = [=](size_t idx) {
+      if (idx < halfInputSize) {
+        return idx + halfInputSize;
+      } else {
+        return idx - halfInputSize;
+      }
+    };
+  } else {
+    indexMap = [=](size_t idx) { return idx; };
+  }
+
+  for (size_t idx = 0; idx < output_lut_size; ++idx) {
+    size_t lut = idx % lut_stride;
+    if (lut >= lut_count) {
+      // Padding between the luts, never extracted
+      lut = 0;
+    }
+    // The box of the rotation, the first one is centered over zero so its
+    // second half is at the end of the output lut (and negated).
+    size_t box = (idx - idx % lut_stride + mega_case_size / 2) / mega_case_size;
+    auto value_at = [&](size_t lut_idx) {
+      return input_luts_aligned[input_luts_offset + lut * input_luts_stride0 +
+                                indexMap(lut_idx) * input_luts_stride1]
+             << (64 - out_MESSAGE_BITS - 1);
+    };
+    output_lut_aligned[output_lut_offset + idx] =
+        box == lut_size ? -value_at(0) : value_at(box);
+  }
+}
+
 void memref_encode_lut_for_crt_woppbs(
     // Output encoded/expanded lut
     uint64_t *output_lut_allocated, uint64_t *output_lut_aligned,
@@ -350,102 +424,25 @@ void memref_encode_lut_for_crt_woppbs(
 
   assert(modulus_product >= input_lut_size);
 
-  // Initialize lut cases not supposed to be reached
-  for (uint64_t i = 0; i < output_lut_size0 * output_lut_size1; i++) {
-    output_lut_aligned[output_lut_offset + i] = 0;
-  }
-
-  // When the woppbs is executed on encrypted signed integers, the index of the
-  // lut elements must be adapted to fit the way signed are encrypted in CRT
-  // (to ensure the lookup falls into the proper case).
-  // This map takes care about properly indexing into the output lut depending
-  // on what bootstrap gets executed.
-  std::function<uint64_t(uint64_t)> indexMap;
-  if (!is_signed) {
-    // When not signed, the integer values are encoded in increasing order. That
-    // is (example of 9 bits values, using crt decomposition [5,7,16]):
-    //
-    // |0     511|
-    // |---------|
-    // |0     511|
-    //
-    // is encoded as
-    //
-    // |0   511|  INVALID  |
-    // |-------|-----------|
-    // |0   511|512     559|
-    //
-    // Where on top are represented the semantic values, and below, the actual
-    // encoding of values, either on uint64_t or as increasing crt values.
-    //
-    // As a consequence, there is nothing particular to do to map the index of
-    // the input lut to an index of the output lut.
-    indexMap = [=](uint64_t plaintext) { return plaintext; };
-  } else {
-    // When signed, the integer values are encoded in a way that resembles 2s
-    // complement. That is (example of 9 bits values, using crt decomposition
-    // [5,7,16]):
-    //
-    // |0     255|-256    -1|
-    // |---------|----------|
-    // |0     255|256    511|
-    //
-    // is encoded as
-    //
-    // |0     255|   INVALID   |-256    -1|
-    // |---------|-------------|----------|
-    // |0     255|256       303|304    559|
-    //
-    // Where on top are represented the semantic values, and below, the actual
-    // encoding of values, either on uint64_t or as increasing crt values.
-    //
-    // As a consequence, to map the index of the input lut to an index of the
-    // output lut we must take care of crossing the invalid range in between
-    // positive values and negative values.
-    indexMap = [=](uint64_t plaintext) {
-      if (plaintext >= (input_lut_size / 2)) {
-        plaintext += modulus_product - input_lut_size;
-      }
-      return plaintext;
-    };
-  }
-
+  std::vector<int64_t> crt_decomposition(crt_decomposition_size);
+  std::vector<int64_t> crt_bits(crt_decomposition_size);
   uint64_t log_lut_crt_size = 0;
-
-  for (size_t in_block = 0; in_block < crt_decomposition_size; in_block++) {
-    auto bits_count = crt_bits_aligned[crt_bits_offset + in_block];
-    log_lut_crt_size += bits_count;
+  for (size_t block = 0; block < crt_decomposition_size; block++) {
+    crt_decomposition[block] =
+        crt_decomposition_aligned[crt_decomposition_offset +
+                                  block * crt_decomposition_stride];
+    crt_bits[block] =
+        crt_bits_aligned[crt_bits_offset + block * crt_bits_stride];
+    log_lut_crt_size += crt_bits[block];
   }
 
-  uint64_t lut_crt_size = 1 << log_lut_crt_size;
-  assert(lut_crt_size == output_lut_size1);
+  assert((uint64_t(1) << log_lut_crt_size) == output_lut_size1);
   assert(crt_decomposition_size == output_lut_size0);
 
-  for (uint64_t in_index = 0; in_index < input_lut_size; in_index++) {
-    uint64_t out_index = 0;
-
-    {
-      uint64_t total_bit_count = 0;
-      for (size_t in_block = 0; in_block < crt_decomposition_size; in_block++) {
-        auto in_base =
-            crt_decomposition_aligned[crt_decomposition_offset + in_block];
-        auto bits_count = crt_bits_aligned[crt_bits_offset + in_block];
-        out_index += (((indexMap(in_index) % in_base) << bits_count) / in_base)
-                     << total_bit_count;
-        total_bit_count += bits_count;
-      }
-    }
-
-    for (size_t out_block = 0; out_block < crt_decomposition_size;
-         out_block++) {
-      auto out_base =
-          crt_decomposition_aligned[crt_decomposition_offset + out_block];
-      auto v = encode_crt(input_lut_aligned[input_lut_offset + in_index],
-                          out_base, modulus_product);
-      output_lut_aligned[output_lut_offset + out_block * lut_crt_size +
-                         out_index] = v;
-    }
-  }
+  concretelang::clientlib::crt::encodeLutForWopPBS(
+      output_lut_aligned + output_lut_offset,
+      input_lut_aligned + input_lut_offset, input_lut_size, crt_decomposition,
+      crt_bits, modulus_product, is_signed);
 }
 
 void memref_add_lwe_ciphertexts_u64(
@@ -508,6 +505,10 @@ void memref_keyswitch_lwe_u64(uint64_t *out_allocated, uint64_t *out_aligned,
                               uint32_t output_dimension, uint32_t ksk_index,
                               mlir::concretelang::RuntimeContext *context) {
   assert(out_stride == 1 && ct0_stride == 1);
+  mlir::concretelang::perf::Timer timer(
+      mlir::concretelang::perf::Op::KEYSWITCH, ksk_index,
+      {decomposition_level_count, decomposition_base_log, input_dimension,
+       output_dimension, 0});
   // Get keyswitch key
   const uint64_t *keyswitch_key = context->keyswitch_key_buffer(ksk_index);
   // Get stack parameter
@@ -525,12 +526,65 @@ void memref_batched_keyswitch_lwe_u64(
     uint64_t ct0_stride0, uint64_t ct0_stride1, uint32_t level,
     uint32_t base_log, uint32_t input_lwe_dim, uint32_t output_lwe_dim,
     uint32_t ksk_index, mlir::concretelang::RuntimeContext *context) {
-  for (size_t i = 0; i < ct0_size0; i++) {
-    memref_keyswitch_lwe_u64(
-        out_allocated + i * out_size1, out_aligned + i * out_size1, out_offset,
-        out_size1, out_stride1, ct0_allocated + i * ct0_size1,
-        ct0_aligned + i * ct0_size1, ct0_offset, ct0_size1, ct0_stride1, level,
-        base_log, input_lwe_dim, output_lwe_dim, ksk_index, context);
+  if (out_size0 != ct0_size0) {
+    std::cerr << "Runtime: memref_batched_keyswitch_lwe_u64 got a batch of "
+              << ct0_size0 << " ciphertexts for " << out_size0
+              << " outputs\n";
+    abort();
+  }
+  // The list keyswitch requires the ciphertexts of each batch to be packed,
+  // the others are keyswitched one at a time
+  if (out_stride1 != 1 || ct0_stride1 != 1 || out_stride0 != out_size1 ||
+      ct0_stride0 != ct0_size1) {
+    for (size_t i = 0; i < ct0_size0; i++) {
+      memref_keyswitch_lwe_u64(
+          out_allocated, out_aligned, out_offset + i * out_stride0, out_size1,
+          out_stride1, ct0_allocated, ct0_aligned, ct0_offset + i * ct0_stride0,
+          ct0_size1, ct0_stride1, level, base_log, input_lwe_dim,
+          output_lwe_dim, ksk_index, context);
+    }
+    return;
+  }
+  auto &stats = mlir::concretelang::perf::stats(
+      mlir::concretelang::perf::Op::KEYSWITCH, ksk_index,
+      {level, base_log, input_lwe_dim, output_lwe_dim, 0});
+  uint64_t startNs = mlir::concretelang::perf::now();
+  // Get keyswitch key
+  const uint64_t *keyswitch_key = context->keyswitch_key_buffer(ksk_index);
+  // The whole batch is keyswitched at once, so that each block of the key is
+  // loaded once per tile of ciphertexts instead of once per ciphertext
+  concrete_cpu_keyswitch_lwe_ciphertext_list_u64(
+      out_aligned + out_offset, ct0_aligned + ct0_offset, keyswitch_key, level,
+      base_log, input_lwe_dim, output_lwe_dim, ct0_size0);
+  // Each ciphertext of the batch is recorded as a keyswitch of the average
+  // duration
+  if (ct0_size0 > 0) {
+    uint64_t durationNs =
+        (mlir::concretelang::perf::now() - startNs) / ct0_size0;
+    for (size_t i = 0; i < ct0_size0; i++) {
+      mlir::concretelang::perf::record(stats,
+                                       mlir::concretelang::perf::Op::KEYSWITCH,
+                                       ksk_index, startNs + i * durationNs,
+                                       durationNs);
+    }
+  }
+}
+
+/// Aborts with an error message if the bootstrap key `bsk_index` is a multi
+/// bit key, which is only supported by memref_bootstrap_lwe_u64. The
+/// compiler only generates classic keys for the other bootstraps, but the
+/// keys given to the runtime are not checked against the circuit.
+static void
+requireClassicBootstrapKey(mlir::concretelang::RuntimeContext *context,
+                           uint32_t bsk_index, const char *function) {
+  auto grouping_factor = context->bootstrap_grouping_factor(bsk_index);
+  if (grouping_factor != 1) {
+    std::cerr << "Runtime: " << function
+              << " doesn't support multi bit bootstrap keys, but the "
+                 "bootstrap key "
+              << bsk_index << " has a grouping factor of " << grouping_factor
+              << "\n";
+    abort();
   }
 }
 
@@ -544,9 +598,14 @@ void memref_bootstrap_lwe_u64(
     uint32_t decomposition_level_count, uint32_t decomposition_base_log,
     uint32_t glwe_dimension, uint32_t bsk_index,
     mlir::concretelang::RuntimeContext *context) {
+  mlir::concretelang::perf::Timer timer(
+      mlir::concretelang::perf::Op::BOOTSTRAP, bsk_index,
+      {input_lwe_dimension, polynomial_size, decomposition_level_count,
+       decomposition_base_log, glwe_dimension});
 
   uint64_t glwe_ct_size = polynomial_size * (glwe_dimension + 1);
   uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_size * sizeof(uint64_t));
+  mlir::concretelang::perf::recordAllocation(glwe_ct_size * sizeof(uint64_t));
   auto tlu = tlu_aligned + tlu_offset;
 
   // Glwe trivial encryption
@@ -560,20 +619,97 @@ void memref_bootstrap_lwe_u64(
   // Get fourrier bootstrap key
   const auto &fft = context->fft(bsk_index);
   auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+  auto grouping_factor = context->bootstrap_grouping_factor(bsk_index);
   // Get stack parameter
   size_t scratch_size;
   size_t scratch_align;
-  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
-      &scratch_size, &scratch_align, glwe_dimension, polynomial_size, fft);
+  if (grouping_factor > 1) {
+    concrete_cpu_multi_bit_bootstrap_lwe_ciphertext_u64_scratch(
+        &scratch_size, &scratch_align, decomposition_level_count,
+        glwe_dimension, polynomial_size, fft);
+  } else {
+    concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+        &scratch_size, &scratch_align, glwe_dimension, polynomial_size, fft);
+  }
   // Allocate scratch
   auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  mlir::concretelang::perf::recordAllocation(scratch_size);
 
   // Bootstrap
-  concrete_cpu_bootstrap_lwe_ciphertext_u64(
+  if (grouping_factor > 1) {
+    // The products of the key by the monomials of the groups are computed in
+    // parallel ahead of the external products
+    concrete_cpu_multi_bit_bootstrap_lwe_ciphertext_u64(
+        out_aligned + out_offset, ct0_aligned + ct0_offset, glwe_ct,
+        bootstrap_key, decomposition_level_count, decomposition_base_log,
+        glwe_dimension, polynomial_size, input_lwe_dimension, grouping_factor,
+        Parallelism::Rayon, fft, scratch, scratch_size);
+  } else {
+    concrete_cpu_bootstrap_lwe_ciphertext_u64(
+        out_aligned + out_offset, ct0_aligned + ct0_offset, glwe_ct,
+        bootstrap_key, decomposition_level_count, decomposition_base_log,
+        glwe_dimension, polynomial_size, input_lwe_dimension, fft, scratch,
+        scratch_size);
+  }
+
+  free(glwe_ct);
+  free(scratch);
+}
+
+void memref_many_lut_bootstrap_lwe_u64(
+    uint64_t *out_allocated, uint64_t *out_aligned, uint64_t out_offset,
+    uint64_t out_size0, uint64_t out_size1, uint64_t out_stride0,
+    uint64_t out_stride1, uint64_t *ct0_allocated, uint64_t *ct0_aligned,
+    uint64_t ct0_offset, uint64_t ct0_size, uint64_t ct0_stride,
+    uint64_t *tlu_allocated, uint64_t *tlu_aligned, uint64_t tlu_offset,
+    uint64_t tlu_size, uint64_t tlu_stride, uint32_t input_lwe_dimension,
+    uint32_t polynomial_size, uint32_t decomposition_level_count,
+    uint32_t decomposition_base_log, uint32_t glwe_dimension,
+    uint32_t bsk_index, mlir::concretelang::RuntimeContext *context) {
+  runtimeCheck(out_stride0 == out_size1 && out_stride1 == 1,
+               "memref_many_lut_bootstrap_lwe_u64",
+               "output ciphertexts not contiguous");
+  mlir::concretelang::perf::Timer timer(
+      mlir::concretelang::perf::Op::BOOTSTRAP, bsk_index,
+      {input_lwe_dimension, polynomial_size, decomposition_level_count,
+       decomposition_base_log, glwe_dimension});
+
+  uint64_t glwe_ct_size = polynomial_size * (glwe_dimension + 1);
+  uint64_t *glwe_ct = (uint64_t *)malloc(glwe_ct_size * sizeof(uint64_t));
+  mlir::concretelang::perf::recordAllocation(glwe_ct_size * sizeof(uint64_t));
+  auto tlu = tlu_aligned + tlu_offset;
+
+  // Glwe trivial encryption
+  for (size_t i = 0; i < polynomial_size * glwe_dimension; i++) {
+    glwe_ct[i] = 0;
+  }
+  for (size_t i = 0; i < polynomial_size; i++) {
+    glwe_ct[polynomial_size * glwe_dimension + i] = tlu[i];
+  }
+
+  size_t lut_count_log = 0;
+  while (((size_t)1 << lut_count_log) < out_size0) {
+    lut_count_log++;
+  }
+
+  // Get fourrier bootstrap key
+  const auto &fft = context->fft(bsk_index);
+  requireClassicBootstrapKey(context, bsk_index,
+                             "memref_many_lut_bootstrap_lwe_u64");
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+  // The many-lut bootstrap uses the same stack as the bootstrap
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratch_size, &scratch_align, glwe_dimension, polynomial_size, fft);
+  auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  mlir::concretelang::perf::recordAllocation(scratch_size);
+
+  concrete_cpu_many_lut_bootstrap_lwe_ciphertext_u64(
       out_aligned + out_offset, ct0_aligned + ct0_offset, glwe_ct,
       bootstrap_key, decomposition_level_count, decomposition_base_log,
-      glwe_dimension, polynomial_size, input_lwe_dimension, fft, scratch,
-      scratch_size);
+      glwe_dimension, polynomial_size, input_lwe_dimension, lut_count_log,
+      out_size0, fft, scratch, scratch_size);
 
   free(glwe_ct);
   free(scratch);
@@ -630,6 +766,10 @@ void memref_wop_pbs_crt_buffer(
     uint32_t ksk_index, uint32_t bsk_index, uint32_t pksk_index,
     // runtime context that hold evluation keys
     mlir::concretelang::RuntimeContext *context) {
+  mlir::concretelang::perf::Timer timer(
+      mlir::concretelang::perf::Op::WOP_PBS, bsk_index,
+      {polynomial_size, bsk_level_count, bsk_base_log, cbs_level_count,
+       cbs_base_log});
 
   // The compiler should only generates 2D memref<BxS>, where B is the number of
   // ciphertext block and S the lweSize.
@@ -672,49 +812,44 @@ void memref_wop_pbs_crt_buffer(
   // is the size of the crt decomposition
   auto extract_bits_output_buffer =
       new uint64_t[lwe_small_size * total_number_of_bits_per_block]{0};
+  mlir::concretelang::perf::recordAllocation(
+      lwe_small_size * total_number_of_bits_per_block * sizeof(uint64_t));
 
-  // We make a private copy to apply a subtraction on the body
+  // We make a private copy to apply a subtraction on the body, with the blocks
+  // in reverse order so the bits of the last block are extracted first
   auto first_ciphertext = in_aligned + in_offset;
-  auto copy_size = crt_decomp_size * lwe_big_size;
-  std::vector<uint64_t> in_copy(first_ciphertext, first_ciphertext + copy_size);
-  // Extraction of each bit for each block
-
-  const auto &fft = context->fft(bsk_index);
-  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
-  auto keyswicth_key = context->keyswitch_key_buffer(ksk_index);
-
-  for (int64_t i = crt_decomp_size - 1, extract_bits_output_offset = 0; i >= 0;
-       extract_bits_output_offset += number_of_bits_per_block[i--]) {
+  std::vector<uint64_t> in_copy(crt_decomp_size * lwe_big_size);
+  std::vector<size_t> number_of_bits(crt_decomp_size);
+  std::vector<size_t> delta_log(crt_decomp_size);
+  for (uint64_t i = 0; i < crt_decomp_size; i++) {
     auto nb_bits_to_extract = number_of_bits_per_block[i];
+    auto j = crt_decomp_size - 1 - i;
+    number_of_bits[j] = nb_bits_to_extract;
+    delta_log[j] = 64 - nb_bits_to_extract;
 
-    size_t delta_log = 64 - nb_bits_to_extract;
-
-    auto in_block = &in_copy[lwe_big_size * i];
+    auto in_block = &in_copy[lwe_big_size * j];
+    std::copy(first_ciphertext + lwe_big_size * i,
+              first_ciphertext + lwe_big_size * (i + 1), in_block);
 
     // trick ( ct - delta/2 + delta/2^4  )
     uint64_t sub = (uint64_t(1) << (uint64_t(64) - nb_bits_to_extract - 1)) -
                    (uint64_t(1) << (uint64_t(64) - nb_bits_to_extract - 5));
     in_block[lwe_big_size - 1] -= sub;
+  }
 
-    size_t scratch_size;
-    size_t scratch_align;
-    concrete_cpu_extract_bit_lwe_ciphertext_u64_scratch(
-        &scratch_size, &scratch_align, lwe_small_dim, lwe_big_dim, glwe_dim,
-        polynomial_size, fft);
-    // Allocate scratch
-    auto *scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
-
-    concrete_cpu_extract_bit_lwe_ciphertext_u64(
-        &extract_bits_output_buffer[lwe_small_size *
-                                    extract_bits_output_offset],
-        in_block, bootstrap_key, keyswicth_key, lwe_small_dim,
-        nb_bits_to_extract, lwe_big_dim, nb_bits_to_extract, delta_log,
-        bsk_level_count, bsk_base_log, glwe_dim, polynomial_size, lwe_small_dim,
-        ksk_level_count, ksk_base_log, lwe_big_dim, lwe_small_dim, fft, scratch,
-        scratch_size);
+  const auto &fft = context->fft(bsk_index);
+  requireClassicBootstrapKey(context, bsk_index, "memref_wop_pbs_crt_buffer");
+  auto bootstrap_key = context->fourier_bootstrap_key_buffer(bsk_index);
+  auto keyswicth_key = context->keyswitch_key_buffer(ksk_index);
 
-    free(scratch);
-  }
+  // The blocks are independent, so their bits are extracted in parallel on
+  // the thread pool of concrete-cpu, each block allocating its own scratch
+  concrete_cpu_extract_bit_lwe_ciphertext_list_u64(
+      extract_bits_output_buffer, in_copy.data(), bootstrap_key, keyswicth_key,
+      lwe_small_dim, total_number_of_bits_per_block, lwe_big_dim,
+      crt_decomp_size, number_of_bits.data(), delta_log.data(),
+      bsk_level_count, bsk_base_log, glwe_dim, polynomial_size, lwe_small_dim,
+      ksk_level_count, ksk_base_log, lwe_big_dim, lwe_small_dim, fft);
 
   size_t ct_in_count = total_number_of_bits_per_block;
   size_t lut_size = 1 << ct_in_count;
@@ -733,6 +868,7 @@ void memref_wop_pbs_crt_buffer(
       cbs_level_count, fft);
 
   auto *scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  mlir::concretelang::perf::recordAllocation(scratch_size);
 
   auto fp_keyswicth_key = context->fp_keyswitch_key_buffer(pksk_index);
 
@@ -742,8 +878,8 @@ void memref_wop_pbs_crt_buffer(
       lwe_big_dim, ct_out_count, lwe_small_dim, ct_in_count, lut_size,
       lut_count, bsk_level_count, bsk_base_log, glwe_dim, polynomial_size,
       lwe_small_dim, fpksk_level_count, fpksk_base_log, lwe_big_dim, glwe_dim,
-      polynomial_size, glwe_dim + 1, cbs_level_count, cbs_base_log, fft,
-      scratch, scratch_size);
+      polynomial_size, glwe_dim + 1, cbs_level_count, cbs_base_log,
+      Parallelism::Rayon, fft, scratch, scratch_size);
 
   free(scratch);
 }
@@ -754,7 +890,7 @@ void memref_copy_one_rank(uint64_t *src_allocated, uint64_t *src_aligned,
                           uint64_t *dst_aligned, uint64_t dst_offset,
                           uint64_t dst_size, uint64_t dst_stride) {
   assert(src_size == dst_size && "memref_copy_one_rank size differs");
-  if (src_stride == dst_stride) {
+  if (src_stride == 1 && dst_stride == 1) {
     memcpy(dst_aligned + dst_offset, src_aligned + src_offset,
            src_size * sizeof(uint64_t));
     return;
@@ -765,6 +901,91 @@ void memref_copy_one_rank(uint64_t *src_allocated, uint64_t *src_aligned,
   }
 }
 
+namespace {
+/// The fields of the descriptor of a ranked memref of 64 bits integers, as
+/// pointed by the descriptor of an unranked memref.
+struct RankedDescriptorView {
+  uint64_t *aligned;
+  int64_t offset;
+  int64_t *sizes;
+  int64_t *strides;
+
+  RankedDescriptorView(int64_t rank, void *descriptor) {
+    auto pointers = (uint64_t **)descriptor;
+    aligned = pointers[1];
+    auto fields = (int64_t *)(pointers + 2);
+    offset = fields[0];
+    sizes = fields + 1;
+    strides = fields + 1 + rank;
+  }
+};
+} // namespace
+
+void memref_copy_blocks(int64_t src_rank, void *src_descriptor,
+                        int64_t dst_rank, void *dst_descriptor) {
+  assert(src_rank == dst_rank && "memref_copy_blocks rank differs");
+  RankedDescriptorView src(src_rank, src_descriptor);
+  RankedDescriptorView dst(dst_rank, dst_descriptor);
+  int64_t rank = src_rank;
+  for (int64_t dim = 0; dim < rank; dim++) {
+    assert(src.sizes[dim] == dst.sizes[dim] &&
+           "memref_copy_blocks size differs");
+    if (src.sizes[dim] == 0) {
+      return;
+    }
+  }
+  // The innermost dimensions which are contiguous in both memrefs are copied
+  // as a single block.
+  int64_t block_size = 1;
+  int64_t outer_rank = rank;
+  while (outer_rank > 0 && src.strides[outer_rank - 1] == block_size &&
+         dst.strides[outer_rank - 1] == block_size) {
+    block_size *= src.sizes[outer_rank - 1];
+    outer_rank--;
+  }
+  // Iterates over the blocks in the order of the outer dimensions.
+  std::vector<int64_t> index(outer_rank, 0);
+  int64_t src_pos = src.offset;
+  int64_t dst_pos = dst.offset;
+  while (true) {
+    memcpy(dst.aligned + dst_pos, src.aligned + src_pos,
+           block_size * sizeof(uint64_t));
+    int64_t dim = outer_rank - 1;
+    for (; dim >= 0; dim--) {
+      index[dim]++;
+      src_pos += src.strides[dim];
+      dst_pos += dst.strides[dim];
+      if (index[dim] < src.sizes[dim]) {
+        break;
+      }
+      src_pos -= src.strides[dim] * src.sizes[dim];
+      dst_pos -= dst.strides[dim] * dst.sizes[dim];
+      index[dim] = 0;
+    }
+    if (dim < 0) {
+      return;
+    }
+  }
+}
+
+void _mlir_ciface_memref_arena_acquire(
+    concretelang::clientlib::MemRefDescriptor<1> *arena,
+    mlir::concretelang::RuntimeContext *context, uint64_t size) {
+  auto buffer = (uint64_t *)context->acquire_arena(size);
+  arena->allocated = buffer;
+  arena->aligned = buffer;
+  arena->offset = 0;
+  arena->sizes[0] = size;
+  arena->strides[0] = 1;
+}
+
+void memref_arena_release(uint8_t *arena_allocated, uint8_t *arena_aligned,
+                          uint64_t arena_offset, uint64_t arena_size,
+                          uint64_t arena_stride,
+                          mlir::concretelang::RuntimeContext *context) {
+  context->release_arena(arena_allocated);
+}
+
 void memref_trace_ciphertext(uint64_t *ct0_allocated, uint64_t *ct0_aligned,
                              uint64_t ct0_offset, uint64_t ct0_size,
                              uint64_t ct0_stride, char *message_ptr,
@@ -793,3 +1014,33 @@ void memref_trace_message(char *message_ptr, uint32_t message_len) {
   std::string message{message_ptr, (size_t)message_len};
   std::cout << message << std::endl;
 }
+
+bool cpu_supports_version(const char *cpu) {
+#if defined(__x86_64__)
+  // The features are only checked once, the dispatchers of the multiversioned
+  // functions calling this on each call.
+  static const bool supportsV2 = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("ssse3") &&
+           __builtin_cpu_supports("sse4.1") &&
+           __builtin_cpu_supports("sse4.2") &&
+           __builtin_cpu_supports("popcnt");
+  }();
+  static const bool supportsV3 =
+      supportsV2 && __builtin_cpu_supports("avx") &&
+      __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi") &&
+      __builtin_cpu_supports("bmi2") && __builtin_cpu_supports("fma");
+  static const bool supportsV4 =
+      supportsV3 && __builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+
+  if (strcmp(cpu, "x86-64-v2") == 0)
+    return supportsV2;
+  if (strcmp(cpu, "x86-64-v3") == 0)
+    return supportsV3;
+  if (strcmp(cpu, "x86-64-v4") == 0)
+    return supportsV4;
+#endif
+  return false;
+}
@@ -9,6 +9,7 @@
 
 #include "concretelang/ClientLib/Serializers.h"
 #include "concretelang/Common/Error.h"
+#include "concretelang/Runtime/perf_counters.h"
 #include "concretelang/ServerLib/DynamicModule.h"
 #include "concretelang/ServerLib/ServerLambda.h"
 #include "concretelang/Support/CompilerEngine.h"
@@ -83,5 +84,36 @@ ServerLambda::call(PublicArguments &args, EvaluationKeys &evaluationKeys) {
                            evaluationKeys);
 }
 
+std::shared_ptr<PreparedEvaluationKeys>
+ServerLambda::prepareEvaluationKeys(EvaluationKeys &evaluationKeys,
+                                    std::optional<std::string> sharedKeysPath) {
+  return PreparedEvaluationKeys::prepare(evaluationKeys, sharedKeysPath);
+}
+
+llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+ServerLambda::call(PublicArguments &args,
+                   std::shared_ptr<PreparedEvaluationKeys> preparedKeys,
+                   mlir::concretelang::MemoryArena *arena) {
+  return invokeRawOnLambda(this, args.clientParameters, args.preparedArgs,
+                           preparedKeys, arena);
+}
+
+std::string ServerLambda::performanceCounters() {
+  return mlir::concretelang::perf::countersJSON();
+}
+
+void ServerLambda::resetPerformanceCounters() {
+  mlir::concretelang::perf::resetCounters();
+}
+
+void ServerLambda::startTrace() { mlir::concretelang::perf::startTrace(); }
+
+outcome::checked<void, StringError> ServerLambda::stopTrace(std::string path) {
+  if (!mlir::concretelang::perf::stopTrace(path)) {
+    return StringError("Cannot write trace file: ") << path;
+  }
+  return outcome::success();
+}
+
 } // namespace serverlib
 } // namespace concretelang
@@ -2,7 +2,9 @@
 // Exceptions. See
 // https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
 // for license information.
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <llvm/ADT/SmallVector.h>
 #include <map>
 #include <optional>
@@ -242,7 +244,9 @@ template <typename V> using Set = llvm::SmallSet<V, 10, HashValComparator<V>>;
 
 void extractCircuitKeys(ClientParameters &output,
                         TFHE::TFHECircuitKeys circuitKeys,
-                        concrete::SecurityCurve curve) {
+                        concrete::SecurityCurve curve,
+                        Set<TFHE::GLWEBootstrapKeyAttr> &classicKeys,
+                        uint64_t multiBitGroupingFactor) {
 
   // Pushing secret keys
   for (auto sk : circuitKeys.secretKeys) {
@@ -278,6 +282,10 @@ void extractCircuitKeys(ClientParameters &output,
     bskParam.variance =
         curve.getVariance(bsk.getGlweDim(), bsk.getPolySize(), 64);
     bskParam.inputLweDimension = inputNormKey.dimension;
+    if (multiBitGroupingFactor > 1 && classicKeys.count(bsk) == 0 &&
+        inputNormKey.dimension % multiBitGroupingFactor == 0) {
+      bskParam.groupingFactor = multiBitGroupingFactor;
+    }
     output.bootstrapKeys.push_back(bskParam);
   }
 
@@ -299,11 +307,118 @@ void extractCircuitKeys(ClientParameters &output,
   }
 }
 
+/// The standard deviation of the error added by the switch of the modulus of
+/// the outputs is kept 2^OUTPUT_MODULUS_SWITCH_MARGIN_LOG times below the
+/// largest error tolerated by the decoding, such that it's negligible compared
+/// to the error of the ciphertexts.
+const double OUTPUT_MODULUS_SWITCH_MARGIN_LOG = 6;
+
+/// Returns the log2 of the largest error tolerated by the decoding of the
+/// ciphertexts with `encoding` modulo 2^64.
+double toleratedErrorLog(const Encoding &encoding) {
+  if (encoding.crt.empty()) {
+    return 62.0 - encoding.precision;
+  }
+  auto modulus = *std::max_element(encoding.crt.begin(), encoding.crt.end());
+  return 63.0 - std::log2(modulus);
+}
+
+/// Returns the log2 of the smallest modulus the ciphertexts with `encoding`
+/// under a secret key of dimension `lweDimension` can be switched to.
+uint64_t outputModulusLog(const Encoding &encoding, uint64_t lweDimension) {
+  // Each coefficient is rounded with an error uniform in [-1/2, 1/2] modulo
+  // the new modulus, the errors of the mask being multiplied by the binary
+  // secret key.
+  double switchErrorLog = 0.5 * std::log2((lweDimension + 1) / 12.0);
+  double modulusLog = 64.0 - toleratedErrorLog(encoding) + switchErrorLog +
+                      OUTPUT_MODULUS_SWITCH_MARGIN_LOG;
+  return std::min<uint64_t>(64, std::ceil(modulusLog));
+}
+
+/// The standard deviation of the error added by the packing of the outputs in
+/// GLWE ciphertexts is kept 2^OUTPUT_PACKING_MARGIN_LOG times below the
+/// largest error tolerated by the decoding.
+const double OUTPUT_PACKING_MARGIN_LOG = 6;
+
+/// Polynomial size of the GLWE ciphertexts packing the outputs under a key
+/// which is not the output key of a bootstrap.
+const uint64_t DEFAULT_OUTPUT_PACKING_POLYNOMIAL_SIZE = 2048;
+
+/// Returns the parameters of a key packing the ciphertexts with `encoding`
+/// under the secret key `inputSecretKeyID` in GLWE ciphertexts under a new
+/// secret key, which is pushed to the client parameters. An output gate has at
+/// most `maxCiphertexts` ciphertexts to pack. The decomposition is the one
+/// with the fewest levels keeping the error added by the keyswitches of the
+/// ciphertexts packed in a GLWE below the tolerated error of the decoding, an
+/// error is returned if none does.
+llvm::Expected<clientlib::PackingKeyswitchKeyParam>
+outputPackingKeyswitchKey(ClientParameters &output,
+                          concrete::SecurityCurve curve,
+                          const Encoding &encoding, uint64_t maxCiphertexts,
+                          LweSecretKeyID inputSecretKeyID) {
+  clientlib::PackingKeyswitchKeyParam pkskParam;
+  pkskParam.inputSecretKeyID = inputSecretKeyID;
+  pkskParam.inputLweDimension = output.secretKeys[inputSecretKeyID].dimension;
+  pkskParam.packingOnly = true;
+
+  // Pack in GLWE ciphertexts of the size of those bootstrapped to the input
+  // key, if any
+  pkskParam.glweDimension = 1;
+  pkskParam.polynomialSize = DEFAULT_OUTPUT_PACKING_POLYNOMIAL_SIZE;
+  for (auto bskParam : output.bootstrapKeys) {
+    if (bskParam.outputSecretKeyID == inputSecretKeyID) {
+      pkskParam.glweDimension = bskParam.glweDimension;
+      pkskParam.polynomialSize = bskParam.polynomialSize;
+      break;
+    }
+  }
+  pkskParam.variance = curve.getVariance(pkskParam.glweDimension,
+                                         pkskParam.polynomialSize, 64);
+
+  clientlib::LweSecretKeyParam skParam;
+  skParam.dimension = pkskParam.glweDimension * pkskParam.polynomialSize;
+  pkskParam.outputSecretKeyID = output.secretKeys.size();
+  output.secretKeys.push_back(skParam);
+
+  // Each of the `n` coefficients of the mask is decomposed on `level` levels
+  // of `baseLog` bits, the decomposition terms multiplying GLWE encryptions of
+  // variance `variance` and the rounding of the decomposition being multiplied
+  // by the binary secret key (variances on the torus). The keyswitched
+  // ciphertexts are summed in the GLWE ciphertext, which adds up the errors
+  // of up to `polynomialSize` keyswitches.
+  double n = pkskParam.inputLweDimension;
+  double packed = std::min<uint64_t>(maxCiphertexts, pkskParam.polynomialSize);
+  double maxVariance = std::exp2(
+      2 * (toleratedErrorLog(encoding) - 64.0 - OUTPUT_PACKING_MARGIN_LOG));
+  pkskParam.level = 0;
+  for (uint64_t level = 1; level <= 64 && pkskParam.level == 0; level++) {
+    for (uint64_t baseLog = 1; baseLog * level <= 64; baseLog++) {
+      double keyswitchVariance = n * level * std::exp2(2.0 * baseLog) /
+                                 12.0 * pkskParam.variance;
+      double roundingVariance =
+          n / 2.0 * std::exp2(-2.0 * level * baseLog) / 12.0;
+      if (packed * (keyswitchVariance + roundingVariance) < maxVariance) {
+        pkskParam.level = level;
+        pkskParam.baseLog = baseLog;
+        break;
+      }
+    }
+  }
+  if (pkskParam.level == 0) {
+    return StreamStringError("Cannot pack the outputs under the secret key ")
+           << inputSecretKeyID
+           << ", no decomposition of the packing key is precise enough for "
+              "their encoding";
+  }
+  return pkskParam;
+}
+
 llvm::Expected<std::monostate>
 extractCircuitGates(ClientParameters &output, mlir::func::FuncOp funcOp,
                     encodings::CircuitEncodings encodings,
                     concrete::SecurityCurve curve,
-                    std::optional<CRTDecomposition> maybeCrt) {
+                    std::optional<CRTDecomposition> maybeCrt,
+                    bool switchOutputsModulus, bool packOutputs) {
 
   // Create input and output circuit gate parameters
   auto funcType = funcOp.getFunctionType();
@@ -317,6 +432,7 @@ extractCircuitGates(ClientParameters &output, mlir::func::FuncOp funcOp,
     }
     output.inputs.push_back(gate.get());
   }
+  std::vector<CircuitGate> outputGates;
   for (auto val : llvm::zip(funcType.getResults(), encodings.outputEncodings)) {
     auto ty = std::get<0>(val);
     auto encoding = std::get<1>(val);
@@ -324,7 +440,68 @@ extractCircuitGates(ClientParameters &output, mlir::func::FuncOp funcOp,
     if (auto err = gate.takeError()) {
       return std::move(err);
     }
-    output.outputs.push_back(gate.get());
+    outputGates.push_back(gate.get());
+  }
+  // The outputs under the same key share their packing key, which must be
+  // precise enough for the encoding tolerating the smallest error among them
+  // and for the largest number of ciphertexts packed together
+  std::map<LweSecretKeyID, Encoding> packingEncodings;
+  std::map<LweSecretKeyID, uint64_t> packingCiphertexts;
+  for (auto &gate : outputGates) {
+    auto &encryption = gate.encryption;
+    if (!encryption.has_value()) {
+      continue;
+    }
+    uint64_t ciphertexts =
+        std::max<uint64_t>(gate.shape.size, 1) *
+        std::max<uint64_t>(encryption->encoding.crt.size(), 1);
+    auto &maxCiphertexts = packingCiphertexts[encryption->secretKeyID];
+    maxCiphertexts = std::max(maxCiphertexts, ciphertexts);
+    auto packingEncoding = packingEncodings.find(encryption->secretKeyID);
+    if (packingEncoding == packingEncodings.end()) {
+      packingEncodings.insert({encryption->secretKeyID, encryption->encoding});
+    } else if (toleratedErrorLog(encryption->encoding) <
+               toleratedErrorLog(packingEncoding->second)) {
+      packingEncoding->second = encryption->encoding;
+    }
+  }
+  std::map<LweSecretKeyID, clientlib::PackingKeyswitchKeyID>
+      outputPackingKeys;
+  for (auto &gate : outputGates) {
+    auto &encryption = gate.encryption;
+    auto lweDimension =
+        encryption.has_value()
+            ? output.secretKeys[encryption->secretKeyID].lweDimension()
+            : 0;
+    if (packOutputs && encryption.has_value()) {
+      auto packingKeyID = outputPackingKeys.find(encryption->secretKeyID);
+      if (packingKeyID == outputPackingKeys.end()) {
+        auto pkskParam = outputPackingKeyswitchKey(
+            output, curve, packingEncodings[encryption->secretKeyID],
+            packingCiphertexts[encryption->secretKeyID],
+            encryption->secretKeyID);
+        if (auto err = pkskParam.takeError()) {
+          return std::move(err);
+        }
+        output.packingKeyswitchKeys.push_back(pkskParam.get());
+        packingKeyID =
+            outputPackingKeys
+                .insert({encryption->secretKeyID,
+                         output.packingKeyswitchKeys.size() - 1})
+                .first;
+      }
+      encryption->packingKeyID = packingKeyID->second;
+      // The switched ciphertexts are the packing GLWE ciphertexts
+      auto pkskParam = output.packingKeyswitchKeys[packingKeyID->second];
+      lweDimension = pkskParam.glweDimension * pkskParam.polynomialSize;
+    }
+    if (switchOutputsModulus && encryption.has_value()) {
+      auto modulusLog = outputModulusLog(encryption->encoding, lweDimension);
+      if (modulusLog < 64) {
+        encryption->modulusLog = modulusLog;
+      }
+    }
+    output.outputs.push_back(gate);
   }
 
   return std::monostate();
@@ -334,7 +511,9 @@ llvm::Expected<ClientParameters>
 createClientParametersFromTFHE(mlir::ModuleOp module,
                                llvm::StringRef functionName, int bitsOfSecurity,
                                encodings::CircuitEncodings encodings,
-                               std::optional<CRTDecomposition> maybeCrt) {
+                               std::optional<CRTDecomposition> maybeCrt,
+                               uint64_t multiBitGroupingFactor,
+                               bool switchOutputsModulus, bool packOutputs) {
 
   // Check that security curves exist
   const auto curve = concrete::getSecurityCurve(bitsOfSecurity, keyFormat);
@@ -361,13 +540,24 @@ createClientParametersFromTFHE(mlir::ModuleOp module,
   // We extract the keys of the circuit
   auto circuitKeys = TFHE::extractCircuitKeys(module);
 
+  // The keys of the many lookup tables bootstraps and of the wop-pbs are
+  // evaluated by the runtime with classic bootstraps only
+  Set<TFHE::GLWEBootstrapKeyAttr> classicKeys;
+  module.walk([&](TFHE::ManyLutBootstrapGLWEOp op) {
+    classicKeys.insert(op.getKey());
+  });
+  module.walk(
+      [&](TFHE::WopPBSGLWEOp op) { classicKeys.insert(op.getBsk()); });
+
   // We extract all the keys used in the circuit
-  extractCircuitKeys(output, circuitKeys, *curve);
+  extractCircuitKeys(output, circuitKeys, *curve, classicKeys,
+                     multiBitGroupingFactor);
 
   // We generate the gates for the inputs aud outputs
-  if (auto err =
-          extractCircuitGates(output, *funcOp, encodings, *curve, maybeCrt)
-              .takeError()) {
+  if (auto err = extractCircuitGates(output, *funcOp, encodings, *curve,
+                                     maybeCrt, switchOutputsModulus,
+                                     packOutputs)
+                     .takeError()) {
     return std::move(err);
   }
 
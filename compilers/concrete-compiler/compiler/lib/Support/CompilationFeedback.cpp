@@ -51,6 +51,13 @@ void CompilationFeedback::fillFromClientParameters(
   // Compute the size of outputs
   totalOutputsSize = 0;
   for (auto gate : params.outputs) {
+    if (gate.isEncrypted() && gate.encryption->packingKeyID.has_value()) {
+      // The ciphertexts of the output are packed in GLWE ciphertexts
+      auto shape = params.packedBufferShape(gate);
+      uint64_t coefficientBits = gate.encryption->modulusLog.value_or(64);
+      totalOutputsSize += (coefficientBits * shape[0] * shape[1] + 7) / 8;
+      continue;
+    }
     totalOutputsSize += gate.byteSize(params.secretKeys);
   }
   // Extract CRT decomposition
@@ -81,6 +88,27 @@ CompilationFeedback::load(std::string jsonPath) {
   return expectedCompFeedback.get();
 }
 
+llvm::json::Value toJSON(const mlir::concretelang::OperationStatistic &v) {
+  llvm::json::Object object{
+      {"operation", v.operation},
+      {"location", v.location},
+      {"keyIndex", v.keyIndex},
+      {"count", v.count},
+      {"complexity", v.complexity},
+      {"complexityShare", v.complexityShare},
+  };
+  return object;
+}
+
+bool fromJSON(const llvm::json::Value j,
+              mlir::concretelang::OperationStatistic &v, llvm::json::Path p) {
+  llvm::json::ObjectMapper O(j, p);
+  return O && O.map("operation", v.operation) &&
+         O.map("location", v.location) && O.map("keyIndex", v.keyIndex) &&
+         O.map("count", v.count) && O.map("complexity", v.complexity) &&
+         O.map("complexityShare", v.complexityShare);
+}
+
 llvm::json::Value toJSON(const mlir::concretelang::CompilationFeedback &v) {
   llvm::json::Object object{
       {"complexity", v.complexity},
@@ -91,6 +119,11 @@ llvm::json::Value toJSON(const mlir::concretelang::CompilationFeedback &v) {
       {"totalKeyswitchKeysSize", v.totalKeyswitchKeysSize},
       {"totalInputsSize", v.totalInputsSize},
       {"totalOutputsSize", v.totalOutputsSize},
+      {"deduplicatedKeyswitches", v.deduplicatedKeyswitches},
+      {"peakIntermediateBuffersSize", v.peakIntermediateBuffersSize},
+      {"operationStatistics", v.operationStatistics},
+      {"peakCiphertextsSize", v.peakCiphertextsSize},
+      {"criticalPathComplexity", v.criticalPathComplexity},
       {"crtDecompositionsOfOutputs", v.crtDecompositionsOfOutputs},
   };
   return object;
@@ -99,6 +132,8 @@ llvm::json::Value toJSON(const mlir::concretelang::CompilationFeedback &v) {
 bool fromJSON(const llvm::json::Value j,
               mlir::concretelang::CompilationFeedback &v, llvm::json::Path p) {
   llvm::json::ObjectMapper O(j, p);
+  // The fields added after the first release are optional, so that the
+  // feedbacks written by older compilers can still be loaded
   return O && O.map("complexity", v.complexity) && O.map("pError", v.pError) &&
          O.map("globalPError", v.globalPError) &&
          O.map("totalSecretKeysSize", v.totalSecretKeysSize) &&
@@ -106,6 +141,12 @@ bool fromJSON(const llvm::json::Value j,
          O.map("totalKeyswitchKeysSize", v.totalKeyswitchKeysSize) &&
          O.map("totalInputsSize", v.totalInputsSize) &&
          O.map("totalOutputsSize", v.totalOutputsSize) &&
+         O.mapOptional("deduplicatedKeyswitches", v.deduplicatedKeyswitches) &&
+         O.mapOptional("peakIntermediateBuffersSize",
+                       v.peakIntermediateBuffersSize) &&
+         O.mapOptional("operationStatistics", v.operationStatistics) &&
+         O.mapOptional("peakCiphertextsSize", v.peakCiphertextsSize) &&
+         O.mapOptional("criticalPathComplexity", v.criticalPathComplexity) &&
          O.map("crtDecompositionsOfOutputs", v.crtDecompositionsOfOutputs);
 }
 
@@ -48,6 +48,7 @@
 #include <concretelang/Support/Jit.h>
 #include <concretelang/Support/LLVMEmitFile.h>
 #include <concretelang/Support/Pipeline.h>
+#include <concretelang/Support/TFHECircuitStatistics.h>
 
 namespace mlir {
 namespace concretelang {
@@ -207,6 +208,15 @@ llvm::Error CompilerEngine::determineFHEParameters(CompilationResult &res) {
     if (!descr.get().has_value()) {
       return llvm::Error::success();
     }
+    auto groupingFactor =
+        compilerOptions.optimizerConfig.multi_bit_grouping_factor;
+    if (groupingFactor < 1 ||
+        groupingFactor > optimizer::MAX_MULTI_BIT_GROUPING_FACTOR) {
+      return StreamStringError("The multi bit grouping factor must be between "
+                               "1 and ")
+             << optimizer::MAX_MULTI_BIT_GROUPING_FACTOR << ", got "
+             << groupingFactor;
+    }
     CompilationFeedback feedback;
     // Make sure to use the gpu constraint of the optimizer if we use gpu
     // backend.
@@ -316,12 +326,38 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
   if (options.chunkIntegers) {
     if (mlir::concretelang::pipeline::transformFHEBigInt(
             mlirContext, module, enablePass, options.chunkSize,
-            options.chunkWidth)
+            options.chunkWidth, dataflowParallelize || loopParallelize)
             .failed()) {
       return errorDiag("Transforming FHE big integer ops failed");
     }
   }
 
+  // Before the composition, so that the tables used to round can be composed
+  // with the tables applied on the rounded values
+  if (options.roundLUTMaxPrecision > 0) {
+    if (mlir::concretelang::pipeline::transformFHERound(
+            mlirContext, module, enablePass, options.roundLUTMaxPrecision)
+            .failed()) {
+      return errorDiag("Transforming FHE round ops failed");
+    }
+  }
+
+  if (options.composeLUTs) {
+    if (mlir::concretelang::pipeline::composeLookupTables(mlirContext, module,
+                                                          enablePass)
+            .failed()) {
+      return errorDiag("Composition of lookup tables failed");
+    }
+  }
+
+  if (options.manyLUT) {
+    if (mlir::concretelang::pipeline::groupLookupTables(
+            mlirContext, module, enablePass, options.manyLUTMaxPrecision)
+            .failed()) {
+      return errorDiag("Grouping of lookup tables failed");
+    }
+  }
+
   // FHE High level pass to determine FHE parameters
   if (auto err = this->determineFHEParameters(res))
     return std::move(err);
@@ -426,7 +462,11 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
       auto clientParametersOrErr =
           mlir::concretelang::createClientParametersFromTFHE(
               module, funcName, options.optimizerConfig.security,
-              options.encodings.value(), maybeCrt);
+              options.encodings.value(), maybeCrt,
+              options.optimizerConfig.use_gpu_constraints
+                  ? 1
+                  : options.optimizerConfig.multi_bit_grouping_factor,
+              options.outputModulusSwitching, options.outputPacking);
 
       if (!clientParametersOrErr)
         return clientParametersOrErr.takeError();
@@ -439,11 +479,31 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
   if (target == Target::NORMALIZED_TFHE)
     return std::move(res);
 
+  uint64_t removedKeyswitches = 0;
+  if (options.optimizeTFHE &&
+      mlir::concretelang::pipeline::deduplicateKeyswitches(
+          mlirContext, module, enablePass, removedKeyswitches)
+          .failed()) {
+    return errorDiag("Deduplication of keyswitches failed");
+  }
+
   if (options.batchTFHEOps) {
     if (mlir::concretelang::pipeline::batchTFHE(mlirContext, module, enablePass)
             .failed()) {
       return errorDiag("Batching of TFHE operations");
     }
+    // Batches of keyswitches of the same ciphertexts can be shared as well
+    if (options.optimizeTFHE &&
+        mlir::concretelang::pipeline::deduplicateKeyswitches(
+            mlirContext, module, enablePass, removedKeyswitches)
+            .failed()) {
+      return errorDiag("Deduplication of keyswitches failed");
+    }
+  }
+
+  if (res.feedback.has_value()) {
+    res.feedback->deduplicatedKeyswitches = removedKeyswitches;
+    mlir::concretelang::TFHE::fillCircuitStatistics(module, *res.feedback);
   }
 
   if (target == Target::BATCHED_TFHE)
@@ -476,8 +536,8 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
   }
 
   // Concrete -> Canonical dialects
-  if (mlir::concretelang::pipeline::lowerConcreteToStd(mlirContext, module,
-                                                       enablePass)
+  if (mlir::concretelang::pipeline::lowerConcreteToStd(
+          mlirContext, module, enablePass, options.inlineLeveledOps)
           .failed()) {
     return errorDiag("Lowering from Bufferized Concrete to canonical MLIR "
                      "dialects failed");
@@ -494,12 +554,18 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
     return std::move(res);
 
   // MLIR canonical dialects -> LLVM Dialect
+  uint64_t arenaSizes = 0;
   if (mlir::concretelang::pipeline::lowerStdToLLVMDialect(
-          mlirContext, module, enablePass, loopParallelize, options.emitGPUOps)
+          mlirContext, module, enablePass, loopParallelize, options.emitGPUOps,
+          options.planMemory, arenaSizes)
           .failed()) {
     return errorDiag("Failed to lower to LLVM dialect");
   }
 
+  if (res.feedback.has_value()) {
+    res.feedback->peakIntermediateBuffersSize = arenaSizes;
+  }
+
   if (target == Target::LLVM)
     return std::move(res);
 
@@ -515,8 +581,21 @@ CompilerEngine::compile(llvm::SourceMgr &sm, Target target, OptionalLib lib) {
   if (target == Target::LLVM_IR)
     return std::move(res);
 
-  if (mlir::concretelang::pipeline::optimizeLLVMModule(llvmContext,
-                                                       *res.llvmModule)
+  auto targetMachine = mlir::concretelang::createTargetMachine(
+      compilerOptions.targetCPU, compilerOptions.targetFeatures);
+  if (!targetMachine)
+    return targetMachine.takeError();
+  res.targetMachine = std::move(*targetMachine);
+
+  // The versions for the other CPUs are generated before the optimizations,
+  // which are then tuned for the CPU of each version.
+  mlir::concretelang::setupModuleTarget(*res.llvmModule, *res.targetMachine);
+  if (auto err = mlir::concretelang::multiversionFunctions(
+          *res.llvmModule, compilerOptions.targetCPUVersions))
+    return std::move(err);
+
+  if (mlir::concretelang::pipeline::optimizeLLVMModule(
+          llvmContext, *res.llvmModule, res.targetMachine.get())
           .failed()) {
     return errorDiag("Failed to optimize LLVM IR");
   }
@@ -805,7 +884,8 @@ CompilerEngine::Library::addCompilation(CompilationResult &compilation) {
                  std::to_string(objectsPath.size()) + ".mlir";
   }
   auto objectPath = sourceName + OBJECT_EXT;
-  if (auto error = mlir::concretelang::emitObject(*module, objectPath)) {
+  if (auto error = mlir::concretelang::emitObject(
+          *module, *compilation.targetMachine, objectPath)) {
     return std::move(error);
   }
 
@@ -5,6 +5,7 @@
 
 #include <concretelang/Runtime/DFRuntime.hpp>
 #include <concretelang/Support/JITSupport.h>
+#include <concretelang/Support/LLVMEmitFile.h>
 #include <llvm/Support/TargetSelect.h>
 #include <mlir/Target/LLVMIR/Dialect/LLVMIR/LLVMToLLVMIRTranslation.h>
 
@@ -32,11 +33,17 @@ JITSupport::compile(llvm::SourceMgr &program, CompilationOptions options) {
   if (!options.clientParametersFuncName.has_value()) {
     return StreamStringError("Need to have a funcname to JIT compile");
   }
+  // The JIT always targets the host, for which the optimizations are tuned.
+  auto targetMachine = createTargetMachine();
+  if (auto err = targetMachine.takeError()) {
+    return std::move(err);
+  }
   // Compile from LLVM Dialect to JITLambda
   auto mlirModule = compilationResult.get().mlirModuleRef->get();
   auto lambda = concretelang::JITLambda::create(
       *options.clientParametersFuncName, mlirModule,
-      mlir::makeOptimizingTransformer(3, 0, nullptr), runtimeLibPath);
+      mlir::makeOptimizingTransformer(3, 0, targetMachine->get()),
+      runtimeLibPath);
   if (auto err = lambda.takeError()) {
     return std::move(err);
   }
@@ -76,9 +76,9 @@ llvm::Error JITLambda::invokeRaw(llvm::MutableArrayRef<void *> args) {
          << pos << " is null or missing";
 }
 
+template <typename Keys>
 llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
-JITLambda::call(clientlib::PublicArguments &args,
-                clientlib::EvaluationKeys &evaluationKeys) {
+JITLambda::callWithKeys(clientlib::PublicArguments &args, Keys &keys) {
 #ifndef CONCRETELANG_DATAFLOW_EXECUTION_ENABLED
   if (this->useDataflow) {
     return StreamStringError(
@@ -102,7 +102,19 @@ JITLambda::call(clientlib::PublicArguments &args,
 #endif
 
   return ::concretelang::invokeRawOnLambda(this, args.clientParameters,
-                                           args.preparedArgs, evaluationKeys);
+                                           args.preparedArgs, keys);
+}
+
+llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+JITLambda::call(clientlib::PublicArguments &args,
+                clientlib::EvaluationKeys &evaluationKeys) {
+  return callWithKeys(args, evaluationKeys);
+}
+
+llvm::Expected<std::unique_ptr<clientlib::PublicResult>>
+JITLambda::call(clientlib::PublicArguments &args,
+                std::shared_ptr<PreparedEvaluationKeys> preparedKeys) {
+  return callWithKeys(args, preparedKeys);
 }
 
 } // namespace concretelang
@@ -8,15 +8,19 @@
 #include "llvm/MC/SubtargetFeature.h"
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/MC/MCSubtargetInfo.h>
 #include <llvm/MC/TargetRegistry.h>
 #include <llvm/Support/ToolOutputFile.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/TargetParser/Host.h>
+#include <llvm/TargetParser/Triple.h>
+#include <llvm/Transforms/Utils/Cloning.h>
 
 #include <mlir/Support/FileUtilities.h>
 
 #include <concretelang/Support/Error.h>
+#include <concretelang/Support/LLVMEmitFile.h>
 #include <concretelang/Support/Utils.h>
 
 namespace mlir {
@@ -25,36 +29,193 @@ namespace concretelang {
 using std::string;
 using std::vector;
 
-// Get target machine from current machine and setup LLVM module accordingly
-std::unique_ptr<llvm::TargetMachine>
-getTargetMachineAndSetupModule(llvm::Module *llvmModule) {
-  // Setup the machine properties from the current architecture.
+llvm::Expected<std::unique_ptr<llvm::TargetMachine>>
+createTargetMachine(llvm::StringRef cpu, llvm::StringRef features) {
+  // The code runs on the host architecture, only the CPU may vary.
   auto targetTriple = llvm::sys::getDefaultTargetTriple();
   std::string errorMessage;
   const auto *target =
       llvm::TargetRegistry::lookupTarget(targetTriple, errorMessage);
   if (!target) {
-    llvm::errs() << "NO target: " << errorMessage << "\n";
-    return nullptr;
+    return StreamStringError("No target for ")
+           << targetTriple << ": " << errorMessage;
   }
 
-  std::string cpu(llvm::sys::getHostCPUName());
-  llvm::SubtargetFeatures features;
-  llvm::StringMap<bool> hostFeatures;
+  std::string targetCPU = cpu.str();
+  llvm::SubtargetFeatures targetFeatures;
 
-  if (llvm::sys::getHostCPUFeatures(hostFeatures))
-    for (auto &f : hostFeatures)
-      features.AddFeature(f.first(), f.second);
+  if (cpu == "native") {
+    targetCPU = llvm::sys::getHostCPUName().str();
+    llvm::StringMap<bool> hostFeatures;
+    if (llvm::sys::getHostCPUFeatures(hostFeatures))
+      for (auto &f : hostFeatures)
+        targetFeatures.AddFeature(f.first(), f.second);
+  }
+  // The explicit features come last to take precedence over the ones of the
+  // host.
+  llvm::SmallVector<llvm::StringRef> explicitFeatures;
+  features.split(explicitFeatures, ',', -1, false);
+  for (auto feature : explicitFeatures)
+    targetFeatures.AddFeature(feature.trim());
 
   std::unique_ptr<llvm::TargetMachine> machine(target->createTargetMachine(
-      targetTriple, cpu, features.getString(), {}, llvm::Reloc::PIC_));
+      targetTriple, targetCPU, targetFeatures.getString(), {},
+      llvm::Reloc::PIC_));
   if (!machine) {
-    llvm::errs() << "Unable to create target machine\n";
-    return nullptr;
+    return StreamStringError("Unable to create target machine for CPU ")
+           << targetCPU;
+  }
+  if (!machine->getMCSubtargetInfo()->isCPUStringValid(targetCPU)) {
+    return StreamStringError("Unknown target CPU ") << targetCPU;
   }
-  llvmModule->setDataLayout(machine->createDataLayout());
-  llvmModule->setTargetTriple(targetTriple);
-  return machine;
+  return std::move(machine);
+}
+
+void setupModuleTarget(llvm::Module &module,
+                       llvm::TargetMachine &targetMachine) {
+  module.setDataLayout(targetMachine.createDataLayout());
+  module.setTargetTriple(targetMachine.getTargetTriple().str());
+  // The functions carry their target, such that the optimizations and the
+  // code generation of each version of a multiversioned function use the
+  // features of its own CPU.
+  for (auto &func : module.functions()) {
+    if (func.isDeclaration())
+      continue;
+    func.addFnAttr("target-cpu", targetMachine.getTargetCPU());
+    func.addFnAttr("target-features", targetMachine.getTargetFeatureString());
+  }
+}
+
+/// CPUs for which a version of the functions can be generated, as recognized
+/// by the `cpu_supports_version` runtime function, from the least to the most
+/// capable.
+static const llvm::StringRef versionCPUs[] = {"x86-64-v2", "x86-64-v3",
+                                              "x86-64-v4"};
+
+llvm::Error multiversionFunctions(llvm::Module &module,
+                                  llvm::ArrayRef<std::string> cpus) {
+  if (cpus.empty())
+    return llvm::Error::success();
+
+  if (llvm::Triple(module.getTargetTriple()).getArch() !=
+      llvm::Triple::x86_64) {
+    return StreamStringError(
+        "Multiversioning is only supported on x86-64 targets");
+  }
+  for (auto &cpu : cpus) {
+    if (!llvm::is_contained(versionCPUs, cpu)) {
+      return StreamStringError("Unsupported CPU for multiversioning: ")
+             << cpu << ", should be one of x86-64-v{2,3,4}";
+    }
+  }
+
+  // The dispatchers call the version for the first CPU supported by the host,
+  // so they check the versions from the most to the least capable CPU.
+  llvm::SmallVector<llvm::StringRef> sortedCPUs;
+  for (auto cpu : llvm::reverse(versionCPUs))
+    if (llvm::is_contained(cpus, cpu))
+      sortedCPUs.push_back(cpu);
+
+  llvm::SmallVector<llvm::Function *> functions;
+  for (auto &func : module.functions())
+    if (!func.isDeclaration())
+      functions.push_back(&func);
+
+  // Clones all the functions for each CPU, the calls between the functions
+  // staying in the same version. The version for the target of the module is
+  // a clone as well, the original functions becoming the dispatchers.
+  auto cloneFunctions = [&](llvm::StringRef suffix) {
+    llvm::ValueToValueMapTy map;
+    llvm::DenseMap<llvm::Function *, llvm::Function *> clones;
+    for (auto func : functions) {
+      auto clone = llvm::Function::Create(func->getFunctionType(),
+                                          llvm::GlobalValue::ExternalLinkage,
+                                          func->getName() + "." + suffix,
+                                          &module);
+      for (auto [arg, cloneArg] : llvm::zip(func->args(), clone->args())) {
+        cloneArg.setName(arg.getName());
+        map[&arg] = &cloneArg;
+      }
+      map[func] = clone;
+      clones[func] = clone;
+    }
+    for (auto func : functions) {
+      llvm::SmallVector<llvm::ReturnInst *> returns;
+      llvm::CloneFunctionInto(clones[func], func, map,
+                              llvm::CloneFunctionChangeType::GlobalChanges,
+                              returns);
+      clones[func]->setLinkage(llvm::GlobalValue::InternalLinkage);
+      clones[func]->setVisibility(llvm::GlobalValue::DefaultVisibility);
+    }
+    return clones;
+  };
+
+  llvm::SmallVector<
+      std::pair<llvm::Constant *, llvm::DenseMap<llvm::Function *,
+                                                 llvm::Function *>>>
+      versions;
+  for (auto cpu : sortedCPUs) {
+    auto clones = cloneFunctions(cpu);
+    for (auto &entry : clones) {
+      entry.second->addFnAttr("target-cpu", cpu);
+      // Only the features of the CPU of the version are used.
+      entry.second->addFnAttr("target-features", "");
+    }
+    auto *cpuName =
+        llvm::ConstantDataArray::getString(module.getContext(), cpu);
+    auto *cpuNameGlobal = new llvm::GlobalVariable(
+        module, cpuName->getType(), true, llvm::GlobalValue::PrivateLinkage,
+        cpuName, "cpu_version." + cpu);
+    versions.push_back({cpuNameGlobal, std::move(clones)});
+  }
+  auto defaults = cloneFunctions("default");
+
+  auto &ctx = module.getContext();
+  llvm::IRBuilder<> builder(ctx);
+  auto supportsVersion = module.getOrInsertFunction(
+      "cpu_supports_version",
+      llvm::FunctionType::get(builder.getInt1Ty(), {builder.getInt8PtrTy()},
+                              /*isVarArg=*/false));
+  if (auto *callee =
+          llvm::dyn_cast<llvm::Function>(supportsVersion.getCallee()))
+    callee->addRetAttr(llvm::Attribute::ZExt);
+
+  for (auto func : functions) {
+    if (func->hasLocalLinkage())
+      continue;
+
+    auto linkage = func->getLinkage();
+    func->deleteBody();
+    func->setLinkage(linkage);
+
+    llvm::SmallVector<llvm::Value *> args;
+    for (auto &arg : func->args())
+      args.push_back(&arg);
+    auto callVersion = [&](llvm::Function *version) {
+      auto *call = builder.CreateCall(version, args);
+      call->setTailCall();
+      if (call->getType()->isVoidTy())
+        builder.CreateRetVoid();
+      else
+        builder.CreateRet(call);
+    };
+
+    builder.SetInsertPoint(llvm::BasicBlock::Create(ctx, "entry", func));
+    for (auto &[cpuName, clones] : versions) {
+      auto *supported = builder.CreateCall(supportsVersion, {cpuName});
+      auto *thenBlock = llvm::BasicBlock::Create(ctx, "", func);
+      auto *elseBlock = llvm::BasicBlock::Create(ctx, "", func);
+      builder.CreateCondBr(supported, thenBlock, elseBlock);
+      builder.SetInsertPoint(thenBlock);
+      callVersion(clones[func]);
+      builder.SetInsertPoint(elseBlock);
+    }
+    callVersion(defaults[func]);
+  }
+
+  // The original functions which aren't externally visible are not called
+  // anymore, and are removed by the optimization pipeline.
+  return llvm::Error::success();
 }
 
 // This function was copied from the MLIR Execution Engine, and provide an
@@ -67,7 +228,7 @@ static void packFunctionArguments(llvm::Module *module) {
   llvm::IRBuilder<> builder(ctx);
   llvm::DenseSet<llvm::Function *> interfaceFunctions;
   for (auto &func : module->getFunctionList()) {
-    if (func.isDeclaration()) {
+    if (func.isDeclaration() || func.hasLocalLinkage()) {
       continue;
     }
     if (interfaceFunctions.count(&func)) {
@@ -129,12 +290,8 @@ static void packFunctionArguments(llvm::Module *module) {
   }
 }
 
-llvm::Error emitObject(llvm::Module &module, string objectPath) {
-  auto targetMachine = getTargetMachineAndSetupModule(&module);
-  if (!targetMachine) {
-    return StreamStringError("No default target machine for object generation");
-  }
-
+llvm::Error emitObject(llvm::Module &module, llvm::TargetMachine &targetMachine,
+                       string objectPath) {
   string Error;
   std::unique_ptr<llvm::ToolOutputFile> objectFile =
       mlir::openOutputFile(objectPath, &Error);
@@ -148,8 +305,8 @@ llvm::Error emitObject(llvm::Module &module, string objectPath) {
   // https://llvm.org/docs/NewPassManager.html#status-of-the-new-and-legacy-pass-managers
   llvm::legacy::PassManager pm;
   auto FileType = llvm::CGFT_ObjectFile;
-  if (targetMachine->addPassesToEmitFile(pm, objectFile->os(), nullptr,
-                                         FileType, false)) {
+  if (targetMachine.addPassesToEmitFile(pm, objectFile->os(), nullptr,
+                                        FileType, false)) {
     return StreamStringError("TheTargetMachine can't emit object file");
   }
 
@@ -38,7 +38,10 @@
 #include <concretelang/Dialect/FHE/Transforms/BigInt/BigInt.h>
 #include <concretelang/Dialect/FHE/Transforms/Boolean/Boolean.h>
 #include <concretelang/Dialect/FHE/Transforms/EncryptedMulToDoubleTLU.h>
+#include <concretelang/Dialect/FHE/Transforms/LUTComposition/LUTComposition.h>
+#include <concretelang/Dialect/FHE/Transforms/ManyLUT/ManyLUT.h>
 #include <concretelang/Dialect/FHE/Transforms/Max/Max.h>
+#include <concretelang/Dialect/FHE/Transforms/Round/Round.h>
 #include <concretelang/Dialect/FHELinalg/Transforms/Tiling.h>
 #include <concretelang/Dialect/RT/Analysis/Autopar.h>
 #include <concretelang/Dialect/TFHE/Transforms/Transforms.h>
@@ -201,6 +204,8 @@ lowerFHELinalgToFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
       pm, mlir::concretelang::createConvertFHETensorOpsToLinalg(), enablePass);
   addPotentiallyNestedPass(pm, mlir::createLinalgGeneralizationPass(),
                            enablePass);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createDataMovementFusionPass(), enablePass);
   addPotentiallyNestedPass(
       pm,
       mlir::concretelang::createLinalgGenericOpWithTensorsToLoopsPass(
@@ -222,12 +227,13 @@ transformFHEBoolean(mlir::MLIRContext &context, mlir::ModuleOp &module,
 mlir::LogicalResult
 transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
                    std::function<bool(mlir::Pass *)> enablePass,
-                   unsigned int chunkSize, unsigned int chunkWidth) {
+                   unsigned int chunkSize, unsigned int chunkWidth,
+                   bool parallelCarries) {
   mlir::PassManager pm(&context);
-  addPotentiallyNestedPass(
-      pm,
-      mlir::concretelang::createFHEBigIntTransformPass(chunkSize, chunkWidth),
-      enablePass);
+  addPotentiallyNestedPass(pm,
+                           mlir::concretelang::createFHEBigIntTransformPass(
+                               chunkSize, chunkWidth, parallelCarries),
+                           enablePass);
   // We want to fully unroll for loops introduced by the BigInt transform since
   // MANP doesn't support loops. This is a workaround that make the IR much
   // bigger than it should be
@@ -236,6 +242,36 @@ transformFHEBigInt(mlir::MLIRContext &context, mlir::ModuleOp &module,
   return pm.run(module.getOperation());
 }
 
+mlir::LogicalResult
+transformFHERound(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                  std::function<bool(mlir::Pass *)> enablePass,
+                  unsigned int maxPrecision) {
+  mlir::PassManager pm(&context);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createFHERoundTransformPass(maxPrecision),
+      enablePass);
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+composeLookupTables(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                    std::function<bool(mlir::Pass *)> enablePass) {
+  mlir::PassManager pm(&context);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createFHELUTCompositionPass(), enablePass);
+  return pm.run(module.getOperation());
+}
+
+mlir::LogicalResult
+groupLookupTables(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                  std::function<bool(mlir::Pass *)> enablePass,
+                  unsigned int maxPrecision) {
+  mlir::PassManager pm(&context);
+  addPotentiallyNestedPass(
+      pm, mlir::concretelang::createFHEManyLUTPass(maxPrecision), enablePass);
+  return pm.run(module.getOperation());
+}
+
 mlir::LogicalResult
 lowerFHEToTFHE(mlir::MLIRContext &context, mlir::ModuleOp &module,
                std::optional<V0FHEContext> &fheContext,
@@ -344,6 +380,21 @@ mlir::LogicalResult optimizeTFHE(mlir::MLIRContext &context,
   return pm.run(module.getOperation());
 }
 
+mlir::LogicalResult
+deduplicateKeyswitches(mlir::MLIRContext &context, mlir::ModuleOp &module,
+                       std::function<bool(mlir::Pass *)> enablePass,
+                       uint64_t &removedKeyswitches) {
+  mlir::PassManager pm(&context);
+  pipelinePrinting("TFHEKeyswitchDeduplication", pm, context);
+  addPotentiallyNestedPass(
+      pm,
+      mlir::concretelang::createTFHEKeyswitchDeduplicationPass(
+          &removedKeyswitches),
+      enablePass);
+
+  return pm.run(module.getOperation());
+}
+
 mlir::LogicalResult extractSDFGOps(mlir::MLIRContext &context,
                                    mlir::ModuleOp &module,
                                    std::function<bool(mlir::Pass *)> enablePass,
@@ -359,9 +410,14 @@ mlir::LogicalResult extractSDFGOps(mlir::MLIRContext &context,
 
 mlir::LogicalResult
 lowerConcreteToStd(mlir::MLIRContext &context, mlir::ModuleOp &module,
-                   std::function<bool(mlir::Pass *)> enablePass) {
+                   std::function<bool(mlir::Pass *)> enablePass,
+                   bool inlineLeveledOps) {
   mlir::PassManager pm(&context);
   pipelinePrinting("ConcreteToStd", pm, context);
+  if (inlineLeveledOps) {
+    addPotentiallyNestedPass(
+        pm, mlir::concretelang::createInlineLeveledOpsPass(), enablePass);
+  }
   addPotentiallyNestedPass(pm, mlir::concretelang::createAddRuntimeContext(),
                            enablePass);
   return pm.run(module.getOperation());
@@ -381,7 +437,8 @@ lowerSDFGToStd(mlir::MLIRContext &context, mlir::ModuleOp &module,
 mlir::LogicalResult
 lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
                       std::function<bool(mlir::Pass *)> enablePass,
-                      bool parallelizeLoops, bool gpu) {
+                      bool parallelizeLoops, bool gpu, bool planMemory,
+                      uint64_t &arenaSizes) {
   mlir::PassManager pm(&context);
   pipelinePrinting("StdToLLVM", pm, context);
 
@@ -437,6 +494,14 @@ lowerStdToLLVMDialect(mlir::MLIRContext &context, mlir::ModuleOp &module,
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createFixupBufferDeallocationPass(), enablePass);
 
+  // Place the intermediate buffers in a per invocation arena, once the
+  // deallocations are known and before the elementwise operations are
+  // lowered to calls
+  if (planMemory)
+    addPotentiallyNestedPass(
+        pm, mlir::concretelang::createMemoryPlanningPass(&arenaSizes),
+        enablePass);
+
   addPotentiallyNestedPass(
       pm, mlir::concretelang::createConvertConcreteToCAPIPass(gpu), enablePass);
   addPotentiallyNestedPass(
@@ -463,9 +528,12 @@ lowerLLVMDialectToLLVMIR(mlir::MLIRContext &context,
 }
 
 mlir::LogicalResult optimizeLLVMModule(llvm::LLVMContext &llvmContext,
-                                       llvm::Module &module) {
+                                       llvm::Module &module,
+                                       llvm::TargetMachine *targetMachine) {
+  // The target machine lets the vectorizers use the vector units of the
+  // target.
   std::function<llvm::Error(llvm::Module *)> optPipeline =
-      mlir::makeOptimizingTransformer(3, 0, nullptr);
+      mlir::makeOptimizingTransformer(3, 0, targetMachine);
 
   if (optPipeline(&module))
     return mlir::failure();
@@ -112,6 +112,11 @@ TFHECircuitKeys extractCircuitKeys(mlir::ModuleOp moduleOp) {
     secretKeys.insert(op.getKeyAttr().getInputKey());
     secretKeys.insert(op.getKeyAttr().getOutputKey());
   });
+  moduleOp->walk([&](TFHE::ManyLutBootstrapGLWEOp op) {
+    bootstrapKeys.insert(op.getKeyAttr());
+    secretKeys.insert(op.getKeyAttr().getInputKey());
+    secretKeys.insert(op.getKeyAttr().getOutputKey());
+  });
 
   // Gathering circuit packing keyswitch keys
   SmallSet<TFHE::GLWEPackingKeyswitchKeyAttr> packingKeyswitchKeys;
@@ -0,0 +1,360 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <optional>
+#include <tuple>
+
+#include "mlir/Dialect/Func/IR/FuncOps.h"
+#include "mlir/Dialect/SCF/IR/SCF.h"
+#include "mlir/Dialect/Utils/StaticValueUtils.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/TypeSwitch.h"
+#include "llvm/Support/MathExtras.h"
+
+#include "concretelang/Dialect/TFHE/IR/TFHEOps.h"
+#include "concretelang/Dialect/TFHE/IR/TFHETypes.h"
+#include "concretelang/Support/TFHECircuitStatistics.h"
+
+namespace TFHE = mlir::concretelang::TFHE;
+
+namespace {
+
+/// Returns the lwe dimension of the ciphertexts encrypted with `key`.
+double lweDimension(TFHE::GLWESecretKey key) {
+  auto normalized = key.getNormalized();
+  assert(normalized.has_value() && "keys should be normalized");
+  return normalized->dimension * normalized->polySize;
+}
+
+// The complexities are estimated with the same model as the optimizer, i.e.
+// by counting the arithmetic operations of the cryptographic primitives.
+
+/// Returns the estimated complexity of a keyswitch from `inputDimension`
+/// to an output of `outputSize` coefficients with `levels` levels.
+double keyswitchComplexity(double inputDimension, double outputSize,
+                           double levels) {
+  double decompositions = inputDimension * levels;
+  double multiplications = inputDimension * levels * outputSize;
+  double additions = (inputDimension * levels - 1) * outputSize + 1;
+  return decompositions + multiplications + additions;
+}
+
+double complexity(TFHE::GLWEKeyswitchKeyAttr key) {
+  return keyswitchComplexity(lweDimension(key.getInputKey()),
+                             lweDimension(key.getOutputKey()) + 1,
+                             key.getLevels());
+}
+
+/// Returns the estimated complexity of a bootstrap, i.e. of one cmux per
+/// coefficient of the mask of the input.
+double complexity(TFHE::GLWEBootstrapKeyAttr key) {
+  double polySize = key.getPolySize();
+  double glweSize = key.getGlweDim() + 1;
+  double levels = key.getLevels();
+  double fft = polySize * std::log2(polySize) + polySize;
+  double cmux = glweSize * levels * fft + glweSize * fft +
+                glweSize * glweSize * levels * polySize;
+  return lweDimension(key.getInputKey()) * cmux;
+}
+
+double complexity(TFHE::GLWEPackingKeyswitchKeyAttr key) {
+  return keyswitchComplexity(key.getInputLweDim(),
+                             (key.getGlweDim() + 1) * key.getOutputPolySize(),
+                             key.getLevels());
+}
+
+/// Returns the estimated complexity of a wop-pbs, i.e. of the extraction of
+/// the bits of the blocks of the crt decomposition and of their circuit
+/// bootstraps. The vertical packing is not counted.
+double complexity(TFHE::WopPBSGLWEOp op) {
+  double bits = 0;
+  for (auto modulus : op.getCrtDecomposition()) {
+    bits += llvm::Log2_64_Ceil(
+        modulus.cast<mlir::IntegerAttr>().getValue().getZExtValue());
+  }
+  double bitExtraction = complexity(op.getKsk()) + complexity(op.getBsk());
+  double circuitBootstrap =
+      op.getCbsLevels() * (complexity(op.getBsk()) + complexity(op.getPksk()));
+  return bits * (bitExtraction + circuitBootstrap);
+}
+
+/// Returns the number of elements of the static tensor `value`.
+uint64_t numElements(mlir::Value value) {
+  return value.getType().cast<mlir::RankedTensorType>().getNumElements();
+}
+
+/// Returns the number of bytes of the ciphertexts of `type`, or 0 if `type`
+/// is not a ciphertext or a static tensor of ciphertexts.
+uint64_t ciphertextsSize(mlir::Type type) {
+  uint64_t elements = 1;
+  if (auto tensorType = type.dyn_cast<mlir::RankedTensorType>()) {
+    if (!tensorType.hasStaticShape()) {
+      return 0;
+    }
+    elements = tensorType.getNumElements();
+    type = tensorType.getElementType();
+  }
+  auto glweType = type.dyn_cast<TFHE::GLWECipherTextType>();
+  if (glweType == nullptr) {
+    return 0;
+  }
+  return elements * (lweDimension(glweType.getKey()) + 1) * sizeof(uint64_t);
+}
+
+/// Returns the number of iterations of `forOp`, or 1 if it is not static.
+uint64_t tripCount(mlir::scf::ForOp forOp) {
+  auto lowerBound = mlir::getConstantIntValue(forOp.getLowerBound());
+  auto upperBound = mlir::getConstantIntValue(forOp.getUpperBound());
+  auto step = mlir::getConstantIntValue(forOp.getStep());
+  if (!lowerBound || !upperBound || !step || *step <= 0) {
+    return 1;
+  }
+  if (*upperBound <= *lowerBound) {
+    return 0;
+  }
+  return llvm::divideCeil(*upperBound - *lowerBound, *step);
+}
+
+/// A cryptographic operation, with its number of executions in a single
+/// execution of its block and its estimated complexity.
+struct CryptographicOperation {
+  std::string operation;
+  uint64_t keyIndex;
+  uint64_t count;
+  double complexity;
+};
+
+std::optional<CryptographicOperation>
+cryptographicOperation(mlir::Operation *op) {
+  return llvm::TypeSwitch<mlir::Operation *,
+                          std::optional<CryptographicOperation>>(op)
+      .Case([](TFHE::KeySwitchGLWEOp op) {
+        return CryptographicOperation{"keyswitch",
+                                      (uint64_t)op.getKey().getIndex(), 1,
+                                      complexity(op.getKey())};
+      })
+      .Case([](TFHE::BatchedKeySwitchGLWEOp op) {
+        uint64_t count = numElements(op.getCiphertexts());
+        return CryptographicOperation{"keyswitch",
+                                      (uint64_t)op.getKey().getIndex(), count,
+                                      count * complexity(op.getKey())};
+      })
+      .Case<TFHE::BootstrapGLWEOp, TFHE::ManyLutBootstrapGLWEOp>(
+          [](auto op) {
+            return CryptographicOperation{"bootstrap",
+                                          (uint64_t)op.getKey().getIndex(), 1,
+                                          complexity(op.getKey())};
+          })
+      .Case([](TFHE::BatchedBootstrapGLWEOp op) {
+        uint64_t count = numElements(op.getCiphertexts());
+        return CryptographicOperation{"bootstrap",
+                                      (uint64_t)op.getKey().getIndex(), count,
+                                      count * complexity(op.getKey())};
+      })
+      .Case([](TFHE::WopPBSGLWEOp op) {
+        // The last dimension of the ciphertexts holds the blocks of the crt
+        // decomposition of a single integer
+        uint64_t blocks = std::max<size_t>(op.getCrtDecomposition().size(), 1);
+        uint64_t count = numElements(op.getCiphertexts()) / blocks;
+        return CryptographicOperation{"wop_pbs",
+                                      (uint64_t)op.getBsk().getIndex(), count,
+                                      count * complexity(op)};
+      })
+      .Default([](mlir::Operation *) { return std::nullopt; });
+}
+
+std::string locationString(mlir::Location location) {
+  std::string loc;
+  llvm::raw_string_ostream stream(loc);
+  location.print(stream);
+  return loc;
+}
+
+class CircuitStatistics {
+public:
+  /// Counts the cryptographic operations of `block`, executed `executions`
+  /// times.
+  void count(mlir::Block &block, uint64_t executions) {
+    for (mlir::Operation &op : block) {
+      if (auto cryptoOp = cryptographicOperation(&op)) {
+        auto key = std::make_tuple(cryptoOp->operation,
+                                   locationString(op.getLoc()),
+                                   cryptoOp->keyIndex);
+        auto inserted = indices.insert({key, statistics.size()});
+        if (inserted.second) {
+          statistics.push_back(mlir::concretelang::OperationStatistic{
+              cryptoOp->operation, std::get<1>(key), cryptoOp->keyIndex, 0, 0,
+              0});
+        }
+        auto &statistic = statistics[inserted.first->second];
+        statistic.count += executions * cryptoOp->count;
+        statistic.complexity += executions * cryptoOp->complexity;
+        continue;
+      }
+      uint64_t regionExecutions = executions;
+      if (auto forOp = llvm::dyn_cast<mlir::scf::ForOp>(op)) {
+        regionExecutions *= tripCount(forOp);
+      }
+      for (mlir::Region &region : op.getRegions()) {
+        for (mlir::Block &nestedBlock : region) {
+          count(nestedBlock, regionExecutions);
+        }
+      }
+    }
+  }
+
+  /// Returns the statistics by decreasing complexity, with their share of
+  /// the complexity of all the cryptographic operations.
+  std::vector<mlir::concretelang::OperationStatistic> takeStatistics() {
+    double total = 0;
+    for (auto &statistic : statistics) {
+      total += statistic.complexity;
+    }
+    for (auto &statistic : statistics) {
+      statistic.complexityShare =
+          total > 0 ? statistic.complexity / total : 0;
+    }
+    std::stable_sort(statistics.begin(), statistics.end(),
+                     [](const auto &lhs, const auto &rhs) {
+                       return lhs.complexity > rhs.complexity;
+                     });
+    indices.clear();
+    return std::move(statistics);
+  }
+
+private:
+  std::map<std::tuple<std::string, std::string, uint64_t>, size_t> indices;
+  std::vector<mlir::concretelang::OperationStatistic> statistics;
+};
+
+/// Returns the estimated complexity of the longest chain of dependent
+/// cryptographic operations of `block`, the independent operations being
+/// run in parallel. The iterations of the loops marked as parallel are
+/// independent, the ones of the other loops are run one after the other.
+double criticalPathComplexity(mlir::Block &block) {
+  // The completion of the computation of the values of the block, relative
+  // to the start of the block
+  llvm::DenseMap<mlir::Value, double> completions;
+  double criticalPath = 0;
+  for (mlir::Operation &op : block) {
+    double start = 0;
+    op.walk([&](mlir::Operation *nestedOp) {
+      for (mlir::Value operand : nestedOp->getOperands()) {
+        auto completion = completions.find(operand);
+        if (completion != completions.end()) {
+          start = std::max(start, completion->second);
+        }
+      }
+    });
+
+    double duration = 0;
+    if (auto cryptoOp = cryptographicOperation(&op)) {
+      duration = cryptoOp->complexity;
+    } else {
+      for (mlir::Region &region : op.getRegions()) {
+        for (mlir::Block &nestedBlock : region) {
+          duration = std::max(duration, criticalPathComplexity(nestedBlock));
+        }
+      }
+      auto forOp = llvm::dyn_cast<mlir::scf::ForOp>(op);
+      if (forOp != nullptr) {
+        auto parallel = forOp->getAttrOfType<mlir::BoolAttr>("parallel");
+        if (parallel == nullptr || !parallel.getValue()) {
+          duration *= tripCount(forOp);
+        }
+      }
+    }
+
+    for (mlir::Value result : op.getResults()) {
+      completions[result] = start + duration;
+    }
+    criticalPath = std::max(criticalPath, start + duration);
+  }
+  return criticalPath;
+}
+
+/// Returns the estimated peak number of bytes of the ciphertexts alive at
+/// the same time in `block`, a value being alive from its definition to its
+/// last use in the block.
+uint64_t peakCiphertextsSize(mlir::Block &block) {
+  // The values of the block whose last use is each operation
+  llvm::DenseMap<mlir::Operation *, llvm::SmallVector<mlir::Value>> lastUses;
+  llvm::DenseMap<mlir::Value, mlir::Operation *> lastUsers;
+  for (mlir::Operation &op : block) {
+    op.walk([&](mlir::Operation *nestedOp) {
+      for (mlir::Value operand : nestedOp->getOperands()) {
+        if (operand.getParentBlock() == &block) {
+          lastUsers[operand] = &op;
+        }
+      }
+    });
+  }
+  for (auto lastUser : lastUsers) {
+    lastUses[lastUser.second].push_back(lastUser.first);
+  }
+
+  uint64_t live = 0;
+  for (mlir::BlockArgument argument : block.getArguments()) {
+    live += ciphertextsSize(argument.getType());
+  }
+  uint64_t peak = live;
+  for (mlir::Operation &op : block) {
+    // The ciphertexts of the nested blocks are alive during the operation
+    uint64_t nested = 0;
+    for (mlir::Region &region : op.getRegions()) {
+      for (mlir::Block &nestedBlock : region) {
+        nested = std::max(nested, peakCiphertextsSize(nestedBlock));
+      }
+    }
+    uint64_t results = 0;
+    for (mlir::Value result : op.getResults()) {
+      results += ciphertextsSize(result.getType());
+    }
+    peak = std::max(peak, live + nested + results);
+
+    live += results;
+    for (mlir::Value result : op.getResults()) {
+      if (result.use_empty()) {
+        live -= ciphertextsSize(result.getType());
+      }
+    }
+    for (mlir::Value value : lastUses.lookup(&op)) {
+      live -= ciphertextsSize(value.getType());
+    }
+  }
+  return peak;
+}
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+namespace TFHE {
+
+void fillCircuitStatistics(mlir::ModuleOp moduleOp,
+                           CompilationFeedback &feedback) {
+  CircuitStatistics statistics;
+  feedback.peakCiphertextsSize = 0;
+  feedback.criticalPathComplexity = 0;
+  moduleOp->walk([&](mlir::func::FuncOp funcOp) {
+    if (funcOp.isExternal()) {
+      return;
+    }
+    mlir::Block &body = funcOp.getBody().front();
+    statistics.count(body, 1);
+    feedback.peakCiphertextsSize =
+        std::max(feedback.peakCiphertextsSize, peakCiphertextsSize(body));
+    feedback.criticalPathComplexity = std::max(
+        feedback.criticalPathComplexity, criticalPathComplexity(body));
+  });
+  feedback.operationStatistics = statistics.takeStatistics();
+}
+
+} // namespace TFHE
+} // namespace concretelang
+} // namespace mlir
@@ -32,6 +32,9 @@ concrete_optimizer::Options options_from_config(optimizer::Config config) {
       /* .use_gpu_constraints = */ config.use_gpu_constraints,
       /* .encoding = */ config.encoding,
       /* .cache_on_disk = */ config.cache_on_disk,
+      /* .multi_bit_grouping_factor = */ config.use_gpu_constraints
+          ? 1
+          : config.multi_bit_grouping_factor,
   };
   return options;
 }
@@ -0,0 +1,118 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include "concretelang/Transforms/Passes.h"
+
+#include "mlir/Dialect/Linalg/IR/Linalg.h"
+#include "mlir/Dialect/Linalg/Transforms/Transforms.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+
+namespace {
+
+/// Returns true if `op` only moves the elements of its single input to its
+/// output, e.g. a transposition, without computing anything.
+bool isDataMovement(mlir::linalg::GenericOp op) {
+  if (op.getNumDpsInputs() != 1 || op.getNumDpsInits() != 1 ||
+      op.getNumParallelLoops() != op.getNumLoops()) {
+    return false;
+  }
+  auto yield =
+      llvm::cast<mlir::linalg::YieldOp>(op.getBody()->getTerminator());
+  return yield.getNumOperands() == 1 &&
+         yield.getOperand(0) == op.getBody()->getArgument(0);
+}
+
+/// Fuses the data movement producing an input of a `linalg.generic` into the
+/// latter, which then reads the elements from the input of the data movement
+/// through the composed indexing map.
+///
+/// Example:
+///
+/// ```mlir
+/// %t = linalg.generic {indexing_maps = [(d0, d1) -> (d0, d1),
+///                                       (d0, d1) -> (d1, d0)]}
+///        ins(%x : tensor<2x3x!FHE.eint<7>>) outs(%z0 : ...) {
+///   ^bb0(%a: !FHE.eint<7>, %b: !FHE.eint<7>):
+///     linalg.yield %a : !FHE.eint<7>
+/// } -> tensor<3x2x!FHE.eint<7>>
+/// %r = linalg.generic {indexing_maps = [(d0, d1) -> (d0, d1),
+///                                       (d0, d1) -> (d0, d1)]}
+///        ins(%t : tensor<3x2x!FHE.eint<7>>) outs(%z1 : ...) {
+///   ^bb0(%a: !FHE.eint<7>, %b: !FHE.eint<7>):
+///     %n = "FHE.neg_eint"(%a) : (!FHE.eint<7>) -> !FHE.eint<7>
+///     linalg.yield %n : !FHE.eint<7>
+/// } -> tensor<3x2x!FHE.eint<7>>
+/// ```
+///
+/// becomes:
+///
+/// ```mlir
+/// %r = linalg.generic {indexing_maps = [(d0, d1) -> (d1, d0),
+///                                       (d0, d1) -> (d0, d1)]}
+///        ins(%x : tensor<2x3x!FHE.eint<7>>) outs(%z1 : ...) {
+///   ^bb0(%a: !FHE.eint<7>, %b: !FHE.eint<7>):
+///     %n = "FHE.neg_eint"(%a) : (!FHE.eint<7>) -> !FHE.eint<7>
+///     linalg.yield %n : !FHE.eint<7>
+/// } -> tensor<3x2x!FHE.eint<7>>
+/// ```
+struct DataMovementFusionPattern
+    : public mlir::OpRewritePattern<mlir::linalg::GenericOp> {
+  DataMovementFusionPattern(mlir::MLIRContext *context)
+      : mlir::OpRewritePattern<mlir::linalg::GenericOp>(context) {}
+
+  mlir::LogicalResult
+  matchAndRewrite(mlir::linalg::GenericOp genericOp,
+                  mlir::PatternRewriter &rewriter) const override {
+    for (mlir::OpOperand *operand : genericOp.getDpsInputOperands()) {
+      auto producer =
+          operand->get().getDefiningOp<mlir::linalg::GenericOp>();
+      // The producer is only fused in its single consumer, as the fused
+      // operation would otherwise still materialize its result for the
+      // other users.
+      if (producer == nullptr || !isDataMovement(producer) ||
+          llvm::any_of(producer->getUsers(),
+                       [&](mlir::Operation *user) {
+                         return user != genericOp.getOperation();
+                       }) ||
+          !mlir::linalg::areElementwiseOpsFusable(operand)) {
+        continue;
+      }
+      auto fusedOp = mlir::linalg::fuseElementwiseOps(rewriter, operand);
+      if (mlir::failed(fusedOp)) {
+        continue;
+      }
+      auto results = fusedOp.value()->getResults().take_back(
+          genericOp.getNumResults());
+      rewriter.replaceOp(genericOp, results);
+      return mlir::success();
+    }
+    return mlir::failure();
+  }
+};
+
+struct DataMovementFusionPass
+    : public DataMovementFusionBase<DataMovementFusionPass> {
+  void runOnOperation() override {
+    mlir::RewritePatternSet patterns(&getContext());
+    patterns.add<DataMovementFusionPattern>(&getContext());
+    if (mlir::applyPatternsAndFoldGreedily(getOperation(), std::move(patterns))
+            .failed()) {
+      signalPassFailure();
+    }
+  }
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+
+std::unique_ptr<mlir::OperationPass<mlir::ModuleOp>>
+createDataMovementFusionPass() {
+  return std::make_unique<DataMovementFusionPass>();
+}
+
+} // namespace concretelang
+} // namespace mlir
@@ -0,0 +1,350 @@
+// Part of the Concrete Compiler Project, under the BSD3 License with Zama
+// Exceptions. See
+// https://github.com/zama-ai/concrete-compiler-internal/blob/main/LICENSE.txt
+// for license information.
+
+#include <climits>
+#include <optional>
+
+#include "mlir/Dialect/Arith/IR/Arith.h"
+#include "mlir/Dialect/LLVMIR/LLVMDialect.h"
+#include "mlir/Interfaces/ViewLikeInterface.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include "concretelang/Conversion/Tools.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteOps.h"
+#include "concretelang/Dialect/Concrete/IR/ConcreteTypes.h"
+#include "concretelang/Dialect/RT/IR/RTDialect.h"
+#include "concretelang/Transforms/Passes.h"
+
+namespace Concrete = mlir::concretelang::Concrete;
+namespace arith = mlir::arith;
+namespace func = mlir::func;
+namespace memref = mlir::memref;
+
+namespace {
+
+char memref_arena_acquire[] = "memref_arena_acquire";
+char memref_arena_release[] = "memref_arena_release";
+
+/// Alignment in bytes of the buffers placed in the arena.
+const uint64_t BUFFER_ALIGNMENT = 64;
+
+uint64_t alignBufferSize(uint64_t size) {
+  return (size + BUFFER_ALIGNMENT - 1) / BUFFER_ALIGNMENT * BUFFER_ALIGNMENT;
+}
+
+/// An intermediate buffer of a function, live from the operation at the
+/// position `start` to the one at the position `end` of the entry block.
+struct Buffer {
+  memref::AllocOp alloc;
+  memref::DeallocOp dealloc;
+  uint64_t size;
+  unsigned int start;
+  unsigned int end;
+  uint64_t offset;
+};
+
+/// Returns the buffer `value` is a cast of.
+mlir::Value stripCasts(mlir::Value value) {
+  while (auto cast = value.getDefiningOp<memref::CastOp>()) {
+    value = cast.getSource();
+  }
+  return value;
+}
+
+/// Returns the buffer `value` is a view of.
+mlir::Value getViewedBuffer(mlir::Value value) {
+  while (auto view = value.getDefiningOp<mlir::ViewLikeOpInterface>()) {
+    value = view.getViewSource();
+  }
+  return value;
+}
+
+/// Collects the uses of `value` and of the views on it, returns false if the
+/// buffer may escape the function or be aliased by a value which is not a
+/// view, e.g. returned or yielded by a loop.
+bool collectUses(mlir::Value value,
+                 llvm::SmallVectorImpl<mlir::OpOperand *> &uses) {
+  for (auto &use : value.getUses()) {
+    auto user = use.getOwner();
+    if (auto view = llvm::dyn_cast<mlir::ViewLikeOpInterface>(user)) {
+      if (view.getViewSource() == value) {
+        for (auto result : user->getResults()) {
+          if (!collectUses(result, uses)) {
+            return false;
+          }
+        }
+        continue;
+      }
+    }
+    if (llvm::isa<func::CallOp>(user) ||
+        user->hasTrait<mlir::OpTrait::IsTerminator>() ||
+        llvm::any_of(user->getResultTypes(), [](mlir::Type type) {
+          return type.isa<mlir::BaseMemRefType>();
+        })) {
+      return false;
+    }
+    uses.push_back(&use);
+  }
+  return true;
+}
+
+/// Returns true if the elementwise operation `op` can write its result in
+/// the buffer of its input `input`.
+bool isInPlaceCandidate(mlir::Operation *op, mlir::Value input,
+                        mlir::Value output) {
+  if (!llvm::isa<Concrete::AddLweBufferOp, Concrete::AddPlaintextLweBufferOp,
+                 Concrete::MulCleartextLweBufferOp,
+                 Concrete::NegateLweBufferOp>(op) ||
+      stripCasts(op->getOperand(0)) != output) {
+    return false;
+  }
+  // The input must be read once and as a whole, as the operation reads it
+  // while writing the output
+  auto reads = llvm::make_filter_range(
+      llvm::drop_begin(op->getOperands()), [&](mlir::Value operand) {
+        return getViewedBuffer(operand) == input;
+      });
+  return llvm::hasSingleElement(reads) && stripCasts(*reads.begin()) == input;
+}
+
+struct MemoryPlanningPass : public MemoryPlanningBase<MemoryPlanningPass> {
+  MemoryPlanningPass(uint64_t *arenaSizes) : arenaSizes(arenaSizes) {}
+
+  void runOnOperation() override {
+    // The declarations of the runtime functions are added to the module
+    // while planning, so the functions are collected first
+    llvm::SmallVector<func::FuncOp> funcs;
+    getOperation().walk([&](func::FuncOp func) { funcs.push_back(func); });
+    for (auto func : funcs) {
+      if (planFunction(func).failed()) {
+        signalPassFailure();
+        return;
+      }
+    }
+  }
+
+private:
+  /// Places the intermediate buffers of the entry block of `func` in a single
+  /// arena acquired from the runtime context at the entry of the function.
+  mlir::LogicalResult planFunction(func::FuncOp func) {
+    if (func.isExternal() || !func.getBody().hasOneBlock()) {
+      return mlir::success();
+    }
+    auto context = llvm::find_if(func.getArguments(), [](mlir::Value arg) {
+      return arg.getType().isa<Concrete::ContextType>();
+    });
+    if (context == func.getArguments().end()) {
+      return mlir::success();
+    }
+    // The buffers of the dataflow tasks are managed by the dataflow runtime
+    auto hasTasks = func.walk([](mlir::Operation *op) {
+      return llvm::isa<mlir::concretelang::RT::RTDialect>(op->getDialect())
+                 ? mlir::WalkResult::interrupt()
+                 : mlir::WalkResult::advance();
+    });
+    if (hasTasks.wasInterrupted()) {
+      return mlir::success();
+    }
+
+    mlir::Block &block = func.getBody().front();
+    ops.clear();
+    positions.clear();
+    for (auto &op : block) {
+      positions[&op] = ops.size();
+      ops.push_back(&op);
+    }
+
+    llvm::SmallVector<Buffer> buffers;
+    for (auto alloc : block.getOps<memref::AllocOp>()) {
+      if (auto buffer = analyzeBuffer(alloc)) {
+        buffers.push_back(*buffer);
+      }
+    }
+    if (buffers.empty()) {
+      return mlir::success();
+    }
+
+    uint64_t arenaSize = assignOffsets(buffers);
+    if (arenaSizes != nullptr) {
+      *arenaSizes += arenaSize;
+    }
+    return rewrite(func, *context, buffers, arenaSize);
+  }
+
+  /// Returns the buffer allocated by `alloc` if it can be placed in the
+  /// arena, i.e. if it has a static size and is deallocated in the entry
+  /// block.
+  std::optional<Buffer> analyzeBuffer(memref::AllocOp alloc) {
+    auto type = alloc.getType();
+    if (!type.hasStaticShape() || !type.getLayout().isIdentity() ||
+        type.getMemorySpace() != nullptr ||
+        !type.getElementType().isIntOrFloat() || alloc->getNumOperands() != 0 ||
+        type.getNumElements() == 0) {
+      return std::nullopt;
+    }
+    llvm::SmallVector<mlir::OpOperand *> uses;
+    if (!collectUses(alloc.getResult(), uses)) {
+      return std::nullopt;
+    }
+    Buffer buffer{alloc,
+                  nullptr,
+                  type.getNumElements() *
+                      ((type.getElementTypeBitWidth() + 7) / 8),
+                  UINT_MAX,
+                  0,
+                  0};
+    for (auto use : uses) {
+      auto user = use->getOwner();
+      if (auto dealloc = llvm::dyn_cast<memref::DeallocOp>(user)) {
+        if (buffer.dealloc != nullptr ||
+            dealloc->getBlock() != alloc->getBlock() ||
+            dealloc.getMemref() != alloc.getResult()) {
+          return std::nullopt;
+        }
+        buffer.dealloc = dealloc;
+        continue;
+      }
+      auto position =
+          positions[alloc->getBlock()->findAncestorOpInBlock(*user)];
+      buffer.start = std::min(buffer.start, position);
+      buffer.end = std::max(buffer.end, position);
+    }
+    if (buffer.dealloc == nullptr || buffer.start == UINT_MAX) {
+      return std::nullopt;
+    }
+    return buffer;
+  }
+
+  /// Returns true if `output` can be written in place of `input` by the
+  /// operation where the lifetime of the latter ends.
+  bool isInPlace(const Buffer &input, const Buffer &output) {
+    return input.end == output.start && input.size == output.size &&
+           isInPlaceCandidate(ops[input.end], input.alloc.getResult(),
+                              output.alloc.getResult());
+  }
+
+  /// Assigns an offset in the arena to the buffers such that the buffers
+  /// live at the same time don't overlap, and returns the size of the arena.
+  uint64_t assignOffsets(llvm::SmallVectorImpl<Buffer> &buffers) {
+    llvm::SmallVector<Buffer *> order;
+    for (auto &buffer : buffers) {
+      order.push_back(&buffer);
+    }
+    // Place the largest buffers first to limit the fragmentation
+    llvm::stable_sort(order, [](Buffer *a, Buffer *b) {
+      return a->size > b->size || (a->size == b->size && a->start < b->start);
+    });
+
+    uint64_t arenaSize = 0;
+    llvm::SmallVector<Buffer *> placed;
+    for (auto buffer : order) {
+      llvm::SmallVector<Buffer *> live;
+      llvm::SmallVector<uint64_t> candidates{0};
+      for (auto other : placed) {
+        if (other->start > buffer->end || buffer->start > other->end) {
+          continue;
+        }
+        live.push_back(other);
+        candidates.push_back(other->offset + alignBufferSize(other->size));
+        if (isInPlace(*other, *buffer) || isInPlace(*buffer, *other)) {
+          candidates.push_back(other->offset);
+        }
+      }
+      llvm::sort(candidates);
+      // First offset where the buffer doesn't overlap the live buffers, but
+      // for the buffers it can be written in place of
+      auto fits = [&](uint64_t offset) {
+        return llvm::all_of(live, [&](Buffer *other) {
+          if (offset == other->offset &&
+              (isInPlace(*other, *buffer) || isInPlace(*buffer, *other))) {
+            return true;
+          }
+          return offset >= other->offset + other->size ||
+                 other->offset >= offset + buffer->size;
+        });
+      };
+      buffer->offset = *llvm::find_if(candidates, fits);
+      arenaSize =
+          std::max(arenaSize, buffer->offset + alignBufferSize(buffer->size));
+      placed.push_back(buffer);
+    }
+    return arenaSize;
+  }
+
+  /// Replaces the allocations of the buffers by views in the arena, which is
+  /// acquired at the entry of `func` and released before its returns.
+  mlir::LogicalResult rewrite(func::FuncOp func, mlir::Value context,
+                              llvm::ArrayRef<Buffer> buffers,
+                              uint64_t arenaSize) {
+    mlir::Block &block = func.getBody().front();
+    mlir::OpBuilder builder(&block, block.begin());
+    auto loc = func.getLoc();
+    auto arenaType = mlir::MemRefType::get({mlir::ShapedType::kDynamic},
+                                           builder.getI8Type());
+
+    // The arena is returned through a pointer on its descriptor, so the
+    // runtime implements the C interface of the function.
+    auto acquireType = builder.getFunctionType(
+        {context.getType(), builder.getI64Type()}, {arenaType});
+    auto releaseType =
+        builder.getFunctionType({arenaType, context.getType()}, {});
+    if (insertForwardDeclaration(func, builder, memref_arena_acquire,
+                                 acquireType)
+            .failed() ||
+        insertForwardDeclaration(func, builder, memref_arena_release,
+                                 releaseType)
+            .failed()) {
+      return mlir::failure();
+    }
+    mlir::SymbolTable::lookupNearestSymbolFrom(
+        func, builder.getStringAttr(memref_arena_acquire))
+        ->setAttr(mlir::LLVM::LLVMDialect::getEmitCWrapperAttrName(),
+                  builder.getUnitAttr());
+
+    auto size = builder.create<arith::ConstantOp>(
+        loc, builder.getI64IntegerAttr(arenaSize));
+    auto arena = builder
+                     .create<func::CallOp>(loc, memref_arena_acquire,
+                                           mlir::TypeRange{arenaType},
+                                           mlir::ValueRange{context, size})
+                     .getResult(0);
+
+    for (auto buffer : buffers) {
+      builder.setInsertionPoint(buffer.alloc);
+      auto offset = builder.create<arith::ConstantIndexOp>(loc, buffer.offset);
+      auto view = builder.create<memref::ViewOp>(
+          buffer.alloc.getLoc(), buffer.alloc.getType(), arena, offset,
+          mlir::ValueRange{});
+      buffer.dealloc.erase();
+      buffer.alloc.getResult().replaceAllUsesWith(view.getResult());
+      buffer.alloc.erase();
+    }
+
+    func.walk([&](func::ReturnOp returnOp) {
+      builder.setInsertionPoint(returnOp);
+      builder.create<func::CallOp>(returnOp.getLoc(), memref_arena_release,
+                                   mlir::TypeRange{},
+                                   mlir::ValueRange{arena, context});
+    });
+    return mlir::success();
+  }
+
+  uint64_t *arenaSizes;
+  /// The operations of the entry block of the planned function and their
+  /// positions.
+  llvm::SmallVector<mlir::Operation *> ops;
+  llvm::DenseMap<mlir::Operation *, unsigned int> positions;
+};
+
+} // namespace
+
+namespace mlir {
+namespace concretelang {
+std::unique_ptr<OperationPass<ModuleOp>>
+createMemoryPlanningPass(uint64_t *arenaSizes) {
+  return std::make_unique<MemoryPlanningPass>(arenaSizes);
+}
+} // namespace concretelang
+} // namespace mlir
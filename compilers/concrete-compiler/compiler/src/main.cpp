@@ -237,6 +237,77 @@ llvm::cl::opt<unsigned int> chunkWidth(
         "Chunk width while decomposing big integers into chunks, default is 2"),
     llvm::cl::init<unsigned int>(2));
 
+llvm::cl::opt<bool> composeLUTs(
+    "compose-luts",
+    llvm::cl::desc("Compose the chains of lookup tables and fold the leveled "
+                   "operations around them into the tables, default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<bool> manyLUT(
+    "many-lut",
+    llvm::cl::desc("Group the lookup tables applied on the same input into "
+                   "many-LUT bootstraps, default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<unsigned int> manyLUTMaxPrecision(
+    "many-lut-max-precision",
+    llvm::cl::desc("Maximal precision of a many-LUT bootstrap, default is 8"),
+    llvm::cl::init<unsigned int>(8));
+
+llvm::cl::opt<unsigned int> roundLUTMaxPrecision(
+    "round-lut-max-precision",
+    llvm::cl::desc("Maximal precision of the lookup tables used to round, "
+                   "among the precisions of the tables of the circuit, 0 "
+                   "always discards the bits one by one, default is 0"),
+    llvm::cl::init<unsigned int>(0));
+
+llvm::cl::opt<bool> planMemory(
+    "plan-memory",
+    llvm::cl::desc("Place the intermediate buffers in a single arena per "
+                   "call, reusing the memory of the buffers which are not live "
+                   "at the same time, default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<bool> outputModulusSwitching(
+    "output-modulus-switching",
+    llvm::cl::desc("Switch the encrypted outputs to the smallest modulus "
+                   "keeping their decryption correct when serializing them, "
+                   "default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<bool> outputPacking(
+    "output-packing",
+    llvm::cl::desc("Pack the ciphertexts of the encrypted outputs in GLWE "
+                   "ciphertexts before returning them, default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<bool> inlineLeveledOps(
+    "inline-leveled-ops",
+    llvm::cl::desc("Lower the leveled operations on ciphertexts to fused loops "
+                   "instead of calls to the runtime, default is false"),
+    llvm::cl::init<bool>(false));
+
+llvm::cl::opt<std::string> targetCPU(
+    "target-cpu",
+    llvm::cl::desc("CPU targeted by the code of the libraries, 'native' for "
+                   "the CPU of the host, 'generic' for a baseline CPU of the "
+                   "host architecture, default is native"),
+    llvm::cl::init<std::string>("native"));
+
+llvm::cl::opt<std::string> targetFeatures(
+    "target-features",
+    llvm::cl::desc("Comma separated features, e.g. +avx2,-avx512f, targeted "
+                   "by the code of the libraries on top of the features of "
+                   "the target CPU"),
+    llvm::cl::init<std::string>(""));
+
+llvm::cl::list<std::string> targetCPUVersions(
+    "target-cpu-versions",
+    llvm::cl::desc("CPUs, among x86-64-v{2,3,4}, for which an additional "
+                   "version of the functions of the libraries is generated, "
+                   "the most capable one supported by the host being used"),
+    llvm::cl::ZeroOrMore, llvm::cl::MiscFlags::CommaSeparated);
+
 llvm::cl::opt<std::string> jitKeySetCachePath(
     "jit-keyset-cache-path",
     llvm::cl::desc("Path to cache KeySet content (unsecure)"));
@@ -303,6 +374,15 @@ llvm::cl::opt<bool> optimizerNoCacheOnDisk(
                    "cache issues."),
     llvm::cl::init(false));
 
+llvm::cl::opt<uint64_t> optimizerMultiBitGroupingFactor(
+    "optimizer-multi-bit-grouping-factor",
+    llvm::cl::desc("Number of mask elements processed by each external "
+                   "product of the bootstraps, i.e. the grouping factor of the "
+                   "multi bit bootstrap keys, 1 for classic bootstraps. The "
+                   "optimizer accounts for the noise and the complexity of "
+                   "the multi bit bootstraps, from 1 to 4."),
+    llvm::cl::init(optimizer::DEFAULT_CONFIG.multi_bit_grouping_factor));
+
 llvm::cl::list<int64_t> fhelinalgTileSizes(
     "fhelinalg-tile-sizes",
     llvm::cl::desc(
@@ -389,6 +469,17 @@ cmdlineCompilationOptions() {
   options.chunkIntegers = cmdline::chunkIntegers;
   options.chunkSize = cmdline::chunkSize;
   options.chunkWidth = cmdline::chunkWidth;
+  options.composeLUTs = cmdline::composeLUTs;
+  options.manyLUT = cmdline::manyLUT;
+  options.manyLUTMaxPrecision = cmdline::manyLUTMaxPrecision;
+  options.roundLUTMaxPrecision = cmdline::roundLUTMaxPrecision;
+  options.planMemory = cmdline::planMemory;
+  options.outputModulusSwitching = cmdline::outputModulusSwitching;
+  options.outputPacking = cmdline::outputPacking;
+  options.inlineLeveledOps = cmdline::inlineLeveledOps;
+  options.targetCPU = cmdline::targetCPU;
+  options.targetFeatures = cmdline::targetFeatures;
+  options.targetCPUVersions = cmdline::targetCPUVersions;
 
   if (!cmdline::v0Constraint.empty()) {
     if (cmdline::v0Constraint.size() != 2) {
@@ -465,6 +556,8 @@ cmdlineCompilationOptions() {
   options.optimizerConfig.strategy = cmdline::optimizerStrategy;
   options.optimizerConfig.encoding = cmdline::optimizerEncoding;
   options.optimizerConfig.cache_on_disk = !cmdline::optimizerNoCacheOnDisk;
+  options.optimizerConfig.multi_bit_grouping_factor =
+      cmdline::optimizerMultiBitGroupingFactor;
 
   if (!std::isnan(options.optimizerConfig.global_p_error) &&
       options.optimizerConfig.strategy) {
@@ -0,0 +1,8 @@
+// RUN: not concretecompiler %s --optimize-tfhe=false --action=dump-tfhe 2>&1| FileCheck %s
+
+// 4 lookup tables on 6 bits need a polynomial of 512 coefficients
+// CHECK: the polynomial size 256 can't hold 4 lookup tables on 6 bits
+func.func @main(%arg0: !FHE.eint<6>, %arg1: tensor<64xi64>, %arg2: tensor<64xi64>, %arg3: tensor<64xi64>, %arg4: tensor<64xi64>) -> (!FHE.eint<6>, !FHE.eint<6>, !FHE.eint<6>, !FHE.eint<6>) {
+  %0:4 = "FHE.apply_many_lookup_tables"(%arg0, %arg1, %arg2, %arg3, %arg4) : (!FHE.eint<6>, tensor<64xi64>, tensor<64xi64>, tensor<64xi64>, tensor<64xi64>) -> (!FHE.eint<6>, !FHE.eint<6>, !FHE.eint<6>, !FHE.eint<6>)
+  return %0#0, %0#1, %0#2, %0#3 : !FHE.eint<6>, !FHE.eint<6>, !FHE.eint<6>, !FHE.eint<6>
+}
@@ -0,0 +1,68 @@
+// RUN: concretecompiler --chunk-integers --chunk-size 4 --chunk-width 2 --parallelize-loops --passes fhe-big-int-transform --action=dump-fhe  %s 2>&1| FileCheck %s
+
+// With parallelism, the carries of the 8 chunks are computed by a prefix
+// network of 3 levels instead of being rippled from chunk to chunk.
+
+// CHECK-LABEL: func.func @add_chunked_eint(%arg0: tensor<8x!FHE.eint<4>>, %arg1: tensor<8x!FHE.eint<4>>) -> tensor<8x!FHE.eint<4>>
+func.func @add_chunked_eint(%arg0: !FHE.eint<16>, %arg1: !FHE.eint<16>) -> !FHE.eint<16> {
+  // CHECK-NOT:  affine.for
+  // CHECK:      %[[SUMS:.*]] = "FHELinalg.add_eint"(%arg0, %arg1) : (tensor<8x!FHE.eint<4>>, tensor<8x!FHE.eint<4>>) -> tensor<8x!FHE.eint<4>>
+  // CHECK-NEXT: %[[STATE_TABLE:.*]] = arith.constant dense<[0, 0, 0, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2]> : tensor<16xi64>
+  // CHECK-NEXT: %[[S0:.*]] = "FHELinalg.apply_lookup_table"(%[[SUMS]], %[[STATE_TABLE]])
+  // CHECK-NEXT: %[[COMBINE_TABLE:.*]] = arith.constant dense<[0, 0, 0, 0, 1, 2, 2, 2, 2, 0, 0, 0, 0, 0, 0, 0]> : tensor<16xi64>
+  // CHECK-NEXT: %[[THREE:.*]] = arith.constant dense<3> : tensor<1xi5>
+
+  // CHECK-NEXT: %[[H1:.*]] = tensor.extract_slice %[[S0]][1] [7] [1] : tensor<8x!FHE.eint<4>> to tensor<7x!FHE.eint<4>>
+  // CHECK-NEXT: %[[L1:.*]] = tensor.extract_slice %[[S0]][0] [7] [1] : tensor<8x!FHE.eint<4>> to tensor<7x!FHE.eint<4>>
+  // CHECK-NEXT: %[[M1:.*]] = "FHELinalg.mul_eint_int"(%[[H1]], %[[THREE]])
+  // CHECK-NEXT: %[[I1:.*]] = "FHELinalg.add_eint"(%[[M1]], %[[L1]])
+  // CHECK-NEXT: %[[C1:.*]] = "FHELinalg.apply_lookup_table"(%[[I1]], %[[COMBINE_TABLE]])
+  // CHECK-NEXT: %[[S1:.*]] = tensor.insert_slice %[[C1]] into %[[S0]][1] [7] [1] : tensor<7x!FHE.eint<4>> into tensor<8x!FHE.eint<4>>
+
+  // CHECK:      tensor.extract_slice %{{.*}}[2] [6] [1]
+  // CHECK:      tensor.extract_slice %{{.*}}[4] [4] [1]
+  // CHECK-NOT:  tensor.extract_slice %{{.*}}[8]
+
+  // CHECK:      %[[CARRY_TABLE:.*]] = arith.constant dense<[0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0]> : tensor<16xi64>
+  // CHECK-NEXT: %[[COUT:.*]] = "FHELinalg.apply_lookup_table"(%{{.*}}, %[[CARRY_TABLE]])
+  // CHECK-NEXT: %[[COUT_LOW:.*]] = tensor.extract_slice %[[COUT]][0] [7] [1]
+  // CHECK-NEXT: %[[ZERO:.*]] = "FHE.zero_tensor"() : () -> tensor<8x!FHE.eint<4>>
+  // CHECK-NEXT: %[[CIN:.*]] = tensor.insert_slice %[[COUT_LOW]] into %[[ZERO]][1] [7] [1]
+  // CHECK-NEXT: %[[WITH_CARRIES:.*]] = "FHELinalg.add_eint"(%[[SUMS]], %[[CIN]])
+  // CHECK-NEXT: %[[FOUR:.*]] = arith.constant dense<4> : tensor<1xi5>
+  // CHECK-NEXT: %[[SHIFTED:.*]] = "FHELinalg.mul_eint_int"(%[[COUT]], %[[FOUR]])
+  // CHECK-NEXT: %[[RES:.*]] = "FHELinalg.sub_eint"(%[[WITH_CARRIES]], %[[SHIFTED]])
+  // CHECK-NEXT: return %[[RES]] : tensor<8x!FHE.eint<4>>
+
+  %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<16>, !FHE.eint<16>) -> (!FHE.eint<16>)
+  return %1: !FHE.eint<16>
+}
+
+// CHECK-LABEL: func.func @add_few_chunks(%arg0: tensor<4x!FHE.eint<4>>, %arg1: tensor<4x!FHE.eint<4>>) -> tensor<4x!FHE.eint<4>>
+func.func @add_few_chunks(%arg0: !FHE.eint<8>, %arg1: !FHE.eint<8>) -> !FHE.eint<8> {
+  // The ripple carry is as shallow as the prefix network for 4 chunks
+  // CHECK: affine.for
+  %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<8>, !FHE.eint<8>) -> (!FHE.eint<8>)
+  return %1: !FHE.eint<8>
+}
+
+// CHECK-LABEL: func.func @add_5_chunks(%arg0: tensor<5x!FHE.eint<4>>, %arg1: tensor<5x!FHE.eint<4>>) -> tensor<5x!FHE.eint<4>>
+func.func @add_5_chunks(%arg0: !FHE.eint<10>, %arg1: !FHE.eint<10>) -> !FHE.eint<10> {
+  // The prefix network of 3 levels has a depth of 5, as the ripple carry
+  // CHECK: affine.for
+  %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<10>, !FHE.eint<10>) -> (!FHE.eint<10>)
+  return %1: !FHE.eint<10>
+}
+
+// CHECK-LABEL: func.func @add_6_chunks(%arg0: tensor<6x!FHE.eint<4>>, %arg1: tensor<6x!FHE.eint<4>>) -> tensor<6x!FHE.eint<4>>
+func.func @add_6_chunks(%arg0: !FHE.eint<12>, %arg1: !FHE.eint<12>) -> !FHE.eint<12> {
+  // The prefix network of 3 levels has a depth of 5, below the 6 of the
+  // ripple carry
+  // CHECK-NOT:  affine.for
+  // CHECK:      tensor.extract_slice %{{.*}}[1] [5] [1]
+  // CHECK:      tensor.extract_slice %{{.*}}[2] [4] [1]
+  // CHECK:      tensor.extract_slice %{{.*}}[4] [2] [1]
+  // CHECK:      return %{{.*}} : tensor<6x!FHE.eint<4>>
+  %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<12>, !FHE.eint<12>) -> (!FHE.eint<12>)
+  return %1: !FHE.eint<12>
+}
@@ -91,9 +91,8 @@ func.func @mux(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: !FHE.ebool) -> !FHE.
   // CHECK-NEXT: %[[V5:.*]] = "FHE.apply_lookup_table"(%[[V4]], %[[TT1]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
   // CHECK-NEXT: %[[V6:.*]] = "FHE.to_bool"(%[[V5]]) : (!FHE.eint<2>) -> !FHE.ebool
   // CHECK-NEXT: %[[V7:.*]] = "FHE.from_bool"(%arg2) : (!FHE.ebool) -> !FHE.eint<2>
-  // CHECK-NEXT: %[[V8:.*]] = "FHE.from_bool"(%arg0) : (!FHE.ebool) -> !FHE.eint<2>
   // CHECK-NEXT: %[[V9:.*]] = "FHE.mul_eint_int"(%[[V7]], %[[C1]]) : (!FHE.eint<2>, i3) -> !FHE.eint<2>
-  // CHECK-NEXT: %[[V10:.*]] = "FHE.add_eint"(%[[V9]], %[[V8]]) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V10:.*]] = "FHE.add_eint"(%[[V9]], %[[V2]]) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
   // CHECK-NEXT: %[[V11:.*]] = "FHE.apply_lookup_table"(%[[V10]], %[[TT2]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
   // CHECK-NEXT: %[[V12:.*]] = "FHE.to_bool"(%[[V11]]) : (!FHE.eint<2>) -> !FHE.ebool
   // CHECK-NEXT: %[[V13:.*]] = "FHE.from_bool"(%[[V6]]) : (!FHE.ebool) -> !FHE.eint<2>
@@ -105,3 +104,64 @@ func.func @mux(%arg0: !FHE.ebool, %arg1: !FHE.ebool, %arg2: !FHE.ebool) -> !FHE.
   %1 = "FHE.mux"(%arg0, %arg1, %arg2) : (!FHE.ebool, !FHE.ebool, !FHE.ebool) -> !FHE.ebool
   return %1: !FHE.ebool
 }
+
+// CHECK-LABEL: func.func @not_fused_in_gate(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool
+func.func @not_fused_in_gate(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool {
+  // CHECK-NEXT: %[[TT:.*]] = arith.constant dense<[0, 0, 1, 0]> : tensor<4xi64>
+  // CHECK-NEXT: %[[C0:.*]] = arith.constant 2 : i3
+  // CHECK-NEXT: %[[V0:.*]] = "FHE.from_bool"(%arg0) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V1:.*]] = "FHE.from_bool"(%arg1) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V2:.*]] = "FHE.mul_eint_int"(%[[V0]], %[[C0]]) : (!FHE.eint<2>, i3) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V3:.*]] = "FHE.add_eint"(%[[V2]], %[[V1]]) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V4:.*]] = "FHE.apply_lookup_table"(%[[V3]], %[[TT]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V5:.*]] = "FHE.to_bool"(%[[V4]]) : (!FHE.eint<2>) -> !FHE.ebool
+  // CHECK-NEXT: return %[[V5]] : !FHE.ebool
+
+  %0 = "FHE.not"(%arg1) : (!FHE.ebool) -> !FHE.ebool
+  %1 = "FHE.and"(%arg0, %0) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  return %1: !FHE.ebool
+}
+
+// CHECK-LABEL: func.func @not_of_gate(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool
+func.func @not_of_gate(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool {
+  // CHECK-NEXT: %[[TT:.*]] = arith.constant dense<[1, 0, 0, 0]> : tensor<4xi64>
+  // CHECK:      %[[V4:.*]] = "FHE.apply_lookup_table"(%{{.*}}, %[[TT]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V5:.*]] = "FHE.to_bool"(%[[V4]]) : (!FHE.eint<2>) -> !FHE.ebool
+  // CHECK-NEXT: return %[[V5]] : !FHE.ebool
+
+  %0 = "FHE.or"(%arg0, %arg1) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  %1 = "FHE.not"(%0) : (!FHE.ebool) -> !FHE.ebool
+  return %1: !FHE.ebool
+}
+
+// CHECK-LABEL: func.func @gates_fused(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool
+func.func @gates_fused(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> !FHE.ebool {
+  // (a and b) xor a = a and not b
+  // CHECK-NEXT: %[[TT:.*]] = arith.constant dense<[0, 0, 1, 0]> : tensor<4xi64>
+  // CHECK-NEXT: %[[C0:.*]] = arith.constant 2 : i3
+  // CHECK-NEXT: %[[V0:.*]] = "FHE.from_bool"(%arg0) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V1:.*]] = "FHE.from_bool"(%arg1) : (!FHE.ebool) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V2:.*]] = "FHE.mul_eint_int"(%[[V0]], %[[C0]]) : (!FHE.eint<2>, i3) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V3:.*]] = "FHE.add_eint"(%[[V2]], %[[V1]]) : (!FHE.eint<2>, !FHE.eint<2>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V4:.*]] = "FHE.apply_lookup_table"(%[[V3]], %[[TT]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V5:.*]] = "FHE.to_bool"(%[[V4]]) : (!FHE.eint<2>) -> !FHE.ebool
+  // CHECK-NEXT: return %[[V5]] : !FHE.ebool
+
+  %0 = "FHE.and"(%arg0, %arg1) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  %1 = "FHE.xor"(%0, %arg0) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  return %1: !FHE.ebool
+}
+
+// CHECK-LABEL: func.func @gates_share_index(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> (!FHE.ebool, !FHE.ebool)
+func.func @gates_share_index(%arg0: !FHE.ebool, %arg1: !FHE.ebool) -> (!FHE.ebool, !FHE.ebool) {
+  // CHECK:      %[[V3:.*]] = "FHE.add_eint"
+  // CHECK-NEXT: %[[V4:.*]] = "FHE.apply_lookup_table"(%[[V3]], %{{.*}}) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V5:.*]] = "FHE.to_bool"(%[[V4]]) : (!FHE.eint<2>) -> !FHE.ebool
+  // CHECK-NEXT: %[[V6:.*]] = "FHE.apply_lookup_table"(%[[V3]], %{{.*}}) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+  // CHECK-NEXT: %[[V7:.*]] = "FHE.to_bool"(%[[V6]]) : (!FHE.eint<2>) -> !FHE.ebool
+  // CHECK-NEXT: return %[[V5]], %[[V7]] : !FHE.ebool, !FHE.ebool
+
+  %0 = "FHE.and"(%arg0, %arg1) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  %1 = "FHE.xor"(%arg0, %arg1) : (!FHE.ebool, !FHE.ebool) -> !FHE.ebool
+  return %0, %1: !FHE.ebool, !FHE.ebool
+}
@@ -0,0 +1,62 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe --compose-luts --passes fhe-lut-composition %s 2>&1 | FileCheck %s
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> !FHE.eint<4> {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[4, 9, 0, 1]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[v0]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<4>
+// CHECK-NEXT:   return %[[v1]] : !FHE.eint<4>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<2>) -> !FHE.eint<4> {
+  %lut0 = arith.constant dense<[1, 2, 3, 0]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[0, 1, 4, 9]> : tensor<4xi64>
+  %c1 = arith.constant 1 : i3
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  %1 = "FHE.add_eint_int"(%0, %c1): (!FHE.eint<2>, i3) -> (!FHE.eint<2>)
+  %2 = "FHE.apply_lookup_table"(%1, %lut1): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<4>)
+  return %2 : !FHE.eint<4>
+}
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> !FHE.eint<2> {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[0, 2, 0, 2]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[v0]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   return %[[v1]] : !FHE.eint<2>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<2>) -> !FHE.eint<2> {
+  %lut = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %c2 = arith.constant 2 : i3
+  %0 = "FHE.mul_eint_int"(%arg0, %c2): (!FHE.eint<2>, i3) -> (!FHE.eint<2>)
+  %1 = "FHE.apply_lookup_table"(%0, %lut): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  return %1 : !FHE.eint<2>
+}
+
+// -----
+
+// The intermediate lookup table is used twice so it's kept
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+// CHECK:        %[[v0:.*]] = "FHE.apply_lookup_table"(%[[a0]], %{{.*}}) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+// CHECK:        %[[v1:.*]] = "FHE.apply_lookup_table"(%[[v0]], %{{.*}}) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   return %[[v0]], %[[v1]] : !FHE.eint<2>, !FHE.eint<2>
+func.func @main(%arg0: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[1, 2, 3, 0]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[0, 0, 1, 1]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  %1 = "FHE.apply_lookup_table"(%0, %lut1): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  return %0, %1 : !FHE.eint<2>, !FHE.eint<2>
+}
+
+// -----
+
+// Duplicated lookup tables are removed
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[1, 2, 3, 0]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[v0]]) : (!FHE.eint<2>, tensor<4xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   return %[[v1]], %[[v1]] : !FHE.eint<2>, !FHE.eint<2>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[1, 2, 3, 0]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  %lut1 = arith.constant dense<[1, 2, 3, 0]> : tensor<4xi64>
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut1): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  return %0, %1 : !FHE.eint<2>, !FHE.eint<2>
+}
@@ -0,0 +1,28 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe --many-lut --passes fhe-many-lut %s 2>&1 | FileCheck %s
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v1:.*]] = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+// CHECK-NEXT:   %[[v2:.*]]:2 = "FHE.apply_many_lookup_tables"(%[[a0]], %[[v0]], %[[v1]]) : (!FHE.eint<2>, tensor<4xi64>, tensor<4xi64>) -> (!FHE.eint<2>, !FHE.eint<2>)
+// CHECK-NEXT:   return %[[v2]]#0, %[[v2]]#1 : !FHE.eint<2>, !FHE.eint<2>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  %1 = "FHE.apply_lookup_table"(%arg0, %lut1): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  return %0, %1 : !FHE.eint<2>, !FHE.eint<2>
+}
+
+// -----
+
+// Lookup tables on different inputs are not grouped
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<2>, %[[a1:.*]]: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+// CHECK-NOT:    FHE.apply_many_lookup_tables
+func.func @main(%arg0: !FHE.eint<2>, %arg1: !FHE.eint<2>) -> (!FHE.eint<2>, !FHE.eint<2>) {
+  %lut0 = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %lut1 = arith.constant dense<[3, 2, 1, 0]> : tensor<4xi64>
+  %0 = "FHE.apply_lookup_table"(%arg0, %lut0): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  %1 = "FHE.apply_lookup_table"(%arg1, %lut1): (!FHE.eint<2>, tensor<4xi64>) -> (!FHE.eint<2>)
+  return %0, %1 : !FHE.eint<2>, !FHE.eint<2>
+}
@@ -0,0 +1,101 @@
+// RUN: concretecompiler --split-input-file --action=dump-fhe --round-lut-max-precision=8 --passes fhe-round-transform %s 2>&1 | FileCheck %s
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<4>, %[[a1:.*]]: tensor<16xi64>) -> (!FHE.eint<2>, !FHE.eint<4>) {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4]> : tensor<16xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[v0]]) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<2>
+// CHECK-NEXT:   %[[v2:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[a1]]) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+// CHECK-NEXT:   return %[[v1]], %[[v2]] : !FHE.eint<2>, !FHE.eint<4>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<4>, %arg1: tensor<16xi64>) -> (!FHE.eint<2>, !FHE.eint<4>) {
+  %0 = "FHE.round"(%arg0) : (!FHE.eint<4>) -> !FHE.eint<2>
+  %1 = "FHE.apply_lookup_table"(%arg0, %arg1) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+  return %0, %1 : !FHE.eint<2>, !FHE.eint<4>
+}
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.esint<4>, %[[a1:.*]]: tensor<16xi64>) -> (!FHE.esint<2>, !FHE.esint<4>) {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[0, 0, 1, 1, 1, 1, 2, 2, -2, -2, -1, -1, -1, -1, 0, 0]> : tensor<16xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHE.apply_lookup_table"(%[[a0]], %[[v0]]) : (!FHE.esint<4>, tensor<16xi64>) -> !FHE.esint<2>
+func.func @main(%arg0: !FHE.esint<4>, %arg1: tensor<16xi64>) -> (!FHE.esint<2>, !FHE.esint<4>) {
+  %0 = "FHE.round"(%arg0) : (!FHE.esint<4>) -> !FHE.esint<2>
+  %1 = "FHE.apply_lookup_table"(%arg0, %arg1) : (!FHE.esint<4>, tensor<16xi64>) -> !FHE.esint<4>
+  return %0, %1 : !FHE.esint<2>, !FHE.esint<4>
+}
+
+// -----
+
+// Without a table in the circuit, a table would raise the parameters
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<4>) -> !FHE.eint<2> {
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.round"(%[[a0]]) : (!FHE.eint<4>) -> !FHE.eint<2>
+// CHECK-NEXT:   return %[[v0]] : !FHE.eint<2>
+// CHECK-NEXT: }
+func.func @main(%arg0: !FHE.eint<4>) -> !FHE.eint<2> {
+  %0 = "FHE.round"(%arg0) : (!FHE.eint<4>) -> !FHE.eint<2>
+  return %0 : !FHE.eint<2>
+}
+
+// -----
+
+// Discarding a single bit already needs a single bootstrap
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<4>, %[[a1:.*]]: tensor<16xi64>) -> (!FHE.eint<3>, !FHE.eint<4>) {
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.round"(%[[a0]]) : (!FHE.eint<4>) -> !FHE.eint<3>
+func.func @main(%arg0: !FHE.eint<4>, %arg1: tensor<16xi64>) -> (!FHE.eint<3>, !FHE.eint<4>) {
+  %0 = "FHE.round"(%arg0) : (!FHE.eint<4>) -> !FHE.eint<3>
+  %1 = "FHE.apply_lookup_table"(%arg0, %arg1) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+  return %0, %1 : !FHE.eint<3>, !FHE.eint<4>
+}
+
+// -----
+
+// The lowest bits are discarded one by one until the integer fits in the
+// widest table of the circuit narrower than the input
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<6>, %[[a1:.*]]: !FHE.eint<4>, %[[a2:.*]]: tensor<16xi64>) -> (!FHE.eint<2>, !FHE.eint<4>) {
+// CHECK-DAG:    %[[c0:.*]] = arith.constant 2 : i7
+// CHECK-DAG:    %[[v0:.*]] = arith.constant dense<[0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4]> : tensor<16xi64>
+// CHECK:        %[[v1:.*]] = "FHE.sub_eint_int"(%[[a0]], %[[c0]]) : (!FHE.eint<6>, i7) -> !FHE.eint<6>
+// CHECK-NEXT:   %[[v2:.*]] = "FHE.round"(%[[v1]]) : (!FHE.eint<6>) -> !FHE.eint<4>
+// CHECK-NEXT:   %[[v3:.*]] = "FHE.apply_lookup_table"(%[[v2]], %[[v0]]) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<2>
+func.func @main(%arg0: !FHE.eint<6>, %arg1: !FHE.eint<4>, %arg2: tensor<16xi64>) -> (!FHE.eint<2>, !FHE.eint<4>) {
+  %0 = "FHE.round"(%arg0) : (!FHE.eint<6>) -> !FHE.eint<2>
+  %1 = "FHE.apply_lookup_table"(%arg1, %arg2) : (!FHE.eint<4>, tensor<16xi64>) -> !FHE.eint<4>
+  return %0, %1 : !FHE.eint<2>, !FHE.eint<4>
+}
+
+// -----
+
+// The tables are at most of max precision
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<12>, %[[a1:.*]]: !FHE.eint<8>, %[[a2:.*]]: !FHE.eint<12>, %[[a3:.*]]: tensor<256xi64>, %[[a4:.*]]: tensor<4096xi64>) -> (!FHE.eint<2>, !FHE.eint<8>, !FHE.eint<12>) {
+// CHECK-DAG:    %[[c0:.*]] = arith.constant 8 : i13
+// CHECK-DAG:    %[[v0:.*]] = arith.constant dense<{{.*}}> : tensor<256xi64>
+// CHECK:        %[[v1:.*]] = "FHE.sub_eint_int"(%[[a0]], %[[c0]]) : (!FHE.eint<12>, i13) -> !FHE.eint<12>
+// CHECK-NEXT:   %[[v2:.*]] = "FHE.round"(%[[v1]]) : (!FHE.eint<12>) -> !FHE.eint<8>
+// CHECK-NEXT:   %[[v3:.*]] = "FHE.apply_lookup_table"(%[[v2]], %[[v0]]) : (!FHE.eint<8>, tensor<256xi64>) -> !FHE.eint<2>
+func.func @main(%arg0: !FHE.eint<12>, %arg1: !FHE.eint<8>, %arg2: !FHE.eint<12>, %arg3: tensor<256xi64>, %arg4: tensor<4096xi64>) -> (!FHE.eint<2>, !FHE.eint<8>, !FHE.eint<12>) {
+  %0 = "FHE.round"(%arg0) : (!FHE.eint<12>) -> !FHE.eint<2>
+  %1 = "FHE.apply_lookup_table"(%arg1, %arg3) : (!FHE.eint<8>, tensor<256xi64>) -> !FHE.eint<8>
+  %2 = "FHE.apply_lookup_table"(%arg2, %arg4) : (!FHE.eint<12>, tensor<4096xi64>) -> !FHE.eint<12>
+  return %0, %1, %2 : !FHE.eint<2>, !FHE.eint<8>, !FHE.eint<12>
+}
+
+// -----
+
+// A table on 8 bits would replace a single bootstrap
+// CHECK:      func.func @main(%[[a0:.*]]: !FHE.eint<12>, %[[a1:.*]]: !FHE.eint<8>, %[[a2:.*]]: tensor<256xi64>) -> (!FHE.eint<7>, !FHE.eint<8>) {
+// CHECK-NEXT:   %[[v0:.*]] = "FHE.round"(%[[a0]]) : (!FHE.eint<12>) -> !FHE.eint<7>
+func.func @main(%arg0: !FHE.eint<12>, %arg1: !FHE.eint<8>, %arg2: tensor<256xi64>) -> (!FHE.eint<7>, !FHE.eint<8>) {
+  %0 = "FHE.round"(%arg0) : (!FHE.eint<12>) -> !FHE.eint<7>
+  %1 = "FHE.apply_lookup_table"(%arg1, %arg2) : (!FHE.eint<8>, tensor<256xi64>) -> !FHE.eint<8>
+  return %0, %1 : !FHE.eint<7>, !FHE.eint<8>
+}
+
+// -----
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<3x!FHE.eint<4>>, %[[a1:.*]]: tensor<16xi64>) -> (tensor<3x!FHE.eint<2>>, tensor<3x!FHE.eint<4>>) {
+// CHECK-NEXT:   %[[v0:.*]] = arith.constant dense<[0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4]> : tensor<16xi64>
+// CHECK-NEXT:   %[[v1:.*]] = "FHELinalg.apply_lookup_table"(%[[a0]], %[[v0]]) : (tensor<3x!FHE.eint<4>>, tensor<16xi64>) -> tensor<3x!FHE.eint<2>>
+func.func @main(%arg0: tensor<3x!FHE.eint<4>>, %arg1: tensor<16xi64>) -> (tensor<3x!FHE.eint<2>>, tensor<3x!FHE.eint<4>>) {
+  %0 = "FHELinalg.round"(%arg0) : (tensor<3x!FHE.eint<4>>) -> tensor<3x!FHE.eint<2>>
+  %1 = "FHELinalg.apply_lookup_table"(%arg0, %arg1) : (tensor<3x!FHE.eint<4>>, tensor<16xi64>) -> tensor<3x!FHE.eint<4>>
+  return %0, %1 : tensor<3x!FHE.eint<2>>, tensor<3x!FHE.eint<4>>
+}
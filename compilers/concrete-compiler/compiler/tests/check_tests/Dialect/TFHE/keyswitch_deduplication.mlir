@@ -0,0 +1,37 @@
+// RUN: concretecompiler --split-input-file --passes tfhe-keyswitch-deduplication --action=dump-batched-tfhe %s 2>&1| FileCheck %s
+
+// CHECK: func.func @same_input(%[[A0:.*]]: !TFHE.glwe<sk[1]<1024,1>>) -> (!TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[1]<527,1>>) {
+// CHECK-NEXT: %[[V0:.*]] = "TFHE.keyswitch_glwe"(%[[A0]]) {key = #TFHE.ksk<sk[1]<1024,1>, sk[1]<527,1>, 4, 4>} : (!TFHE.glwe<sk[1]<1024,1>>) -> !TFHE.glwe<sk[1]<527,1>>
+// CHECK-NEXT: return %[[V0]], %[[V0]] : !TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[1]<527,1>>
+func.func @same_input(%arg0: !TFHE.glwe<sk[1]<1024,1>>) -> (!TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[1]<527,1>>) {
+  %0 = "TFHE.keyswitch_glwe"(%arg0) {key=#TFHE.ksk<sk[1]<1024,1>,sk[1]<527,1>,4,4>} : (!TFHE.glwe<sk[1]<1024,1>>) -> !TFHE.glwe<sk[1]<527,1>>
+  %1 = "TFHE.keyswitch_glwe"(%arg0) {key=#TFHE.ksk<sk[1]<1024,1>,sk[1]<527,1>,4,4>} : (!TFHE.glwe<sk[1]<1024,1>>) -> !TFHE.glwe<sk[1]<527,1>>
+  return %0, %1: !TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[1]<527,1>>
+}
+
+// -----
+
+// CHECK: func.func @same_shifted_input(%[[A0:.*]]: !TFHE.glwe<sk[1]<1024,1>>) -> (!TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[1]<527,1>>) {
+// CHECK:      "TFHE.keyswitch_glwe"
+// CHECK-NOT:  "TFHE.keyswitch_glwe"
+func.func @same_shifted_input(%arg0: !TFHE.glwe<sk[1]<1024,1>>) -> (!TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[1]<527,1>>) {
+  %c0 = arith.constant 4 : i64
+  %0 = "TFHE.add_glwe_int"(%arg0, %c0) : (!TFHE.glwe<sk[1]<1024,1>>, i64) -> !TFHE.glwe<sk[1]<1024,1>>
+  %1 = "TFHE.keyswitch_glwe"(%0) {key=#TFHE.ksk<sk[1]<1024,1>,sk[1]<527,1>,4,4>} : (!TFHE.glwe<sk[1]<1024,1>>) -> !TFHE.glwe<sk[1]<527,1>>
+  %c1 = arith.constant 4 : i64
+  %2 = "TFHE.add_glwe_int"(%arg0, %c1) : (!TFHE.glwe<sk[1]<1024,1>>, i64) -> !TFHE.glwe<sk[1]<1024,1>>
+  %3 = "TFHE.keyswitch_glwe"(%2) {key=#TFHE.ksk<sk[1]<1024,1>,sk[1]<527,1>,4,4>} : (!TFHE.glwe<sk[1]<1024,1>>) -> !TFHE.glwe<sk[1]<527,1>>
+  return %1, %3: !TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[1]<527,1>>
+}
+
+// -----
+
+// Keyswitches with different keys are kept
+// CHECK: func.func @different_keys(%[[A0:.*]]: !TFHE.glwe<sk[1]<1024,1>>) -> (!TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[2]<527,1>>) {
+// CHECK-NEXT: "TFHE.keyswitch_glwe"
+// CHECK-NEXT: "TFHE.keyswitch_glwe"
+func.func @different_keys(%arg0: !TFHE.glwe<sk[1]<1024,1>>) -> (!TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[2]<527,1>>) {
+  %0 = "TFHE.keyswitch_glwe"(%arg0) {key=#TFHE.ksk<sk[1]<1024,1>,sk[1]<527,1>,4,4>} : (!TFHE.glwe<sk[1]<1024,1>>) -> !TFHE.glwe<sk[1]<527,1>>
+  %1 = "TFHE.keyswitch_glwe"(%arg0) {key=#TFHE.ksk<sk[1]<1024,1>,sk[2]<527,1>,4,4>} : (!TFHE.glwe<sk[1]<1024,1>>) -> !TFHE.glwe<sk[2]<527,1>>
+  return %0, %1: !TFHE.glwe<sk[1]<527,1>>, !TFHE.glwe<sk[2]<527,1>>
+}
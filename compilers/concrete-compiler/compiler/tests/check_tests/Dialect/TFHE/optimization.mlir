@@ -29,3 +29,32 @@ func.func @mul_cleartext_lwe_ciphertext_minus_1(%arg0: !TFHE.glwe<sk[1]<527,1>>)
   %2 = "TFHE.mul_glwe_int"(%arg0, %0): (!TFHE.glwe<sk[1]<527,1>>, i64) -> (!TFHE.glwe<sk[1]<527,1>>)
   return %2: !TFHE.glwe<sk[1]<527,1>>
 }
+
+// CHECK-LABEL: func.func @encode_lut_for_crt_woppbs_cst() -> tensor<2x8xi64>
+func.func @encode_lut_for_crt_woppbs_cst() -> tensor<2x8xi64> {
+  // CHECK-NEXT: %[[V1:.*]] = arith.constant dense<{{\[}}[0, -9223372036854775808, 0, -9223372036854775808, 0, 0, 0, 0], [0, 0, 0, 6148914691236517205, -6148914691236517206, 0, 0, 0]]> : tensor<2x8xi64>
+  // CHECK-NEXT: return %[[V1]] : tensor<2x8xi64>
+
+  %lut = arith.constant dense<[0, 1, 2, 3]> : tensor<4xi64>
+  %0 = "TFHE.encode_lut_for_crt_woppbs"(%lut) {crtBits = [1, 2], crtDecomposition = [2, 3], isSigned = false, modulusProduct = 6 : i32} : (tensor<4xi64>) -> tensor<2x8xi64>
+  return %0: tensor<2x8xi64>
+}
+
+// CHECK-LABEL: func.func @encode_lut_for_crt_woppbs(%arg0: tensor<4xi64>) -> tensor<2x8xi64>
+func.func @encode_lut_for_crt_woppbs(%arg0: tensor<4xi64>) -> tensor<2x8xi64> {
+  // CHECK-NEXT: %[[V1:.*]] = "TFHE.encode_lut_for_crt_woppbs"(%arg0) {crtBits = [1, 2], crtDecomposition = [2, 3], isSigned = false, modulusProduct = 6 : i32} : (tensor<4xi64>) -> tensor<2x8xi64>
+  // CHECK-NEXT: return %[[V1]] : tensor<2x8xi64>
+
+  %0 = "TFHE.encode_lut_for_crt_woppbs"(%arg0) {crtBits = [1, 2], crtDecomposition = [2, 3], isSigned = false, modulusProduct = 6 : i32} : (tensor<4xi64>) -> tensor<2x8xi64>
+  return %0: tensor<2x8xi64>
+}
+
+// CHECK-LABEL: func.func @encode_plaintext_with_crt_cst() -> tensor<3xi64>
+func.func @encode_plaintext_with_crt_cst() -> tensor<3xi64> {
+  // CHECK-NEXT: %[[V1:.*]] = arith.constant dense<[-9223372036854775808, 6148914691236517205, 3689348814741910323]> : tensor<3xi64>
+  // CHECK-NEXT: return %[[V1]] : tensor<3xi64>
+
+  %c1 = arith.constant 1 : i64
+  %0 = "TFHE.encode_plaintext_with_crt"(%c1) {mods = [2, 3, 5], modsProd = 30 : i64} : (i64) -> tensor<3xi64>
+  return %0: tensor<3xi64>
+}
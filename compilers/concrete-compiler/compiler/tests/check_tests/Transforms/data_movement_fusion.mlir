@@ -0,0 +1,36 @@
+// RUN: concretecompiler --split-input-file --action=dump-tfhe --passes fhe-tensor-ops-to-linalg --passes data-movement-fusion %s 2>&1 | FileCheck %s
+
+// The transposition is read through the indexing map of its consumer.
+
+// CHECK-DAG: #[[$MAP0:.*]] = affine_map<(d0, d1) -> (d1, d0)>
+// CHECK-DAG: #[[$MAP1:.*]] = affine_map<(d0, d1) -> (d0, d1)>
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<2x3x!FHE.eint<7>>) -> tensor<3x2x!FHE.eint<7>> {
+// CHECK:        %[[v0:.*]] = linalg.generic {indexing_maps = [#[[$MAP0]], #[[$MAP1]]], iterator_types = ["parallel", "parallel"]} ins(%[[a0]] : tensor<2x3x!FHE.eint<7>>)
+// CHECK-NEXT:     ^bb0(%[[aa0:.*]]: !FHE.eint<7>, %[[aa1:.*]]: !FHE.eint<7>):
+// CHECK-NEXT:       %[[n:.*]] = "FHE.neg_eint"(%[[aa0]]) : (!FHE.eint<7>) -> !FHE.eint<7>
+// CHECK-NEXT:       linalg.yield %[[n]] : !FHE.eint<7>
+// CHECK-NEXT:   } -> tensor<3x2x!FHE.eint<7>>
+// CHECK-NEXT:   return %[[v0]] : tensor<3x2x!FHE.eint<7>>
+func.func @main(%arg0: tensor<2x3x!FHE.eint<7>>) -> tensor<3x2x!FHE.eint<7>> {
+  %0 = "FHELinalg.transpose"(%arg0) : (tensor<2x3x!FHE.eint<7>>) -> tensor<3x2x!FHE.eint<7>>
+  %1 = "FHELinalg.neg_eint"(%0) : (tensor<3x2x!FHE.eint<7>>) -> tensor<3x2x!FHE.eint<7>>
+  return %1 : tensor<3x2x!FHE.eint<7>>
+}
+
+// -----
+
+// The transposition is kept when its result has other uses.
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<2x3x!FHE.eint<7>>) -> (tensor<3x2x!FHE.eint<7>>, tensor<3x2x!FHE.eint<7>>) {
+// CHECK:        %[[v0:.*]] = linalg.generic
+// CHECK-SAME:     ins(%[[a0]] : tensor<2x3x!FHE.eint<7>>)
+// CHECK:          linalg.yield %{{.*}} : !FHE.eint<7>
+// CHECK:        %[[v1:.*]] = linalg.generic
+// CHECK-SAME:     ins(%[[v0]] : tensor<3x2x!FHE.eint<7>>)
+// CHECK:        return %[[v1]], %[[v0]]
+func.func @main(%arg0: tensor<2x3x!FHE.eint<7>>) -> (tensor<3x2x!FHE.eint<7>>, tensor<3x2x!FHE.eint<7>>) {
+  %0 = "FHELinalg.transpose"(%arg0) : (tensor<2x3x!FHE.eint<7>>) -> tensor<3x2x!FHE.eint<7>>
+  %1 = "FHELinalg.neg_eint"(%0) : (tensor<3x2x!FHE.eint<7>>) -> tensor<3x2x!FHE.eint<7>>
+  return %1, %0 : tensor<3x2x!FHE.eint<7>>, tensor<3x2x!FHE.eint<7>>
+}
@@ -0,0 +1,44 @@
+// RUN: concretecompiler --split-input-file --action=dump-std --passes tfhe-to-concrete --passes concrete-inline-leveled-ops %s 2>&1 | FileCheck %s
+
+// A chain of leveled operations is fused in a single loop.
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<2049xi64>, %[[a1:.*]]: tensor<2049xi64>, %[[a2:.*]]: i64, %[[a3:.*]]: i64) -> tensor<2049xi64> {
+// CHECK:        %[[v0:.*]] = linalg.generic
+// CHECK-SAME:     ins(%[[a0]], %[[a1]] : tensor<2049xi64>, tensor<2049xi64>)
+// CHECK:          arith.addi
+// CHECK:          linalg.index 0
+// CHECK:          arith.cmpi eq
+// CHECK:          arith.select %{{.*}}, %[[a2]]
+// CHECK:          arith.addi
+// CHECK:          arith.muli %{{.*}}, %[[a3]]
+// CHECK:          arith.subi
+// CHECK:          linalg.yield %{{.*}} : i64
+// CHECK-NEXT:   } -> tensor<2049xi64>
+// CHECK-NOT:    linalg.generic
+// CHECK-NOT:    Concrete.
+// CHECK:        return %[[v0]] : tensor<2049xi64>
+func.func @main(%arg0: !TFHE.glwe<sk[1]<1,2048>>, %arg1: !TFHE.glwe<sk[1]<1,2048>>, %arg2: i64, %arg3: i64) -> !TFHE.glwe<sk[1]<1,2048>> {
+  %0 = "TFHE.add_glwe"(%arg0, %arg1) : (!TFHE.glwe<sk[1]<1,2048>>, !TFHE.glwe<sk[1]<1,2048>>) -> !TFHE.glwe<sk[1]<1,2048>>
+  %1 = "TFHE.add_glwe_int"(%0, %arg2) : (!TFHE.glwe<sk[1]<1,2048>>, i64) -> !TFHE.glwe<sk[1]<1,2048>>
+  %2 = "TFHE.mul_glwe_int"(%1, %arg3) : (!TFHE.glwe<sk[1]<1,2048>>, i64) -> !TFHE.glwe<sk[1]<1,2048>>
+  %3 = "TFHE.neg_glwe"(%2) : (!TFHE.glwe<sk[1]<1,2048>>) -> !TFHE.glwe<sk[1]<1,2048>>
+  return %3 : !TFHE.glwe<sk[1]<1,2048>>
+}
+
+// -----
+
+// A result used twice is computed by its own loop.
+
+// CHECK:      func.func @main(%[[a0:.*]]: tensor<2049xi64>) -> (tensor<2049xi64>, tensor<2049xi64>) {
+// CHECK:        %[[v0:.*]] = linalg.generic
+// CHECK-SAME:     ins(%[[a0]] : tensor<2049xi64>)
+// CHECK:          arith.subi
+// CHECK:        %[[v1:.*]] = linalg.generic
+// CHECK-SAME:     ins(%[[v0]], %[[v0]] : tensor<2049xi64>, tensor<2049xi64>)
+// CHECK:          arith.addi
+// CHECK:        return %[[v1]], %[[v0]]
+func.func @main(%arg0: !TFHE.glwe<sk[1]<1,2048>>) -> (!TFHE.glwe<sk[1]<1,2048>>, !TFHE.glwe<sk[1]<1,2048>>) {
+  %0 = "TFHE.neg_glwe"(%arg0) : (!TFHE.glwe<sk[1]<1,2048>>) -> !TFHE.glwe<sk[1]<1,2048>>
+  %1 = "TFHE.add_glwe"(%0, %0) : (!TFHE.glwe<sk[1]<1,2048>>, !TFHE.glwe<sk[1]<1,2048>>) -> !TFHE.glwe<sk[1]<1,2048>>
+  return %1, %0 : !TFHE.glwe<sk[1]<1,2048>>, !TFHE.glwe<sk[1]<1,2048>>
+}
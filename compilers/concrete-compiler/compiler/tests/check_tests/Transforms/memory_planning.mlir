@@ -0,0 +1,17 @@
+// RUN: concretecompiler --force-encoding native --plan-memory --action=dump-llvm-dialect %s 2>&1| FileCheck %s
+
+// The intermediate ciphertexts are placed in an arena acquired from the
+// runtime context, which implements the C interface of the acquisition.
+
+// CHECK: llvm.func @memref_arena_acquire
+// CHECK: llvm.call @_mlir_ciface_memref_arena_acquire
+// CHECK: llvm.func @main
+// CHECK: llvm.call @memref_arena_acquire
+// CHECK: llvm.call @memref_arena_release
+// CHECK-NEXT: llvm.return
+func.func @main(%arg0: !FHE.eint<3>, %arg1: !FHE.eint<3>) -> !FHE.eint<3> {
+  %0 = "FHE.add_eint"(%arg0, %arg1) : (!FHE.eint<3>, !FHE.eint<3>) -> !FHE.eint<3>
+  %1 = "FHE.add_eint"(%0, %arg0) : (!FHE.eint<3>, !FHE.eint<3>) -> !FHE.eint<3>
+  %2 = "FHE.neg_eint"(%1) : (!FHE.eint<3>) -> !FHE.eint<3>
+  return %2 : !FHE.eint<3>
+}
@@ -0,0 +1,85 @@
+// RUN: concretecompiler --split-input-file --passes memory-planning --action=dump-llvm-dialect %s 2>&1| FileCheck %s
+
+// The buffers live at the same time are placed one after the other, at
+// offsets aligned on 64 bytes: a ciphertext of 2049 words takes 16448 bytes.
+
+// CHECK-DAG:  func.func private @memref_arena_acquire(!Concrete.context, i64) -> memref<?xi8> attributes {llvm.emit_c_interface}
+// CHECK-DAG:  func.func private @memref_arena_release(memref<?xi8>, !Concrete.context)
+// CHECK:      func.func @main(%[[a0:.*]]: memref<2049xi64>, %[[a1:.*]]: memref<2049xi64>, %[[a2:.*]]: memref<2049xi64>, %[[ctx:.*]]: !Concrete.context) {
+// CHECK-NEXT:   %[[size:.*]] = arith.constant 32896 : i64
+// CHECK-NEXT:   %[[arena:.*]] = call @memref_arena_acquire(%[[ctx]], %[[size]]) : (!Concrete.context, i64) -> memref<?xi8>
+// CHECK-NEXT:   %[[o0:.*]] = arith.constant 0 : index
+// CHECK-NEXT:   %[[v0:.*]] = memref.view %[[arena]][%[[o0]]][] : memref<?xi8> to memref<2049xi64>
+// CHECK-NEXT:   "Concrete.add_lwe_buffer"(%[[v0]], %[[a0]], %[[a1]])
+// CHECK-NEXT:   %[[o1:.*]] = arith.constant 16448 : index
+// CHECK-NEXT:   %[[v1:.*]] = memref.view %[[arena]][%[[o1]]][] : memref<?xi8> to memref<2049xi64>
+// CHECK-NEXT:   "Concrete.negate_lwe_buffer"(%[[v1]], %[[a0]])
+// CHECK-NEXT:   "Concrete.add_lwe_buffer"(%[[a2]], %[[v0]], %[[v1]])
+// CHECK-NEXT:   call @memref_arena_release(%[[arena]], %[[ctx]]) : (memref<?xi8>, !Concrete.context) -> ()
+// CHECK-NEXT:   return
+// CHECK-NEXT: }
+func.func @main(%arg0: memref<2049xi64>, %arg1: memref<2049xi64>, %arg2: memref<2049xi64>, %arg3: !Concrete.context) {
+  %0 = memref.alloc() : memref<2049xi64>
+  "Concrete.add_lwe_buffer"(%0, %arg0, %arg1) : (memref<2049xi64>, memref<2049xi64>, memref<2049xi64>) -> ()
+  %1 = memref.alloc() : memref<2049xi64>
+  "Concrete.negate_lwe_buffer"(%1, %arg0) : (memref<2049xi64>, memref<2049xi64>) -> ()
+  "Concrete.add_lwe_buffer"(%arg2, %0, %1) : (memref<2049xi64>, memref<2049xi64>, memref<2049xi64>) -> ()
+  memref.dealloc %0 : memref<2049xi64>
+  memref.dealloc %1 : memref<2049xi64>
+  return
+}
+
+// -----
+
+// The buffers which are not live at the same time share the same offset
+
+// CHECK:      func.func @main(%[[a0:.*]]: memref<2049xi64>, %[[a1:.*]]: memref<2049xi64>, %[[a2:.*]]: memref<2049xi64>, %[[a3:.*]]: memref<2049xi64>, %[[ctx:.*]]: !Concrete.context) {
+// CHECK-NEXT:   %[[size:.*]] = arith.constant 16448 : i64
+// CHECK-NEXT:   %[[arena:.*]] = call @memref_arena_acquire(%[[ctx]], %[[size]]) : (!Concrete.context, i64) -> memref<?xi8>
+// CHECK-NEXT:   %[[o0:.*]] = arith.constant 0 : index
+// CHECK-NEXT:   %[[v0:.*]] = memref.view %[[arena]][%[[o0]]][] : memref<?xi8> to memref<2049xi64>
+// CHECK-NEXT:   "Concrete.add_lwe_buffer"(%[[v0]], %[[a0]], %[[a1]])
+// CHECK-NEXT:   "Concrete.add_lwe_buffer"(%[[a2]], %[[v0]], %[[a1]])
+// CHECK-NEXT:   %[[o1:.*]] = arith.constant 0 : index
+// CHECK-NEXT:   %[[v1:.*]] = memref.view %[[arena]][%[[o1]]][] : memref<?xi8> to memref<2049xi64>
+// CHECK-NEXT:   "Concrete.negate_lwe_buffer"(%[[v1]], %[[a0]])
+// CHECK-NEXT:   "Concrete.add_lwe_buffer"(%[[a3]], %[[v1]], %[[a1]])
+// CHECK-NEXT:   call @memref_arena_release(%[[arena]], %[[ctx]])
+// CHECK-NEXT:   return
+func.func @main(%arg0: memref<2049xi64>, %arg1: memref<2049xi64>, %arg2: memref<2049xi64>, %arg3: memref<2049xi64>, %arg4: !Concrete.context) {
+  %0 = memref.alloc() : memref<2049xi64>
+  "Concrete.add_lwe_buffer"(%0, %arg0, %arg1) : (memref<2049xi64>, memref<2049xi64>, memref<2049xi64>) -> ()
+  "Concrete.add_lwe_buffer"(%arg2, %0, %arg1) : (memref<2049xi64>, memref<2049xi64>, memref<2049xi64>) -> ()
+  memref.dealloc %0 : memref<2049xi64>
+  %1 = memref.alloc() : memref<2049xi64>
+  "Concrete.negate_lwe_buffer"(%1, %arg0) : (memref<2049xi64>, memref<2049xi64>) -> ()
+  "Concrete.add_lwe_buffer"(%arg3, %1, %arg1) : (memref<2049xi64>, memref<2049xi64>, memref<2049xi64>) -> ()
+  memref.dealloc %1 : memref<2049xi64>
+  return
+}
+
+// -----
+
+// The result of the negation is written in place of its input, which dies at
+// the negation
+
+// CHECK:      func.func @main(%[[a0:.*]]: memref<2049xi64>, %[[a1:.*]]: memref<2049xi64>, %[[a2:.*]]: memref<2049xi64>, %[[ctx:.*]]: !Concrete.context) {
+// CHECK-NEXT:   %[[size:.*]] = arith.constant 16448 : i64
+// CHECK-NEXT:   %[[arena:.*]] = call @memref_arena_acquire(%[[ctx]], %[[size]]) : (!Concrete.context, i64) -> memref<?xi8>
+// CHECK-NEXT:   %[[o0:.*]] = arith.constant 0 : index
+// CHECK-NEXT:   %[[v0:.*]] = memref.view %[[arena]][%[[o0]]][] : memref<?xi8> to memref<2049xi64>
+// CHECK-NEXT:   "Concrete.add_lwe_buffer"(%[[v0]], %[[a0]], %[[a1]])
+// CHECK-NEXT:   %[[o1:.*]] = arith.constant 0 : index
+// CHECK-NEXT:   %[[v1:.*]] = memref.view %[[arena]][%[[o1]]][] : memref<?xi8> to memref<2049xi64>
+// CHECK-NEXT:   "Concrete.negate_lwe_buffer"(%[[v1]], %[[v0]])
+// CHECK-NEXT:   "Concrete.add_lwe_buffer"(%[[a2]], %[[v1]], %[[a1]])
+func.func @main(%arg0: memref<2049xi64>, %arg1: memref<2049xi64>, %arg2: memref<2049xi64>, %arg3: !Concrete.context) {
+  %0 = memref.alloc() : memref<2049xi64>
+  "Concrete.add_lwe_buffer"(%0, %arg0, %arg1) : (memref<2049xi64>, memref<2049xi64>, memref<2049xi64>) -> ()
+  %1 = memref.alloc() : memref<2049xi64>
+  "Concrete.negate_lwe_buffer"(%1, %0) : (memref<2049xi64>, memref<2049xi64>) -> ()
+  memref.dealloc %0 : memref<2049xi64>
+  "Concrete.add_lwe_buffer"(%arg2, %1, %arg1) : (memref<2049xi64>, memref<2049xi64>, memref<2049xi64>) -> ()
+  memref.dealloc %1 : memref<2049xi64>
+  return
+}
@@ -0,0 +1,14 @@
+// RUN: concretecompiler --action=dump-optimized-llvm-ir --target-cpu=generic --target-cpu-versions=x86-64-v3 %s 2>&1 | FileCheck %s
+
+// The entry point dispatches its calls to the version for x86-64-v3 if the
+// host supports it, and to the generic version otherwise.
+
+// CHECK:      define {{.*}}@main(
+// CHECK:        call {{.*}}@cpu_supports_version(ptr {{.*}}@cpu_version.x86-64-v3)
+// CHECK:        call {{.*}}@main.x86-64-v3(
+// CHECK:      define internal {{.*}}@main.x86-64-v3({{.*}} #[[V3:[0-9]+]]
+// CHECK:      attributes #[[V3]] = {{.*}}"target-cpu"="x86-64-v3"
+func.func @main(%arg0: tensor<64xi64>, %arg1: tensor<64xi64>) -> tensor<64xi64> {
+  %0 = arith.addi %arg0, %arg1 : tensor<64xi64>
+  return %0 : tensor<64xi64>
+}
@@ -0,0 +1,17 @@
+// RUN: concretecompiler --action=dump-optimized-llvm-ir --target-cpu=generic --target-cpu-versions=x86-64-v2,x86-64-v4,x86-64-v3 %s 2>&1 | FileCheck %s
+
+// The entry point checks the versions from the most to the least capable CPU,
+// whatever the order in which they are given.
+
+// CHECK:      define {{.*}}@main(
+// CHECK:        call {{.*}}@cpu_supports_version(ptr {{.*}}@cpu_version.x86-64-v4)
+// CHECK:        call {{.*}}@main.x86-64-v4(
+// CHECK:        call {{.*}}@cpu_supports_version(ptr {{.*}}@cpu_version.x86-64-v3)
+// CHECK:        call {{.*}}@main.x86-64-v3(
+// CHECK:        call {{.*}}@cpu_supports_version(ptr {{.*}}@cpu_version.x86-64-v2)
+// CHECK:        call {{.*}}@main.x86-64-v2(
+// CHECK:        call {{.*}}@main.default(
+func.func @main(%arg0: tensor<64xi64>, %arg1: tensor<64xi64>) -> tensor<64xi64> {
+  %0 = arith.addi %arg0, %arg1 : tensor<64xi64>
+  return %0 : tensor<64xi64>
+}
@@ -1,6 +1,9 @@
 #include "../end_to_end_tests/end_to_end_test.h"
+#include "concretelang/Support/JITSupport.h"
+#include "concretelang/Support/LibrarySupport.h"
 
 #include <benchmark/benchmark.h>
+#include <functional>
 
 #define BENCHMARK_HAS_CXX11
 #include "llvm/Support/Path.h"
@@ -109,10 +112,49 @@ enum Action {
   EVALUATE,
 };
 
+template <typename LambdaSupport>
+void registerActions(std::function<std::string(std::string)> benchName,
+                     EndToEndDesc description, LambdaSupport support,
+                     mlir::concretelang::CompilationOptions options,
+                     std::vector<enum Action> actions) {
+  for (auto action : actions) {
+    switch (action) {
+    case Action::COMPILE:
+      benchmark::RegisterBenchmark(
+          benchName("compile").c_str(), [=](::benchmark::State &st) {
+            BM_Compile(st, description, support, options);
+          });
+      break;
+    case Action::KEYGEN:
+      benchmark::RegisterBenchmark(
+          benchName("keygen").c_str(), [=](::benchmark::State &st) {
+            BM_KeyGen(st, description, support, options);
+          });
+      break;
+    case Action::ENCRYPT:
+      benchmark::RegisterBenchmark(
+          benchName("encrypt").c_str(), [=](::benchmark::State &st) {
+            BM_ExportArguments(st, description, support, options);
+          });
+      break;
+    case Action::EVALUATE:
+      benchmark::RegisterBenchmark(
+          benchName("evaluate").c_str(), [=](::benchmark::State &st) {
+            BM_Evaluate(st, description, support, options);
+          });
+      break;
+    }
+  }
+}
+
+/// Registers the benchmarks of the `descriptions`, compiled with the JIT
+/// support if `libpath` is empty, and with the library support using
+/// `libpath` as prefix of the compilation artifacts otherwise.
 void registerEndToEndBenchmark(std::string suiteName,
                                std::vector<EndToEndDesc> descriptions,
                                mlir::concretelang::CompilationOptions options,
                                std::vector<enum Action> actions,
+                               std::string libpath = "",
                                size_t stackSizeRequirement = 0) {
   auto optionsName = getOptionsName(options);
   for (auto description : descriptions) {
@@ -122,40 +164,22 @@ void registerEndToEndBenchmark(std::string suiteName,
       options.optimizerConfig.p_error = description.p_error.value();
     }
     options.optimizerConfig.encoding = description.encoding;
-    mlir::concretelang::JITSupport support;
-    auto benchName = [&](std::string name) {
+    auto benchName = [=](std::string name) {
       std::ostringstream s;
       s << suiteName << "/" << name << "/" << optionsName << "/"
         << description.description;
       return s.str();
     };
-    for (auto action : actions) {
-      switch (action) {
-      case Action::COMPILE:
-        benchmark::RegisterBenchmark(
-            benchName("compile").c_str(), [=](::benchmark::State &st) {
-              BM_Compile(st, description, support, options);
-            });
-        break;
-      case Action::KEYGEN:
-        benchmark::RegisterBenchmark(
-            benchName("keygen").c_str(), [=](::benchmark::State &st) {
-              BM_KeyGen(st, description, support, options);
-            });
-        break;
-      case Action::ENCRYPT:
-        benchmark::RegisterBenchmark(
-            benchName("encrypt").c_str(), [=](::benchmark::State &st) {
-              BM_ExportArguments(st, description, support, options);
-            });
-        break;
-      case Action::EVALUATE:
-        benchmark::RegisterBenchmark(
-            benchName("evaluate").c_str(), [=](::benchmark::State &st) {
-              BM_Evaluate(st, description, support, options);
-            });
-        break;
-      }
+    if (libpath.empty()) {
+      registerActions(benchName, description,
+                      mlir::concretelang::JITSupport(), options, actions);
+    } else {
+      // The builds for different options use different artifacts.
+      registerActions(benchName, description,
+                      mlir::concretelang::LibrarySupport(
+                          libpath + optionsName + "_" +
+                          description.description),
+                      options, actions);
     }
   }
   setCurrentStackLimit(stackSizeRequirement);
@@ -177,6 +201,20 @@ int main(int argc, char **argv) {
       llvm::cl::values(
           clEnumValN(Action::EVALUATE, "evaluate", "Run evaluate benchmark")));
 
+  llvm::cl::opt<bool> compareTargets(
+      "compare-targets",
+      llvm::cl::desc("Compare the libraries targeting a generic CPU, a "
+                     "generic CPU with versions for x86-64-v{2,3,4}, and the "
+                     "host CPU, instead of using the target options"),
+      llvm::cl::init(false));
+
+  llvm::cl::opt<bool> compareCarries(
+      "compare-carries",
+      llvm::cl::desc("Compare the chunked integers whose additions ripple "
+                     "the carries, without parallelism, to those computing "
+                     "them with a prefix network, with loop parallelism"),
+      llvm::cl::init(false));
+
   // parse end to end test compiler options
   auto options = parseEndToEndCommandLine(argc, argv);
 
@@ -190,12 +228,44 @@ int main(int argc, char **argv) {
                Action::EVALUATE};
   }
 
+  std::vector<mlir::concretelang::CompilationOptions> targetOptions = {
+      compilationOptions};
+  if (compareTargets) {
+    if (libpath.empty()) {
+      llvm::errs() << "You must specify the library path to compare targets, "
+                      "as the JIT always targets the host";
+      return 1;
+    }
+    auto generic = compilationOptions;
+    generic.targetCPU = "generic";
+    generic.targetCPUVersions = {};
+    auto multiversioned = generic;
+    multiversioned.targetCPUVersions = {"x86-64-v4", "x86-64-v3",
+                                        "x86-64-v2"};
+    auto native = compilationOptions;
+    native.targetCPU = "native";
+    native.targetCPUVersions = {};
+    targetOptions = {generic, multiversioned, native};
+  }
+  if (compareCarries) {
+    // The prefix network is only chosen with parallelism, the two lowerings
+    // being otherwise compiled the same
+    auto ripple = compilationOptions;
+    ripple.chunkIntegers = true;
+    ripple.loopParallelize = false;
+    ripple.dataflowParallelize = false;
+    auto prefix = ripple;
+    prefix.loopParallelize = true;
+    targetOptions = {ripple, prefix};
+  }
+
   auto stackSizeRequirement = 0;
   for (auto descFile : descriptionFiles) {
     auto suiteName = llvm::sys::path::stem(descFile.path).str();
-    registerEndToEndBenchmark(suiteName, descFile.descriptions,
-                              compilationOptions, actions,
-                              stackSizeRequirement);
+    for (auto options : targetOptions) {
+      registerEndToEndBenchmark(suiteName, descFile.descriptions, options,
+                                actions, libpath, stackSizeRequirement);
+    }
   }
   ::benchmark::RunSpecifiedBenchmarks();
   ::benchmark::Shutdown();
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sstream>
+#include <thread>
+
+#include "concretelang/ClientLib/KeySet.h"
+#include "concretelang/Runtime/context.h"
+#include "concretelang/Runtime/key_placement.h"
+
+namespace clientlib = concretelang::clientlib;
+using mlir::concretelang::KeyPlacement;
+using mlir::concretelang::PreparedEvaluationKeys;
+
+/// Number of bootstraps run by each thread per benchmark iteration.
+const size_t PBS_PER_THREAD = 4;
+
+/// Returns evaluation keys with a single bootstrap key with usual parameters.
+static clientlib::EvaluationKeys &getEvaluationKeys() {
+  static std::unique_ptr<clientlib::KeySet> keySet = []() {
+    clientlib::ClientParameters params;
+    params.secretKeys.push_back({/*.dimension =*/2048});
+    params.secretKeys.push_back({/*.dimension =*/750});
+    clientlib::BootstrapKeyParam bsk;
+    bsk.inputSecretKeyID = 1;
+    bsk.outputSecretKeyID = 0;
+    bsk.level = 1;
+    bsk.baseLog = 23;
+    bsk.glweDimension = 1;
+    bsk.variance = 0.;
+    bsk.polynomialSize = 2048;
+    bsk.inputLweDimension = 750;
+    params.bootstrapKeys.push_back(bsk);
+    auto keySet =
+        clientlib::KeySet::generate(params, clientlib::ConcreteCSPRNG(0));
+    assert(keySet.has_value());
+    return std::move(keySet.value());
+  }();
+  static clientlib::EvaluationKeys evaluationKeys = keySet->evaluationKeys();
+  return evaluationKeys;
+}
+
+/// Run `PBS_PER_THREAD` bootstraps on a thread pinned on `cpu`.
+static void runBootstraps(PreparedEvaluationKeys &keys, int cpu) {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+
+  auto param = keys.getKeys().getBootstrapKey(0).parameters();
+  auto fft = keys.fft(0);
+  size_t scratch_size;
+  size_t scratch_align;
+  concrete_cpu_bootstrap_lwe_ciphertext_u64_scratch(
+      &scratch_size, &scratch_align, param.glweDimension, param.polynomialSize,
+      fft);
+  auto scratch = (uint8_t *)aligned_alloc(scratch_align, scratch_size);
+  std::vector<uint64_t> ct_in(param.inputLweDimension + 1, 0);
+  std::vector<uint64_t> ct_out(param.glweDimension * param.polynomialSize + 1);
+  std::vector<uint64_t> accumulator(
+      (param.glweDimension + 1) * param.polynomialSize, 0);
+
+  for (size_t i = 0; i < PBS_PER_THREAD; i++) {
+    concrete_cpu_bootstrap_lwe_ciphertext_u64(
+        ct_out.data(), ct_in.data(), accumulator.data(),
+        keys.fourierBootstrapKey(0), param.level, param.baseLog,
+        param.glweDimension, param.polynomialSize, param.inputLweDimension, fft,
+        scratch, scratch_size);
+  }
+  free(scratch);
+}
+
+/// Benchmark the bootstrap throughput of the cpus of the NUMA node `node`
+/// with the bootstrap key placed according to `placement`.
+static void BM_PBSThroughput(benchmark::State &state, KeyPlacement placement,
+                             size_t node) {
+  auto keys = PreparedEvaluationKeys::prepare(getEvaluationKeys(),
+                                              std::nullopt, placement);
+  keys->wait();
+  auto cpus = mlir::concretelang::numaNodeCpus(node);
+
+  for (auto _ : state) {
+    std::vector<std::thread> threads;
+    for (auto cpu : cpus) {
+      threads.push_back(std::thread([&, cpu]() { runBootstraps(*keys, cpu); }));
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+  state.counters["pbs"] = benchmark::Counter(
+      state.iterations() * cpus.size() * PBS_PER_THREAD,
+      benchmark::Counter::kIsRate);
+}
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+
+  std::vector<std::pair<std::string, KeyPlacement>> placements = {
+      {"default", {/*.hugePages =*/false, /*.numaReplicas =*/false}},
+      {"huge_pages", {/*.hugePages =*/true, /*.numaReplicas =*/false}},
+      {"numa_replicas", {/*.hugePages =*/false, /*.numaReplicas =*/true}},
+      {"huge_pages_numa_replicas",
+       {/*.hugePages =*/true, /*.numaReplicas =*/true}},
+  };
+  for (size_t node = 0; node < mlir::concretelang::numaNodeCount(); node++) {
+    for (auto placement : placements) {
+      std::ostringstream name;
+      name << "pbs_throughput/node" << node << "/" << placement.first;
+      benchmark::RegisterBenchmark(
+          name.str().c_str(),
+          [=](::benchmark::State &st) {
+            BM_PBSThroughput(st, placement.second, node);
+          })
+          ->UseRealTime();
+    }
+  }
+
+  ::benchmark::RunSpecifiedBenchmarks();
+  ::benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,38 @@
+import argparse
+
+
+def main(args):
+    print("# /!\ DO NOT EDIT MANUALLY THIS FILE MANUALLY")
+    print("# /!\ THIS FILE HAS BEEN GENERATED THANKS THE end_to_end_chunked_add_gen.py scripts")
+    print("# This file benchmarks the additions of integers which are chunked by the compiler.\n\n")
+    for i, p in enumerate(args.bitwidth):
+        if i != 0:
+            print("---")
+        half = 2 ** (p - 1)
+        print("description: chunked_add_eint_{0}bits".format(p))
+        print("program: |")
+        print(
+            "  func.func @main(%arg0: !FHE.eint<{0}>, %arg1: !FHE.eint<{0}>) -> !FHE.eint<{0}> {{".format(p))
+        print(
+            "    %0 = \"FHE.add_eint\"(%arg0, %arg1): (!FHE.eint<{0}>, !FHE.eint<{0}>) -> (!FHE.eint<{0}>)".format(p))
+        print("    return %0: !FHE.eint<{0}>".format(p))
+        print("  }")
+        print("tests:")
+        print("  - inputs:")
+        # The carry of the lowest chunk goes through all the chunks but the last
+        print("    - scalar: {0}".format(half - 1))
+        print("    - scalar: 1")
+        print("    outputs:")
+        print("    - scalar: {0}".format(half))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument(
+        "--bitwidth",
+        help="Specify the list of bitwidths of the chunked integers",
+        nargs="+",
+        type=int,
+        default=[16, 32, 64],
+    )
+    main(parser.parse_args())
@@ -19,3 +19,69 @@ TEST(Lambda_chunked_int, chunked_int_add_eint) {
   ASSERT_EXPECTED_VALUE(lambda(2057594037927936_u64, 1111_u64),
                         (uint64_t)2057594037929047);
 }
+
+// The additions below are compiled with a ripple carry without parallelism,
+// and with a parallel prefix network on the carries otherwise. The two
+// lowerings are compared by `make run-cpu-benchmarks-carries`.
+
+TEST(Lambda_chunked_int, chunked_int_add_eint_32_ripple_carry) {
+  checkedJit(lambda, R"XXX(
+    func.func @main(%arg0: !FHE.eint<32>, %arg1: !FHE.eint<32>) -> !FHE.eint<32> {
+      %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<32>, !FHE.eint<32>) -> (!FHE.eint<32>)
+      return %1: !FHE.eint<32>
+    }
+    )XXX",
+             "main", DEFAULT_useDefaultFHEConstraints,
+             DEFAULT_dataflowParallelize, false, DEFAULT_batchTFHEOps,
+             DEFAULT_global_p_error, true, 4, 2);
+  ASSERT_EXPECTED_VALUE(lambda(1_u64, 2_u64), (uint64_t)3);
+  ASSERT_EXPECTED_VALUE(lambda(4294967295_u64, 1_u64), (uint64_t)0);
+  ASSERT_EXPECTED_VALUE(lambda(2863311530_u64, 1431655765_u64),
+                        (uint64_t)4294967295);
+}
+
+TEST(Lambda_chunked_int, chunked_int_add_eint_32_prefix_carry) {
+  checkedJit(lambda, R"XXX(
+    func.func @main(%arg0: !FHE.eint<32>, %arg1: !FHE.eint<32>) -> !FHE.eint<32> {
+      %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<32>, !FHE.eint<32>) -> (!FHE.eint<32>)
+      return %1: !FHE.eint<32>
+    }
+    )XXX",
+             "main", DEFAULT_useDefaultFHEConstraints,
+             DEFAULT_dataflowParallelize, true, DEFAULT_batchTFHEOps,
+             DEFAULT_global_p_error, true, 4, 2);
+  ASSERT_EXPECTED_VALUE(lambda(1_u64, 2_u64), (uint64_t)3);
+  ASSERT_EXPECTED_VALUE(lambda(4294967295_u64, 1_u64), (uint64_t)0);
+  ASSERT_EXPECTED_VALUE(lambda(2863311530_u64, 1431655765_u64),
+                        (uint64_t)4294967295);
+}
+
+TEST(Lambda_chunked_int, chunked_int_add_eint_64_ripple_carry) {
+  checkedJit(lambda, R"XXX(
+    func.func @main(%arg0: !FHE.eint<64>, %arg1: !FHE.eint<64>) -> !FHE.eint<64> {
+      %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<64>, !FHE.eint<64>) -> (!FHE.eint<64>)
+      return %1: !FHE.eint<64>
+    }
+    )XXX",
+             "main", DEFAULT_useDefaultFHEConstraints,
+             DEFAULT_dataflowParallelize, false, DEFAULT_batchTFHEOps,
+             DEFAULT_global_p_error, true, 4, 2);
+  ASSERT_EXPECTED_VALUE(lambda(72057594037927936_u64, 10000_u64),
+                        (uint64_t)72057594037937936);
+  ASSERT_EXPECTED_VALUE(lambda(18446744073709551615_u64, 1_u64), (uint64_t)0);
+}
+
+TEST(Lambda_chunked_int, chunked_int_add_eint_64_prefix_carry) {
+  checkedJit(lambda, R"XXX(
+    func.func @main(%arg0: !FHE.eint<64>, %arg1: !FHE.eint<64>) -> !FHE.eint<64> {
+      %1 = "FHE.add_eint"(%arg0, %arg1): (!FHE.eint<64>, !FHE.eint<64>) -> (!FHE.eint<64>)
+      return %1: !FHE.eint<64>
+    }
+    )XXX",
+             "main", DEFAULT_useDefaultFHEConstraints,
+             DEFAULT_dataflowParallelize, true, DEFAULT_batchTFHEOps,
+             DEFAULT_global_p_error, true, 4, 2);
+  ASSERT_EXPECTED_VALUE(lambda(72057594037927936_u64, 10000_u64),
+                        (uint64_t)72057594037937936);
+  ASSERT_EXPECTED_VALUE(lambda(18446744073709551615_u64, 1_u64), (uint64_t)0);
+}
@@ -96,6 +96,18 @@ parseEndToEndCommandLine(int argc, char **argv) {
           "evaluation "
           "keys")));
 
+  // Target options, only used by the library support as the JIT always
+  // targets the host
+  llvm::cl::opt<std::string> targetCPU(
+      "target-cpu",
+      llvm::cl::desc("Set the targetCPU compilation options to run the tests"),
+      llvm::cl::init<std::string>("native"));
+  llvm::cl::list<std::string> targetCPUVersions(
+      "target-cpu-versions",
+      llvm::cl::desc(
+          "Set the targetCPUVersions compilation options to run the tests"),
+      llvm::cl::ZeroOrMore, llvm::cl::MiscFlags::CommaSeparated);
+
   // JIT or Library support
   llvm::cl::opt<bool> jit(
       "jit",
@@ -130,6 +142,8 @@ parseEndToEndCommandLine(int argc, char **argv) {
   compilationOptions.optimizerConfig.display = optimizerDisplay.getValue();
   compilationOptions.optimizerConfig.security = securityLevel.getValue();
   compilationOptions.optimizerConfig.strategy = optimizerStrategy.getValue();
+  compilationOptions.targetCPU = targetCPU.getValue();
+  compilationOptions.targetCPUVersions = targetCPUVersions;
 
   mlir::concretelang::setupLogging(verbose.getValue());
 
@@ -158,6 +172,8 @@ std::string getOptionsName(mlir::concretelang::CompilationOptions options) {
     os << "_dataflow";
   if (options.emitGPUOps)
     os << "_gpu";
+  if (options.chunkIntegers)
+    os << "_chunked";
   auto ostr = os.str();
   if (ostr.size() == 0) {
     os << "_default";
@@ -168,6 +184,12 @@ std::string getOptionsName(mlir::concretelang::CompilationOptions options) {
   if (options.optimizerConfig.strategy != optimizer::DEFAULT_CONFIG.strategy) {
     os << "_" << options.optimizerConfig.strategy;
   }
+  if (options.targetCPU != "native") {
+    os << "_" << options.targetCPU;
+  }
+  for (auto cpu : options.targetCPUVersions) {
+    os << "_" << cpu;
+  }
   return os.str().substr(1);
 }
 
@@ -1,7 +1,7 @@
 import pytest
 import numpy as np
 from concrete.compiler.utils import ACCEPTED_NUMPY_UINTS
-from concrete.compiler import ClientSupport
+from concrete.compiler import ClientSupport, LambdaArgument
 
 
 @pytest.mark.parametrize(
@@ -74,3 +74,32 @@ def test_accepted_array_as_scalar():
         pytest.fail(f"value of type {type(value)} should be supported")
     assert arg.is_scalar(), "should have been a scalar"
     assert arg.get_scalar() == value
+
+
+@pytest.mark.parametrize(
+    "dtype",
+    [
+        pytest.param(np.uint8, id="uint8"),
+        pytest.param(np.uint64, id="uint64"),
+        pytest.param(np.int8, id="int8"),
+        pytest.param(np.int64, id="int64"),
+    ],
+)
+def test_ndarray_is_not_copied(dtype):
+    value = np.arange(6, dtype=dtype).reshape(2, 3)
+    arg = LambdaArgument.from_array(value)
+
+    array = arg.get_tensor_array()
+    assert array.dtype == dtype
+    assert array.shape == value.shape
+    assert np.shares_memory(array, value), "values should have been borrowed"
+    assert np.all(np.equal(array, value))
+
+
+def test_non_contiguous_ndarray():
+    value = np.arange(6, dtype=np.uint8).reshape(2, 3).T
+    with pytest.raises(ValueError):
+        LambdaArgument.from_array(value)
+
+    arg = ClientSupport._create_lambda_argument(value, signed=False)
+    assert np.all(np.equal(arg.get_tensor_array(), value))
@@ -1,3 +1,4 @@
+import json
 import numpy as np
 import pytest
 import shutil
@@ -5,6 +6,7 @@ import tempfile
 
 from concrete.compiler import (
     ClientSupport,
+    CompilationOptions,
     EvaluationKeys,
     LibrarySupport,
     PublicArguments,
@@ -112,3 +114,180 @@ def test_client_server_end_to_end(mlir, args, expected_result, keyset_cache):
             client_parameters, keyset, result_deserialized
         )
         assert np.array_equal(output, expected_result)
+
+
+def test_client_server_output_modulus_switching(keyset_cache):
+    mlir = """
+
+func.func @main(%a0: tensor<4x!FHE.eint<5>>, %a1: tensor<4x!FHE.eint<5>>) -> tensor<4x!FHE.eint<5>> {
+    %res = "FHELinalg.add_eint"(%a0, %a1) : (tensor<4x!FHE.eint<5>>, tensor<4x!FHE.eint<5>>) -> tensor<4x!FHE.eint<5>>
+    return %res : tensor<4x!FHE.eint<5>>
+}
+
+    """
+    args = (
+        np.array([1, 2, 3, 4], dtype=np.uint8),
+        np.array([7, 0, 1, 5], dtype=np.uint8),
+    )
+    expected_result = np.array([8, 2, 4, 9])
+
+    serialized_sizes = []
+    for output_modulus_switching in [False, True]:
+        options = CompilationOptions.new("main")
+        options.set_output_modulus_switching(output_modulus_switching)
+        with tempfile.TemporaryDirectory() as tmpdirname:
+            support = LibrarySupport.new(str(tmpdirname))
+            compilation_result = support.compile(mlir, options)
+            server_lambda = support.load_server_lambda(compilation_result)
+
+            client_parameters = support.load_client_parameters(compilation_result)
+            keyset = ClientSupport.key_set(client_parameters, keyset_cache)
+
+            public_args = ClientSupport.encrypt_arguments(
+                client_parameters, keyset, args
+            )
+            result = support.server_call(
+                server_lambda, public_args, keyset.get_evaluation_keys()
+            )
+            result_serialized = result.serialize()
+            serialized_sizes.append(len(result_serialized))
+            result_deserialized = PublicResult.deserialize(
+                client_parameters, result_serialized
+            )
+
+            output = ClientSupport.decrypt_result(
+                client_parameters, keyset, result_deserialized
+            )
+            assert np.array_equal(output, expected_result)
+
+    # The coefficients of the switched ciphertexts are packed on less bits
+    assert serialized_sizes[1] * 2 < serialized_sizes[0]
+
+
+def test_client_server_output_packing(keyset_cache):
+    mlir = """
+
+func.func @main(%a0: tensor<64x!FHE.eint<5>>, %a1: tensor<64x!FHE.eint<5>>) -> tensor<64x!FHE.eint<5>> {
+    %res = "FHELinalg.add_eint"(%a0, %a1) : (tensor<64x!FHE.eint<5>>, tensor<64x!FHE.eint<5>>) -> tensor<64x!FHE.eint<5>>
+    return %res : tensor<64x!FHE.eint<5>>
+}
+
+    """
+    args = (
+        np.arange(64, dtype=np.uint8) % 16,
+        (np.arange(64, dtype=np.uint8) * 3) % 16,
+    )
+    expected_result = args[0].astype(np.int64) + args[1]
+
+    serialized_sizes = []
+    for output_packing in [False, True]:
+        options = CompilationOptions.new("main")
+        options.set_output_packing(output_packing)
+        with tempfile.TemporaryDirectory() as tmpdirname:
+            support = LibrarySupport.new(str(tmpdirname))
+            compilation_result = support.compile(mlir, options)
+            server_lambda = support.load_server_lambda(compilation_result)
+
+            client_parameters = support.load_client_parameters(compilation_result)
+            keyset = ClientSupport.key_set(client_parameters, keyset_cache)
+
+            public_args = ClientSupport.encrypt_arguments(
+                client_parameters, keyset, args
+            )
+            result = support.server_call(
+                server_lambda, public_args, keyset.get_evaluation_keys()
+            )
+            result_serialized = result.serialize()
+            serialized_sizes.append(len(result_serialized))
+            result_deserialized = PublicResult.deserialize(
+                client_parameters, result_serialized
+            )
+
+            output = ClientSupport.decrypt_result(
+                client_parameters, keyset, result_deserialized
+            )
+            assert np.array_equal(output, expected_result)
+
+    # The 64 ciphertexts of the output are packed in a single GLWE ciphertext
+    assert serialized_sizes[1] * 4 < serialized_sizes[0]
+
+
+def test_client_server_output_packing_full_glwe(keyset_cache):
+    # Without bootstrap, the outputs are packed in GLWE ciphertexts of 2048
+    # coefficients: the first one is full and sums the errors of 2048
+    # keyswitches
+    size = 2100
+    mlir = f"""
+
+func.func @main(%a0: tensor<{size}x!FHE.eint<5>>, %a1: tensor<{size}x!FHE.eint<5>>) -> tensor<{size}x!FHE.eint<5>> {{
+    %res = "FHELinalg.add_eint"(%a0, %a1) : (tensor<{size}x!FHE.eint<5>>, tensor<{size}x!FHE.eint<5>>) -> tensor<{size}x!FHE.eint<5>>
+    return %res : tensor<{size}x!FHE.eint<5>>
+}}
+
+    """
+    args = (
+        np.arange(size, dtype=np.uint8) % 16,
+        (np.arange(size, dtype=np.uint8) * 3) % 16,
+    )
+    expected_result = args[0].astype(np.int64) + args[1]
+
+    options = CompilationOptions.new("main")
+    options.set_output_packing(True)
+    with tempfile.TemporaryDirectory() as tmpdirname:
+        support = LibrarySupport.new(str(tmpdirname))
+        compilation_result = support.compile(mlir, options)
+        server_lambda = support.load_server_lambda(compilation_result)
+
+        client_parameters = support.load_client_parameters(compilation_result)
+        packing_keys = json.loads(client_parameters.serialize())[
+            "packingKeyswitchKeys"
+        ]
+        assert len(packing_keys) == 1
+        assert packing_keys[0]["polynomialSize"] <= size
+
+        keyset = ClientSupport.key_set(client_parameters, keyset_cache)
+        public_args = ClientSupport.encrypt_arguments(client_parameters, keyset, args)
+        result = support.server_call(
+            server_lambda, public_args, keyset.get_evaluation_keys()
+        )
+        result_deserialized = PublicResult.deserialize(
+            client_parameters, result.serialize()
+        )
+
+        output = ClientSupport.decrypt_result(
+            client_parameters, keyset, result_deserialized
+        )
+        assert np.array_equal(output, expected_result)
+
+
+def test_client_server_output_packing_most_precise_output():
+    # Both outputs are under the same key and share their packing key, which
+    # must be precise enough for the 7 bits output whatever the order
+    packing_keys = []
+    for outputs in ["%r2, %r7", "%r7, %r2"]:
+        types = (
+            "!FHE.eint<2>, !FHE.eint<7>"
+            if outputs.startswith("%r2")
+            else "!FHE.eint<7>, !FHE.eint<2>"
+        )
+        mlir = f"""
+
+func.func @main(%a2: !FHE.eint<2>, %a7: !FHE.eint<7>) -> ({types}) {{
+    %r2 = "FHE.add_eint"(%a2, %a2): (!FHE.eint<2>, !FHE.eint<2>) -> (!FHE.eint<2>)
+    %r7 = "FHE.add_eint"(%a7, %a7): (!FHE.eint<7>, !FHE.eint<7>) -> (!FHE.eint<7>)
+    return {outputs}: {types}
+}}
+
+        """
+        options = CompilationOptions.new("main")
+        options.set_output_packing(True)
+        with tempfile.TemporaryDirectory() as tmpdirname:
+            support = LibrarySupport.new(str(tmpdirname))
+            compilation_result = support.compile(mlir, options)
+            client_parameters = support.load_client_parameters(compilation_result)
+            packing_keys.append(
+                json.loads(client_parameters.serialize())["packingKeyswitchKeys"]
+            )
+
+    assert len(packing_keys[0]) == 1
+    assert packing_keys[0] == packing_keys[1]
@@ -9,6 +9,7 @@ from concrete.compiler import (
     ClientSupport,
     CompilationOptions,
     CompilationFeedback,
+    set_server_call_workers,
 )
 
 
@@ -38,6 +39,11 @@ def run(engine, args, compilation_result, keyset_cache):
     assert isinstance(compilation_feedback.total_bootstrap_keys_size, int)
     assert isinstance(compilation_feedback.total_inputs_size, int)
     assert isinstance(compilation_feedback.total_output_size, int)
+    assert isinstance(compilation_feedback.deduplicated_keyswitches, int)
+    assert isinstance(compilation_feedback.peak_intermediate_buffers_size, int)
+    assert isinstance(compilation_feedback.operation_statistics, list)
+    assert isinstance(compilation_feedback.peak_ciphertexts_size, int)
+    assert isinstance(compilation_feedback.critical_path_complexity, float)
 
     # Client
     client_parameters = engine.load_client_parameters(compilation_result)
@@ -277,6 +283,120 @@ def test_lib_compile_and_run_security_level(keyset_cache):
     _test_lib_compile_and_run_with_options(keyset_cache, options)
 
 
+def test_lib_compile_and_run_plan_memory(keyset_cache):
+    options = CompilationOptions.new("main")
+    options.set_plan_memory(True)
+    _test_lib_compile_and_run_with_options(keyset_cache, options)
+
+
+def test_lib_compile_and_run_plan_memory_intermediate_buffers(keyset_cache):
+    mlir_input = """
+        func.func @main(%a0: tensor<4x!FHE.eint<6>>, %a1: tensor<4xi7>, %a2: tensor<4x!FHE.eint<6>>, %a3: tensor<4xi7>) -> tensor<4x!FHE.eint<6>> {
+            %1 = "FHELinalg.add_eint_int"(%a0, %a1) : (tensor<4x!FHE.eint<6>>, tensor<4xi7>) -> tensor<4x!FHE.eint<6>>
+            %2 = "FHELinalg.add_eint_int"(%a2, %a3) : (tensor<4x!FHE.eint<6>>, tensor<4xi7>) -> tensor<4x!FHE.eint<6>>
+            %res = "FHELinalg.add_eint"(%1, %2) : (tensor<4x!FHE.eint<6>>, tensor<4x!FHE.eint<6>>) -> tensor<4x!FHE.eint<6>>
+            return %res : tensor<4x!FHE.eint<6>>
+        }
+    """
+    args = (
+        np.array([1, 2, 3, 4], dtype=np.uint8),
+        np.array([9, 8, 6, 5], dtype=np.uint8),
+        np.array([3, 2, 7, 0], dtype=np.uint8),
+        np.array([1, 4, 2, 11], dtype=np.uint8),
+    )
+    expected_result = np.array([14, 16, 18, 20])
+    options = CompilationOptions.new("main")
+    options.set_plan_memory(True)
+    engine = LibrarySupport.new("./py_test_lib_compile_and_run_plan_memory")
+    compilation_result = engine.compile(mlir_input, options)
+    compilation_feedback = engine.load_compilation_feedback(compilation_result)
+    assert compilation_feedback.peak_intermediate_buffers_size > 0
+
+    client_parameters = engine.load_client_parameters(compilation_result)
+    key_set = ClientSupport.key_set(client_parameters, keyset_cache)
+    server_lambda = engine.load_server_lambda(compilation_result)
+    evaluation_keys = key_set.get_evaluation_keys()
+    # Each call acquires and releases the memory of its intermediate buffers
+    for _ in range(2):
+        public_arguments = ClientSupport.encrypt_arguments(
+            client_parameters, key_set, args
+        )
+        public_result = engine.server_call(
+            server_lambda, public_arguments, evaluation_keys
+        )
+        result = ClientSupport.decrypt_result(client_parameters, key_set, public_result)
+        assert_result(result, expected_result)
+
+
+def test_lib_compile_and_run_inline_leveled_ops(keyset_cache):
+    mlir_input = """
+        func.func @main(%a0: tensor<4x!FHE.eint<6>>, %a1: tensor<4xi7>, %a2: tensor<4x!FHE.eint<6>>) -> tensor<4x!FHE.eint<6>> {
+            %1 = "FHELinalg.add_eint_int"(%a0, %a1) : (tensor<4x!FHE.eint<6>>, tensor<4xi7>) -> tensor<4x!FHE.eint<6>>
+            %2 = "FHELinalg.mul_eint_int"(%a2, %a1) : (tensor<4x!FHE.eint<6>>, tensor<4xi7>) -> tensor<4x!FHE.eint<6>>
+            %3 = "FHELinalg.add_eint"(%1, %2) : (tensor<4x!FHE.eint<6>>, tensor<4x!FHE.eint<6>>) -> tensor<4x!FHE.eint<6>>
+            %4 = "FHELinalg.neg_eint"(%a0) : (tensor<4x!FHE.eint<6>>) -> tensor<4x!FHE.eint<6>>
+            %res = "FHELinalg.add_eint"(%3, %4) : (tensor<4x!FHE.eint<6>>, tensor<4x!FHE.eint<6>>) -> tensor<4x!FHE.eint<6>>
+            return %res : tensor<4x!FHE.eint<6>>
+        }
+    """
+    args = (
+        np.array([1, 2, 3, 4], dtype=np.uint8),
+        np.array([5, 1, 0, 2], dtype=np.uint8),
+        np.array([3, 4, 7, 6], dtype=np.uint8),
+    )
+    expected_result = np.array([20, 5, 0, 14])
+    options = CompilationOptions.new("main")
+    options.set_inline_leveled_ops(True)
+    engine = LibrarySupport.new("./py_test_lib_compile_and_run_inline_leveled_ops")
+    compile_run_assert(engine, mlir_input, args, expected_result, keyset_cache, options)
+
+
+def test_lib_compile_and_run_multi_bit_grouping_factor(keyset_cache):
+    options = CompilationOptions.new("main")
+    options.set_multi_bit_grouping_factor(2)
+    _test_lib_compile_and_run_with_options(keyset_cache, options)
+
+
+def test_lib_compile_and_run_round_lut(keyset_cache):
+    # The rounding is rewritten to a table on 6 bits, the precision of the
+    # other table on its input, which replaces its 3 bootstraps
+    mlir_input = """
+        func.func @main(%arg0: !FHE.eint<6>) -> !FHE.eint<6> {
+            %quarter = arith.constant dense<[0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 6, 7, 7, 7, 7, 8, 8, 8, 8, 9, 9, 9, 9, 10, 10, 10, 10, 11, 11, 11, 11, 12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15]> : tensor<64xi64>
+            %0 = "FHE.apply_lookup_table"(%arg0, %quarter): (!FHE.eint<6>, tensor<64xi64>) -> (!FHE.eint<6>)
+            %1 = "FHE.round"(%arg0) : (!FHE.eint<6>) -> !FHE.eint<3>
+            %double = arith.constant dense<[0, 2, 4, 6, 8, 10, 12, 14]> : tensor<8xi64>
+            %2 = "FHE.apply_lookup_table"(%1, %double): (!FHE.eint<3>, tensor<8xi64>) -> (!FHE.eint<6>)
+            %3 = "FHE.add_eint"(%0, %2): (!FHE.eint<6>, !FHE.eint<6>) -> (!FHE.eint<6>)
+            return %3: !FHE.eint<6>
+        }
+    """
+    args = (21,)
+    expected_result = 11
+    engine = LibrarySupport.new("./py_test_lib_compile_and_run_round_lut")
+    complexities = []
+    for max_precision in (0, 8):
+        options = CompilationOptions.new("main")
+        options.set_round_lut_max_precision(max_precision)
+        compilation_result = engine.compile(mlir_input, options)
+        feedback = engine.load_compilation_feedback(compilation_result)
+        complexities.append(feedback.complexity)
+        result = run(engine, args, compilation_result, keyset_cache)
+        assert_result(result, expected_result)
+    assert complexities[1] < complexities[0]
+
+
+def test_set_server_call_workers_not_positive():
+    with pytest.raises(ValueError):
+        set_server_call_workers(0)
+
+
+def test_multi_bit_grouping_factor_out_of_range():
+    options = CompilationOptions.new("main")
+    with pytest.raises(ValueError):
+        options.set_multi_bit_grouping_factor(5)
+
+
 @pytest.mark.parallel
 @pytest.mark.parametrize(
     "mlir_input, args, expected_result", end_to_end_parallel_fixture
@@ -1,8 +1,10 @@
 #include <cassert>
 #include <gtest/gtest.h>
+#include <sstream>
 
 #include "concretelang/ClientLib/ClientParameters.h"
 #include "concretelang/ClientLib/EncryptedArguments.h"
+#include "concretelang/ClientLib/Serializers.h"
 #include "tests_tools/assert.h"
 
 namespace clientlib = concretelang::clientlib;
@@ -74,3 +76,38 @@ TEST(Support, client_parameters_json_serde) {
   auto parseResult = llvm::json::parse<clientlib::ClientParameters>(jsonStr);
   ASSERT_EXPECTED_VALUE(parseResult, params0);
 }
+
+TEST(Support, bootstrap_key_param_binary_serde) {
+  clientlib::BootstrapKeyParam classic{
+      /*.inputSecretKeyID = */ 0,
+      /*.outputSecretKeyID = */ 0,
+      /*.level = */ 1,
+      /*.baseLog = */ 2,
+      /*.glweDimension = */ 3,
+      /*.variance = */ 0.001,
+      /*.polynomialSize = */ 1024,
+      /*.inputLweDimension = */ 600,
+  };
+
+  // The classic keys keep the layout of the keysets serialized before the
+  // multi-bit keys
+  std::stringstream classicStream;
+  classicStream << classic;
+  ASSERT_EQ(classicStream.str().size(), 6 * sizeof(uint64_t));
+  clientlib::BootstrapKeyParam classicRead;
+  classicRead.groupingFactor = 3;
+  classicStream >> classicRead;
+  ASSERT_EQ(classicRead.level, classic.level);
+  ASSERT_EQ(classicRead.inputLweDimension, classic.inputLweDimension);
+  ASSERT_EQ(classicRead.groupingFactor, 1u);
+
+  auto multiBit = classic;
+  multiBit.groupingFactor = 3;
+  std::stringstream multiBitStream;
+  multiBitStream << multiBit;
+  clientlib::BootstrapKeyParam multiBitRead;
+  multiBitStream >> multiBitRead;
+  ASSERT_EQ(multiBitRead.level, multiBit.level);
+  ASSERT_EQ(multiBitRead.inputLweDimension, multiBit.inputLweDimension);
+  ASSERT_EQ(multiBitRead.groupingFactor, 3u);
+}
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include "concretelang/ClientLib/ClientParameters.h"
+#include "concretelang/ClientLib/KeySetCache.h"
+#include "tests_tools/assert.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+namespace clientlib = concretelang::clientlib;
+
+/// Create a client parameters with two secret keys, a keyswitch key between
+/// them and one input and output scalar gate of the given precision.
+static clientlib::ClientParameters
+generateClientParameters(clientlib::Precision precision) {
+  clientlib::ClientParameters params;
+  params.secretKeys.push_back({/*.dimension =*/1024});
+  params.secretKeys.push_back({/*.dimension =*/512});
+  clientlib::KeyswitchKeyParam ksk;
+  ksk.inputSecretKeyID = 0;
+  ksk.outputSecretKeyID = 1;
+  ksk.level = 3;
+  ksk.baseLog = 4;
+  ksk.variance = 0.;
+  params.keyswitchKeys.push_back(ksk);
+  clientlib::EncryptionGate encryption;
+  encryption.secretKeyID = clientlib::BIG_KEY;
+  encryption.encoding.precision = precision;
+  encryption.encoding.isSigned = false;
+  encryption.variance = 0.;
+  clientlib::CircuitGate gate;
+  gate.encryption = encryption;
+  gate.shape = {/*.width =*/precision, /*.dimensions =*/{}, /*.size =*/0,
+                /*.sign =*/false};
+  params.inputs.push_back(gate);
+  params.outputs.push_back(gate);
+  return params;
+}
+
+/// Add a keyswitch key from the second secret key to the first one.
+static void addBackwardKeyswitchKey(clientlib::ClientParameters &params) {
+  auto ksk = params.keyswitchKeys[0];
+  std::swap(ksk.inputSecretKeyID, ksk.outputSecretKeyID);
+  params.keyswitchKeys.push_back(ksk);
+}
+
+/// Returns the number of entries stored in the cache at `cachePath`.
+static size_t countEntries(llvm::StringRef cachePath) {
+  llvm::SmallString<0> keysPath(cachePath);
+  llvm::sys::path::append(keysPath, "keys");
+  std::error_code err;
+  size_t count = 0;
+  for (llvm::sys::fs::directory_iterator it(keysPath, err), end;
+       !err && it != end; it.increment(err)) {
+    count++;
+  }
+  return count;
+}
+
+TEST(KeySetCache, addresses_ignore_other_keys_and_gates) {
+  auto params3 = generateClientParameters(3);
+  auto params5 = generateClientParameters(5);
+  addBackwardKeyswitchKey(params5);
+  ASSERT_NE(params3.hash(), params5.hash());
+
+  auto addresses3 = clientlib::KeySetCache::keyAddresses(params3, 0, 42);
+  auto addresses5 = clientlib::KeySetCache::keyAddresses(params5, 0, 42);
+  ASSERT_EQ(addresses3.secretKeys, addresses5.secretKeys);
+  ASSERT_EQ(addresses5.keyswitchKeys.size(), 2u);
+  ASSERT_EQ(addresses3.keyswitchKeys[0], addresses5.keyswitchKeys[0]);
+  ASSERT_NE(addresses5.keyswitchKeys[0], addresses5.keyswitchKeys[1]);
+}
+
+TEST(KeySetCache, addresses_depend_on_seed_and_dependencies) {
+  auto params = generateClientParameters(3);
+  auto addresses = clientlib::KeySetCache::keyAddresses(params, 0, 42);
+  auto otherSeed = clientlib::KeySetCache::keyAddresses(params, 0, 43);
+  ASSERT_NE(addresses.secretKeys, otherSeed.secretKeys);
+  ASSERT_NE(addresses.keyswitchKeys, otherSeed.keyswitchKeys);
+
+  // Two secret keys of the same dimension are distinct keys
+  params.secretKeys[1].dimension = 1024;
+  auto sameDimension = clientlib::KeySetCache::keyAddresses(params, 0, 42);
+  ASSERT_NE(sameDimension.secretKeys[0], sameDimension.secretKeys[1]);
+  ASSERT_NE(addresses.keyswitchKeys, sameDimension.keyswitchKeys);
+}
+
+TEST(KeySetCache, addresses_are_stable) {
+  // Addresses name the entries stored on disk, so they must not depend on the
+  // platform, the build or the process
+  auto params = generateClientParameters(3);
+  auto addresses = clientlib::KeySetCache::keyAddresses(params, 0, 42);
+  ASSERT_EQ(addresses.secretKeys[0], 0x32c3a5e81f68f372u);
+  ASSERT_EQ(addresses.secretKeys[1], 0xa35348ed85d2aa14u);
+  ASSERT_EQ(addresses.keyswitchKeys[0], 0x53e54a8272830839u);
+}
+
+TEST(KeySetCache, keys_are_shared_across_circuits) {
+  llvm::SmallString<0> cachePath;
+  ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("KeySetCache", cachePath));
+  auto cache = std::make_shared<clientlib::KeySetCache>(std::string(cachePath));
+
+  auto params3 = generateClientParameters(3);
+  auto params5 = generateClientParameters(5);
+  addBackwardKeyswitchKey(params5);
+  auto keySet3 = clientlib::KeySetCache::generate(cache, params3, 0, 42);
+  ASSERT_TRUE(keySet3.has_value());
+  ASSERT_EQ(countEntries(cachePath), 3u);
+  auto keySet5 = clientlib::KeySetCache::generate(cache, params5, 0, 42);
+  ASSERT_TRUE(keySet5.has_value());
+  // Only the backward keyswitch key is added to the stored entries
+  ASSERT_EQ(countEntries(cachePath), 4u);
+
+  // The second circuit reuses the stored entries
+  auto sk3 = keySet3.value()->getSecretKeys();
+  auto sk5 = keySet5.value()->getSecretKeys();
+  ASSERT_EQ(sk3.size(), sk5.size());
+  for (size_t i = 0; i < sk3.size(); i++) {
+    ASSERT_EQ(sk3[i].size(), sk5[i].size());
+    ASSERT_TRUE(std::equal(sk3[i].buffer(), sk3[i].buffer() + sk3[i].size(),
+                           sk5[i].buffer()));
+  }
+
+  // Encryption with one circuit decrypts with the other
+  uint64_t *ciphertext = nullptr;
+  uint64_t size = 0;
+  ASSERT_OUTCOME_HAS_VALUE(keySet3.value()->allocate_lwe(0, &ciphertext, size));
+  ASSERT_OUTCOME_HAS_VALUE(keySet3.value()->encrypt_lwe(0, ciphertext, 5));
+  uint64_t output;
+  ASSERT_OUTCOME_HAS_VALUE(keySet5.value()->decrypt_lwe(0, ciphertext, output));
+  ASSERT_EQ(output, 5u);
+  free(ciphertext);
+
+  llvm::sys::fs::remove_directories(cachePath);
+}
@@ -41,6 +41,7 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         maximum_acceptable_error_probability: p_error,
         ciphertext_modulus_log: 64,
         complexity_model: &CpuComplexity::default(),
+        multi_bit_grouping_factor: 1,
     };
 
     let cache = decomposition::cache(security_level, processing_unit, None, true);
@@ -43,19 +43,29 @@ fn caches_from(options: ffi::Options) -> decomposition::PersistDecompCaches {
     )
 }
 
-fn optimize_bootstrap(precision: u64, noise_factor: f64, options: ffi::Options) -> ffi::Solution {
-    let processing_unit = processing_unit(options);
+fn search_space_from(options: ffi::Options) -> SearchSpace {
+    let mut search_space = SearchSpace::default(processing_unit(options));
+    // multi bit bootstrap keys are only used with internal dimensions multiple of the grouping
+    // factor
+    let grouping_factor = options.multi_bit_grouping_factor;
+    search_space
+        .internal_lwe_dimensions
+        .retain(|internal_dim| internal_dim % grouping_factor == 0);
+    search_space
+}
 
+fn optimize_bootstrap(precision: u64, noise_factor: f64, options: ffi::Options) -> ffi::Solution {
     let config = Config {
         security_level: options.security_level,
         maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
         ciphertext_modulus_log: 64,
         complexity_model: &CpuComplexity::default(),
+        multi_bit_grouping_factor: options.multi_bit_grouping_factor,
     };
 
     let sum_size = 1;
 
-    let search_space = SearchSpace::default(processing_unit);
+    let search_space = search_space_from(options);
 
     let result = concrete_optimizer::optimization::atomic_pattern::optimize_one(
         sum_size,
@@ -483,17 +493,24 @@ impl OperationDag {
         self.0.add_round_op(input.into(), rounded_precision).into()
     }
 
-    fn optimize_v0(&self, options: ffi::Options) -> ffi::Solution {
-        let processing_unit = processing_unit(options);
+    fn add_unsafe_cast(
+        &mut self,
+        input: ffi::OperatorIndex,
+        out_precision: Precision,
+    ) -> ffi::OperatorIndex {
+        self.0.add_unsafe_cast(input.into(), out_precision).into()
+    }
 
+    fn optimize_v0(&self, options: ffi::Options) -> ffi::Solution {
         let config = Config {
             security_level: options.security_level,
             maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
             ciphertext_modulus_log: 64,
             complexity_model: &CpuComplexity::default(),
+            multi_bit_grouping_factor: options.multi_bit_grouping_factor,
         };
 
-        let search_space = SearchSpace::default(processing_unit);
+        let search_space = search_space_from(options);
 
         let result = concrete_optimizer::optimization::dag::solo_key::optimize::optimize(
             &self.0,
@@ -507,15 +524,15 @@ impl OperationDag {
     }
 
     fn optimize(&self, options: ffi::Options) -> ffi::DagSolution {
-        let processing_unit = processing_unit(options);
         let config = Config {
             security_level: options.security_level,
             maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
             ciphertext_modulus_log: 64,
             complexity_model: &CpuComplexity::default(),
+            multi_bit_grouping_factor: options.multi_bit_grouping_factor,
         };
 
-        let search_space = SearchSpace::default(processing_unit);
+        let search_space = search_space_from(options);
 
         let encoding = options.encoding.into();
         let result = concrete_optimizer::optimization::dag::solo_key::optimize_generic::optimize(
@@ -534,14 +551,14 @@ impl OperationDag {
     }
 
     fn optimize_multi(&self, options: ffi::Options) -> ffi::CircuitSolution {
-        let processing_unit = processing_unit(options);
         let config = Config {
             security_level: options.security_level,
             maximum_acceptable_error_probability: options.maximum_acceptable_error_probability,
             ciphertext_modulus_log: 64,
             complexity_model: &CpuComplexity::default(),
+            multi_bit_grouping_factor: options.multi_bit_grouping_factor,
         };
-        let search_space = SearchSpace::default(processing_unit);
+        let search_space = search_space_from(options);
 
         let encoding = options.encoding.into();
         let circuit_sol =
@@ -647,6 +664,12 @@ mod ffi {
             rounded_precision: u8,
         ) -> OperatorIndex;
 
+        fn add_unsafe_cast(
+            self: &mut OperationDag,
+            input: OperatorIndex,
+            out_precision: u8,
+        ) -> OperatorIndex;
+
         fn optimize_v0(self: &OperationDag, options: Options) -> Solution;
 
         fn optimize(self: &OperationDag, options: Options) -> DagSolution;
@@ -728,6 +751,7 @@ mod ffi {
         pub use_gpu_constraints: bool,
         pub encoding: Encoding,
         pub cache_on_disk: bool,
+        pub multi_bit_grouping_factor: u64,
     }
 
     #[namespace = "concrete_optimizer::dag"]
@@ -25,6 +25,7 @@ concrete_optimizer::Options default_options() {
     .use_gpu_constraints = false,
     .encoding = concrete_optimizer::Encoding::Auto,
     .cache_on_disk = true,
+    .multi_bit_grouping_factor = 1,
   };
 }
 
@@ -74,6 +75,25 @@ void test_dag_lut() {
   assert(!solution.use_wop_pbs);
 }
 
+void test_dag_lut_multi_bit() {
+  auto dag = concrete_optimizer::dag::empty();
+
+  std::vector<uint64_t> shape = {3};
+
+  concrete_optimizer::dag::OperatorIndex input =
+      dag->add_input(PRECISION_8B, slice(shape));
+
+  std::vector<u_int64_t> table = {};
+  dag->add_lut(input, slice(table), PRECISION_8B);
+
+  auto options = default_options();
+  options.multi_bit_grouping_factor = 3;
+  auto solution = dag->optimize(options);
+  assert(!solution.use_wop_pbs);
+  assert(solution.internal_ks_output_lwe_dimension % 3 == 0);
+  assert(solution.p_error <= P_ERROR);
+}
+
 void test_dag_lut_wop() {
   auto dag = concrete_optimizer::dag::empty();
 
@@ -211,6 +231,7 @@ int main() {
   test_v0();
   test_dag_no_lut();
   test_dag_lut();
+  test_dag_lut_multi_bit();
   test_dag_lut_wop();
   test_dag_lut_force_wop();
   test_multi_parameters_1_precision();
@@ -202,7 +202,9 @@ pub fn optimize_one(
                 glwe_dimension: glwe_dim,
             };
 
-            let cmux_quantities = caches.cmux.pareto_quantities(glwe_params);
+            let cmux_quantities = caches
+                .cmux
+                .pareto_quantities(glwe_params, config.multi_bit_grouping_factor);
 
             for &internal_dim in &search_space.internal_lwe_dimensions {
                 assert!(256 < internal_dim);
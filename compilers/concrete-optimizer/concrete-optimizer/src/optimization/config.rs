@@ -16,6 +16,9 @@ pub struct Config<'a> {
     pub maximum_acceptable_error_probability: f64,
     pub ciphertext_modulus_log: u32,
     pub complexity_model: &'a dyn ComplexityModel,
+    // number of mask elements processed by each external product of the bootstraps, 1 for the
+    // classic bootstrap
+    pub multi_bit_grouping_factor: u64,
 }
 
 #[derive(Clone, Debug)]
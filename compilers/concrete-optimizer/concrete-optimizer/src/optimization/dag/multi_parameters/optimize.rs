@@ -492,6 +492,7 @@ fn apply_partitions_input_and_modulus_variance_and_cost(
 
 fn apply_pbs_variance_and_cost_or_lower_bounds(
     caches: &mut cmux::Cache,
+    multi_bit_grouping_factor: u64,
     macro_parameters: &[MacroParameters],
     initial_pbs: &[Option<CmuxComplexityNoise>],
     partition: PartitionIndex,
@@ -508,8 +509,10 @@ fn apply_pbs_variance_and_cost_or_lower_bounds(
             // OPT: Most values could be shared on first optimize_macro
             let in_internal_dim = macro_parameters[i].internal_dim;
             let out_glwe_params = macro_parameters[i].glwe_params;
-            let variance_min =
-                cmux::lowest_noise_br(caches.pareto_quantities(out_glwe_params), in_internal_dim);
+            let variance_min = cmux::lowest_noise_br(
+                caches.pareto_quantities(out_glwe_params, multi_bit_grouping_factor),
+                in_internal_dim,
+            );
             *operations.variance.pbs(i) = variance_min;
             *operations.cost.pbs(i) = 0.0;
         }
@@ -569,6 +572,7 @@ pub const REAL_FAST_KS: bool = false;
 fn optimize_macro(
     security_level: u64,
     ciphertext_modulus_log: u32,
+    multi_bit_grouping_factor: u64,
     search_space: &SearchSpace,
     partition: PartitionIndex,
     used_tlu_keyswitch: &[Vec<bool>],
@@ -670,6 +674,7 @@ fn optimize_macro(
             // OPT: could be done once and than partially updated
             apply_pbs_variance_and_cost_or_lower_bounds(
                 &mut caches.cmux,
+                multi_bit_grouping_factor,
                 &macros,
                 &init_parameters.micro_params.pbs,
                 partition,
@@ -704,7 +709,9 @@ fn optimize_macro(
                 continue;
             }
 
-            let cmux_pareto = caches.cmux.pareto_quantities(glwe_params);
+            let cmux_pareto = caches
+                .cmux
+                .pareto_quantities(glwe_params, multi_bit_grouping_factor);
 
             if non_feasible {
                 // here we optimize for feasibility only
@@ -865,6 +872,7 @@ pub fn optimize(
             let new_params = optimize_macro(
                 security_level,
                 ciphertext_modulus_log,
+                config.multi_bit_grouping_factor,
                 search_space,
                 partition,
                 &used_tlu_keyswitch,
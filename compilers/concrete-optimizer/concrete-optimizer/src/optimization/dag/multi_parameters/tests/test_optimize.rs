@@ -33,6 +33,7 @@ mod tests {
             maximum_acceptable_error_probability: _4_SIGMA,
             ciphertext_modulus_log: 64,
             complexity_model: &CpuComplexity::default(),
+            multi_bit_grouping_factor: 1,
         };
 
         let search_space = SearchSpace::default_cpu();
@@ -326,7 +326,9 @@ pub fn optimize(
             };
             let input_noise_out = minimal_variance(&config, glwe_params);
 
-            let cmux_pareto = caches.cmux.pareto_quantities(glwe_params);
+            let cmux_pareto = caches
+                .cmux
+                .pareto_quantities(glwe_params, config.multi_bit_grouping_factor);
 
             for &internal_dim in &search_space.internal_lwe_dimensions {
                 let ks_pareto = caches.keyswitch.pareto_quantities(internal_dim);
@@ -472,6 +474,7 @@ pub(crate) mod tests {
             maximum_acceptable_error_probability: _4_SIGMA,
             ciphertext_modulus_log: 64,
             complexity_model: &CpuComplexity::default(),
+            multi_bit_grouping_factor: 1,
         };
 
         let search_space = SearchSpace::default_cpu();
@@ -515,6 +518,7 @@ pub(crate) mod tests {
             maximum_acceptable_error_probability: _4_SIGMA,
             ciphertext_modulus_log: 64,
             complexity_model: &CpuComplexity::default(),
+            multi_bit_grouping_factor: 1,
         };
 
         _ = optimize_v0(
@@ -611,6 +615,7 @@ pub(crate) mod tests {
             maximum_acceptable_error_probability: _4_SIGMA,
             ciphertext_modulus_log: 64,
             complexity_model: &CpuComplexity::default(),
+            multi_bit_grouping_factor: 1,
         };
 
         let state = optimize(&dag);
@@ -3,7 +3,9 @@ use crate::config;
 use crate::parameters::{BrDecompositionParameters, CmuxParameters, GlweParameters};
 use crate::utils::cache::ephemeral::{CacheHashMap, EphemeralCache};
 use crate::utils::cache::persistent::{default_cache_dir, PersistentCacheHashMap};
+use crate::utils::square;
 use concrete_cpu_noise_model::gaussian_noise::noise::cmux::variance_cmux;
+use concrete_cpu_noise_model::gaussian_noise::noise::multi_bit_external_product_glwe::variance_multi_bit_external_product_glwe;
 use serde::{Deserialize, Serialize};
 use std::sync::Arc;
 
@@ -14,15 +16,32 @@ pub struct CmuxComplexityNoise {
     pub decomp: BrDecompositionParameters,
     pub complexity: f64,
     pub noise: f64,
+    // number of mask elements processed by each external product, 1 for the classic bootstrap
+    pub grouping_factor: u64,
 }
 
 impl CmuxComplexityNoise {
+    fn external_products(&self, in_lwe_dim: u64) -> f64 {
+        ((in_lwe_dim + self.grouping_factor - 1) / self.grouping_factor) as f64
+    }
     pub fn complexity_br(&self, in_lwe_dim: u64) -> f64 {
-        in_lwe_dim as f64 * self.complexity
+        self.external_products(in_lwe_dim) * self.complexity
     }
     pub fn noise_br(&self, in_lwe_dim: u64) -> f64 {
-        in_lwe_dim as f64 * self.noise
+        self.external_products(in_lwe_dim) * self.noise
+    }
+}
+
+/* Complexity of the sum, in the fourier domain, of the 2^grouping_factor - 1 ggsw of a group
+multiplied by their monomials, done before each external product of a multi bit bootstrap */
+fn multi_bit_ggsw_complexity(grouping_factor: u64, params: CmuxParameters) -> f64 {
+    if grouping_factor == 1 {
+        return 0.0;
     }
+    let glwe_params = params.output_glwe_params;
+    let ggsw_polynomials = square(glwe_params.glwe_dimension + 1) as f64
+        * params.br_decomposition_parameter.level as f64;
+    ((1 << grouping_factor) - 1) as f64 * ggsw_polynomials * glwe_params.polynomial_size() as f64
 }
 
 /* This is stricly variance decreasing and strictly complexity increasing */
@@ -31,8 +50,10 @@ pub fn pareto_quantities(
     ciphertext_modulus_log: u32,
     security_level: u64,
     glwe_params: GlweParameters,
+    grouping_factor: u64,
 ) -> Vec<CmuxComplexityNoise> {
     assert!(ciphertext_modulus_log == 64);
+    assert!(grouping_factor >= 1);
 
     let variance_bsk = glwe_params.minimal_variance(ciphertext_modulus_log, security_level);
 
@@ -53,14 +74,27 @@ pub fn pareto_quantities(
         let range = (1..=prev_best_log2_base).rev();
 
         for log2_base in range {
-            let base_noise = variance_cmux(
-                glwe_params.glwe_dimension,
-                glwe_params.polynomial_size(),
-                log2_base,
-                level,
-                ciphertext_modulus_log,
-                variance_bsk,
-            );
+            let base_noise = if grouping_factor == 1 {
+                variance_cmux(
+                    glwe_params.glwe_dimension,
+                    glwe_params.polynomial_size(),
+                    log2_base,
+                    level,
+                    ciphertext_modulus_log,
+                    variance_bsk,
+                )
+            } else {
+                variance_multi_bit_external_product_glwe(
+                    glwe_params.glwe_dimension,
+                    glwe_params.polynomial_size(),
+                    log2_base,
+                    level,
+                    ciphertext_modulus_log,
+                    variance_bsk,
+                    grouping_factor as u32,
+                    false,
+                )
+            };
             if base_noise > level_decreasing_base_noise {
                 break;
             }
@@ -88,12 +122,14 @@ pub fn pareto_quantities(
             output_glwe_params: glwe_params,
         };
 
-        let complexity = complexity_model.cmux_complexity(params, ciphertext_modulus_log);
+        let complexity = complexity_model.cmux_complexity(params, ciphertext_modulus_log)
+            + multi_bit_ggsw_complexity(grouping_factor, params);
 
         quantities.push(CmuxComplexityNoise {
             decomp: params.br_decomposition_parameter,
             noise: level_decreasing_base_noise,
             complexity,
+            grouping_factor,
         });
         assert!(increasing_complexity < complexity);
         increasing_complexity = complexity;
@@ -114,15 +150,21 @@ pub fn lowest_complexity_br(quantities: &[CmuxComplexityNoise], in_lwe_dim: u64)
     quantities[0].complexity_br(in_lwe_dim)
 }
 
-pub type Cache = CacheHashMap<GlweParameters, Vec<CmuxComplexityNoise>>;
+// The pareto front depends on the grouping factor of the bootstrap keys
+pub type Cache = CacheHashMap<(GlweParameters, u64), Vec<CmuxComplexityNoise>>;
 
 impl Cache {
-    pub fn pareto_quantities(&mut self, glwe_params: GlweParameters) -> &[CmuxComplexityNoise] {
-        self.get(glwe_params)
+    pub fn pareto_quantities(
+        &mut self,
+        glwe_params: GlweParameters,
+        grouping_factor: u64,
+    ) -> &[CmuxComplexityNoise] {
+        self.get((glwe_params, grouping_factor))
     }
 }
 
-pub type PersistDecompCache = PersistentCacheHashMap<GlweParameters, Vec<CmuxComplexityNoise>>;
+pub type PersistDecompCache =
+    PersistentCacheHashMap<(GlweParameters, u64), Vec<CmuxComplexityNoise>>;
 
 pub fn cache(
     security_level: u64,
@@ -134,12 +176,13 @@ pub fn cache(
     let hardware = processing_unit.br_to_string();
     let path = format!("{cache_dir}/cmux-decomp-{hardware}-64-{security_level}");
 
-    let function = move |glwe_params: GlweParameters| {
+    let function = move |(glwe_params, grouping_factor): (GlweParameters, u64)| {
         pareto_quantities(
             complexity_model.as_ref(),
             ciphertext_modulus_log,
             security_level,
             glwe_params,
+            grouping_factor,
         )
     };
     PersistentCacheHashMap::new_no_read(&path, VERSION, function)
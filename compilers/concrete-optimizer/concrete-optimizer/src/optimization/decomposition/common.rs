@@ -2,4 +2,4 @@ use crate::parameters::GlweParameters;
 
 pub type MacroParam = (GlweParameters, u64);
 
-pub const VERSION: u64 = 3;
+pub const VERSION: u64 = 4;
@@ -464,7 +464,8 @@ fn optimize_raw(
                 glwe_dimension: glwe_dim,
             };
 
-            let pareto_cmux = caches.cmux.pareto_quantities(glwe_params);
+            // the bootstrap keys of the wop-pbs are classic ones
+            let pareto_cmux = caches.cmux.pareto_quantities(glwe_params, 1);
 
             let pareto_pp_switch = caches.pp_switch.pareto_quantities(glwe_params);
 
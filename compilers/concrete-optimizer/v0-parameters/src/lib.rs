@@ -113,6 +113,7 @@ pub fn all_results(args: &Args) -> Vec<Vec<Option<Solution>>> {
         maximum_acceptable_error_probability,
         ciphertext_modulus_log: 64,
         complexity_model: &CpuComplexity::default(),
+        multi_bit_grouping_factor: 1,
     };
 
     let cache = decomposition::cache(security_level, processing_unit, None, cache_on_disk);
@@ -4,7 +4,7 @@ Declaration of `Circuit` class.
 
 # pylint: disable=import-error,no-member,no-name-in-module
 
-from typing import Any, Optional, Tuple, Union
+from typing import Any, Dict, List, Optional, Tuple, Union
 
 import numpy as np
 
@@ -225,3 +225,26 @@ class Circuit:
         Get the probability of having at least one simple TLU error during the entire execution.
         """
         return self.server.global_p_error
+
+    @property
+    def operation_statistics(self) -> List[Dict[str, Any]]:
+        """
+        Get the number and the estimated complexity of the keyswitches, bootstraps and wop-pbs
+        for each location and key of the circuit, by decreasing complexity.
+        """
+        return self.server.operation_statistics
+
+    @property
+    def peak_size_of_ciphertexts(self) -> int:
+        """
+        Get the estimated peak size of the ciphertexts alive at the same time in the circuit.
+        """
+        return self.server.peak_size_of_ciphertexts
+
+    @property
+    def critical_path_complexity(self) -> float:
+        """
+        Get the estimated complexity of the circuit when all of its independent operations are run
+        in parallel.
+        """
+        return self.server.critical_path_complexity
@@ -8,7 +8,7 @@ import json
 import shutil
 import tempfile
 from pathlib import Path
-from typing import Optional, Union
+from typing import Any, Dict, List, Optional, Union
 
 # mypy: disable-error-code=attr-defined
 import concrete.compiler
@@ -22,8 +22,10 @@ from concrete.compiler import (
     LibraryCompilationResult,
     LibraryLambda,
     LibrarySupport,
+    PreparedEvaluationKeys,
     PublicArguments,
     PublicResult,
+    PublicResultFuture,
 )
 from mlir._mlir_libs._concretelang._compiler import OptimizerStrategy
 
@@ -258,7 +260,39 @@ class Server:
 
         return Server(client_specs, output_dir, support, compilation_result, server_lambda)
 
-    def run(self, args: PublicArguments, evaluation_keys: EvaluationKeys) -> PublicResult:
+    def prepare_evaluation_keys(
+        self,
+        evaluation_keys: EvaluationKeys,
+        shared_keys_path: Optional[str] = None,
+    ) -> PreparedEvaluationKeys:
+        """
+        Start the preparation of evaluation keys for encrypted computation in background.
+
+        The preparation converts the bootstrap keys to the representation used during evaluation,
+        it is otherwise done at each call to `run`. A call made while the preparation is in flight
+        only waits for the keys it uses.
+
+        Args:
+            evaluation_keys (EvaluationKeys):
+                evaluation keys for encrypted computation
+
+            shared_keys_path (Optional[str], default = None):
+                directory (e.g. /dev/shm or a hugetlbfs mount point) where the prepared keys
+                are shared with the other server processes of the host, so they are prepared
+                only once per host, the keys are private to the process if None
+
+        Returns:
+            PreparedEvaluationKeys:
+                handle on the prepared keys, to be used in subsequent calls to `run`
+        """
+
+        return evaluation_keys.prepare(shared_keys_path)
+
+    def run(
+        self,
+        args: PublicArguments,
+        evaluation_keys: Union[EvaluationKeys, PreparedEvaluationKeys],
+    ) -> PublicResult:
         """
         Evaluate using encrypted arguments.
 
@@ -266,8 +300,9 @@ class Server:
             args (PublicArguments):
                 encrypted arguments of the computation
 
-            evaluation_keys (EvaluationKeys):
-                evaluation keys for encrypted computation
+            evaluation_keys (Union[EvaluationKeys, PreparedEvaluationKeys]):
+                evaluation keys for encrypted computation, or keys prepared by
+                `prepare_evaluation_keys`
 
         Returns:
             PublicResult:
@@ -276,6 +311,76 @@ class Server:
 
         return self._support.server_call(self._server_lambda, args, evaluation_keys)
 
+    def run_async(
+        self,
+        args: PublicArguments,
+        evaluation_keys: Union[EvaluationKeys, PreparedEvaluationKeys],
+    ) -> PublicResultFuture:
+        """
+        Evaluate using encrypted arguments, without waiting for the result.
+
+        The evaluation runs on a pool of native workers and doesn't hold the GIL, so other
+        Python threads (e.g., the ones serving other requests) run meanwhile.
+
+        Args:
+            args (PublicArguments):
+                encrypted arguments of the computation
+
+            evaluation_keys (Union[EvaluationKeys, PreparedEvaluationKeys]):
+                evaluation keys for encrypted computation, or keys prepared by
+                `prepare_evaluation_keys`
+
+        Returns:
+            PublicResultFuture:
+                future of the encrypted result of the computation
+        """
+
+        return self._support.server_call_async(self._server_lambda, args, evaluation_keys)
+
+    @staticmethod
+    def performance_counters() -> dict:
+        """
+        Get the performance counters of the runtime.
+
+        Counters are shared by all the servers of the process and are always recorded.
+
+        Returns:
+            dict:
+                memory allocated by the runtime, and, for each operation, key and parameters,
+                the count of operations, their total duration and an histogram of their
+                latencies (bucket i counts the latencies in [2^i, 2^(i+1)) nanoseconds)
+        """
+
+        return concrete.compiler.performance_counters()
+
+    @staticmethod
+    def reset_performance_counters():
+        """
+        Reset the performance counters of the runtime.
+        """
+
+        concrete.compiler.reset_performance_counters()
+
+    @staticmethod
+    def start_trace():
+        """
+        Start recording a trace of the operations of the runtime.
+        """
+
+        concrete.compiler.start_trace()
+
+    @staticmethod
+    def stop_trace(path: Union[str, Path]):
+        """
+        Stop recording the trace and save it.
+
+        Args:
+            path (Union[str, Path]):
+                path of the trace file, in the Chrome trace event format (readable by Perfetto)
+        """
+
+        concrete.compiler.stop_trace(str(path))
+
     def cleanup(self):
         """
         Cleanup the temporary library output directory.
@@ -339,3 +444,27 @@ class Server:
         Get the probability of having at least one simple TLU error during the entire execution.
         """
         return self._compilation_feedback.global_p_error
+
+    @property
+    def operation_statistics(self) -> List[Dict[str, Any]]:
+        """
+        Get the number and the estimated complexity of the keyswitches, bootstraps and wop-pbs
+        for each location and key of the compiled program, by decreasing complexity.
+        """
+        return self._compilation_feedback.operation_statistics
+
+    @property
+    def peak_size_of_ciphertexts(self) -> int:
+        """
+        Get the estimated peak size of the ciphertexts alive at the same time in the compiled
+        program.
+        """
+        return self._compilation_feedback.peak_ciphertexts_size
+
+    @property
+    def critical_path_complexity(self) -> float:
+        """
+        Get the estimated complexity of the compiled program when all of its independent operations
+        are run in parallel.
+        """
+        return self._compilation_feedback.critical_path_complexity
@@ -2,6 +2,7 @@
 Tests of `Circuit` class.
 """
 
+import json
 import tempfile
 from pathlib import Path
 
@@ -53,10 +54,16 @@ def test_circuit_feedback(helpers):
     assert isinstance(circuit.size_of_outputs, int)
     assert isinstance(circuit.p_error, float)
     assert isinstance(circuit.global_p_error, float)
+    assert isinstance(circuit.operation_statistics, list)
+    assert isinstance(circuit.peak_size_of_ciphertexts, int)
+    assert isinstance(circuit.critical_path_complexity, float)
 
     assert circuit.p_error <= p_error
     assert circuit.global_p_error <= global_p_error
 
+    assert sum(statistic["count"] for statistic in circuit.operation_statistics) > 0
+    assert circuit.critical_path_complexity > 0
+
 
 def test_circuit_bad_run(helpers):
     """
@@ -192,6 +199,135 @@ def test_client_server_api(helpers):
         server.cleanup()
 
 
+def test_client_server_api_prepared_evaluation_keys(helpers):
+    """
+    Test client/server API with evaluation keys prepared ahead of the calls.
+    """
+
+    configuration = helpers.configuration()
+
+    @compiler({"x": "encrypted"})
+    def function(x):
+        return (x**2) % 16
+
+    inputset = [np.random.randint(0, 8, size=(3,)) for _ in range(10)]
+    circuit = function.compile(inputset, configuration.fork(jit=False))
+
+    server = circuit.server
+    client = circuit.client
+
+    prepared_evaluation_keys = server.prepare_evaluation_keys(client.evaluation_keys)
+    for sample in ([3, 5, 1], [7, 2, 0]):
+        result = server.run(client.encrypt(sample), prepared_evaluation_keys)
+        assert np.array_equal(client.decrypt(result), [(x**2) % 16 for x in sample])
+
+    prepared_evaluation_keys.wait()
+    assert prepared_evaluation_keys.is_ready()
+
+    circuit.cleanup()
+
+
+def test_client_server_api_run_async(helpers):
+    """
+    Test client/server API with concurrent asynchronous runs.
+    """
+
+    configuration = helpers.configuration()
+
+    @compiler({"x": "encrypted"})
+    def function(x):
+        return (x**2) % 16
+
+    inputset = [np.random.randint(0, 8, size=(3,)) for _ in range(10)]
+    circuit = function.compile(inputset, configuration.fork(jit=False))
+
+    server = circuit.server
+    client = circuit.client
+
+    prepared_evaluation_keys = server.prepare_evaluation_keys(client.evaluation_keys)
+    samples = [[3, 5, 1], [7, 2, 0], [4, 6, 2]]
+    futures = [
+        server.run_async(client.encrypt(sample), prepared_evaluation_keys) for sample in samples
+    ]
+    for sample, future in zip(samples, futures):
+        assert np.array_equal(client.decrypt(future.result()), [(x**2) % 16 for x in sample])
+        assert future.done()
+
+    circuit.cleanup()
+
+
+def test_client_server_api_shared_evaluation_keys(helpers):
+    """
+    Test client/server API with evaluation keys prepared in shared segments.
+    """
+
+    configuration = helpers.configuration()
+
+    @compiler({"x": "encrypted"})
+    def function(x):
+        return (x**2) % 16
+
+    inputset = [np.random.randint(0, 8, size=(3,)) for _ in range(10)]
+    circuit = function.compile(inputset, configuration.fork(jit=False))
+
+    server = circuit.server
+    client = circuit.client
+
+    with tempfile.TemporaryDirectory() as shared_keys_path:
+        # the second preparation maps the segments created by the first one
+        for _ in range(2):
+            prepared_evaluation_keys = server.prepare_evaluation_keys(
+                client.evaluation_keys,
+                shared_keys_path=shared_keys_path,
+            )
+            sample = [3, 5, 1]
+            result = server.run(client.encrypt(sample), prepared_evaluation_keys)
+            assert np.array_equal(client.decrypt(result), [(x**2) % 16 for x in sample])
+
+        assert len(list(Path(shared_keys_path).iterdir())) > 0
+
+    circuit.cleanup()
+
+
+def test_server_performance_counters(helpers):
+    """
+    Test performance counters and trace of the server.
+    """
+
+    configuration = helpers.configuration()
+
+    @compiler({"x": "encrypted"})
+    def function(x):
+        return (x**2) % 16
+
+    inputset = [np.random.randint(0, 8, size=(3,)) for _ in range(10)]
+    circuit = function.compile(inputset, configuration.fork(jit=False))
+
+    server = circuit.server
+    client = circuit.client
+
+    server.reset_performance_counters()
+    with tempfile.TemporaryDirectory() as tmp_dir:
+        trace_path = Path(tmp_dir) / "trace.json"
+
+        server.start_trace()
+        server.run(client.encrypt([3, 5, 1]), client.evaluation_keys)
+        server.stop_trace(trace_path)
+
+        with open(trace_path, "r", encoding="utf-8") as f:
+            trace = json.load(f)
+
+    counters = server.performance_counters()
+    bootstraps = [op for op in counters["operations"] if op["op"] == "bootstrap"]
+    assert sum(op["count"] for op in bootstraps) >= 3
+    assert all(sum(op["histogram_log2_ns"]) == op["count"] for op in bootstraps)
+
+    traced = [event for event in trace["traceEvents"] if event["name"] == "bootstrap"]
+    assert len(traced) == sum(op["count"] for op in bootstraps)
+
+    circuit.cleanup()
+
+
 def test_client_server_api_crt(helpers):
     """
     Test client/server API on a CRT circuit.